@@ -25,11 +25,20 @@ using pw::framebuffer_pool::FramebufferPool;
 
 namespace {
 
+#if FRAMEBUFFER_BAND_HEIGHT > 0
+// Draw the display a band at a time, using two band buffers so that one band
+// can be drawn while the other is being sent to the display.
+constexpr pw::math::Size<uint16_t> kFramebufferDimensions = {
+    .width = DISPLAY_WIDTH,
+    .height = FRAMEBUFFER_BAND_HEIGHT,
+};
+#else
 constexpr uint16_t kDisplayScaleFactor = 1;
 constexpr pw::math::Size<uint16_t> kFramebufferDimensions = {
     .width = DISPLAY_WIDTH / kDisplayScaleFactor,
     .height = DISPLAY_HEIGHT / kDisplayScaleFactor,
 };
+#endif
 constexpr size_t kNumPixels =
     kFramebufferDimensions.width * kFramebufferDimensions.height;
 constexpr uint16_t kFramebufferRowBytes =
@@ -37,8 +46,14 @@ constexpr uint16_t kFramebufferRowBytes =
 constexpr pw::math::Size<uint16_t> kDisplaySize = {DISPLAY_WIDTH,
                                                    DISPLAY_HEIGHT};
 
+#if FRAMEBUFFER_BAND_HEIGHT > 0
+color_rgb565_t s_pixel_data1[kNumPixels];
+color_rgb565_t s_pixel_data2[kNumPixels];
+const pw::Vector<void*, 2> s_pixel_buffers{s_pixel_data1, s_pixel_data2};
+#else
 color_rgb565_t s_pixel_data[kNumPixels];
 const pw::Vector<void*, 1> s_pixel_buffers{s_pixel_data};
+#endif
 FramebufferPool s_fb_pool({
     .fb_addr = s_pixel_buffers,
     .dimensions = kFramebufferDimensions,
@@ -12,11 +12,13 @@
 // License for the specific language governing permissions and limitations under
 // the License.
 #include "app_common/common.h"
+#include "pw_color/color.h"
 #include "pw_display/display.h"
 #include "pw_display_driver_null/display_driver.h"
 #include "pw_status/try.h"
 
 using pw::Status;
+using pw::color::color_rgb565_t;
 using pw::framebuffer::PixelFormat;
 using pw::framebuffer_pool::FramebufferPool;
 
@@ -26,6 +28,22 @@ constexpr pw::math::Size<uint16_t> kDisplaySize = {DISPLAY_WIDTH,
                                                    DISPLAY_HEIGHT};
 
 pw::display_driver::DisplayDriverNULL s_display_driver;
+#if FRAMEBUFFER_BAND_HEIGHT > 0
+// Band buffers, so that the display can be drawn a band at a time.
+constexpr pw::math::Size<uint16_t> kBandDimensions = {DISPLAY_WIDTH,
+                                                      FRAMEBUFFER_BAND_HEIGHT};
+constexpr uint16_t kBandRowBytes =
+    sizeof(color_rgb565_t) * kBandDimensions.width;
+color_rgb565_t s_band_data1[kBandDimensions.width * kBandDimensions.height];
+color_rgb565_t s_band_data2[kBandDimensions.width * kBandDimensions.height];
+const pw::Vector<void*, 2> s_pixel_buffers{s_band_data1, s_band_data2};
+pw::framebuffer_pool::FramebufferPool s_fb_pool({
+    .fb_addr = s_pixel_buffers,
+    .dimensions = kBandDimensions,
+    .row_bytes = kBandRowBytes,
+    .pixel_format = PixelFormat::RGB565,
+});
+#else
 const pw::Vector<void*, 0> s_pixel_buffers;
 pw::framebuffer_pool::FramebufferPool s_fb_pool({
     .fb_addr = s_pixel_buffers,
@@ -33,6 +51,7 @@ pw::framebuffer_pool::FramebufferPool s_fb_pool({
     .row_bytes = 0,
     .pixel_format = PixelFormat::None,
 });
+#endif
 pw::display::Display s_display(s_display_driver, kDisplaySize, s_fb_pool);
 
 }  // namespace
@@ -31,6 +31,7 @@
 #include "pw_spi/chip_selector_digital_out.h"
 #include "pw_spi_rp2040/initiator.h"
 #include "pw_status/status.h"
+#include "pw_status/try.h"
 #include "pw_sync/borrow.h"
 #include "pw_sync/mutex.h"
 
@@ -222,6 +223,15 @@ Status Common::Init() {
   // Set up the default UART and assign it to the default GPIO's.
   setup_default_uart();
 
+  unsigned actual_baudrate = spi_init(SPI_PORT, kBaudRate);
+  PW_LOG_DEBUG("Actual Baudrate: %u", actual_baudrate);
+
+#if SPI_MISO_GPIO != -1
+  gpio_set_function(SPI_MISO_GPIO, GPIO_FUNC_SPI);
+#endif
+  gpio_set_function(SPI_CLOCK_GPIO, GPIO_FUNC_SPI);
+  gpio_set_function(SPI_MOSI_GPIO, GPIO_FUNC_SPI);
+
   s_display_cs_pin.Enable();
   s_display_dc_pin.Enable();
 #if DISPLAY_RESET_GPIO != -1
@@ -232,30 +242,28 @@ Status Common::Init() {
   s_display_tear_effect_pin.Enable();
 #endif
 
+  // Start the display's power-up sequence, and finish the remaining setup
+  // while waiting out its delays.
+  PW_TRY(s_display_driver.StartInit());
+
   i2c_bus.Enable();
 
 #if BACKLIGHT_GPIO != -1
   SetBacklight(0xffff);  // Full brightness.
 #endif
 
-  unsigned actual_baudrate = spi_init(SPI_PORT, kBaudRate);
-  PW_LOG_DEBUG("Actual Baudrate: %u", actual_baudrate);
-
-#if SPI_MISO_GPIO != -1
-  gpio_set_function(SPI_MISO_GPIO, GPIO_FUNC_SPI);
-#endif
-  gpio_set_function(SPI_CLOCK_GPIO, GPIO_FUNC_SPI);
-  gpio_set_function(SPI_MOSI_GPIO, GPIO_FUNC_SPI);
+  Status status = s_display_driver.PollInit();
+  while (status.IsUnavailable()) {
+    status = s_display_driver.PollInit();
+  }
+  PW_TRY(status);
 
 #if USE_PIO
   // Init the display before the pixel pusher.
-  s_display_driver.Init();
-  auto result = s_pixel_pusher.Init(s_fb_pool);
+  PW_TRY(s_pixel_pusher.Init(s_fb_pool));
   s_pixel_pusher.SetPixelDouble(true);
-  return result;
-#else
-  return s_display_driver.Init();
 #endif
+  return pw::OkStatus();
 }
 
 // static
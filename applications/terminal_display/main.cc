@@ -15,6 +15,7 @@
 #include <cstdint>
 #include <cwchar>
 #include <forward_list>
+#include <iterator>
 #include <memory>
 #include <string_view>
 #include <utility>
@@ -31,7 +32,8 @@
 #include "pw_color/colors_pico8.h"
 #include "pw_draw/draw.h"
 #include "pw_draw/font_set.h"
-#include "pw_draw/pigweed_farm.h"
+#include "pw_draw/glyph_cache.h"
+#include "pw_draw/pigweed_farm_indexed.h"
 #include "pw_framebuffer/framebuffer.h"
 #include "pw_log/log.h"
 #include "pw_math/vector2.h"
@@ -41,6 +43,7 @@
 #include "pw_string/string_builder.h"
 #include "pw_sys_io/sys_io.h"
 #include "text_buffer.h"
+#include "text_buffer_renderer.h"
 
 #if defined(USE_FREERTOS)
 #include "FreeRTOS.h"
@@ -52,6 +55,7 @@ using pw::color::colors_pico8_rgb565;
 using pw::display::Display;
 using pw::draw::FontSet;
 using pw::framebuffer::Framebuffer;
+using pw::math::Rect;
 using pw::math::Size;
 using pw::math::Vector2;
 using pw::ring_buffer::PrefixedEntryRingBuffer;
@@ -133,7 +137,17 @@ constexpr int kButtonWidth = 108;
 constexpr Vector2<int> kButtonTL = {320 - kButtonWidth, 0};
 constexpr Size<int> kButtonSize = {kButtonWidth, 12};
 
-TextBuffer s_log_text_buffer;
+// The log text area geometry, in characters.
+constexpr int kLogColumns = 52;
+constexpr int kLogRows = 9;
+constexpr int kLogScrollbackRows = 16;
+
+TextBufferWithStorage<kLogColumns, kLogRows, kLogScrollbackRows>
+    s_log_text_buffer;
+pw::draw::GlyphCache s_glyph_cache;
+// Incremented whenever the animated part of the header (the sprite artwork and
+// the FPS message) changes.
+uint32_t s_animation_generation = 0;
 DemoDecoder s_demo_decoder(s_log_text_buffer);
 Button g_button(kButtonLabel, kButtonTL, kButtonSize);
 #if defined(USE_FREERTOS)
@@ -222,21 +236,78 @@ void LogCallback(std::string_view log) {
   pw::sys_io::WriteLine(log).IgnoreError();
 };
 
+constexpr int kSpritePosX = 10;
+constexpr int kSpritePosY = 24;
+constexpr int kSpriteScale = 4;
+constexpr int kSpriteBorderSize = 8;
+
+// The area of the screen redrawn when the header animation changes. This
+// covers the sprite artwork, the sun (which may rise above the artwork), and
+// the FPS message. The farm sprite sheet is 43x11 pixels.
+constexpr Rect<uint16_t> kAnimationArea = {
+    0,
+    0,
+    kSpritePosX + 43 * kSpriteScale + kSpriteBorderSize,
+    kSpritePosY + 11 * kSpriteScale + kSpriteBorderSize};
+
+Vector2<int> s_sun_offset;
+
+// Advance the sun animation by one frame. Returns true if the sun moved.
+bool MoveSun() {
+  static int motion_dir = -1;
+  static int frame_num = 0;
+  const Vector2<int> prev_offset = s_sun_offset;
+  frame_num++;
+  if ((frame_num % 5) == 0)
+    s_sun_offset.x += motion_dir;
+  if ((frame_num % 15) == 0)
+    s_sun_offset.y -= motion_dir;
+  if (s_sun_offset.x < -60)
+    motion_dir = 1;
+  else if (s_sun_offset.x > 10)
+    motion_dir = -1;
+  return s_sun_offset.x != prev_offset.x || s_sun_offset.y != prev_offset.y;
+}
+
+// The farm sprite's shadow colors, indexed like pigweed_farm_indexed_palette,
+// so that the shadow is drawn from the same sprite with a palette swap.
+constexpr color_rgb565_t kFarmShadowPalette[] = {
+    0xf81f,  // Transparent
+    0x383,
+    0x83ce,
+    0x383,
+    0x83ce,
+    0x8004,
+    0x8004,
+    0x81ca,
+    0x81ca,
+    0x205,
+    0x205,
+    0x5143,
+    0x5143,
+};
+static_assert(std::size(kFarmShadowPalette) ==
+              std::size(pigweed_farm_indexed_palette));
+
 // Draw the Pigweed sprite and artwork at the top of the display.
 // Returns the bottom Y coordinate drawn.
 int DrawPigweedSprite(Framebuffer& framebuffer) {
-  int sprite_pos_x = 10;
-  int sprite_pos_y = 24;
-  int sprite_scale = 4;
-  int border_size = 8;
+  int sprite_pos_x = kSpritePosX;
+  int sprite_pos_y = kSpritePosY;
+  int sprite_scale = kSpriteScale;
+  int border_size = kSpriteBorderSize;
+  const int sprite_width =
+      pigweed_farm_indexed_sprite_sheet.width * sprite_scale;
+  const int sprite_height =
+      pigweed_farm_indexed_sprite_sheet.height * sprite_scale;
 
   // Draw the dark blue border
   pw::draw::DrawRectWH(
       framebuffer,
       sprite_pos_x - border_size,
       sprite_pos_y - border_size,
-      pigweed_farm_sprite_sheet.width * sprite_scale + (border_size * 2),
-      pigweed_farm_sprite_sheet.height * sprite_scale + (border_size * 2),
+      sprite_width + (border_size * 2),
+      sprite_height + (border_size * 2),
       colors_pico8_rgb565[COLOR_DARK_BLUE],
       true);
 
@@ -248,54 +319,44 @@ int DrawPigweedSprite(Framebuffer& framebuffer) {
       framebuffer,
       sprite_pos_x - border_size,
       sprite_pos_y - border_size,
-      pigweed_farm_sprite_sheet.width * sprite_scale + (border_size * 2),
-      pigweed_farm_sprite_sheet.height * sprite_scale + (border_size * 2),
+      sprite_width + (border_size * 2),
+      sprite_height + (border_size * 2),
       colors_pico8_rgb565[COLOR_BLUE],
       true);
 
-  static Vector2<int> sun_offset;
-  static int motion_dir = -1;
-  static int frame_num = 0;
-  frame_num++;
-  if ((frame_num % 5) == 0)
-    sun_offset.x += motion_dir;
-  if ((frame_num % 15) == 0)
-    sun_offset.y -= motion_dir;
-  if (sun_offset.x < -60)
-    motion_dir = 1;
-  else if (sun_offset.x > 10)
-    motion_dir = -1;
+  const Vector2<int> sun_offset = s_sun_offset;
 
   // Draw the Sun
   pw::draw::DrawCircle(framebuffer,
-                       sun_offset.x + sprite_pos_x +
-                           (pigweed_farm_sprite_sheet.width * sprite_scale) -
-                           32,
+                       sun_offset.x + sprite_pos_x + sprite_width - 32,
                        sun_offset.y + sprite_pos_y,
                        20,
                        colors_pico8_rgb565[COLOR_ORANGE],
                        true);
   pw::draw::DrawCircle(framebuffer,
-                       sun_offset.x + sprite_pos_x +
-                           (pigweed_farm_sprite_sheet.width * sprite_scale) -
-                           32,
+                       sun_offset.x + sprite_pos_x + sprite_width - 32,
                        sun_offset.y + sprite_pos_y,
                        18,
                        colors_pico8_rgb565[COLOR_YELLOW],
                        true);
 
   // Draw the farm sprite's shadow
-  pigweed_farm_sprite_sheet.current_index = 1;
+  pigweed_farm_indexed_sprite_sheet.current_index = 0;
   pw::draw::DrawSprite(framebuffer,
                        sprite_pos_x + 2,
                        sprite_pos_y + 2,
-                       &pigweed_farm_sprite_sheet,
-                       4);
+                       &pigweed_farm_indexed_sprite_sheet,
+                       kFarmShadowPalette,
+                       4,
+                       pw::draw::SpriteFlip::kNone);
 
   // Draw the farm sprite
-  pigweed_farm_sprite_sheet.current_index = 0;
-  pw::draw::DrawSprite(
-      framebuffer, sprite_pos_x, sprite_pos_y, &pigweed_farm_sprite_sheet, 4);
+  pw::draw::DrawSprite(framebuffer,
+                       sprite_pos_x,
+                       sprite_pos_y,
+                       &pigweed_farm_indexed_sprite_sheet,
+                       4,
+                       pw::draw::SpriteFlip::kNone);
 
   return 76;
 }
@@ -311,7 +372,8 @@ void DrawFPS(Vector2<int> tl,
              colors_pico8_rgb565[COLOR_PEACH],
              kBlack,
              pw::draw::font6x8,
-             framebuffer);
+             framebuffer,
+             s_glyph_cache);
 }
 
 // Draw the pigweed text banner.
@@ -331,7 +393,8 @@ int DrawPigweedBanner(Vector2<int> tl, Framebuffer& framebuffer) {
                                        colors_pico8_rgb565[COLOR_PINK],
                                        kBlack,
                                        pw::draw::font6x8_box_chars,
-                                       framebuffer);
+                                       framebuffer,
+                                       s_glyph_cache);
     tl.y += string_dims.height;
   }
   return tl.y - pw::draw::font6x8_box_chars.height;
@@ -399,34 +462,86 @@ int DrawHeader(Framebuffer& framebuffer, std::wstring_view fps_msg) {
   return DrawFontSheets(tl, framebuffer);
 }
 
-void DrawLogTextBuffer(int top, const FontSet& font, Framebuffer& framebuffer) {
-  constexpr int kLeft = 0;
-  Vector2<int> loc;
-  Vector2<int> pos{kLeft, top};
-  Size<int> buffer_size = s_log_text_buffer.GetSize();
-  for (loc.y = 0; loc.y < buffer_size.height; loc.y++) {
-    for (loc.x = 0; loc.x < buffer_size.width; loc.x++) {
-      auto ch = s_log_text_buffer.GetChar(loc);
-      if (!ch.ok())
-        continue;
-      Size<int> char_size = DrawCharacter(ch->ch,
-                                          pos,
-                                          ch->foreground_color,
-                                          ch->background_color,
-                                          font,
-                                          framebuffer);
-      pos.x += char_size.width;
-    }
-    pos.y += font.height;
-    pos.x = kLeft;
+// Redraw the animated part of the header.
+void DrawAnimation(Framebuffer& framebuffer, std::wstring_view fps_msg) {
+  pw::draw::DrawRectWH(framebuffer,
+                       kAnimationArea.x,
+                       kAnimationArea.y,
+                       kAnimationArea.width,
+                       kAnimationArea.height,
+                       kBlack,
+                       /*filled=*/true);
+  DrawPigweedSprite(framebuffer);
+  DrawFPS({1, 2}, framebuffer, fps_msg);
+}
+
+// What was last drawn into a framebuffer, so that only the parts of the screen
+// which have changed since then are redrawn.
+struct FramebufferState {
+  const void* data = nullptr;
+  uint32_t animation_generation = 0;
+};
+
+std::array<FramebufferState, TextBufferRenderer::kMaxFramebuffers>
+    s_framebuffer_states;
+size_t s_next_evicted_state = 0;
+
+// Return the state of |framebuffer|, or nullptr if nothing has been drawn into
+// it yet.
+FramebufferState* GetFramebufferState(const Framebuffer& framebuffer) {
+  for (FramebufferState& state : s_framebuffer_states) {
+    if (state.data == framebuffer.data())
+      return &state;
   }
+  return nullptr;
 }
 
-void DrawFrame(Framebuffer& framebuffer, std::wstring_view fps_msg) {
-  constexpr int kHeaderMargin = 4;
-  int header_bottom = DrawHeader(framebuffer, fps_msg);
-  DrawLogTextBuffer(
-      header_bottom + kHeaderMargin, pw::draw::font6x8, framebuffer);
+// Start tracking the state of |framebuffer|, which has just been drawn in
+// full, replacing the oldest tracked framebuffer if necessary.
+FramebufferState& AddFramebufferState(const Framebuffer& framebuffer) {
+  FramebufferState& state = s_framebuffer_states[s_next_evicted_state];
+  s_next_evicted_state =
+      (s_next_evicted_state + 1) % s_framebuffer_states.size();
+  state.data = framebuffer.data();
+  state.animation_generation = s_animation_generation;
+  return state;
+}
+
+// Draw the frame, redrawing only what has changed since |framebuffer| was last
+// drawn, and mark the redrawn areas as dirty on |display|.
+void DrawFrame(Framebuffer& framebuffer,
+               std::wstring_view fps_msg,
+               TextBufferRenderer& text_renderer,
+               Display& display) {
+  FramebufferState* state = GetFramebufferState(framebuffer);
+  if (!state) {
+    pw::draw::Fill(framebuffer, kBlack);
+    DrawHeader(framebuffer, fps_msg);
+    state = &AddFramebufferState(framebuffer);
+    display.MarkDirty(
+        {0, 0, framebuffer.size().width, framebuffer.size().height});
+  } else if (state->animation_generation != s_animation_generation) {
+    DrawAnimation(framebuffer, fps_msg);
+    display.MarkDirty(kAnimationArea);
+  }
+  state->animation_generation = s_animation_generation;
+
+  text_renderer.Draw(framebuffer, [&display](const Rect<uint16_t>& rect) {
+    display.MarkDirty(rect);
+  });
+}
+
+// Draw everything which is visible in |band|, which covers a horizontal strip
+// of the display starting at band.origin().
+void DrawBand(Framebuffer& band,
+              std::wstring_view fps_msg,
+              int header_bottom,
+              TextBufferRenderer& text_renderer) {
+  pw::draw::Fill(band, kBlack);
+  if (band.origin().y < header_bottom) {
+    DrawHeader(band, fps_msg);
+  }
+  text_renderer.DrawAll(band);
 }
 
 void CreateDemoLogMessages() {
@@ -475,30 +590,65 @@ void MainTask(void* pvParameters) {
   PW_CHECK_OK(Common::Init());
 
   Display& display = Common::GetDisplay();
-  Framebuffer framebuffer = display.GetFramebuffer();
-  PW_ASSERT(framebuffer.is_valid());
-
-  pw::draw::Fill(framebuffer, kBlack);
 
-  DrawFrame(framebuffer, fps_view);
-  // Push the frame buffer to the screen.
-  display.ReleaseFramebuffer(std::move(framebuffer));
-
-  // The display loop.
-  while (1) {
-    uint32_t start = pw::spin_delay::Millis();
+  // The log text is drawn below the header, so draw the header once to find
+  // where it ends.
+  constexpr int kHeaderMargin = 4;
+  int header_bottom = 0;
+  Framebuffer framebuffer;
+  if (display.IsBanded()) {
+    PW_CHECK_OK(display.DrawBands([&](Framebuffer& band) {
+      pw::draw::Fill(band, kBlack);
+      header_bottom = DrawHeader(band, fps_view);
+    }));
+  } else {
     framebuffer = display.GetFramebuffer();
     PW_ASSERT(framebuffer.is_valid());
     pw::draw::Fill(framebuffer, kBlack);
-    DrawFrame(framebuffer, fps_view);
-    uint32_t end = pw::spin_delay::Millis();
-    uint32_t time = end - start;
-    draw_times.PushBack(pw::as_bytes(pw::span{std::addressof(time), 1}));
-    start = end;
-
+    header_bottom = DrawHeader(framebuffer, fps_view);
+    AddFramebufferState(framebuffer);
+    display.MarkDirty(
+        {0, 0, framebuffer.size().width, framebuffer.size().height});
+  }
+  TextBufferRenderer text_renderer(s_log_text_buffer,
+                                   pw::draw::font6x8,
+                                   {0, header_bottom + kHeaderMargin},
+                                   s_glyph_cache);
+
+  if (!display.IsBanded()) {
+    DrawFrame(framebuffer, fps_view, text_renderer, display);
+    // Push the frame buffer to the screen.
     display.ReleaseFramebuffer(std::move(framebuffer));
-    time = pw::spin_delay::Millis() - start;
-    flush_times.PushBack(pw::as_bytes(pw::span{std::addressof(time), 1}));
+  }
+
+  // The display loop.
+  while (1) {
+    uint32_t start = pw::spin_delay::Millis();
+    if (MoveSun())
+      s_animation_generation++;
+    if (display.IsBanded()) {
+      // Bands are drawn and flushed together, so the whole frame is counted
+      // as draw time.
+      PW_CHECK_OK(display.DrawBands([&](Framebuffer& band) {
+        DrawBand(band, fps_view, header_bottom, text_renderer);
+      }));
+      uint32_t time = pw::spin_delay::Millis() - start;
+      draw_times.PushBack(pw::as_bytes(pw::span{std::addressof(time), 1}));
+      time = 0;
+      flush_times.PushBack(pw::as_bytes(pw::span{std::addressof(time), 1}));
+    } else {
+      framebuffer = display.GetFramebuffer();
+      PW_ASSERT(framebuffer.is_valid());
+      DrawFrame(framebuffer, fps_view, text_renderer, display);
+      uint32_t end = pw::spin_delay::Millis();
+      uint32_t time = end - start;
+      draw_times.PushBack(pw::as_bytes(pw::span{std::addressof(time), 1}));
+      start = end;
+
+      display.ReleaseFramebuffer(std::move(framebuffer));
+      time = pw::spin_delay::Millis() - start;
+      flush_times.PushBack(pw::as_bytes(pw::span{std::addressof(time), 1}));
+    }
 
     // Every second make a log message.
     frames++;
@@ -516,6 +666,7 @@ void MainTask(void* pvParameters) {
                               CalcAverageUint32Value(draw_times),
                               CalcAverageUint32Value(flush_times));
       fps_view = std::wstring_view(fps_buffer.data(), len);
+      s_animation_generation++;
 
       frame_start_millis = pw::spin_delay::Millis();
     }
@@ -14,18 +14,82 @@
 
 #include "text_buffer.h"
 
+#include <algorithm>
+#include <cstdlib>
+
+#include "pw_assert/assert.h"
+
 using pw::color::color_rgb565_t;
 using pw::math::Vector2;
 
 namespace {
-constexpr int kMaxColIdx = kNumCharsWide - 1;
-constexpr int kMaxRowIdx = kNumRows - 1;
 
-static_assert(kNumRows > 1, "Text buffer too small");
+// Return a measure of the difference between two RGB565 colors.
+int ColorDistance(color_rgb565_t a, color_rgb565_t b) {
+  const int dr = ((a >> 11) & 0x1f) - ((b >> 11) & 0x1f);
+  const int dg = ((a >> 5) & 0x3f) - ((b >> 5) & 0x3f);
+  const int db = (a & 0x1f) - (b & 0x1f);
+  // Green has twice the resolution of red and blue.
+  return 4 * dr * dr + dg * dg + 4 * db * db;
+}
+
 }  // namespace
 
+TextBuffer::TextBuffer(pw::span<Cell> cells,
+                       pw::span<DirtyMask> dirty_masks,
+                       pw::span<DirtyMask> row_dirty_masks,
+                       int columns,
+                       int rows)
+    : cells_(cells),
+      dirty_masks_(dirty_masks),
+      row_dirty_masks_(row_dirty_masks),
+      columns_(columns),
+      rows_(rows),
+      num_ring_rows_(cells.size() / columns) {
+  PW_ASSERT(num_ring_rows_ >= rows);
+  PW_ASSERT(dirty_masks.size() == static_cast<size_t>(columns * rows));
+  PW_ASSERT(row_dirty_masks.size() == static_cast<size_t>(rows));
+}
+
+void TextBuffer::Clear() {
+  palette_size_ = 0;
+  const Cell blank = MakeCell(Char());
+  std::fill(cells_.begin(), cells_.end(), blank);
+  std::fill(dirty_masks_.begin(), dirty_masks_.end(), 0);
+  std::fill(row_dirty_masks_.begin(), row_dirty_masks_.end(), 0);
+  top_row_ = 0;
+  num_scrollback_rows_ = 0;
+  scrollback_offset_ = 0;
+  cursor_ = {0, 0};
+}
+
+uint8_t TextBuffer::GetColorIndex(color_rgb565_t color) {
+  for (size_t i = 0; i < palette_size_; i++) {
+    if (palette_[i] == color)
+      return i;
+  }
+  if (palette_size_ < kMaxColors) {
+    palette_[palette_size_] = color;
+    return palette_size_++;
+  }
+  size_t closest = 0;
+  for (size_t i = 1; i < kMaxColors; i++) {
+    if (ColorDistance(palette_[i], color) <
+        ColorDistance(palette_[closest], color)) {
+      closest = i;
+    }
+  }
+  return closest;
+}
+
+TextBuffer::Cell TextBuffer::MakeCell(const Char& ch) {
+  const uint8_t fg_index = GetColorIndex(ch.foreground_color);
+  const uint8_t bg_index = GetColorIndex(ch.background_color);
+  return Cell{ch.ch, static_cast<uint8_t>(fg_index << 4 | bg_index)};
+}
+
 void TextBuffer::InsertNewline() {
-  if (cursor_.y == kMaxRowIdx) {
+  if (cursor_.y == rows_ - 1) {
     ScrollUp();
   } else {
     cursor_.y++;
@@ -34,11 +98,44 @@ void TextBuffer::InsertNewline() {
 }
 
 pw::Result<TextBuffer::Char> TextBuffer::GetChar(Vector2<int> loc) const {
-  if (loc.x < 0 || static_cast<size_t>(loc.x) > kMaxColIdx || loc.y < 0 ||
-      static_cast<size_t>(loc.y) > kMaxRowIdx) {
+  if (loc.x < 0 || loc.x >= columns_ || loc.y < 0 || loc.y >= rows_) {
     return pw::Status::OutOfRange();
   }
-  return text_rows_[loc.y].chars[loc.x];
+  const Cell& cell = RingRow(ScreenRowIndex(loc.y))[loc.x];
+  return Char{cell.ch, palette_[cell.colors >> 4], palette_[cell.colors & 0xf]};
+}
+
+pw::Status TextBuffer::SetScrollbackOffset(int rows) {
+  if (rows < 0 || rows > num_scrollback_rows_)
+    return pw::Status::OutOfRange();
+  if (rows != scrollback_offset_) {
+    scrollback_offset_ = rows;
+    MarkAllDirty(~DirtyMask{0});
+    generation_++;
+  }
+  return pw::OkStatus();
+}
+
+void TextBuffer::MarkDirty(Vector2<int> loc) {
+  dirty_masks_[loc.y * columns_ + loc.x] = ~DirtyMask{0};
+  row_dirty_masks_[loc.y] = ~DirtyMask{0};
+}
+
+void TextBuffer::ClearDirty(int row, DirtyMask mask) {
+  DirtyMask* row_masks = &dirty_masks_[row * columns_];
+  for (int col = 0; col < columns_; col++) {
+    row_masks[col] &= ~mask;
+  }
+  row_dirty_masks_[row] &= ~mask;
+}
+
+void TextBuffer::MarkAllDirty(DirtyMask mask) {
+  for (DirtyMask& dirty_mask : dirty_masks_) {
+    dirty_mask |= mask;
+  }
+  for (DirtyMask& row_dirty_mask : row_dirty_masks_) {
+    row_dirty_mask |= mask;
+  }
 }
 
 void TextBuffer::DrawCharacter(const Char& ch) {
@@ -48,27 +145,53 @@ void TextBuffer::DrawCharacter(const Char& ch) {
     return;
   }
 
-  if (character_wrap_enabled_ && cursor_.x > kMaxColIdx) {
+  if (character_wrap_enabled_ && cursor_.x >= columns_) {
     InsertNewline();
   }
 
-  if (cursor_.x > kMaxColIdx) {
+  if (cursor_.x >= columns_) {
     // The current line has grown too long.
     return;
   }
 
   PW_ASSERT(cursor_.x >= 0 && cursor_.y >= 0);
-  PW_ASSERT(cursor_.y <= kMaxRowIdx);
-  PW_ASSERT(cursor_.x <= kMaxColIdx);
+  PW_ASSERT(cursor_.y < rows_);
 
-  text_rows_[cursor_.y].chars[cursor_.x] = ch;
+  Cell& dest = RingRow(TextRowIndex(cursor_.y))[cursor_.x];
+  const Cell cell = MakeCell(ch);
+  if (dest != cell) {
+    dest = cell;
+    const int screen_row = cursor_.y + scrollback_offset_;
+    if (screen_row < rows_)
+      MarkDirty({cursor_.x, screen_row});
+    generation_++;
+  }
 
   cursor_.x++;
 }
 
 void TextBuffer::ScrollUp() {
-  for (size_t r = 0; r < kMaxRowIdx; r++) {
-    text_rows_[r] = text_rows_[r + 1];
+  // Each screen row will show the contents of the row below it, so only the
+  // characters which differ between the two need to be redrawn. When the most
+  // recent text is shown, the bottom row will be blank.
+  const Cell blank = MakeCell(Char());
+  for (int r = 0; r < rows_; r++) {
+    const Cell* row = RingRow(ScreenRowIndex(r));
+    const Cell* next_row = (r < rows_ - 1 || scrollback_offset_ > 0)
+                               ? RingRow(ScreenRowIndex(r + 1))
+                               : nullptr;
+    for (int c = 0; c < columns_; c++) {
+      if (row[c] != (next_row ? next_row[c] : blank))
+        MarkDirty({c, r});
+    }
   }
-  text_rows_.back().Clear();
+
+  // The row after the bottom of the text is either unused, or the oldest row
+  // of history. It becomes the new (cleared) bottom row.
+  Cell* new_row = RingRow(TextRowIndex(rows_));
+  std::fill(new_row, new_row + columns_, blank);
+  top_row_ = (top_row_ + 1) % num_ring_rows_;
+  num_scrollback_rows_ =
+      std::min(num_scrollback_rows_ + 1, num_ring_rows_ - rows_);
+  generation_++;
 }
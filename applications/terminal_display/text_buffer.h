@@ -14,14 +14,15 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
 
 #include "pw_color/color.h"
 #include "pw_math/size.h"
 #include "pw_math/vector2.h"
 #include "pw_result/result.h"
-
-constexpr size_t kNumCharsWide = 52;
-constexpr size_t kNumRows = 9;
+#include "pw_span/span.h"
+#include "pw_status/status.h"
 
 constexpr pw::color::color_rgb565_t kBlackColor = 0x0000;
 constexpr pw::color::color_rgb565_t kWhiteColor = 0xffff;
@@ -30,8 +31,29 @@ constexpr pw::color::color_rgb565_t kWhiteColor = 0xffff;
 // at (0,0), and new characters are inserted right-to-left. Newline ('\n')
 // characters cause the text to be scrolled up - eventually rolling off the
 // top of the buffer to make space for new text rows at the bottom.
+//
+// Rows are stored in a ring, so scrolling does not move any characters. Rows
+// which scroll off the top are kept as scrollback history, which can be shown
+// with SetScrollbackOffset(), until their storage is needed for new rows.
+//
+// Characters are packed into two bytes: the character itself, and the indices
+// of its foreground and background colors in a palette of up to kMaxColors
+// colors. Colors are added to the palette as they are first used. Once it is
+// full, other colors are replaced by the closest palette color.
+//
+// Every screen location has a DirtyMask with one bit per renderer target
+// (e.g. per framebuffer). All bits are set whenever the character shown at
+// that location changes, and each target clears its own bit once it has
+// redrawn the location. Every change also increments generation().
+//
+// TextBuffer does not own its storage; use TextBufferWithStorage.
 class TextBuffer {
  public:
+  static constexpr size_t kMaxColors = 16;
+  static constexpr size_t kMaxDirtyTargets = 8;
+
+  using DirtyMask = uint8_t;
+
   // An ASCII character with a foreground and background color.
   struct Char {
     // Set to a cleared default state.
@@ -41,39 +63,153 @@ class TextBuffer {
       background_color = kBlackColor;
     }
 
+    bool operator==(const Char& other) const {
+      return ch == other.ch && foreground_color == other.foreground_color &&
+             background_color == other.background_color;
+    }
+    bool operator!=(const Char& other) const { return !(*this == other); }
+
     char ch = '\0';
     pw::color::color_rgb565_t foreground_color = kWhiteColor;
     pw::color::color_rgb565_t background_color = kBlackColor;
   };
 
-  // A row of ASCII text characters.
-  struct TextRow {
-    void Clear() {
-      for (Char& ch : chars) {
-        ch.Reset();
-      }
+  // A character as stored in the buffer.
+  struct Cell {
+    bool operator==(const Cell& other) const {
+      return ch == other.ch && colors == other.colors;
     }
-    std::array<Char, kNumCharsWide> chars;
+    bool operator!=(const Cell& other) const { return !(*this == other); }
+
+    char ch;
+    // Palette index of the foreground color in the high nibble, and of the
+    // background color in the low nibble.
+    uint8_t colors;
   };
+  static_assert(sizeof(Cell) == 2);
 
   // Insert a character at the current cursor location. The cursor will be
   // moved right by one slot. Newline ('\n') characters will move the cursor to
   // the next line, at column 0.
   void DrawCharacter(const Char& ch);
 
-  // Return the size, in characters, of the text buffer.
+  // Return the size, in characters, of the visible text.
   pw::math::Size<int> GetSize() const {
-    return pw::math::Size<int>{kNumCharsWide, kNumRows};
+    return pw::math::Size<int>{columns_, rows_};
   }
 
-  // Return the character at the specified location.
+  // Return the character shown at the specified location.
   pw::Result<Char> GetChar(pw::math::Vector2<int> loc) const;
 
+  // Return the number of rows of scrollback history currently available.
+  int GetScrollbackRows() const { return num_scrollback_rows_; }
+
+  // Show the text |rows| rows above the bottom of the buffer. Zero shows the
+  // most recent text. Returns OUT_OF_RANGE if there are not that many rows of
+  // history.
+  pw::Status SetScrollbackOffset(int rows);
+  int scrollback_offset() const { return scrollback_offset_; }
+
+  // Return the dirty bits of the specified location.
+  DirtyMask GetDirtyMask(pw::math::Vector2<int> loc) const {
+    return dirty_masks_[loc.y * columns_ + loc.x];
+  }
+
+  // Return the union of the dirty bits of every location in |row|.
+  DirtyMask GetRowDirtyMask(int row) const { return row_dirty_masks_[row]; }
+
+  // Clear the |mask| dirty bits of every location in |row|.
+  void ClearDirty(int row, DirtyMask mask);
+
+  // Set the |mask| dirty bits of every location.
+  void MarkAllDirty(DirtyMask mask);
+
+  // Return a counter which is incremented whenever the buffer contents change.
+  uint32_t generation() const { return generation_; }
+
+  // Return the colors currently in the palette.
+  pw::span<const pw::color::color_rgb565_t> palette() const {
+    return pw::span(palette_.data(), palette_size_);
+  }
+
+ protected:
+  // |cells| must hold |columns| * (|rows| + number of scrollback rows) cells,
+  // |dirty_masks| must hold |columns| * |rows| masks, and |row_dirty_masks|
+  // must hold |rows| masks. The storage is not initialized until Clear() is
+  // called.
+  TextBuffer(pw::span<Cell> cells,
+             pw::span<DirtyMask> dirty_masks,
+             pw::span<DirtyMask> row_dirty_masks,
+             int columns,
+             int rows);
+
+  // Remove all text and history, and reset the palette.
+  void Clear();
+
  private:
+  // Return the cells of the row at ring index |ring_row|.
+  Cell* RingRow(int ring_row) { return &cells_[ring_row * columns_]; }
+  const Cell* RingRow(int ring_row) const {
+    return &cells_[ring_row * columns_];
+  }
+
+  // Return the ring index of |row| rows below the top of the visible text,
+  // ignoring the scrollback offset.
+  int TextRowIndex(int row) const { return (top_row_ + row) % num_ring_rows_; }
+
+  // Return the ring index of the row shown at |screen_row|.
+  int ScreenRowIndex(int screen_row) const {
+    return (top_row_ + num_ring_rows_ - scrollback_offset_ + screen_row) %
+           num_ring_rows_;
+  }
+
+  // Return the palette index of the closest color to |color|, adding it to
+  // the palette if there is space.
+  uint8_t GetColorIndex(pw::color::color_rgb565_t color);
+
+  Cell MakeCell(const Char& ch);
+
+  void MarkDirty(pw::math::Vector2<int> loc);
   void ScrollUp();
   void InsertNewline();
 
+  const pw::span<Cell> cells_;
+  const pw::span<DirtyMask> dirty_masks_;
+  const pw::span<DirtyMask> row_dirty_masks_;
+  const int columns_;
+  const int rows_;
+  const int num_ring_rows_;
+  // Ring index of the top row of visible text.
+  int top_row_ = 0;
+  int num_scrollback_rows_ = 0;
+  int scrollback_offset_ = 0;
   pw::math::Vector2<int> cursor_ = {0, 0};
   bool character_wrap_enabled_ = false;
-  std::array<TextRow, kNumRows> text_rows_;
+  std::array<pw::color::color_rgb565_t, kMaxColors> palette_;
+  size_t palette_size_ = 0;
+  uint32_t generation_ = 0;
+};
+
+// A TextBuffer showing kRows rows of kColumns characters, and keeping up to
+// kScrollbackRows rows of history.
+template <int kColumns, int kRows, int kScrollbackRows = 0>
+class TextBufferWithStorage : public TextBuffer {
+ public:
+  static_assert(kColumns > 0);
+  static_assert(kRows > 1, "Text buffer too small");
+  static_assert(kScrollbackRows >= 0);
+
+  TextBufferWithStorage()
+      : TextBuffer(cell_storage_,
+                   dirty_mask_storage_,
+                   row_dirty_mask_storage_,
+                   kColumns,
+                   kRows) {
+    Clear();
+  }
+
+ private:
+  std::array<Cell, kColumns * (kRows + kScrollbackRows)> cell_storage_;
+  std::array<DirtyMask, kColumns * kRows> dirty_mask_storage_;
+  std::array<DirtyMask, kRows> row_dirty_mask_storage_;
 };
@@ -0,0 +1,146 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "text_buffer_renderer.h"
+
+#include <string_view>
+
+#include "pw_draw/draw.h"
+
+using pw::framebuffer::Framebuffer;
+using pw::math::Rect;
+using pw::math::Size;
+using pw::math::Vector2;
+
+namespace {
+
+// The maximum number of characters passed to each DrawString call.
+constexpr size_t kMaxRunLength = 64;
+
+}  // namespace
+
+TextBufferRenderer::TextBufferRenderer(TextBuffer& text_buffer,
+                                       const pw::draw::FontSet& font,
+                                       Vector2<int> tl,
+                                       pw::draw::GlyphCache& glyph_cache)
+    : text_buffer_(text_buffer),
+      font_(font),
+      tl_(tl),
+      glyph_cache_(glyph_cache) {}
+
+TextBuffer::DirtyMask TextBufferRenderer::GetDirtyBit(
+    const Framebuffer& framebuffer) {
+  size_t idx = kMaxFramebuffers;
+  for (size_t i = 0; i < kMaxFramebuffers; i++) {
+    if (framebuffers_[i] == framebuffer.data())
+      return 1 << i;
+    if (!framebuffers_[i] && idx == kMaxFramebuffers)
+      idx = i;
+  }
+  if (idx == kMaxFramebuffers) {
+    idx = next_evicted_;
+    next_evicted_ = (next_evicted_ + 1) % kMaxFramebuffers;
+  }
+  framebuffers_[idx] = framebuffer.data();
+  const TextBuffer::DirtyMask dirty_bit = 1 << idx;
+  text_buffer_.MarkAllDirty(dirty_bit);
+  return dirty_bit;
+}
+
+void TextBufferRenderer::DrawRowSpan(int row,
+                                     int first,
+                                     int last,
+                                     Framebuffer& framebuffer) {
+  // Characters are gathered into runs which share the same colors, and each
+  // run is drawn with a single DrawString call.
+  std::array<wchar_t, kMaxRunLength> run;
+  size_t run_length = 0;
+  TextBuffer::Char run_colors;
+  Vector2<int> pos{tl_.x + first * font_.width, tl_.y + row * font_.height};
+  for (int col = first; col <= last + 1; col++) {
+    auto ch = text_buffer_.GetChar({col, row});
+    const bool end_of_span = col > last || !ch.ok();
+    if (run_length &&
+        (end_of_span || run_length == run.size() ||
+         ch->foreground_color != run_colors.foreground_color ||
+         ch->background_color != run_colors.background_color)) {
+      Size<int> run_size =
+          pw::draw::DrawString(std::wstring_view(run.data(), run_length),
+                               pos,
+                               run_colors.foreground_color,
+                               run_colors.background_color,
+                               font_,
+                               framebuffer,
+                               glyph_cache_);
+      pos.x += run_size.width;
+      run_length = 0;
+    }
+    if (end_of_span)
+      break;
+    if (!run_length)
+      run_colors = ch.value();
+    run[run_length++] = ch->ch;
+  }
+}
+
+size_t TextBufferRenderer::Draw(Framebuffer& framebuffer,
+                                const DirtyCallback& dirty_callback) {
+  const TextBuffer::DirtyMask dirty_bit = GetDirtyBit(framebuffer);
+  const Size<int> buffer_size = text_buffer_.GetSize();
+
+  size_t num_drawn = 0;
+  for (int row = 0; row < buffer_size.height; row++) {
+    if (!(text_buffer_.GetRowDirtyMask(row) & dirty_bit))
+      continue;
+    // Redraw one span from the first to the last changed character. The
+    // unchanged characters in between are cheap to draw with the glyph cache
+    // and keep the number of dirty rectangles down.
+    int first = 0;
+    while (!(text_buffer_.GetDirtyMask({first, row}) & dirty_bit))
+      first++;
+    int last = buffer_size.width - 1;
+    while (!(text_buffer_.GetDirtyMask({last, row}) & dirty_bit))
+      last--;
+    text_buffer_.ClearDirty(row, dirty_bit);
+
+    DrawRowSpan(row, first, last, framebuffer);
+    num_drawn += last - first + 1;
+
+    const int x = tl_.x + first * font_.width;
+    const int y = tl_.y + row * font_.height;
+    if (x >= 0 && y >= 0) {
+      dirty_callback(Rect<uint16_t>{static_cast<uint16_t>(x),
+                                    static_cast<uint16_t>(y),
+                                    static_cast<uint16_t>((last - first + 1) *
+                                                          font_.width),
+                                    font_.height});
+    }
+  }
+  return num_drawn;
+}
+
+size_t TextBufferRenderer::DrawAll(Framebuffer& framebuffer) {
+  const Size<int> buffer_size = text_buffer_.GetSize();
+  const Rect<uint16_t> bounds = framebuffer.bounds();
+
+  size_t num_drawn = 0;
+  for (int row = 0; row < buffer_size.height; row++) {
+    const int y = tl_.y + row * font_.height;
+    if (y + font_.height <= bounds.y || y >= bounds.y + bounds.height)
+      continue;
+    DrawRowSpan(row, 0, buffer_size.width - 1, framebuffer);
+    num_drawn += buffer_size.width;
+  }
+  return num_drawn;
+}
@@ -0,0 +1,82 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_draw/font_set.h"
+#include "pw_draw/glyph_cache.h"
+#include "pw_framebuffer/framebuffer.h"
+#include "pw_function/function.h"
+#include "pw_math/rect.h"
+#include "pw_math/vector2.h"
+#include "text_buffer.h"
+
+// Draws a TextBuffer into framebuffers, redrawing only the characters which
+// have changed since each framebuffer was last drawn.
+//
+// Framebuffers are recognized by their pixel data address. A framebuffer
+// which has not been seen before (or not since it was evicted by others) is
+// drawn in full. Up to kMaxFramebuffers distinct framebuffers are tracked,
+// which covers double and triple buffered displays. Each tracked framebuffer
+// uses one of the text buffer's dirty bits, so only one renderer may draw a
+// given text buffer.
+class TextBufferRenderer {
+ public:
+  static constexpr size_t kMaxFramebuffers = 3;
+  static_assert(kMaxFramebuffers <= TextBuffer::kMaxDirtyTargets);
+
+  using DirtyCallback = pw::Function<void(const pw::math::Rect<uint16_t>&)>;
+
+  // Draw |text_buffer| with its top-left character at |tl|.
+  TextBufferRenderer(TextBuffer& text_buffer,
+                     const pw::draw::FontSet& font,
+                     pw::math::Vector2<int> tl,
+                     pw::draw::GlyphCache& glyph_cache);
+
+  // Redraw the characters of the text buffer which differ from what was last
+  // drawn into |framebuffer|. |dirty_callback| is called with the rectangle of
+  // every redrawn row span. Returns the number of characters drawn.
+  size_t Draw(pw::framebuffer::Framebuffer& framebuffer,
+              const DirtyCallback& dirty_callback);
+
+  // Draw every character within |framebuffer|, whether or not it has changed,
+  // without affecting what Draw() redraws. This is for framebuffers whose
+  // contents are not kept between frames, such as the bands of a display
+  // drawn with Display::DrawBands(). Returns the number of characters drawn.
+  size_t DrawAll(pw::framebuffer::Framebuffer& framebuffer);
+
+ private:
+  // Return the text buffer dirty bit of |framebuffer|, starting to track it
+  // (and marking the whole text buffer dirty for it) if it is not already
+  // tracked.
+  TextBuffer::DirtyMask GetDirtyBit(
+      const pw::framebuffer::Framebuffer& framebuffer);
+
+  // Draw columns |first| through |last| (inclusive) of |row|.
+  void DrawRowSpan(int row,
+                   int first,
+                   int last,
+                   pw::framebuffer::Framebuffer& framebuffer);
+
+  TextBuffer& text_buffer_;
+  const pw::draw::FontSet& font_;
+  const pw::math::Vector2<int> tl_;
+  pw::draw::GlyphCache& glyph_cache_;
+  // The tracked framebuffers, indexed by their dirty bit number.
+  std::array<const void*, kMaxFramebuffers> framebuffers_ = {};
+  size_t next_evicted_ = 0;
+};
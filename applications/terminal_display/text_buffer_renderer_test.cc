@@ -0,0 +1,173 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "text_buffer_renderer.h"
+
+#include <algorithm>
+#include <array>
+
+#include "gtest/gtest.h"
+#include "pw_color/color.h"
+#include "pw_color/colors_pico8.h"
+#include "pw_containers/vector.h"
+#include "pw_draw/font_set.h"
+#include "pw_draw/glyph_cache.h"
+#include "pw_framebuffer/framebuffer.h"
+#include "pw_framebuffer/writer.h"
+#include "text_buffer.h"
+
+using pw::color::color_rgb565_t;
+using pw::framebuffer::Framebuffer;
+using pw::framebuffer::FramebufferWriter;
+using pw::framebuffer::PixelFormat;
+using pw::math::Rect;
+
+namespace {
+
+constexpr color_rgb565_t kIndigo = pw::color::colors_pico8_rgb565[13];
+constexpr color_rgb565_t kDarkGreen = pw::color::colors_pico8_rgb565[3];
+constexpr size_t kNumCharsWide = 52;
+constexpr size_t kNumRows = 9;
+constexpr uint16_t kWidth = kNumCharsWide * 6;
+constexpr uint16_t kHeight = kNumRows * 8;
+constexpr size_t kNumPixels = kWidth * kHeight;
+
+class TextBufferRendererTest : public ::testing::Test {
+ protected:
+  TextBufferRendererTest()
+      : renderer_(text_buffer_, pw::draw::font6x8, {0, 0}, glyph_cache_) {}
+
+  Framebuffer MakeFramebuffer(std::array<color_rgb565_t, kNumPixels>& data) {
+    Framebuffer fb(data.data(),
+                   PixelFormat::RGB565,
+                   {kWidth, kHeight},
+                   kWidth * sizeof(color_rgb565_t));
+    FramebufferWriter(fb).Fill(0xffff);
+    return fb;
+  }
+
+  size_t Draw(Framebuffer& fb) {
+    dirty_rects_.clear();
+    return renderer_.Draw(fb, [this](const Rect<uint16_t>& rect) {
+      dirty_rects_.push_back(rect);
+    });
+  }
+
+  void Write(const char* str) {
+    for (; *str; str++) {
+      text_buffer_.DrawCharacter({*str, kIndigo, kDarkGreen});
+    }
+  }
+
+  TextBufferWithStorage<kNumCharsWide, kNumRows> text_buffer_;
+  pw::draw::GlyphCache glyph_cache_;
+  TextBufferRenderer renderer_;
+  pw::Vector<Rect<uint16_t>, kNumRows> dirty_rects_;
+  std::array<color_rgb565_t, kNumPixels> data_a_;
+  std::array<color_rgb565_t, kNumPixels> data_b_;
+  std::array<color_rgb565_t, kNumPixels> expected_data_;
+};
+
+TEST_F(TextBufferRendererTest, FirstDrawIsComplete) {
+  Framebuffer fb = MakeFramebuffer(data_a_);
+  EXPECT_EQ(Draw(fb), kNumCharsWide * kNumRows);
+  ASSERT_EQ(dirty_rects_.size(), kNumRows);
+  EXPECT_EQ(dirty_rects_[1], (Rect<uint16_t>{0, 8, kWidth, 8}));
+  for (color_rgb565_t pixel : data_a_) {
+    EXPECT_EQ(pixel, kBlackColor);
+  }
+
+  EXPECT_EQ(Draw(fb), 0u);
+  EXPECT_TRUE(dirty_rects_.empty());
+}
+
+TEST_F(TextBufferRendererTest, RedrawsChangedCharacters) {
+  Framebuffer fb = MakeFramebuffer(data_a_);
+  Draw(fb);
+
+  Write("\nab");
+  EXPECT_EQ(Draw(fb), 2u);
+  ASSERT_EQ(dirty_rects_.size(), 1u);
+  EXPECT_EQ(dirty_rects_[0], (Rect<uint16_t>{0, 8, 12, 8}));
+  EXPECT_EQ(data_a_[8 * kWidth], kDarkGreen);
+}
+
+TEST_F(TextBufferRendererTest, TracksEachFramebuffer) {
+  Framebuffer fb_a = MakeFramebuffer(data_a_);
+  Framebuffer fb_b = MakeFramebuffer(data_b_);
+  Draw(fb_a);
+  Draw(fb_b);
+
+  Write("a");
+  EXPECT_EQ(Draw(fb_a), 1u);
+  Write("b");
+  // fb_b missed both characters, fb_a only the second one.
+  EXPECT_EQ(Draw(fb_b), 2u);
+  EXPECT_EQ(Draw(fb_a), 1u);
+  EXPECT_EQ(Draw(fb_b), 0u);
+  EXPECT_EQ(data_a_, data_b_);
+}
+
+TEST_F(TextBufferRendererTest, MatchesCompleteRedraw) {
+  Framebuffer fb_a = MakeFramebuffer(data_a_);
+  Framebuffer fb_b = MakeFramebuffer(data_b_);
+  Draw(fb_a);
+  Draw(fb_b);
+  for (int i = 0; i < 12; i++) {
+    Write("Line\n");
+    Write(i % 2 ? "odd" : "even line");
+    Draw(i % 2 ? fb_a : fb_b);
+  }
+  Draw(fb_a);
+  Draw(fb_b);
+
+  // A new framebuffer is drawn completely.
+  Framebuffer expected = MakeFramebuffer(expected_data_);
+  renderer_.Draw(expected, [](const Rect<uint16_t>&) {});
+  EXPECT_EQ(data_a_, expected_data_);
+  EXPECT_EQ(data_b_, expected_data_);
+}
+
+TEST_F(TextBufferRendererTest, DrawAllBands) {
+  Write("ab\ncd\nef");
+  Framebuffer expected = MakeFramebuffer(expected_data_);
+  Draw(expected);
+
+  // Draw 5 row bands, which split the character rows.
+  constexpr uint16_t kBandHeight = 5;
+  std::array<color_rgb565_t, kWidth * kBandHeight> band_data;
+  for (uint16_t band_y = 0; band_y < kHeight; band_y += kBandHeight) {
+    Framebuffer band(band_data.data(),
+                     PixelFormat::RGB565,
+                     {kWidth, kBandHeight},
+                     kWidth * sizeof(color_rgb565_t));
+    band.set_origin({0, band_y});
+    FramebufferWriter(band).Fill(0xffff);
+    // Only the character rows which overlap the band are drawn.
+    const int first_row = band_y / 8;
+    const int last_row =
+        std::min<int>((band_y + kBandHeight - 1) / 8, kNumRows - 1);
+    EXPECT_EQ(renderer_.DrawAll(band),
+              (last_row - first_row + 1) * kNumCharsWide);
+    const int num_pixel_rows = std::min<int>(kBandHeight, kHeight - band_y);
+    for (int i = 0; i < num_pixel_rows * kWidth; i++) {
+      ASSERT_EQ(band_data[i], expected_data_[band_y * kWidth + i]);
+    }
+  }
+
+  // DrawAll() does not affect what Draw() redraws.
+  EXPECT_EQ(Draw(expected), 0u);
+}
+
+}  // namespace
@@ -22,16 +22,41 @@ using pw::color::color_rgb565_t;
 namespace {
 constexpr color_rgb565_t kIndigo = pw::color::colors_pico8_rgb565[13];
 constexpr color_rgb565_t kDarkGreen = pw::color::colors_pico8_rgb565[3];
+constexpr size_t kNumCharsWide = 52;
+constexpr size_t kNumRows = 9;
+constexpr int kNumScrollbackRows = 4;
+constexpr TextBuffer::DirtyMask kAllTargets = 0xff;
+
+using TestTextBuffer = TextBufferWithStorage<kNumCharsWide, kNumRows>;
+using ScrollbackTextBuffer =
+    TextBufferWithStorage<kNumCharsWide, kNumRows, kNumScrollbackRows>;
+
+// Write |str| followed by a newline.
+void WriteLine(TextBuffer& buffer, const char* str) {
+  for (; *str; str++) {
+    buffer.DrawCharacter({*str, kIndigo, kDarkGreen});
+  }
+  buffer.DrawCharacter({'\n', kIndigo, kDarkGreen});
+}
+
+size_t CountDirty(const TextBuffer& buffer, int row) {
+  size_t count = 0;
+  for (int c = 0; c < buffer.GetSize().width; c++) {
+    if (buffer.GetDirtyMask({c, row}))
+      count++;
+  }
+  return count;
+}
 }  // namespace
 
 TEST(TextBufferTest, DimsAsExpected) {
-  TextBuffer buffer;
+  TestTextBuffer buffer;
   ASSERT_EQ(kNumCharsWide, static_cast<size_t>(buffer.GetSize().width));
   ASSERT_EQ(kNumRows, static_cast<size_t>(buffer.GetSize().height));
 }
 
 TEST(TextBufferTest, ClearedOnConstruction) {
-  TextBuffer buffer;
+  TestTextBuffer buffer;
 
   const auto buffer_size = buffer.GetSize();
   for (int r = 0; r < buffer_size.height; r++) {
@@ -46,7 +71,7 @@ TEST(TextBufferTest, ClearedOnConstruction) {
 }
 
 TEST(TextBufferTest, OutOfBoundsColumnNotOk) {
-  TextBuffer buffer;
+  TestTextBuffer buffer;
   auto ch = buffer.GetChar({buffer.GetSize().width, 0});
   EXPECT_FALSE(ch.ok());
 
@@ -55,7 +80,7 @@ TEST(TextBufferTest, OutOfBoundsColumnNotOk) {
 }
 
 TEST(TextBufferTest, OutOfBoundsRowNotOk) {
-  TextBuffer buffer;
+  TestTextBuffer buffer;
   auto ch = buffer.GetChar({0, buffer.GetSize().height});
   EXPECT_FALSE(ch.ok());
 
@@ -64,7 +89,7 @@ TEST(TextBufferTest, OutOfBoundsRowNotOk) {
 }
 
 TEST(TextBufferTest, SimpleInsert) {
-  TextBuffer buffer;
+  TestTextBuffer buffer;
 
   buffer.DrawCharacter({'A', kIndigo, kDarkGreen});
   auto ch = buffer.GetChar({0, 0});
@@ -88,7 +113,7 @@ TEST(TextBufferTest, SimpleInsert) {
 }
 
 TEST(TextBufferTest, NewLineInsertsToNextRow) {
-  TextBuffer buffer;
+  TestTextBuffer buffer;
   buffer.DrawCharacter({'A', kIndigo, kDarkGreen});
   buffer.DrawCharacter({'\n', kIndigo, kDarkGreen});
   buffer.DrawCharacter({'B', kIndigo, kDarkGreen});
@@ -109,7 +134,7 @@ TEST(TextBufferTest, NewLineInsertsToNextRow) {
 
 TEST(TextBufferTest, Scroll) {
   // Insert enough newlines to scroll buffer.
-  TextBuffer buffer;
+  TestTextBuffer buffer;
   char next_char = 'A';
   for (size_t i = 0; i < kNumRows; i++) {
     buffer.DrawCharacter({next_char, kIndigo, kDarkGreen});
@@ -124,3 +149,115 @@ TEST(TextBufferTest, Scroll) {
   EXPECT_EQ(kIndigo, ch->foreground_color);
   EXPECT_EQ(kDarkGreen, ch->background_color);
 }
+
+TEST(TextBufferTest, ChangesSetDirtyBits) {
+  TestTextBuffer buffer;
+  EXPECT_EQ(0, buffer.GetRowDirtyMask(0));
+  const uint32_t generation = buffer.generation();
+
+  buffer.DrawCharacter({'A', kIndigo, kDarkGreen});
+  EXPECT_NE(generation, buffer.generation());
+  EXPECT_EQ(kAllTargets, buffer.GetDirtyMask({0, 0}));
+  EXPECT_EQ(kAllTargets, buffer.GetRowDirtyMask(0));
+  EXPECT_EQ(1u, CountDirty(buffer, 0));
+
+  // Each target's bit is cleared independently.
+  buffer.ClearDirty(0, 0x01);
+  EXPECT_EQ(0xfe, buffer.GetDirtyMask({0, 0}));
+  EXPECT_EQ(0xfe, buffer.GetRowDirtyMask(0));
+  buffer.ClearDirty(0, 0xfe);
+  EXPECT_EQ(0, buffer.GetDirtyMask({0, 0}));
+  EXPECT_EQ(0, buffer.GetRowDirtyMask(0));
+
+  buffer.MarkAllDirty(0x02);
+  EXPECT_EQ(0x02, buffer.GetDirtyMask({5, kNumRows - 1}));
+}
+
+TEST(TextBufferTest, UnchangedCharacterNotDirty) {
+  TestTextBuffer buffer;
+  // Writing the default character over itself changes nothing.
+  buffer.DrawCharacter({'\0', kWhiteColor, kBlackColor});
+  EXPECT_EQ(0, buffer.GetRowDirtyMask(0));
+  EXPECT_EQ(0u, buffer.generation());
+}
+
+TEST(TextBufferTest, ScrollDirtiesOnlyChangedCharacters) {
+  TestTextBuffer buffer;
+  for (size_t i = 0; i < kNumRows - 1; i++) {
+    buffer.DrawCharacter({'\n', kIndigo, kDarkGreen});
+  }
+  buffer.DrawCharacter({'A', kIndigo, kDarkGreen});
+  buffer.DrawCharacter({'B', kIndigo, kDarkGreen});
+  buffer.ClearDirty(kNumRows - 1, kAllTargets);
+
+  // Scroll "AB" up from the last row to the one above it.
+  buffer.DrawCharacter({'\n', kIndigo, kDarkGreen});
+  EXPECT_EQ('A', buffer.GetChar({0, kNumRows - 2})->ch);
+  EXPECT_EQ('\0', buffer.GetChar({0, kNumRows - 1})->ch);
+  for (size_t r = 0; r < kNumRows - 2; r++) {
+    EXPECT_EQ(0, buffer.GetRowDirtyMask(r));
+  }
+  EXPECT_EQ(2u, CountDirty(buffer, kNumRows - 2));
+  EXPECT_EQ(2u, CountDirty(buffer, kNumRows - 1));
+}
+
+TEST(TextBufferTest, CellsArePacked) {
+  EXPECT_EQ(2u, sizeof(TextBuffer::Cell));
+  // Each visible character costs two bytes of cell storage and one byte of
+  // dirty bits, and each scrollback character only its cell.
+  using TallerTextBuffer = TextBufferWithStorage<kNumCharsWide, kNumRows + 1>;
+  EXPECT_LE(sizeof(TallerTextBuffer) - sizeof(TestTextBuffer),
+            kNumCharsWide * 3 + sizeof(void*));
+  EXPECT_LE(sizeof(ScrollbackTextBuffer) - sizeof(TestTextBuffer),
+            kNumScrollbackRows * kNumCharsWide * 2 + sizeof(void*));
+}
+
+TEST(TextBufferTest, PaletteFallsBackToClosestColor) {
+  TestTextBuffer buffer;
+  // The default white and black use two palette entries.
+  for (size_t i = 0; i < TextBuffer::kMaxColors - 2; i++) {
+    buffer.DrawCharacter({'x', static_cast<color_rgb565_t>(i + 1), 0});
+  }
+  EXPECT_EQ(TextBuffer::kMaxColors, buffer.palette().size());
+  for (size_t i = 0; i < TextBuffer::kMaxColors - 2; i++) {
+    const auto ch = buffer.GetChar({static_cast<int>(i), 0});
+    EXPECT_EQ(i + 1, ch->foreground_color);
+  }
+
+  // A new color is replaced by the closest color in the palette.
+  buffer.DrawCharacter({'x', 0xfffe, 0});
+  EXPECT_EQ(TextBuffer::kMaxColors, buffer.palette().size());
+  EXPECT_EQ(kWhiteColor,
+            buffer.GetChar({TextBuffer::kMaxColors - 2, 0})->foreground_color);
+}
+
+TEST(TextBufferTest, Scrollback) {
+  ScrollbackTextBuffer buffer;
+  EXPECT_EQ(0, buffer.GetScrollbackRows());
+  EXPECT_EQ(pw::Status::OutOfRange(), buffer.SetScrollbackOffset(1));
+
+  // Write enough lines to fill the screen and the scrollback history, plus
+  // one more line which is lost.
+  char next_char = 'A';
+  for (size_t i = 0; i < kNumRows + kNumScrollbackRows; i++) {
+    const char line[] = {next_char++, '\0'};
+    WriteLine(buffer, line);
+  }
+  EXPECT_EQ(kNumScrollbackRows, buffer.GetScrollbackRows());
+  // 'A' was lost, 'B' is the oldest history row.
+  EXPECT_EQ('F', buffer.GetChar({0, 0})->ch);
+  EXPECT_EQ('\0', buffer.GetChar({0, kNumRows - 1})->ch);
+
+  for (int r = 0; r < static_cast<int>(kNumRows); r++) {
+    buffer.ClearDirty(r, kAllTargets);
+  }
+  ASSERT_EQ(pw::OkStatus(), buffer.SetScrollbackOffset(kNumScrollbackRows));
+  EXPECT_EQ(kAllTargets, buffer.GetRowDirtyMask(0));
+  EXPECT_EQ('B', buffer.GetChar({0, 0})->ch);
+  EXPECT_EQ('J', buffer.GetChar({0, kNumRows - 1})->ch);
+
+  // Text written while scrolled back is only visible once scrolled into view.
+  buffer.DrawCharacter({'Z', kIndigo, kDarkGreen});
+  ASSERT_EQ(pw::OkStatus(), buffer.SetScrollbackOffset(0));
+  EXPECT_EQ('Z', buffer.GetChar({0, kNumRows - 1})->ch);
+}
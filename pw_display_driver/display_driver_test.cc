@@ -0,0 +1,561 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#include "pw_display_driver/display_driver.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "pw_containers/vector.h"
+#include "pw_display_driver/fake_spi_bus.h"
+#include "pw_display_driver_ili9341/display_driver.h"
+#include "pw_display_driver_st7735/display_driver.h"
+#include "pw_display_driver_st7789/display_driver.h"
+#include "pw_framebuffer/framebuffer.h"
+#include "pw_math/rect.h"
+
+using pw::framebuffer::Framebuffer;
+using pw::framebuffer::PixelFormat;
+using Rect = pw::math::Rect<uint16_t>;
+
+namespace pw::display_driver {
+
+namespace {
+
+// MIPI DCS commands shared by all of the SPI display controllers.
+constexpr uint8_t kSoftwareReset = 0x01;
+constexpr uint8_t kColumnAddressSet = 0x2A;
+constexpr uint8_t kRowAddressSet = 0x2B;
+constexpr uint8_t kMemoryWrite = 0x2C;
+
+constexpr uint16_t kWidth = 320;
+constexpr uint16_t kHeight = 240;
+
+uint16_t s_pixel_data[kWidth * kHeight];
+
+Framebuffer MakeFramebuffer(uint16_t width, uint16_t height) {
+  for (size_t i = 0; i < width * height; i++) {
+    s_pixel_data[i] = static_cast<uint16_t>(i);
+  }
+  return Framebuffer(s_pixel_data,
+                     PixelFormat::RGB565,
+                     {width, height},
+                     width * sizeof(uint16_t));
+}
+
+// Write |region| of |framebuffer| and verify that the driver reported success
+// and returned the framebuffer.
+void WriteRegion(DisplayDriver& driver,
+                 Framebuffer& framebuffer,
+                 const Rect& region) {
+  bool called = false;
+  driver.WriteRegion(std::move(framebuffer),
+                     region,
+                     [&](Framebuffer fb, Status status) {
+                       EXPECT_EQ(OkStatus(), status);
+                       framebuffer = std::move(fb);
+                       called = true;
+                     });
+  EXPECT_TRUE(called);
+  EXPECT_TRUE(framebuffer.is_valid());
+}
+
+void WriteFramebuffer(DisplayDriver& driver, Framebuffer& framebuffer) {
+  bool called = false;
+  driver.WriteFramebuffer(std::move(framebuffer),
+                          [&](Framebuffer fb, Status status) {
+                            EXPECT_EQ(OkStatus(), status);
+                            framebuffer = std::move(fb);
+                            called = true;
+                          });
+  EXPECT_TRUE(called);
+  EXPECT_TRUE(framebuffer.is_valid());
+}
+
+void ExpectCommand(const FakeSpiBus::Write& write, uint8_t command) {
+  EXPECT_TRUE(write.is_command);
+  EXPECT_EQ(8, write.bits_per_word);
+  EXPECT_EQ(1u, write.size);
+  EXPECT_EQ(std::byte{command}, write.data[0]);
+}
+
+// Verify an address set command (CASET or RASET) for |min| to |max|.
+void ExpectAddressSet(const FakeSpiBus::Write& command_write,
+                      const FakeSpiBus::Write& data_write,
+                      uint8_t command,
+                      uint16_t min,
+                      uint16_t max) {
+  ExpectCommand(command_write, command);
+  EXPECT_FALSE(data_write.is_command);
+  EXPECT_EQ(8, data_write.bits_per_word);
+  ASSERT_EQ(4u, data_write.size);
+  EXPECT_EQ(std::byte(min >> 8), data_write.data[0]);
+  EXPECT_EQ(std::byte(min & 0xff), data_write.data[1]);
+  EXPECT_EQ(std::byte(max >> 8), data_write.data[2]);
+  EXPECT_EQ(std::byte(max & 0xff), data_write.data[3]);
+}
+
+// Verify that the first five writes set the address window to the inclusive
+// range |col_min|..|col_max|, |row_min|..|row_max| and start a memory write.
+void ExpectAddressWindow(const FakeSpiBus& bus,
+                         uint16_t col_min,
+                         uint16_t col_max,
+                         uint16_t row_min,
+                         uint16_t row_max) {
+  const auto& writes = bus.writes();
+  ASSERT_GE(writes.size(), 5u);
+  ExpectAddressSet(writes[0], writes[1], kColumnAddressSet, col_min, col_max);
+  ExpectAddressSet(writes[2], writes[3], kRowAddressSet, row_min, row_max);
+  ExpectCommand(writes[4], kMemoryWrite);
+}
+
+// Verify a write of |num_pixels| pixels starting with framebuffer pixel
+// (x, y).
+void ExpectPixels(const FakeSpiBus::Write& write,
+                  size_t num_pixels,
+                  uint16_t x,
+                  uint16_t y,
+                  uint16_t fb_width) {
+  EXPECT_FALSE(write.is_command);
+  EXPECT_EQ(16, write.bits_per_word);
+  EXPECT_EQ(num_pixels, write.size);
+  uint16_t first_pixel;
+  std::memcpy(&first_pixel, write.data.data(), sizeof(first_pixel));
+  EXPECT_EQ(static_cast<uint16_t>(y * fb_width + x), first_pixel);
+}
+
+TEST(DisplayDriverST7789, WriteRegion) {
+  FakeSpiBus bus;
+  DisplayDriverST7789 driver({
+      .data_cmd_gpio = bus.data_cmd_gpio(),
+      .spi_cs_gpio = bus.chip_select_gpio(),
+      .reset_gpio = nullptr,
+      .tear_effect_gpio = nullptr,
+      .spi_device_8_bit = bus.device_8_bit(),
+      .spi_device_16_bit = bus.device_16_bit(),
+  });
+  EXPECT_TRUE(driver.SupportsRegionWrite());
+  Framebuffer fb = MakeFramebuffer(kWidth, kHeight);
+
+  WriteRegion(driver, fb, {10, 20, 4, 3});
+  ExpectAddressWindow(bus, 10, 13, 20, 22);
+  const auto& writes = bus.writes();
+  ASSERT_EQ(8u, writes.size());
+  ExpectPixels(writes[5], 4, 10, 20, kWidth);
+  ExpectPixels(writes[6], 4, 10, 21, kWidth);
+  ExpectPixels(writes[7], 4, 10, 22, kWidth);
+
+  // Full width rows are contiguous and are sent in a single write.
+  bus.Clear();
+  WriteRegion(driver, fb, {0, 100, kWidth, 2});
+  ExpectAddressWindow(bus, 0, kWidth - 1, 100, 101);
+  ASSERT_EQ(6u, writes.size());
+  ExpectPixels(writes[5], 2 * kWidth, 0, 100, kWidth);
+}
+
+TEST(DisplayDriverST7789, WriteRegionBand) {
+  FakeSpiBus bus;
+  DisplayDriverST7789 driver({
+      .data_cmd_gpio = bus.data_cmd_gpio(),
+      .spi_cs_gpio = bus.chip_select_gpio(),
+      .reset_gpio = nullptr,
+      .tear_effect_gpio = nullptr,
+      .spi_device_8_bit = bus.device_8_bit(),
+      .spi_device_16_bit = bus.device_16_bit(),
+  });
+  // A 20 row band of the display, starting at row 100.
+  Framebuffer fb = MakeFramebuffer(kWidth, 20);
+  fb.set_origin({0, 100});
+  const auto& writes = bus.writes();
+
+  WriteRegion(driver, fb, {0, 100, kWidth, 20});
+  ExpectAddressWindow(bus, 0, kWidth - 1, 100, 119);
+  ASSERT_EQ(6u, writes.size());
+  ExpectPixels(writes[5], 20 * kWidth, 0, 0, kWidth);
+
+  // Regions are clipped to the band.
+  bus.Clear();
+  WriteRegion(driver, fb, {5, 90, 4, 12});
+  ExpectAddressWindow(bus, 5, 8, 100, 101);
+  ASSERT_EQ(7u, writes.size());
+  ExpectPixels(writes[5], 4, 5, 0, kWidth);
+  ExpectPixels(writes[6], 4, 5, 1, kWidth);
+}
+
+TEST(DisplayDriverST7789, WriteFramebufferRestoresWindow) {
+  FakeSpiBus bus;
+  DisplayDriverST7789 driver({
+      .data_cmd_gpio = bus.data_cmd_gpio(),
+      .spi_cs_gpio = bus.chip_select_gpio(),
+      .reset_gpio = nullptr,
+      .tear_effect_gpio = nullptr,
+      .spi_device_8_bit = bus.device_8_bit(),
+      .spi_device_16_bit = bus.device_16_bit(),
+  });
+  Framebuffer fb = MakeFramebuffer(kWidth, kHeight);
+  const auto& writes = bus.writes();
+
+  WriteRegion(driver, fb, {1, 1, 1, 1});
+  bus.Clear();
+  WriteFramebuffer(driver, fb);
+  ExpectAddressWindow(bus, 0, kWidth - 1, 0, kHeight - 1);
+  ASSERT_EQ(6u, writes.size());
+  ExpectPixels(writes[5], kWidth * kHeight, 0, 0, kWidth);
+
+  // The window is already full screen, so only a memory write is needed.
+  bus.Clear();
+  WriteFramebuffer(driver, fb);
+  ASSERT_EQ(2u, writes.size());
+  ExpectCommand(writes[0], kMemoryWrite);
+  ExpectPixels(writes[1], kWidth * kHeight, 0, 0, kWidth);
+}
+
+TEST(DisplayDriverST7789, WriteRegionClipped) {
+  FakeSpiBus bus;
+  DisplayDriverST7789 driver({
+      .data_cmd_gpio = bus.data_cmd_gpio(),
+      .spi_cs_gpio = bus.chip_select_gpio(),
+      .reset_gpio = nullptr,
+      .tear_effect_gpio = nullptr,
+      .spi_device_8_bit = bus.device_8_bit(),
+      .spi_device_16_bit = bus.device_16_bit(),
+  });
+  Framebuffer fb = MakeFramebuffer(kWidth, kHeight);
+
+  WriteRegion(driver, fb, {kWidth, 0, 10, 10});
+  EXPECT_TRUE(bus.writes().empty());
+
+  WriteRegion(driver, fb, {kWidth - 2, kHeight - 1, 10, 10});
+  ExpectAddressWindow(bus, kWidth - 2, kWidth - 1, kHeight - 1, kHeight - 1);
+  ASSERT_EQ(6u, bus.writes().size());
+  ExpectPixels(bus.writes()[5], 2, kWidth - 2, kHeight - 1, kWidth);
+}
+
+// The CASET and RASET parameters, which are the only data bytes sent before
+// the pixels of a WriteRect().
+constexpr size_t kAddressWindowDataBytes = 8;
+
+TEST(DisplayDriverST7789, WriteRect) {
+  FakeSpiBus bus;
+  DisplayDriverST7789 driver({
+      .data_cmd_gpio = bus.data_cmd_gpio(),
+      .spi_cs_gpio = bus.chip_select_gpio(),
+      .reset_gpio = nullptr,
+      .tear_effect_gpio = nullptr,
+      .spi_device_8_bit = bus.device_8_bit(),
+      .spi_device_16_bit = bus.device_16_bit(),
+  });
+  MakeFramebuffer(kWidth, kHeight);
+  const auto& writes = bus.writes();
+
+  // A 10x4 rect within rows 16 pixels apart sets the address window once and
+  // then sends each row.
+  EXPECT_EQ(
+      OkStatus(),
+      driver.WriteRect(span(s_pixel_data, 3 * 16 + 10), {7, 9, 10, 4}, 16));
+  ExpectAddressWindow(bus, 7, 16, 9, 12);
+  ASSERT_EQ(9u, writes.size());
+  for (int row = 0; row < 4; row++) {
+    ExpectPixels(writes[5 + row], 10, 0, row, 16);
+  }
+  EXPECT_EQ(3u, bus.num_commands());
+  EXPECT_EQ(kAddressWindowDataBytes + 10 * 4 * 2, bus.num_data_bytes());
+
+  // Contiguous rows are sent in a single write.
+  bus.Clear();
+  EXPECT_EQ(OkStatus(),
+            driver.WriteRect(span(s_pixel_data, 10 * 4), {7, 9, 10, 4}, 10));
+  ExpectAddressWindow(bus, 7, 16, 9, 12);
+  ASSERT_EQ(6u, writes.size());
+  ExpectPixels(writes[5], 10 * 4, 0, 0, 10);
+
+  // Rects are clipped to the display.
+  bus.Clear();
+  EXPECT_EQ(OkStatus(),
+            driver.WriteRect(
+                span(s_pixel_data, 9 * 16 + 8), {kWidth - 4, 2, 8, 10}, 16));
+  ExpectAddressWindow(bus, kWidth - 4, kWidth - 1, 2, 11);
+  ASSERT_EQ(15u, writes.size());
+  ExpectPixels(writes[5], 4, 0, 0, 16);
+  ExpectPixels(writes[14], 4, 0, 9, 16);
+}
+
+TEST(DisplayDriverST7789, WriteRectCommands) {
+  FakeSpiBus bus;
+  DisplayDriverST7789 driver({
+      .data_cmd_gpio = bus.data_cmd_gpio(),
+      .spi_cs_gpio = bus.chip_select_gpio(),
+      .reset_gpio = nullptr,
+      .tear_effect_gpio = nullptr,
+      .spi_device_8_bit = bus.device_8_bit(),
+      .spi_device_16_bit = bus.device_16_bit(),
+  });
+  constexpr Rect kRect{20, 0, 100, kHeight};
+
+  // Sending a rect a row at a time sets the address window for each row.
+  for (uint16_t row = 0; row < kRect.height; row++) {
+    EXPECT_EQ(OkStatus(),
+              driver.WriteRow(span(&s_pixel_data[row * kWidth], kRect.width),
+                              row,
+                              kRect.x));
+  }
+  EXPECT_EQ(3u * kRect.height, bus.num_commands());
+  EXPECT_EQ((kAddressWindowDataBytes + kRect.width * 2) * kRect.height,
+            bus.num_data_bytes());
+
+  // WriteRect() only sets it once.
+  bus.Clear();
+  EXPECT_EQ(OkStatus(), driver.WriteRect(s_pixel_data, kRect, kWidth));
+  EXPECT_EQ(3u, bus.num_commands());
+  EXPECT_EQ(kAddressWindowDataBytes + kRect.width * kRect.height * 2,
+            bus.num_data_bytes());
+}
+
+TEST(DisplayDriverST7789, WriteRowWindow) {
+  FakeSpiBus bus;
+  DisplayDriverST7789 driver({
+      .data_cmd_gpio = bus.data_cmd_gpio(),
+      .spi_cs_gpio = bus.chip_select_gpio(),
+      .reset_gpio = nullptr,
+      .tear_effect_gpio = nullptr,
+      .spi_device_8_bit = bus.device_8_bit(),
+      .spi_device_16_bit = bus.device_16_bit(),
+  });
+  MakeFramebuffer(kWidth, kHeight);
+
+  // The address window only covers the row's pixels.
+  EXPECT_EQ(OkStatus(), driver.WriteRow(span(s_pixel_data, 5), 9, 7));
+  ExpectAddressWindow(bus, 7, 11, 9, 9);
+  ASSERT_EQ(6u, bus.writes().size());
+  ExpectPixels(bus.writes()[5], 5, 0, 0, kWidth);
+}
+
+TEST(DisplayDriverST7789, StartInit) {
+  FakeSpiBus bus;
+  DisplayDriverST7789 driver({
+      .data_cmd_gpio = bus.data_cmd_gpio(),
+      .spi_cs_gpio = bus.chip_select_gpio(),
+      .reset_gpio = nullptr,
+      .tear_effect_gpio = nullptr,
+      .spi_device_8_bit = bus.device_8_bit(),
+      .spi_device_16_bit = bus.device_16_bit(),
+  });
+  const auto& writes = bus.writes();
+
+  // Only the software reset is sent before its delay.
+  EXPECT_EQ(OkStatus(), driver.StartInit());
+  ASSERT_EQ(1u, writes.size());
+  ExpectCommand(writes[0], kSoftwareReset);
+  EXPECT_EQ(Status::Unavailable(), driver.PollInit());
+  EXPECT_EQ(1u, writes.size());
+
+  Status status = driver.PollInit();
+  while (status.IsUnavailable()) {
+    status = driver.PollInit();
+  }
+  EXPECT_EQ(OkStatus(), status);
+  EXPECT_EQ(16u, bus.num_commands());
+  EXPECT_EQ(22u, bus.num_data_bytes());
+  // The address window covers the screen.
+  ASSERT_EQ(27u, writes.size());
+  ExpectAddressSet(writes[21], writes[22], kColumnAddressSet, 0, kWidth - 1);
+  ExpectAddressSet(writes[23], writes[24], kRowAddressSet, 0, kHeight - 1);
+}
+
+TEST(DisplayDriverILI9341, WriteRegion) {
+  FakeSpiBus bus;
+  DisplayDriverILI9341 driver({
+      .data_cmd_gpio = bus.data_cmd_gpio(),
+      .reset_gpio = nullptr,
+      .spi_device_8_bit = bus.device_8_bit(),
+      .spi_device_16_bit = bus.device_16_bit(),
+  });
+  EXPECT_TRUE(driver.SupportsRegionWrite());
+  Framebuffer fb = MakeFramebuffer(kWidth, kHeight);
+  const auto& writes = bus.writes();
+
+  WriteRegion(driver, fb, {5, 6, 7, 2});
+  ExpectAddressWindow(bus, 5, 11, 6, 7);
+  ASSERT_EQ(7u, writes.size());
+  ExpectPixels(writes[5], 7, 5, 6, kWidth);
+  ExpectPixels(writes[6], 7, 5, 7, kWidth);
+
+  // Contiguous rows are sent at most ten rows at a time.
+  bus.Clear();
+  WriteRegion(driver, fb, {0, 200, kWidth, 25});
+  ExpectAddressWindow(bus, 0, kWidth - 1, 200, 224);
+  ASSERT_EQ(8u, writes.size());
+  ExpectPixels(writes[5], 10 * kWidth, 0, 200, kWidth);
+  ExpectPixels(writes[6], 10 * kWidth, 0, 210, kWidth);
+  ExpectPixels(writes[7], 5 * kWidth, 0, 220, kWidth);
+
+  // The next full framebuffer write restores the full address window.
+  bus.Clear();
+  WriteFramebuffer(driver, fb);
+  ExpectAddressWindow(bus, 0, kWidth - 1, 0, kHeight - 1);
+  ASSERT_EQ(5u + kHeight / 10, writes.size());
+}
+
+TEST(DisplayDriverILI9341, WriteRect) {
+  FakeSpiBus bus;
+  DisplayDriverILI9341 driver({
+      .data_cmd_gpio = bus.data_cmd_gpio(),
+      .reset_gpio = nullptr,
+      .spi_device_8_bit = bus.device_8_bit(),
+      .spi_device_16_bit = bus.device_16_bit(),
+  });
+  MakeFramebuffer(kWidth, kHeight);
+  const auto& writes = bus.writes();
+
+  // Contiguous rows are sent at most ten rows at a time.
+  EXPECT_EQ(OkStatus(),
+            driver.WriteRect(span(s_pixel_data, 50 * 25), {3, 4, 50, 25}, 50));
+  ExpectAddressWindow(bus, 3, 52, 4, 28);
+  ASSERT_EQ(8u, writes.size());
+  ExpectPixels(writes[5], 10 * 50, 0, 0, 50);
+  ExpectPixels(writes[6], 10 * 50, 0, 10, 50);
+  ExpectPixels(writes[7], 5 * 50, 0, 20, 50);
+  EXPECT_EQ(3u, bus.num_commands());
+  EXPECT_EQ(kAddressWindowDataBytes + 50 * 25 * 2, bus.num_data_bytes());
+
+  // WriteRow() only sets the address window to the row.
+  bus.Clear();
+  EXPECT_EQ(OkStatus(), driver.WriteRow(span(s_pixel_data, 8), 200, 100));
+  ExpectAddressWindow(bus, 100, 107, 200, 200);
+  ASSERT_EQ(6u, writes.size());
+  ExpectPixels(writes[5], 8, 0, 0, kWidth);
+}
+
+TEST(DisplayDriverILI9341, Init) {
+  FakeSpiBus bus;
+  DisplayDriverILI9341 driver({
+      .data_cmd_gpio = bus.data_cmd_gpio(),
+      .reset_gpio = nullptr,
+      .spi_device_8_bit = bus.device_8_bit(),
+      .spi_device_16_bit = bus.device_16_bit(),
+      .swap_row_col = true,
+  });
+  const auto& writes = bus.writes();
+
+  EXPECT_EQ(OkStatus(), driver.Init());
+  EXPECT_EQ(27u, bus.num_commands());
+  EXPECT_EQ(76u, bus.num_data_bytes());
+  // Swapping rows and columns swaps the address window.
+  ASSERT_EQ(49u, writes.size());
+  ExpectAddressSet(writes[34], writes[35], kColumnAddressSet, 0, kHeight - 1);
+  ExpectAddressSet(writes[36], writes[37], kRowAddressSet, 0, kWidth - 1);
+  ExpectCommand(writes[48], kMemoryWrite);
+}
+
+TEST(DisplayDriverST7735, WriteRegion) {
+  constexpr uint16_t kST7735Width = 160;
+  constexpr uint16_t kST7735Height = 128;
+  FakeSpiBus bus;
+  DisplayDriverST7735 driver({
+      .data_cmd_gpio = bus.data_cmd_gpio(),
+      .reset_gpio = nullptr,
+      .spi_device_8_bit = bus.device_8_bit(),
+      .spi_device_16_bit = bus.device_16_bit(),
+  });
+  EXPECT_TRUE(driver.SupportsRegionWrite());
+  Framebuffer fb = MakeFramebuffer(kST7735Width, kST7735Height);
+  const auto& writes = bus.writes();
+
+  // The ST7735 panel is offset within the controller's memory.
+  WriteRegion(driver, fb, {0, 0, 2, 2});
+  ExpectAddressWindow(bus, 1, 2, 2, 3);
+  ASSERT_EQ(7u, writes.size());
+  ExpectPixels(writes[5], 2, 0, 0, kST7735Width);
+  ExpectPixels(writes[6], 2, 0, 1, kST7735Width);
+}
+
+TEST(DisplayDriverST7735, WriteRect) {
+  FakeSpiBus bus;
+  DisplayDriverST7735 driver({
+      .data_cmd_gpio = bus.data_cmd_gpio(),
+      .reset_gpio = nullptr,
+      .spi_device_8_bit = bus.device_8_bit(),
+      .spi_device_16_bit = bus.device_16_bit(),
+  });
+  MakeFramebuffer(kWidth, kHeight);
+  const auto& writes = bus.writes();
+
+  EXPECT_EQ(OkStatus(),
+            driver.WriteRect(span(s_pixel_data, 2 * 8 + 3), {10, 20, 3, 3}, 8));
+  ExpectAddressWindow(bus, 11, 13, 22, 24);
+  ASSERT_EQ(8u, writes.size());
+  ExpectPixels(writes[5], 3, 0, 0, 8);
+  ExpectPixels(writes[7], 3, 0, 2, 8);
+  EXPECT_EQ(3u, bus.num_commands());
+  EXPECT_EQ(kAddressWindowDataBytes + 3 * 3 * 2, bus.num_data_bytes());
+
+  // Rows are written the same way.
+  bus.Clear();
+  EXPECT_EQ(OkStatus(), driver.WriteRow(span(s_pixel_data, 4), 5, 6));
+  ExpectAddressWindow(bus, 7, 10, 7, 7);
+  ASSERT_EQ(6u, writes.size());
+  ExpectPixels(writes[5], 4, 0, 0, kWidth);
+}
+
+// Records each WriteRow() made by the default WriteRect().
+class RowDisplayDriver : public DisplayDriver {
+ public:
+  struct Row {
+    uint16_t row_idx;
+    uint16_t col_idx;
+    size_t num_pixels;
+    uint16_t first_pixel;
+  };
+
+  Status Init() override { return OkStatus(); }
+  void WriteFramebuffer(Framebuffer framebuffer,
+                        WriteCallback write_callback) override {
+    write_callback(std::move(framebuffer), OkStatus());
+  }
+  Status WriteRow(span<uint16_t> row_pixels,
+                  uint16_t row_idx,
+                  uint16_t col_idx) override {
+    rows_.push_back({row_idx, col_idx, row_pixels.size(), row_pixels[0]});
+    return OkStatus();
+  }
+  uint16_t GetWidth() const override { return kWidth; }
+  uint16_t GetHeight() const override { return kHeight; }
+
+  const pw::Vector<Row, 8>& rows() const { return rows_; }
+
+ private:
+  pw::Vector<Row, 8> rows_;
+};
+
+TEST(DisplayDriver, DefaultWriteRect) {
+  RowDisplayDriver driver;
+  MakeFramebuffer(kWidth, kHeight);
+
+  EXPECT_EQ(OkStatus(),
+            driver.WriteRect(span(s_pixel_data, 2 * 12 + 5), {4, 6, 5, 3}, 12));
+  ASSERT_EQ(3u, driver.rows().size());
+  for (uint16_t row = 0; row < 3; row++) {
+    EXPECT_EQ(6 + row, driver.rows()[row].row_idx);
+    EXPECT_EQ(4, driver.rows()[row].col_idx);
+    EXPECT_EQ(5u, driver.rows()[row].num_pixels);
+    EXPECT_EQ(row * 12, driver.rows()[row].first_pixel);
+  }
+}
+
+}  // namespace
+
+}  // namespace pw::display_driver
@@ -0,0 +1,73 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#include "pw_display_driver/fake_spi_bus.h"
+
+#include <algorithm>
+
+using pw::digital_io::State;
+
+namespace pw::display_driver {
+
+namespace {
+
+constexpr pw::spi::Config MakeConfig(uint8_t bits_per_word) {
+  return {
+      .polarity = pw::spi::ClockPolarity::kActiveHigh,
+      .phase = pw::spi::ClockPhase::kFallingEdge,
+      .bits_per_word = pw::spi::BitsPerWord(bits_per_word),
+      .bit_order = pw::spi::BitOrder::kMsbFirst,
+  };
+}
+
+}  // namespace
+
+FakeSpiBus::FakeSpiBus()
+    : initiator_8_bit_(*this, 8),
+      initiator_16_bit_(*this, 16),
+      borrowable_initiator_8_bit_(initiator_8_bit_, initiator_mutex_),
+      borrowable_initiator_16_bit_(initiator_16_bit_, initiator_mutex_),
+      device_8_bit_(borrowable_initiator_8_bit_, MakeConfig(8), chip_selector_),
+      device_16_bit_(
+          borrowable_initiator_16_bit_, MakeConfig(16), chip_selector_) {}
+
+Status FakeSpiBus::Record(uint8_t bits_per_word, ConstByteSpan write_buffer) {
+  if (writes_until_failure_ == 0) {
+    return Status::Internal();
+  }
+  if (writes_until_failure_ != SIZE_MAX) {
+    writes_until_failure_--;
+  }
+  const bool is_command = data_cmd_gpio_.state() != State::kActive;
+  if (is_command) {
+    num_commands_ += write_buffer.size();
+  } else {
+    num_data_bytes_ += write_buffer.size() * (bits_per_word / 8);
+  }
+  if (writes_.full()) {
+    return OkStatus();
+  }
+  Write write{
+      .is_command = is_command,
+      .bits_per_word = bits_per_word,
+      .size = write_buffer.size(),
+      .data = {},
+  };
+  std::copy_n(write_buffer.begin(),
+              std::min(write_buffer.size(), kMaxSavedBytes),
+              write.data.begin());
+  writes_.push_back(write);
+  return OkStatus();
+}
+
+}  // namespace pw::display_driver
@@ -0,0 +1,139 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#include "pw_display_driver/init_sequence.h"
+
+#include <cstdint>
+
+#include "pw_bytes/span.h"
+#include "pw_spin_delay/delay.h"
+#include "pw_status/try.h"
+
+using pw::digital_io::State;
+using pw::spi::ChipSelectBehavior;
+using pw::spi::Device;
+
+namespace pw::display_driver {
+
+InitSequencer::InitSequencer(pw::digital_io::DigitalOut& data_cmd_gpio,
+                             Device& device,
+                             ChipSelectBehavior behavior)
+    : data_cmd_gpio_(data_cmd_gpio), device_(device), behavior_(behavior) {}
+
+void InitSequencer::Start(std::initializer_list<span<const uint8_t>> parts) {
+  PW_ASSERT(parts.size() <= kMaxParts);
+  num_parts_ = 0;
+  for (span<const uint8_t> part : parts) {
+    PW_ASSERT(IsValidInitSequence(part));
+    parts_[num_parts_++] = part;
+  }
+  part_idx_ = 0;
+  offset_ = 0;
+  waiting_ = false;
+  status_ = OkStatus();
+  SkipSentParts();
+}
+
+void InitSequencer::SkipSentParts() {
+  while (part_idx_ < num_parts_ && offset_ == parts_[part_idx_].size()) {
+    part_idx_++;
+    offset_ = 0;
+  }
+}
+
+void InitSequencer::SetDataMode(bool data_mode) {
+  if (gpio_known_ && data_mode_ == data_mode) {
+    return;
+  }
+  data_cmd_gpio_.SetState(data_mode ? State::kActive : State::kInactive);
+  data_mode_ = data_mode;
+  gpio_known_ = true;
+}
+
+Status InitSequencer::WriteCommand(Device::Transaction& transaction,
+                                   uint8_t command,
+                                   span<const uint8_t> args) {
+  SetDataMode(false);
+  const std::byte buff[1]{static_cast<std::byte>(command)};
+  PW_TRY(transaction.Write(buff));
+  if (args.empty()) {
+    return OkStatus();
+  }
+  SetDataMode(true);
+  return transaction.Write(ConstByteSpan(
+      reinterpret_cast<const std::byte*>(args.data()), args.size()));
+}
+
+Status InitSequencer::Poll() {
+  if (!status_.ok()) {
+    return status_;
+  }
+  if (waiting_) {
+    if (static_cast<int32_t>(pw::spin_delay::Millis() - deadline_ms_) < 0) {
+      return Status::Unavailable();
+    }
+    waiting_ = false;
+  }
+  if (part_idx_ == num_parts_) {
+    return status_;
+  }
+
+  uint32_t delay_ms = 0;
+  {
+    auto transaction = device_.StartTransaction(behavior_);
+    // The driver may have changed the GPIO since the last transaction.
+    gpio_known_ = false;
+    while (part_idx_ < num_parts_ && delay_ms == 0) {
+      const span<const uint8_t> part = parts_[part_idx_];
+      const uint8_t command = part[offset_];
+      const uint8_t count = part[offset_ + 1];
+      const span<const uint8_t> args =
+          part.subspan(offset_ + 2, count & ~kInitDelay);
+      offset_ += 2 + args.size();
+      if (count & kInitDelay) {
+        delay_ms = InitDelayMillis(part[offset_++]);
+      }
+      SkipSentParts();
+      status_ = WriteCommand(transaction, command, args);
+      if (!status_.ok()) {
+        // Abandon the rest of the sequence. status_ is returned until the
+        // next Start().
+        num_parts_ = 0;
+        part_idx_ = 0;
+        offset_ = 0;
+        return status_;
+      }
+    }
+  }
+  if (delay_ms == 0) {
+    return OkStatus();
+  }
+  deadline_ms_ = pw::spin_delay::Millis() + delay_ms;
+  waiting_ = true;
+  return Status::Unavailable();
+}
+
+Status InitSequencer::Finish() {
+  Status s = Poll();
+  while (s.IsUnavailable()) {
+    const int32_t remaining_ms =
+        static_cast<int32_t>(deadline_ms_ - pw::spin_delay::Millis());
+    if (waiting_ && remaining_ms > 0) {
+      pw::spin_delay::WaitMillis(remaining_ms);
+    }
+    s = Poll();
+  }
+  return s;
+}
+
+}  // namespace pw::display_driver
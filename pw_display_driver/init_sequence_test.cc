@@ -0,0 +1,174 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#include "pw_display_driver/init_sequence.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "gtest/gtest.h"
+#include "pw_display_driver/fake_spi_bus.h"
+#include "pw_spin_delay/delay.h"
+
+using pw::spi::ChipSelectBehavior;
+
+namespace pw::display_driver {
+
+namespace {
+
+// clang-format off
+constexpr uint8_t kSequence[] = {
+    0x01, kInitDelay, 2,
+    0x11, 0,
+    0x3A, 1, 0x55,
+    0x36, kInitDelay | 2, 0x12, 0x34, 3,
+};
+// clang-format on
+static_assert(IsValidInitSequence(kSequence));
+
+constexpr uint8_t kDisplayOn[] = {0x29, 0};
+
+void ExpectCommand(const FakeSpiBus::Write& write, uint8_t command) {
+  EXPECT_TRUE(write.is_command);
+  EXPECT_EQ(1u, write.size);
+  EXPECT_EQ(std::byte{command}, write.data[0]);
+}
+
+void ExpectData(const FakeSpiBus::Write& write, size_t size, uint8_t first) {
+  EXPECT_FALSE(write.is_command);
+  EXPECT_EQ(8, write.bits_per_word);
+  EXPECT_EQ(size, write.size);
+  EXPECT_EQ(std::byte{first}, write.data[0]);
+}
+
+TEST(InitSequence, IsValid) {
+  constexpr uint8_t kMissingCount[] = {0x01};
+  constexpr uint8_t kMissingArgument[] = {0x3A, 2, 0x55};
+  constexpr uint8_t kMissingDelay[] = {0x3A, kInitDelay | 1, 0x55};
+  static_assert(IsValidInitSequence(span<const uint8_t>()));
+  static_assert(IsValidInitSequence(kDisplayOn));
+  static_assert(!IsValidInitSequence(kMissingCount));
+  static_assert(!IsValidInitSequence(kMissingArgument));
+  static_assert(!IsValidInitSequence(kMissingDelay));
+
+  EXPECT_EQ(10u, InitDelayMillis(10));
+  EXPECT_EQ(kInitDelayLongMillis, InitDelayMillis(kInitDelayLong));
+}
+
+TEST(InitSequence, Buffer) {
+  InitSequenceBuffer<16> buffer;
+  buffer.Add(0x3A, {0x55});
+  buffer.Add(0x36, {0x12, 0x34}, /*delay_ms=*/3);
+  buffer.Add(0x29, {});
+  constexpr std::array<uint8_t, 10> kExpected = {
+      0x3A, 1, 0x55, 0x36, kInitDelay | 2, 0x12, 0x34, 3, 0x29, 0};
+  ASSERT_EQ(kExpected.size(), buffer.sequence().size());
+  EXPECT_TRUE(std::equal(
+      kExpected.begin(), kExpected.end(), buffer.sequence().begin()));
+  EXPECT_TRUE(IsValidInitSequence(buffer.sequence()));
+
+  buffer.Clear();
+  EXPECT_TRUE(buffer.sequence().empty());
+}
+
+TEST(InitSequencer, Poll) {
+  FakeSpiBus bus;
+  InitSequencer sequencer(bus.data_cmd_gpio(),
+                          bus.device_8_bit(),
+                          ChipSelectBehavior::kPerTransaction);
+  const auto& writes = bus.writes();
+
+  // Nothing is sent until polled.
+  sequencer.Start({kSequence});
+  EXPECT_TRUE(sequencer.busy());
+  EXPECT_EQ(0u, writes.size());
+
+  // The commands up to the first delay are sent, and polling does nothing
+  // more until it has elapsed.
+  EXPECT_EQ(Status::Unavailable(), sequencer.Poll());
+  ASSERT_EQ(1u, writes.size());
+  ExpectCommand(writes[0], 0x01);
+  Status status = sequencer.Poll();
+  while (status.IsUnavailable() && writes.size() == 1) {
+    status = sequencer.Poll();
+  }
+
+  // The remaining commands all precede the final delay.
+  EXPECT_EQ(Status::Unavailable(), status);
+  ASSERT_EQ(6u, writes.size());
+  ExpectCommand(writes[1], 0x11);
+  ExpectCommand(writes[2], 0x3A);
+  ExpectData(writes[3], 1, 0x55);
+  ExpectCommand(writes[4], 0x36);
+  ExpectData(writes[5], 2, 0x12);
+  EXPECT_TRUE(sequencer.busy());
+
+  while (status.IsUnavailable()) {
+    status = sequencer.Poll();
+  }
+  EXPECT_EQ(OkStatus(), status);
+  EXPECT_FALSE(sequencer.busy());
+  EXPECT_EQ(6u, writes.size());
+  EXPECT_EQ(OkStatus(), sequencer.Poll());
+}
+
+TEST(InitSequencer, Finish) {
+  FakeSpiBus bus;
+  InitSequencer sequencer(bus.data_cmd_gpio(),
+                          bus.device_8_bit(),
+                          ChipSelectBehavior::kPerWriteRead);
+
+  // Empty parts are skipped, and Finish() waits out every delay.
+  const uint32_t start_ms = pw::spin_delay::Millis();
+  sequencer.Start({kSequence, span<const uint8_t>(), kDisplayOn});
+  EXPECT_EQ(OkStatus(), sequencer.Finish());
+  EXPECT_GE(pw::spin_delay::Millis() - start_ms, 5u);
+  EXPECT_FALSE(sequencer.busy());
+  EXPECT_EQ(5u, bus.num_commands());
+  EXPECT_EQ(3u, bus.num_data_bytes());
+  ASSERT_EQ(7u, bus.writes().size());
+  ExpectCommand(bus.writes()[6], 0x29);
+}
+
+TEST(InitSequencer, BusError) {
+  constexpr uint8_t kSleepOut[] = {0x11, 0};
+  FakeSpiBus bus;
+  InitSequencer sequencer(bus.data_cmd_gpio(),
+                          bus.device_8_bit(),
+                          ChipSelectBehavior::kPerWriteRead);
+
+  // The write of the second table's command fails.
+  bus.FailAfterWrites(1);
+  sequencer.Start({kSleepOut, kDisplayOn});
+  EXPECT_EQ(Status::Internal(), sequencer.Poll());
+  EXPECT_FALSE(sequencer.busy());
+  ASSERT_EQ(1u, bus.writes().size());
+  ExpectCommand(bus.writes()[0], 0x11);
+
+  // The error is reported until the next Start(), and nothing more is sent.
+  bus.Clear();
+  EXPECT_EQ(Status::Internal(), sequencer.Poll());
+  EXPECT_EQ(Status::Internal(), sequencer.Finish());
+  EXPECT_FALSE(sequencer.busy());
+  EXPECT_EQ(0u, bus.writes().size());
+
+  sequencer.Start({kSleepOut, kDisplayOn});
+  EXPECT_EQ(OkStatus(), sequencer.Finish());
+  EXPECT_EQ(2u, bus.writes().size());
+}
+
+}  // namespace
+
+}  // namespace pw::display_driver
@@ -0,0 +1,181 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#include "pw_display_driver/mipi_dcs.h"
+
+#include <array>
+#include <cstddef>
+
+#include "pw_spin_delay/delay.h"
+
+using pw::digital_io::State;
+using pw::framebuffer::Framebuffer;
+using pw::framebuffer::PixelFormat;
+using pw::math::Rect;
+using pw::math::Size;
+using pw::spi::ChipSelectBehavior;
+using pw::spi::Device;
+
+namespace pw::display_driver {
+
+namespace {
+
+constexpr uint8_t HighByte(uint16_t val) { return val >> 8; }
+
+constexpr uint8_t LowByte(uint16_t val) { return val & 0xff; }
+
+// The four argument bytes of an address set command for |min|..|max|.
+constexpr std::array<std::byte, 4> AddressRange(uint16_t min, uint16_t max) {
+  return {
+      std::byte{HighByte(min)},
+      std::byte{LowByte(min)},
+      std::byte{HighByte(max)},
+      std::byte{LowByte(max)},
+  };
+}
+
+}  // namespace
+
+DisplayDriverMipiDcsBase::DisplayDriverMipiDcsBase(
+    const Bus& bus,
+    Size<uint16_t> screen_size,
+    Size<uint16_t> offset,
+    ChipSelectBehavior init_chip_select)
+    : bus_(bus),
+      init_sequencer_(
+          bus_.data_cmd_gpio, bus_.spi_device_8_bit, init_chip_select),
+      screen_size_(screen_size),
+      offset_(offset) {}
+
+Status DisplayDriverMipiDcsBase::Init() {
+  PW_TRY(StartInit());
+  return init_sequencer_.Finish();
+}
+
+Status DisplayDriverMipiDcsBase::PollInit() { return init_sequencer_.Poll(); }
+
+Status DisplayDriverMipiDcsBase::BeginInit() {
+  if (bus_.reset_gpio) {
+    PW_TRY(Reset());
+  }
+  const uint16_t max_column = offset_.width + screen_size_.width - 1;
+  const uint16_t max_row = offset_.height + screen_size_.height - 1;
+  window_init_sequence_.Clear();
+  window_init_sequence_.Add(mipi_dcs::kColumnAddressSet,
+                            {HighByte(offset_.width),
+                             LowByte(offset_.width),
+                             HighByte(max_column),
+                             LowByte(max_column)});
+  window_init_sequence_.Add(mipi_dcs::kRowAddressSet,
+                            {HighByte(offset_.height),
+                             LowByte(offset_.height),
+                             HighByte(max_row),
+                             LowByte(max_row)});
+  partial_window_ = false;
+  return OkStatus();
+}
+
+Status DisplayDriverMipiDcsBase::SendInitStart() {
+  const Status s = init_sequencer_.Poll();
+  return s.IsUnavailable() ? OkStatus() : s;
+}
+
+Status DisplayDriverMipiDcsBase::Reset() {
+  PW_TRY(bus_.reset_gpio->SetStateActive());
+  pw::spin_delay::WaitMillis(100);
+  PW_TRY(bus_.reset_gpio->SetStateInactive());
+  pw::spin_delay::WaitMillis(100);
+  return OkStatus();
+}
+
+Status DisplayDriverMipiDcsBase::WriteCommand(Device::Transaction& transaction,
+                                              uint8_t command,
+                                              ConstByteSpan args) {
+  // Set the D/CX pin to indicate command, and then data, values.
+  bus_.data_cmd_gpio.SetState(State::kInactive);
+  const std::byte buff[1]{static_cast<std::byte>(command)};
+  PW_TRY(transaction.Write(buff));
+  bus_.data_cmd_gpio.SetState(State::kActive);
+  if (args.empty()) {
+    return OkStatus();
+  }
+  return transaction.Write(args);
+}
+
+Status DisplayDriverMipiDcsBase::SetAddressWindow(
+    const Rect<uint16_t>& window) {
+  const uint16_t min_column = offset_.width + window.x;
+  const uint16_t min_row = offset_.height + window.y;
+  auto transaction = bus_.spi_device_8_bit.StartTransaction(
+      ChipSelectBehavior::kPerWriteRead);
+  partial_window_ = true;
+  PW_TRY(WriteCommand(
+      transaction,
+      mipi_dcs::kColumnAddressSet,
+      AddressRange(min_column, min_column + window.width - 1)));
+  PW_TRY(WriteCommand(transaction,
+                      mipi_dcs::kRowAddressSet,
+                      AddressRange(min_row, min_row + window.height - 1)));
+  return WriteCommand(transaction, mipi_dcs::kMemoryWrite, ConstByteSpan());
+}
+
+Status DisplayDriverMipiDcsBase::StartScreenWrite() {
+  if (partial_window_) {
+    // Restore the address window changed by WriteRect().
+    PW_TRY(SetAddressWindow({0, 0, screen_size_.width, screen_size_.height}));
+    partial_window_ = false;
+    return OkStatus();
+  }
+  auto transaction = bus_.spi_device_8_bit.StartTransaction(
+      ChipSelectBehavior::kPerWriteRead);
+  return WriteCommand(transaction, mipi_dcs::kMemoryWrite, ConstByteSpan());
+}
+
+void DisplayDriverMipiDcsBase::WriteRegion(Framebuffer framebuffer,
+                                           const Rect<uint16_t>& region,
+                                           WriteCallback write_callback) {
+  PW_ASSERT(framebuffer.is_valid());
+  PW_ASSERT(framebuffer.pixel_format() == PixelFormat::RGB565);
+  // |region| is in display coordinates, and the framebuffer may only cover
+  // part of the display.
+  const Rect<uint16_t> window = region.Intersect(framebuffer.bounds());
+  if (window.IsEmpty()) {
+    write_callback(std::move(framebuffer), OkStatus());
+    return;
+  }
+  const uint16_t stride = framebuffer.row_bytes() / sizeof(uint16_t);
+  uint16_t* pixels = static_cast<uint16_t*>(framebuffer.data()) +
+                     (window.y - framebuffer.origin().y) * stride +
+                     (window.x - framebuffer.origin().x);
+  const size_t num_pixels = (window.height - 1) * stride + window.width;
+  const Status s = WriteRect(span(pixels, num_pixels), window, stride);
+  write_callback(std::move(framebuffer), s);
+}
+
+Status DisplayDriverMipiDcsBase::WriteRow(span<uint16_t> row_pixels,
+                                          uint16_t row_idx,
+                                          uint16_t col_idx) {
+  const uint16_t width = static_cast<uint16_t>(row_pixels.size());
+  return WriteRect(row_pixels, {col_idx, row_idx, width, 1}, width);
+}
+
+bool DisplayDriverMipiDcsBase::SupportsResize() const {
+  return bus_.pixel_pusher != nullptr && bus_.pixel_pusher->SupportsResize();
+}
+
+bool DisplayDriverMipiDcsBase::SupportsRegionWrite() const {
+  // The pixel pusher always sends entire framebuffers.
+  return bus_.pixel_pusher == nullptr;
+}
+
+}  // namespace pw::display_driver
@@ -0,0 +1,471 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#include "pw_display_driver/mipi_dcs.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "pw_display_driver/fake_spi_bus.h"
+#include "pw_display_driver/init_sequence.h"
+#include "pw_display_driver_ili9341/display_driver.h"
+#include "pw_display_driver_st7735/display_driver.h"
+#include "pw_display_driver_st7789/display_driver.h"
+#include "pw_framebuffer/framebuffer.h"
+#include "pw_framebuffer_pool/framebuffer_pool.h"
+#include "pw_math/rect.h"
+#include "pw_pixel_pusher/pixel_pusher.h"
+
+using pw::framebuffer::Framebuffer;
+using pw::framebuffer::PixelFormat;
+using Rect = pw::math::Rect<uint16_t>;
+
+namespace pw::display_driver {
+
+namespace {
+
+// The conformance tests below are run against each SPI display driver, along
+// with TestPanel, to verify the behavior of DisplayDriverMipiDcs for every
+// panel descriptor.
+
+// A panel with an offset and a small row limit, and no init commands other
+// than its address window.
+struct TestPanel {
+  struct Config {
+    pw::digital_io::DigitalOut& data_cmd_gpio;
+    pw::digital_io::DigitalOut* reset_gpio;
+    pw::spi::Device& spi_device_8_bit;
+    pw::spi::Device& spi_device_16_bit;
+    pw::pixel_pusher::PixelPusher* pixel_pusher = nullptr;
+  };
+
+  static constexpr uint16_t kColumnOffset = 5;
+  static constexpr uint16_t kRowOffset = 7;
+  static constexpr int kMaxRowsPerWrite = 3;
+  static constexpr pw::spi::ChipSelectBehavior kInitChipSelect =
+      pw::spi::ChipSelectBehavior::kPerTransaction;
+
+  static pw::math::Size<uint16_t> ScreenSize(const Config&) {
+    return {100, 50};
+  }
+
+  static void StartInit(const Config&,
+                        span<const uint8_t> window_sequence,
+                        InitSequencer& sequencer) {
+    static constexpr uint8_t kSoftwareReset[] = {mipi_dcs::kSoftwareReset, 0};
+    sequencer.Start({kSoftwareReset, window_sequence});
+  }
+};
+
+using TestDriver = DisplayDriverMipiDcs<TestPanel>;
+
+// Sends the framebuffers it is given to nowhere.
+class FakePixelPusher : public pw::pixel_pusher::PixelPusher {
+ public:
+  Status Init(const pw::framebuffer_pool::FramebufferPool&) override {
+    return OkStatus();
+  }
+  void WriteFramebuffer(Framebuffer framebuffer,
+                        WriteCallback complete_callback) override {
+    num_writes_++;
+    complete_callback(std::move(framebuffer), OkStatus());
+  }
+
+  int num_writes() const { return num_writes_; }
+
+ private:
+  int num_writes_ = 0;
+};
+
+constexpr uint16_t kMaxWidth = 320;
+constexpr uint16_t kMaxHeight = 320;
+
+uint16_t s_pixel_data[kMaxWidth * kMaxHeight];
+
+template <typename Driver>
+typename Driver::Config MakeConfig(
+    FakeSpiBus& bus, pw::pixel_pusher::PixelPusher* pixel_pusher = nullptr) {
+  typename Driver::Config config{
+      .data_cmd_gpio = bus.data_cmd_gpio(),
+      .reset_gpio = nullptr,
+      .spi_device_8_bit = bus.device_8_bit(),
+      .spi_device_16_bit = bus.device_16_bit(),
+  };
+  config.pixel_pusher = pixel_pusher;
+  return config;
+}
+
+template <>
+DisplayDriverST7789::Config MakeConfig<DisplayDriverST7789>(
+    FakeSpiBus& bus, pw::pixel_pusher::PixelPusher* pixel_pusher) {
+  return {
+      .data_cmd_gpio = bus.data_cmd_gpio(),
+      .spi_cs_gpio = bus.chip_select_gpio(),
+      .reset_gpio = nullptr,
+      .tear_effect_gpio = nullptr,
+      .spi_device_8_bit = bus.device_8_bit(),
+      .spi_device_16_bit = bus.device_16_bit(),
+      .pixel_pusher = pixel_pusher,
+  };
+}
+
+Framebuffer MakeFramebuffer(const DisplayDriver& driver) {
+  const uint16_t width = driver.GetWidth();
+  const uint16_t height = driver.GetHeight();
+  for (size_t i = 0; i < width * height; i++) {
+    s_pixel_data[i] = static_cast<uint16_t>(i);
+  }
+  return Framebuffer(s_pixel_data,
+                     PixelFormat::RGB565,
+                     {width, height},
+                     width * sizeof(uint16_t));
+}
+
+void ExpectCommand(const FakeSpiBus::Write& write, uint8_t command) {
+  EXPECT_TRUE(write.is_command);
+  EXPECT_EQ(8, write.bits_per_word);
+  EXPECT_EQ(1u, write.size);
+  EXPECT_EQ(std::byte{command}, write.data[0]);
+}
+
+void ExpectAddressSet(const FakeSpiBus::Write& command_write,
+                      const FakeSpiBus::Write& data_write,
+                      uint8_t command,
+                      uint16_t min,
+                      uint16_t max) {
+  ExpectCommand(command_write, command);
+  EXPECT_FALSE(data_write.is_command);
+  EXPECT_EQ(8, data_write.bits_per_word);
+  ASSERT_EQ(4u, data_write.size);
+  EXPECT_EQ(std::byte(min >> 8), data_write.data[0]);
+  EXPECT_EQ(std::byte(min & 0xff), data_write.data[1]);
+  EXPECT_EQ(std::byte(max >> 8), data_write.data[2]);
+  EXPECT_EQ(std::byte(max & 0xff), data_write.data[3]);
+}
+
+// Verify that the writes starting at |index| set the address window to
+// |window|, in display coordinates, for a driver of type |Driver|.
+template <typename Driver>
+void ExpectAddressWindow(const FakeSpiBus& bus,
+                         size_t index,
+                         const Rect& window) {
+  using Panel = typename Driver::Panel;
+  const auto& writes = bus.writes();
+  ASSERT_GE(writes.size(), index + 4);
+  const uint16_t col = Panel::kColumnOffset + window.x;
+  const uint16_t row = Panel::kRowOffset + window.y;
+  ExpectAddressSet(writes[index],
+                   writes[index + 1],
+                   mipi_dcs::kColumnAddressSet,
+                   col,
+                   col + window.width - 1);
+  ExpectAddressSet(writes[index + 2],
+                   writes[index + 3],
+                   mipi_dcs::kRowAddressSet,
+                   row,
+                   row + window.height - 1);
+}
+
+// Verify that the writes starting at |index| send |num_rows| rows of |width|
+// pixels starting at s_pixel_data[first], |stride| pixels apart, and that
+// they are the last writes.
+template <typename Driver>
+void ExpectPixels(const FakeSpiBus& bus,
+                  size_t index,
+                  uint16_t width,
+                  uint16_t num_rows,
+                  uint16_t stride,
+                  size_t first) {
+  constexpr int kMaxRowsPerWrite = Driver::Panel::kMaxRowsPerWrite;
+  const auto& writes = bus.writes();
+  int rows_per_write = stride == width ? num_rows : 1;
+  if (kMaxRowsPerWrite > 0 && rows_per_write > kMaxRowsPerWrite) {
+    rows_per_write = kMaxRowsPerWrite;
+  }
+  for (int row = 0; row < num_rows; row += rows_per_write, index++) {
+    ASSERT_LT(index, writes.size());
+    const int rows = std::min(rows_per_write, num_rows - row);
+    EXPECT_FALSE(writes[index].is_command);
+    EXPECT_EQ(16, writes[index].bits_per_word);
+    EXPECT_EQ(static_cast<size_t>(width * rows), writes[index].size);
+    uint16_t first_pixel;
+    std::memcpy(&first_pixel, writes[index].data.data(), sizeof(first_pixel));
+    EXPECT_EQ(static_cast<uint16_t>(first + row * stride), first_pixel);
+  }
+  EXPECT_EQ(index, writes.size());
+}
+
+// Init starts with a command, sets the address window to the entire screen,
+// and can be polled to completion.
+template <typename Driver>
+void TestInit() {
+  FakeSpiBus bus;
+  Driver driver(MakeConfig<Driver>(bus));
+  const auto& writes = bus.writes();
+
+  EXPECT_EQ(OkStatus(), driver.StartInit());
+  ASSERT_GE(writes.size(), 1u);
+  EXPECT_TRUE(writes[0].is_command);
+  Status status = driver.PollInit();
+  while (status.IsUnavailable()) {
+    status = driver.PollInit();
+  }
+  EXPECT_EQ(OkStatus(), status);
+
+  size_t window_index = 0;
+  while (window_index < writes.size() &&
+         !(writes[window_index].is_command &&
+           writes[window_index].data[0] ==
+               std::byte{mipi_dcs::kColumnAddressSet})) {
+    window_index++;
+  }
+  ExpectAddressWindow<Driver>(
+      bus, window_index, {0, 0, driver.GetWidth(), driver.GetHeight()});
+
+  // Init() runs the whole sequence again.
+  const size_t num_writes = writes.size();
+  bus.Clear();
+  EXPECT_EQ(OkStatus(), driver.Init());
+  EXPECT_EQ(num_writes, writes.size());
+}
+
+// WriteRect sets the address window to the rectangle and streams its rows,
+// coalescing contiguous rows up to the panel's limit.
+template <typename Driver>
+void TestWriteRect() {
+  FakeSpiBus bus;
+  Driver driver(MakeConfig<Driver>(bus));
+  MakeFramebuffer(driver);
+
+  EXPECT_EQ(OkStatus(),
+            driver.WriteRect(span(s_pixel_data, 7 * 20), {3, 4, 20, 7}, 20));
+  ExpectAddressWindow<Driver>(bus, 0, {3, 4, 20, 7});
+  ExpectCommand(bus.writes()[4], mipi_dcs::kMemoryWrite);
+  ExpectPixels<Driver>(bus, 5, 20, 7, 20, 0);
+  EXPECT_EQ(3u, bus.num_commands());
+  EXPECT_EQ(8u + 20 * 7 * 2, bus.num_data_bytes());
+
+  // Rows which are not contiguous are written one at a time.
+  bus.Clear();
+  EXPECT_EQ(OkStatus(),
+            driver.WriteRect(span(s_pixel_data, 4 * 30 + 6), {1, 2, 6, 5}, 30));
+  ExpectAddressWindow<Driver>(bus, 0, {1, 2, 6, 5});
+  ExpectPixels<Driver>(bus, 5, 6, 5, 30, 0);
+}
+
+// WriteRect clips to the screen, and WriteRow writes a one row rectangle.
+template <typename Driver>
+void TestWriteRectClipped() {
+  FakeSpiBus bus;
+  Driver driver(MakeConfig<Driver>(bus));
+  MakeFramebuffer(driver);
+  const uint16_t width = driver.GetWidth();
+  const uint16_t height = driver.GetHeight();
+
+  const uint16_t x = width - 4;
+  const uint16_t y = height - 2;
+
+  EXPECT_EQ(
+      OkStatus(),
+      driver.WriteRect(span(s_pixel_data, 3 * 10 + 10), {x, y, 10, 4}, 10));
+  ExpectAddressWindow<Driver>(bus, 0, {x, y, 4, 2});
+  ExpectPixels<Driver>(bus, 5, 4, 2, 10, 0);
+
+  // Entirely off screen.
+  bus.Clear();
+  EXPECT_EQ(OkStatus(),
+            driver.WriteRect(span(s_pixel_data, 4), {width, 0, 4, 1}, 4));
+  EXPECT_EQ(0u, bus.writes().size());
+
+  bus.Clear();
+  EXPECT_EQ(OkStatus(), driver.WriteRow(span(s_pixel_data, 8), 9, 2));
+  ExpectAddressWindow<Driver>(bus, 0, {2, 9, 8, 1});
+  ExpectPixels<Driver>(bus, 5, 8, 1, 8, 0);
+}
+
+// WriteRegion writes part of a framebuffer placed at its origin, and the
+// next WriteFramebuffer restores the full screen address window.
+template <typename Driver>
+void TestWriteRegion() {
+  FakeSpiBus bus;
+  Driver driver(MakeConfig<Driver>(bus));
+  EXPECT_TRUE(driver.SupportsRegionWrite());
+  EXPECT_FALSE(driver.SupportsResize());
+  const uint16_t width = driver.GetWidth();
+  const uint16_t height = driver.GetHeight();
+  Framebuffer framebuffer = MakeFramebuffer(driver);
+  Framebuffer band(framebuffer.data(),
+                   PixelFormat::RGB565,
+                   {width, 16},
+                   width * sizeof(uint16_t));
+  band.set_origin({0, 16});
+
+  bool called = false;
+  driver.WriteRegion(std::move(band),
+                     {2, 20, 5, 3},
+                     [&](Framebuffer fb, Status status) {
+                       EXPECT_EQ(OkStatus(), status);
+                       EXPECT_TRUE(fb.is_valid());
+                       called = true;
+                     });
+  EXPECT_TRUE(called);
+  ExpectAddressWindow<Driver>(bus, 0, {2, 20, 5, 3});
+  ExpectPixels<Driver>(bus, 5, 5, 3, width, 4 * width + 2);
+
+  bus.Clear();
+  called = false;
+  driver.WriteFramebuffer(std::move(framebuffer),
+                          [&](Framebuffer fb, Status status) {
+                            EXPECT_EQ(OkStatus(), status);
+                            framebuffer = std::move(fb);
+                            called = true;
+                          });
+  EXPECT_TRUE(called);
+  ExpectAddressWindow<Driver>(bus, 0, {0, 0, width, height});
+  ExpectCommand(bus.writes()[4], mipi_dcs::kMemoryWrite);
+  EXPECT_EQ(3u, bus.num_commands());
+  EXPECT_EQ(8u + width * height * 2, bus.num_data_bytes());
+
+  // The address window is only set again after a partial write.
+  bus.Clear();
+  driver.WriteFramebuffer(std::move(framebuffer),
+                          [&](Framebuffer fb, Status) {
+                            framebuffer = std::move(fb);
+                          });
+  ASSERT_GE(bus.writes().size(), 1u);
+  ExpectCommand(bus.writes()[0], mipi_dcs::kMemoryWrite);
+  EXPECT_EQ(1u, bus.num_commands());
+  EXPECT_EQ(width * height * 2u, bus.num_data_bytes());
+}
+
+// A framebuffer which is not the size of the screen is rejected without
+// writing anything.
+template <typename Driver>
+void TestWriteFramebufferSizeMismatch() {
+  FakeSpiBus bus;
+  Driver driver(MakeConfig<Driver>(bus));
+  const uint16_t width = driver.GetWidth();
+  const uint16_t height = driver.GetHeight();
+
+  for (const pw::math::Size<uint16_t> size :
+       {pw::math::Size<uint16_t>{static_cast<uint16_t>(width - 1), height},
+        pw::math::Size<uint16_t>{width, static_cast<uint16_t>(height / 2)}}) {
+    Framebuffer framebuffer(s_pixel_data,
+                            PixelFormat::RGB565,
+                            size,
+                            size.width * sizeof(uint16_t));
+    bool called = false;
+    driver.WriteFramebuffer(std::move(framebuffer),
+                            [&](Framebuffer fb, Status s) {
+                              EXPECT_EQ(Status::OutOfRange(), s);
+                              EXPECT_TRUE(fb.is_valid());
+                              called = true;
+                            });
+    EXPECT_TRUE(called);
+  }
+  EXPECT_EQ(0u, bus.writes().size());
+}
+
+// Framebuffers are handed to the pixel pusher when there is one.
+template <typename Driver>
+void TestPixelPusher() {
+  FakeSpiBus bus;
+  FakePixelPusher pixel_pusher;
+  Driver driver(MakeConfig<Driver>(bus, &pixel_pusher));
+  EXPECT_FALSE(driver.SupportsRegionWrite());
+
+  bool called = false;
+  driver.WriteFramebuffer(MakeFramebuffer(driver), [&](Framebuffer, Status s) {
+    EXPECT_EQ(OkStatus(), s);
+    called = true;
+  });
+  EXPECT_TRUE(called);
+  EXPECT_EQ(1, pixel_pusher.num_writes());
+  EXPECT_EQ(0u, bus.writes().size());
+}
+
+TEST(MipiDcsConformance, InitTestPanel) { TestInit<TestDriver>(); }
+TEST(MipiDcsConformance, InitILI9341) { TestInit<DisplayDriverILI9341>(); }
+TEST(MipiDcsConformance, InitST7735) { TestInit<DisplayDriverST7735>(); }
+TEST(MipiDcsConformance, InitST7789) { TestInit<DisplayDriverST7789>(); }
+
+TEST(MipiDcsConformance, WriteRectTestPanel) { TestWriteRect<TestDriver>(); }
+TEST(MipiDcsConformance, WriteRectILI9341) {
+  TestWriteRect<DisplayDriverILI9341>();
+}
+TEST(MipiDcsConformance, WriteRectST7735) {
+  TestWriteRect<DisplayDriverST7735>();
+}
+TEST(MipiDcsConformance, WriteRectST7789) {
+  TestWriteRect<DisplayDriverST7789>();
+}
+
+TEST(MipiDcsConformance, WriteRectClippedTestPanel) {
+  TestWriteRectClipped<TestDriver>();
+}
+TEST(MipiDcsConformance, WriteRectClippedILI9341) {
+  TestWriteRectClipped<DisplayDriverILI9341>();
+}
+TEST(MipiDcsConformance, WriteRectClippedST7735) {
+  TestWriteRectClipped<DisplayDriverST7735>();
+}
+TEST(MipiDcsConformance, WriteRectClippedST7789) {
+  TestWriteRectClipped<DisplayDriverST7789>();
+}
+
+TEST(MipiDcsConformance, WriteRegionTestPanel) {
+  TestWriteRegion<TestDriver>();
+}
+TEST(MipiDcsConformance, WriteRegionILI9341) {
+  TestWriteRegion<DisplayDriverILI9341>();
+}
+TEST(MipiDcsConformance, WriteRegionST7735) {
+  TestWriteRegion<DisplayDriverST7735>();
+}
+TEST(MipiDcsConformance, WriteRegionST7789) {
+  TestWriteRegion<DisplayDriverST7789>();
+}
+
+TEST(MipiDcsConformance, WriteFramebufferSizeMismatchTestPanel) {
+  TestWriteFramebufferSizeMismatch<TestDriver>();
+}
+TEST(MipiDcsConformance, WriteFramebufferSizeMismatchILI9341) {
+  TestWriteFramebufferSizeMismatch<DisplayDriverILI9341>();
+}
+TEST(MipiDcsConformance, WriteFramebufferSizeMismatchST7735) {
+  TestWriteFramebufferSizeMismatch<DisplayDriverST7735>();
+}
+TEST(MipiDcsConformance, WriteFramebufferSizeMismatchST7789) {
+  TestWriteFramebufferSizeMismatch<DisplayDriverST7789>();
+}
+
+TEST(MipiDcsConformance, PixelPusherTestPanel) {
+  TestPixelPusher<TestDriver>();
+}
+TEST(MipiDcsConformance, PixelPusherILI9341) {
+  TestPixelPusher<DisplayDriverILI9341>();
+}
+TEST(MipiDcsConformance, PixelPusherST7735) {
+  TestPixelPusher<DisplayDriverST7735>();
+}
+TEST(MipiDcsConformance, PixelPusherST7789) {
+  TestPixelPusher<DisplayDriverST7789>();
+}
+
+}  // namespace
+
+}  // namespace pw::display_driver
@@ -15,9 +15,11 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <utility>
 
 #include "pw_framebuffer/framebuffer.h"
 #include "pw_function/function.h"
+#include "pw_math/rect.h"
 #include "pw_span/span.h"
 #include "pw_status/status.h"
 
@@ -37,23 +39,73 @@ class DisplayDriver {
   // Initialize the display controller.
   virtual Status Init() = 0;
 
+  // Begin initializing the display controller without waiting out the delays
+  // of its power-up sequence, so that other startup work can be done in the
+  // meantime. PollInit() must then be called until it no longer returns
+  // Unavailable before anything is written to the display. The default
+  // implementation calls Init().
+  virtual Status StartInit() { return Init(); }
+
+  // Continue the initialization begun by StartInit() without blocking.
+  // Returns Unavailable while it is in progress, otherwise its result.
+  virtual Status PollInit() { return OkStatus(); }
+
   // Send all pixels in the supplied |framebuffer| to the display controller
   // for display.
   virtual void WriteFramebuffer(pw::framebuffer::Framebuffer framebuffer,
                                 WriteCallback write_callback) = 0;
 
+  // Send the pixels of |framebuffer| within |region| to the same location on
+  // the display, leaving the rest of the display unchanged. |region| is in
+  // display coordinates, and a framebuffer which only covers part of the
+  // display (such as a band of a banded display) is placed at its origin().
+  // Only used when SupportsRegionWrite() returns true. The default
+  // implementation sends the entire framebuffer.
+  virtual void WriteRegion(pw::framebuffer::Framebuffer framebuffer,
+                           const pw::math::Rect<uint16_t>& region,
+                           WriteCallback write_callback) {
+    static_cast<void>(region);
+    WriteFramebuffer(std::move(framebuffer), std::move(write_callback));
+  }
+
   // Send a row of pixels to the display. The number of pixels must be <=
   // display width.
   virtual Status WriteRow(span<uint16_t> row_pixels,
                           uint16_t row_idx,
                           uint16_t col_idx) = 0;
 
+  // Send the pixels of |rect|, in display coordinates, from |pixels|. Row r
+  // of |rect| starts at pixels[r * stride], so |pixels| holds at least
+  // (rect.height - 1) * stride + rect.width pixels, and |stride| is at least
+  // rect.width. Drivers which can set the controller's address window to
+  // |rect| do so once and then stream every row, rather than setting it for
+  // each row as WriteRow() does. Like WriteRow(), the pixels have been sent
+  // when it returns. The default implementation calls WriteRow() for each
+  // row.
+  virtual Status WriteRect(span<uint16_t> pixels,
+                           const pw::math::Rect<uint16_t>& rect,
+                           uint16_t stride) {
+    for (int row = 0; row < rect.height; row++) {
+      Status status = WriteRow(pixels.subspan(row * stride, rect.width),
+                               static_cast<uint16_t>(rect.y + row),
+                               rect.x);
+      if (!status.ok()) {
+        return status;
+      }
+    }
+    return OkStatus();
+  }
+
   virtual uint16_t GetWidth() const = 0;
 
   virtual uint16_t GetHeight() const = 0;
 
   // Display driver supports resizing during write.
   virtual bool SupportsResize() const { return false; }
+
+  // Display driver supports writing a region of the framebuffer with
+  // WriteRegion().
+  virtual bool SupportsRegionWrite() const { return false; }
 };
 
 }  // namespace pw::display_driver
@@ -0,0 +1,140 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_bytes/span.h"
+#include "pw_containers/vector.h"
+#include "pw_digital_io/digital_io.h"
+#include "pw_spi/chip_selector.h"
+#include "pw_spi/device.h"
+#include "pw_spi/initiator.h"
+#include "pw_status/status.h"
+#include "pw_sync/borrow.h"
+#include "pw_sync/mutex.h"
+
+namespace pw::display_driver {
+
+// A fake SPI bus, for host tests, which records everything written by a
+// display driver to its display controller.
+//
+// The bus provides the GPIO lines and the 8-bit and 16-bit SPI devices used
+// to configure the SPI display drivers. Each write is recorded along with
+// the state of the data/command GPIO and the word size of the device used.
+class FakeSpiBus {
+ public:
+  static constexpr size_t kMaxWrites = 64;
+  static constexpr size_t kMaxSavedBytes = 4;
+
+  // A single write to the bus.
+  struct Write {
+    // True if the data/command GPIO was in command mode.
+    bool is_command;
+    // The word size of the SPI device used for the write.
+    uint8_t bits_per_word;
+    // The size of the write buffer. The display drivers write 16-bit data by
+    // passing the number of words (pixels), not bytes.
+    size_t size;
+    // The first (up to) kMaxSavedBytes bytes of the write.
+    std::array<std::byte, kMaxSavedBytes> data;
+  };
+
+  FakeSpiBus();
+
+  pw::digital_io::DigitalOut& data_cmd_gpio() { return data_cmd_gpio_; }
+  pw::digital_io::DigitalOut& chip_select_gpio() { return chip_select_gpio_; }
+  pw::spi::Device& device_8_bit() { return device_8_bit_; }
+  pw::spi::Device& device_16_bit() { return device_16_bit_; }
+
+  // All writes since construction or the last call to Clear(). Writes beyond
+  // kMaxWrites are dropped.
+  const pw::Vector<Write, kMaxWrites>& writes() const { return writes_; }
+
+  // The number of commands, and of data bytes (two for each word of a 16-bit
+  // write), written since construction or the last call to Clear(). Unlike
+  // writes(), these count every write.
+  size_t num_commands() const { return num_commands_; }
+  size_t num_data_bytes() const { return num_data_bytes_; }
+
+  // Fail every write after the next |num_writes| with INTERNAL, until
+  // Clear() is called. Failed writes are not recorded.
+  void FailAfterWrites(size_t num_writes) {
+    writes_until_failure_ = num_writes;
+  }
+
+  void Clear() {
+    writes_.clear();
+    num_commands_ = 0;
+    num_data_bytes_ = 0;
+    writes_until_failure_ = SIZE_MAX;
+  }
+
+ private:
+  class Gpio : public pw::digital_io::DigitalOut {
+   public:
+    pw::digital_io::State state() const { return state_; }
+
+   private:
+    Status DoEnable(bool) override { return OkStatus(); }
+    Status DoSetState(pw::digital_io::State level) override {
+      state_ = level;
+      return OkStatus();
+    }
+
+    pw::digital_io::State state_ = pw::digital_io::State::kInactive;
+  };
+
+  class Initiator : public pw::spi::Initiator {
+   public:
+    Initiator(FakeSpiBus& bus, uint8_t bits_per_word)
+        : bus_(bus), bits_per_word_(bits_per_word) {}
+
+    // pw::spi::Initiator implementation:
+    Status Configure(const pw::spi::Config&) override { return OkStatus(); }
+    Status WriteRead(ConstByteSpan write_buffer, ByteSpan) override {
+      return bus_.Record(bits_per_word_, write_buffer);
+    }
+
+   private:
+    FakeSpiBus& bus_;
+    const uint8_t bits_per_word_;
+  };
+
+  class ChipSelector : public pw::spi::ChipSelector {
+   public:
+    Status SetActive(bool) override { return OkStatus(); }
+  };
+
+  Status Record(uint8_t bits_per_word, ConstByteSpan write_buffer);
+
+  Gpio data_cmd_gpio_;
+  Gpio chip_select_gpio_;
+  Initiator initiator_8_bit_;
+  Initiator initiator_16_bit_;
+  ChipSelector chip_selector_;
+  pw::sync::VirtualMutex initiator_mutex_;
+  pw::sync::Borrowable<pw::spi::Initiator> borrowable_initiator_8_bit_;
+  pw::sync::Borrowable<pw::spi::Initiator> borrowable_initiator_16_bit_;
+  pw::spi::Device device_8_bit_;
+  pw::spi::Device device_16_bit_;
+  pw::Vector<Write, kMaxWrites> writes_;
+  size_t num_commands_ = 0;
+  size_t num_data_bytes_ = 0;
+  size_t writes_until_failure_ = SIZE_MAX;
+};
+
+}  // namespace pw::display_driver
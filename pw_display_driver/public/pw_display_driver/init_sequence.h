@@ -0,0 +1,173 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+#include "pw_assert/assert.h"
+#include "pw_digital_io/digital_io.h"
+#include "pw_span/span.h"
+#include "pw_spi/device.h"
+#include "pw_status/status.h"
+
+namespace pw::display_driver {
+
+// Display controller initialization sequences are byte-code tables of
+// commands, each encoded as:
+//
+//   <command> <count> <count argument bytes> [<delay>]
+//
+// When the kInitDelay bit of <count> is set the arguments are followed by a
+// delay, in milliseconds, to wait after sending the command. A delay of
+// kInitDelayLong waits for kInitDelayLongMillis instead. The table ends after
+// its last command, and tables defined as constants are checked with
+// IsValidInitSequence() in a static_assert:
+//
+//   constexpr uint8_t kInitSequence[] = {
+//       CMD_SWRESET,   kInitDelay, 150,
+//       CMD_COLMOD,    1, 0x55,
+//       CMD_SLEEP_OUT, kInitDelay, 200,
+//       CMD_DISPLAY_ON, 0,
+//   };
+//   static_assert(IsValidInitSequence(kInitSequence));
+inline constexpr uint8_t kInitDelay = 0x80;
+inline constexpr uint8_t kInitDelayLong = 0xff;
+inline constexpr uint32_t kInitDelayLongMillis = 500;
+
+// Return the number of milliseconds to wait for an encoded |delay|.
+constexpr uint32_t InitDelayMillis(uint8_t delay) {
+  return delay == kInitDelayLong ? kInitDelayLongMillis : delay;
+}
+
+// Return true if |sequence| is a well formed init sequence, with every
+// command's arguments and delay within the table.
+constexpr bool IsValidInitSequence(span<const uint8_t> sequence) {
+  size_t i = 0;
+  while (i < sequence.size()) {
+    if (sequence.size() - i < 2) {
+      return false;
+    }
+    const uint8_t count = sequence[i + 1];
+    const size_t num_args = count & ~kInitDelay;
+    const size_t delay_size = (count & kInitDelay) ? 1 : 0;
+    i += 2;
+    if (sequence.size() - i < num_args + delay_size) {
+      return false;
+    }
+    i += num_args + delay_size;
+  }
+  return true;
+}
+
+// An init sequence built at run time, for the commands whose arguments
+// depend on the driver configuration (such as the screen size).
+template <size_t kCapacity>
+class InitSequenceBuffer {
+ public:
+  // Append |command| with |args|, followed by a delay of |delay_ms|
+  // milliseconds when it is non-zero.
+  constexpr void Add(uint8_t command,
+                     std::initializer_list<uint8_t> args,
+                     uint8_t delay_ms = 0) {
+    const size_t delay_size = delay_ms ? 1 : 0;
+    PW_ASSERT(args.size() < kInitDelay);
+    PW_ASSERT(size_ + 2 + args.size() + delay_size <= kCapacity);
+    data_[size_++] = command;
+    data_[size_++] =
+        static_cast<uint8_t>(args.size()) | (delay_ms ? kInitDelay : 0);
+    for (uint8_t arg : args) {
+      data_[size_++] = arg;
+    }
+    if (delay_ms) {
+      data_[size_++] = delay_ms;
+    }
+  }
+
+  constexpr void Clear() { size_ = 0; }
+
+  constexpr span<const uint8_t> sequence() const {
+    return span<const uint8_t>(data_.data(), size_);
+  }
+
+ private:
+  std::array<uint8_t, kCapacity> data_{};
+  size_t size_ = 0;
+};
+
+// Sends init sequences to a display controller through its 8-bit SPI device
+// and data/command GPIO.
+//
+// The commands between two delays are sent in a single bus transaction, and
+// the data/command GPIO only changes state between a command and its
+// arguments. The arguments are written straight from the table. Rather than
+// spinning through each delay, Poll() returns Unavailable until it has
+// elapsed, so the caller is free to do other work in the meantime.
+class InitSequencer {
+ public:
+  // The maximum number of tables in a single sequence.
+  static constexpr size_t kMaxParts = 6;
+
+  // |behavior| is the chip select behavior of the transactions used to send
+  // the commands.
+  InitSequencer(pw::digital_io::DigitalOut& data_cmd_gpio,
+                pw::spi::Device& device,
+                pw::spi::ChipSelectBehavior behavior);
+
+  // Begin a sequence made of |parts|, sent one after another. The tables
+  // must remain valid until the sequence is done, and are not sent until
+  // Poll() or Finish() is called.
+  void Start(std::initializer_list<span<const uint8_t>> parts);
+
+  // Send the commands up to the next delay, unless waiting for the previous
+  // delay to elapse. Returns Unavailable while the sequence is in progress,
+  // OkStatus when it is done, or the error which ended it.
+  Status Poll();
+
+  // Send the remainder of the sequence, waiting out its delays.
+  Status Finish();
+
+  // True from Start() until the sequence is done.
+  bool busy() const { return waiting_ || part_idx_ < num_parts_; }
+
+ private:
+  // Move past any tables which have been completely sent.
+  void SkipSentParts();
+  // Send |command| and |args| as part of |transaction|.
+  Status WriteCommand(pw::spi::Device::Transaction& transaction,
+                      uint8_t command,
+                      span<const uint8_t> args);
+  // Set the data/command GPIO, unless already in that state.
+  void SetDataMode(bool data_mode);
+
+  pw::digital_io::DigitalOut& data_cmd_gpio_;
+  pw::spi::Device& device_;
+  const pw::spi::ChipSelectBehavior behavior_;
+  std::array<span<const uint8_t>, kMaxParts> parts_;
+  size_t num_parts_ = 0;
+  size_t part_idx_ = 0;
+  // Offset of the next command in parts_[part_idx_].
+  size_t offset_ = 0;
+  // The pw::spin_delay::Millis() time at which the pending delay elapses.
+  uint32_t deadline_ms_ = 0;
+  bool waiting_ = false;
+  // The last state set on the data/command GPIO in this transaction.
+  bool gpio_known_ = false;
+  bool data_mode_ = false;
+  Status status_;
+};
+
+}  // namespace pw::display_driver
@@ -0,0 +1,257 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "pw_assert/assert.h"
+#include "pw_bytes/span.h"
+#include "pw_digital_io/digital_io.h"
+#include "pw_display_driver/display_driver.h"
+#include "pw_display_driver/init_sequence.h"
+#include "pw_framebuffer/framebuffer.h"
+#include "pw_math/rect.h"
+#include "pw_math/size.h"
+#include "pw_pixel_pusher/pixel_pusher.h"
+#include "pw_span/span.h"
+#include "pw_spi/device.h"
+#include "pw_status/status.h"
+#include "pw_status/try.h"
+
+namespace pw::display_driver {
+
+// MIPI Display Command Set commands used by DisplayDriverMipiDcs.
+namespace mipi_dcs {
+
+inline constexpr uint8_t kSoftwareReset = 0x01;
+inline constexpr uint8_t kColumnAddressSet = 0x2A;
+inline constexpr uint8_t kRowAddressSet = 0x2B;
+inline constexpr uint8_t kMemoryWrite = 0x2C;
+
+}  // namespace mipi_dcs
+
+// The parts of DisplayDriverMipiDcs which do not depend on the panel: the
+// command writes, hardware reset, address window and region writes.
+class DisplayDriverMipiDcsBase : public DisplayDriver {
+ public:
+  // The controller connection, taken from the panel's configuration.
+  struct Bus {
+    // The GPIO line to use when specifying data/command mode for the display
+    // controller.
+    pw::digital_io::DigitalOut& data_cmd_gpio;
+    // Optional GPIO line to reset the display controller.
+    pw::digital_io::DigitalOut* reset_gpio;
+    // The SPI device used for commands and their arguments.
+    pw::spi::Device& spi_device_8_bit;
+    // The SPI device used for pixel data.
+    pw::spi::Device& spi_device_16_bit;
+    // Optional pixel pusher which writes entire framebuffers.
+    pw::pixel_pusher::PixelPusher* pixel_pusher;
+  };
+
+  // DisplayDriver implementation:
+  Status Init() override;
+  Status PollInit() override;
+  void WriteRegion(pw::framebuffer::Framebuffer framebuffer,
+                   const pw::math::Rect<uint16_t>& region,
+                   WriteCallback write_callback) override;
+  Status WriteRow(span<uint16_t> row_pixels,
+                  uint16_t row_idx,
+                  uint16_t col_idx) override;
+  uint16_t GetWidth() const override { return screen_size_.width; }
+  uint16_t GetHeight() const override { return screen_size_.height; }
+  bool SupportsResize() const override;
+  bool SupportsRegionWrite() const override;
+
+ protected:
+  // |offset| is the position of the panel's first pixel in the controller's
+  // memory, and |init_chip_select| the chip select behavior used to send the
+  // init sequence.
+  DisplayDriverMipiDcsBase(const Bus& bus,
+                           pw::math::Size<uint16_t> screen_size,
+                           pw::math::Size<uint16_t> offset,
+                           pw::spi::ChipSelectBehavior init_chip_select);
+
+  // Reset the controller, if there is a reset GPIO, and build the init
+  // sequence which sets the address window to the entire screen.
+  Status BeginInit();
+  span<const uint8_t> window_init_sequence() const {
+    return window_init_sequence_.sequence();
+  }
+  // Send the init sequence up to its first delay.
+  Status SendInitStart();
+
+  // Set the address window to |window|, in display coordinates, and start a
+  // memory write.
+  Status SetAddressWindow(const pw::math::Rect<uint16_t>& window);
+  // Start a memory write of the entire screen.
+  Status StartScreenWrite();
+
+  // Return |rect| clipped to the screen.
+  pw::math::Rect<uint16_t> ClipToScreen(
+      const pw::math::Rect<uint16_t>& rect) const {
+    return rect.Intersect({0, 0, screen_size_.width, screen_size_.height});
+  }
+
+  const Bus bus_;
+  InitSequencer init_sequencer_;
+
+ private:
+  // Toggle the reset GPIO line to reset the display controller.
+  Status Reset();
+  // Write |command| and its |args| to the display controller.
+  Status WriteCommand(pw::spi::Device::Transaction& transaction,
+                      uint8_t command,
+                      ConstByteSpan args);
+
+  const pw::math::Size<uint16_t> screen_size_;
+  const pw::math::Size<uint16_t> offset_;
+  // The address window set during initialization.
+  InitSequenceBuffer<12> window_init_sequence_;
+  // True when the address window may not cover the entire display.
+  bool partial_window_ = false;
+};
+
+// A display driver for SPI display controllers which implement the MIPI
+// Display Command Set, for the panel described by |Panel|:
+//
+//   struct Panel {
+//     // The driver configuration. It has the members of
+//     // DisplayDriverMipiDcsBase::Bus, along with any panel settings.
+//     struct Config;
+//     // The position of the panel in the controller's memory.
+//     static constexpr uint16_t kColumnOffset;
+//     static constexpr uint16_t kRowOffset;
+//     // The maximum number of rows of pixels sent in a single SPI write, or
+//     // zero for no limit.
+//     static constexpr int kMaxRowsPerWrite;
+//     // The chip select behavior used to send the init sequence.
+//     static constexpr pw::spi::ChipSelectBehavior kInitChipSelect;
+//     // The size of the screen in the address window set by the init
+//     // sequence.
+//     static pw::math::Size<uint16_t> ScreenSize(const Config& config);
+//     // Start |sequencer| on the init sequence, which includes
+//     // |window_sequence| to set the address window to the entire screen.
+//     static void StartInit(const Config& config,
+//                           span<const uint8_t> window_sequence,
+//                           InitSequencer& sequencer);
+//   };
+//
+// Pixels are written through the 16-bit SPI device, which sends each RGB565
+// pixel most significant byte first whatever the byte order of the CPU.
+// Unless a pixel pusher is configured, WriteFramebuffer() reports OutOfRange
+// for a framebuffer which is not the size of the screen.
+template <typename PanelDescriptor>
+class DisplayDriverMipiDcs : public DisplayDriverMipiDcsBase {
+ public:
+  using Panel = PanelDescriptor;
+  using Config = typename Panel::Config;
+
+  DisplayDriverMipiDcs(const Config& config)
+      : DisplayDriverMipiDcsBase(
+            {
+                .data_cmd_gpio = config.data_cmd_gpio,
+                .reset_gpio = config.reset_gpio,
+                .spi_device_8_bit = config.spi_device_8_bit,
+                .spi_device_16_bit = config.spi_device_16_bit,
+                .pixel_pusher = config.pixel_pusher,
+            },
+            Panel::ScreenSize(config),
+            {Panel::kColumnOffset, Panel::kRowOffset},
+            Panel::kInitChipSelect),
+        config_(config) {}
+
+  // DisplayDriver implementation:
+  Status StartInit() override {
+    PW_TRY(BeginInit());
+    Panel::StartInit(config_, window_init_sequence(), init_sequencer_);
+    return SendInitStart();
+  }
+
+  void WriteFramebuffer(pw::framebuffer::Framebuffer framebuffer,
+                        WriteCallback write_callback) override {
+    PW_ASSERT(framebuffer.is_valid());
+    PW_ASSERT(framebuffer.pixel_format() ==
+              pw::framebuffer::PixelFormat::RGB565);
+    if (bus_.pixel_pusher) {
+      bus_.pixel_pusher->WriteFramebuffer(std::move(framebuffer),
+                                          std::move(write_callback));
+      return;
+    }
+    if (framebuffer.size() !=
+        pw::math::Size<uint16_t>{GetWidth(), GetHeight()}) {
+      write_callback(std::move(framebuffer), Status::OutOfRange());
+      return;
+    }
+    Status s = StartScreenWrite();
+    if (s.ok()) {
+      s = WritePixels(static_cast<const uint16_t*>(framebuffer.data()),
+                      GetWidth(),
+                      GetHeight(),
+                      framebuffer.row_bytes() / sizeof(uint16_t));
+    }
+    write_callback(std::move(framebuffer), s);
+  }
+
+  Status WriteRect(span<uint16_t> pixels,
+                   const pw::math::Rect<uint16_t>& rect,
+                   uint16_t stride) override {
+    PW_ASSERT(stride >= rect.width);
+    const pw::math::Rect<uint16_t> window = ClipToScreen(rect);
+    if (window.IsEmpty()) {
+      return OkStatus();
+    }
+    PW_ASSERT(pixels.size() >=
+              static_cast<size_t>((rect.height - 1) * stride + rect.width));
+    PW_TRY(SetAddressWindow(window));
+    return WritePixels(
+        &pixels[(window.y - rect.y) * stride + (window.x - rect.x)],
+        window.width,
+        window.height,
+        stride);
+  }
+
+ private:
+  // Write |height| rows of |width| pixels, |stride| pixels apart, to the
+  // current address window. Rows which are contiguous are sent in a single
+  // write, up to Panel::kMaxRowsPerWrite rows at a time.
+  Status WritePixels(const uint16_t* pixels,
+                     uint16_t width,
+                     uint16_t height,
+                     uint16_t stride) {
+    int rows_per_write = stride == width ? height : 1;
+    if constexpr (Panel::kMaxRowsPerWrite > 0) {
+      rows_per_write = std::min(rows_per_write, Panel::kMaxRowsPerWrite);
+    }
+    auto transaction = bus_.spi_device_16_bit.StartTransaction(
+        pw::spi::ChipSelectBehavior::kPerTransaction);
+    Status s;
+    for (int row = 0; row < height && s.ok(); row += rows_per_write) {
+      const int num_rows = std::min(rows_per_write, height - row);
+      // The SPI device is in 16-bit mode, so the write length is in pixels.
+      s = transaction.Write(
+          ConstByteSpan(reinterpret_cast<const std::byte*>(pixels),
+                        width * num_rows));
+      pixels += stride * num_rows;
+    }
+    return s;
+  }
+
+  const Config config_;
+};
+
+}  // namespace pw::display_driver
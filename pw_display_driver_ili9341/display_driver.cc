@@ -14,24 +14,10 @@
 
 #include "pw_display_driver_ili9341/display_driver.h"
 
-#include <algorithm>
-
-#include "pw_digital_io/digital_io.h"
-#include "pw_framebuffer/framebuffer.h"
-#include "pw_spin_delay/delay.h"
-
-using pw::digital_io::State;
-using pw::framebuffer::Framebuffer;
-using pw::framebuffer::PixelFormat;
-using pw::spi::ChipSelectBehavior;
-using pw::spi::Device;
-
 namespace pw::display_driver {
 
 namespace {
 
-constexpr std::array<std::byte, 0> kEmptyByteArray = {};
-
 // clang-format off
 // Level 1 commands:
 constexpr uint8_t CMD_SWRESET            = 0x01;   // Software Reset.
@@ -123,11 +109,6 @@ constexpr uint8_t CMD_3GAMMA_EN          = 0xF2;   // Enable 3G.
 constexpr uint8_t CMD_PRC                = 0xF7;   // Pump ratio control .
 // clang-format on
 
-// The ILI9341 is hard-coded at 320x240;
-constexpr int kDisplayWidth = 320;
-constexpr int kDisplayHeight = 240;
-constexpr int kDisplayNumPixels = kDisplayWidth * kDisplayHeight;
-
 // clang-format off
 constexpr std::byte MADCTL_MY  = std::byte{0b10000000}; // Row address order.
 constexpr std::byte MADCTL_MX  = std::byte{0b01000000}; // Column address order.
@@ -137,7 +118,7 @@ constexpr std::byte MADCTL_BGR = std::byte{0b00001000}; // BGR/RGB order.
 constexpr std::byte MADCTL_MH  = std::byte{0b00000100}; // Horizontal refresh order.
 
 // Take value specified in target.
-constexpr std::byte kMADMode = std::byte{ILI9341_MADCTL};
+constexpr uint8_t kMADMode = ILI9341_MADCTL;
 
 constexpr uint8_t kDTC_PTG_MASK          = 0b00001100;
 constexpr uint8_t kDTC_PTG_NORMAL_SCAN   = 0b00000000;
@@ -161,370 +142,104 @@ constexpr uint8_t kRGBWithDE = 0xC2;
 constexpr uint8_t kRGBWithoutDE = 0xE2;
 
 // Frame Control (Normal Mode)
-constexpr std::byte kFrameRate61 = std::byte{0x1F};
-constexpr std::byte kFrameRate70 = std::byte{0x1B};
-constexpr std::byte kFrameRate79 = std::byte{0x18};
-constexpr std::byte kFrameRate119 = std::byte{0x10};
+constexpr uint8_t kFrameRate61 = 0x1F;
+constexpr uint8_t kFrameRate70 = 0x1B;
+constexpr uint8_t kFrameRate79 = 0x18;
+constexpr uint8_t kFrameRate119 = 0x10;
 
-constexpr std::byte kPixelFormat16bits = std::byte(0x55);
-constexpr std::byte kPixelFormat18bits = std::byte(0x36);
+constexpr uint8_t kPixelFormat16bits = 0x55;
+constexpr uint8_t kPixelFormat18bits = 0x36;
 
-constexpr uint8_t HighByte(uint16_t val) { return val >> 8; }
+// The initialization sequence is sent in parts, as some of its commands
+// depend on the configuration.
+// clang-format off
+constexpr uint8_t kInitStartSequence[] = {
+    0xEF,             3, 0x03, 0x80, 0x02,  // ?
+    CMD_POWERB,       3, 0x00, 0xC1, 0x30,
+    CMD_POWER_SEQ,    4, 0x64, 0x03, 0x12, 0x81,
+    CMD_DTCA,         3, 0x85, 0x00, 0x78,
+    CMD_POWERA,       5, 0x39, 0x2C, 0x00, 0x34, 0x02,
+    CMD_PRC,          1, 0x20,
+    CMD_DTCB,         2, 0x00, 0x00,
+    // Division ratio = fosc.
+    CMD_FRMCTR1,      2, 0x00, kFrameRate70,
+    CMD_DFC,          2, 0x0A, 0xA2,
+    // Power control. GVDD = 0x10 = 3.65V.
+    CMD_POWER1,       1, 0x10,
+    CMD_POWER2,       1, 0x10,
+    // VCM control.
+    CMD_VCOM1,        2, 0x3e, 0x28,
+    CMD_VCOM2,        1, 0x86,
+    CMD_MADCTL,       1, kMADMode,
+    CMD_PIXEL_FORMAT, 1, kPixelFormat16bits,
+    // Gamma Function Disable?
+    CMD_3GAMMA_EN,    1, 0x00,
+};
+
+constexpr uint8_t kRGBWithDESequence[] = {
+    CMD_RGB_INTERFACE, 1, kRGBWithDE,
+};
+
+constexpr uint8_t kRGBWithoutDESequence[] = {
+    CMD_RGB_INTERFACE, 1, kRGBWithoutDE,
+};
+
+constexpr uint8_t kDisplayFunctionSequence[] = {
+    CMD_DFC, 4, 0x0A, 0xA7, 0x27, 0x04,
+};
+
+constexpr uint8_t kInterfaceControlSequence[] = {
+    CMD_INTERFACE, 3, 0x00, 0x01, 0x06,
+};
+
+constexpr uint8_t kInitEndSequence[] = {
+    CMD_GRAM,           kInitDelay, 200,
+    CMD_GAMMA,          1, 0x01,
+    CMD_PGAMMA,         15, 0x0F, 0x31, 0x2B, 0x0C, 0x0E, 0x08, 0x4E, 0xF1,
+                            0x37, 0x07, 0x10, 0x03, 0x0E, 0x09, 0x00,
+    CMD_NGAMMA,         15, 0x00, 0x0E, 0x14, 0x03, 0x11, 0x07, 0x31, 0xC1,
+                            0x48, 0x08, 0x0F, 0x0C, 0x31, 0x36, 0x0F,
+    CMD_SLEEP_OUT,      kInitDelay, 200,
+    CMD_DISPLAY_ON,     0,
+    CMD_NORMAL_MODE_ON, 0,
+    CMD_GRAM,           0,
+};
+// clang-format on
 
-constexpr uint8_t LowByte(uint16_t val) { return val & 0xff; }
+static_assert(IsValidInitSequence(kInitStartSequence));
+static_assert(IsValidInitSequence(kRGBWithDESequence));
+static_assert(IsValidInitSequence(kRGBWithoutDESequence));
+static_assert(IsValidInitSequence(kDisplayFunctionSequence));
+static_assert(IsValidInitSequence(kInterfaceControlSequence));
+static_assert(IsValidInitSequence(kInitEndSequence));
 
 }  // namespace
 
-DisplayDriverILI9341::DisplayDriverILI9341(const Config& config)
-    : config_(config) {}
-
-void DisplayDriverILI9341::SetMode(Mode mode) {
-  // Set the D/CX pin to indicate data or command values.
-  if (mode == Mode::kData) {
-    config_.data_cmd_gpio.SetState(State::kActive);
-  } else {
-    config_.data_cmd_gpio.SetState(State::kInactive);
-  }
-}
-
-Status DisplayDriverILI9341::WriteCommand(Device::Transaction& transaction,
-                                          const Command& command) {
-  SetMode(Mode::kCommand);
-  std::byte buff[1]{static_cast<std::byte>(command.command)};
-  auto s = transaction.Write(buff);
-  if (!s.ok())
-    return s;
-
-  SetMode(Mode::kData);
-  if (command.command_data.empty())
-    return OkStatus();
-  return transaction.Write(command.command_data);
-}
-
-Status DisplayDriverILI9341::Init() {
-  Reset().IgnoreError();
-
-  // TODO(cmumford): Figure out why kPerTransaction is flakey for this.
-  // Seems to be OK on the Pico's display, but not the STM32F429I-DISC1.
-  auto transaction = config_.spi_device_8_bit.StartTransaction(
-      ChipSelectBehavior::kPerWriteRead);
-
-  // ?
-  WriteCommand(transaction,
-               {0xEF,
-                std::array<std::byte, 3>{
-                    std::byte{0x03},
-                    std::byte{0x80},
-                    std::byte{0x02},
-                }});
-
-  WriteCommand(transaction,
-               {CMD_POWERB,
-                std::array<std::byte, 3>{
-                    std::byte{0x00},
-                    std::byte{0xC1},
-                    std::byte{0x30},
-                }});
-
-  WriteCommand(transaction,
-               {CMD_POWER_SEQ,
-                std::array<std::byte, 4>{
-                    std::byte{0x64},
-                    std::byte{0x03},
-                    std::byte{0x12},
-                    std::byte{0x81},
-                }});
-
-  WriteCommand(transaction,
-               {CMD_DTCA,
-                std::array<std::byte, 3>{
-                    std::byte{0x85},
-                    std::byte{0x00},
-                    std::byte{0x78},
-                }});
-
-  WriteCommand(transaction,
-               {CMD_POWERA,
-                std::array<std::byte, 5>{
-                    std::byte{0x39},
-                    std::byte{0x2C},
-                    std::byte{0x00},
-                    std::byte{0x34},
-                    std::byte{0x02},
-                }});
-
-  WriteCommand(transaction,
-               {CMD_PRC, std::array<std::byte, 1>{std::byte{0x20}}});
-
-  WriteCommand(transaction,
-               {CMD_DTCB,
-                std::array<std::byte, 2>{
-                    std::byte{0x00},
-                    std::byte{0x00},
-                }});
-
-  WriteCommand(transaction,
-               {CMD_FRMCTR1,
-                std::array<std::byte, 2>{
-                    std::byte{0x00},  // division ratio = fosc.
-                    kFrameRate70,
-                }});
-
-  // Display Function Control
-  WriteCommand(transaction,
-               {CMD_DFC,
-                std::array<std::byte, 2>{
-                    std::byte{0x0A},
-                    std::byte{0xA2},
-                }});
-
-  // Power control. GVDD = 0x10 = 3.65V.
-  WriteCommand(transaction,
-               {CMD_POWER1, std::array<std::byte, 1>{std::byte{0x10}}});
-
-  // Power control
-  WriteCommand(transaction,
-               {CMD_POWER2, std::array<std::byte, 1>{std::byte{0x10}}});
-
-  // VCM control
-  WriteCommand(transaction,
-               {CMD_VCOM1,
-                std::array<std::byte, 2>{
-                    std::byte{0x3e},
-                    std::byte{0x28},
-                }});
-
-  // VCM control
-  WriteCommand(transaction,
-               {CMD_VCOM2, std::array<std::byte, 1>{std::byte{0x86}}});
-
-  // Memory Access Control.
-  WriteCommand(transaction, {CMD_MADCTL, std::array<std::byte, 1>{kMADMode}});
-
-  WriteCommand(
-      transaction,
-      {CMD_PIXEL_FORMAT, std::array<std::byte, 1>{kPixelFormat16bits}});
-
-  // Gamma Function Disable?
-  WriteCommand(transaction,
-               {CMD_3GAMMA_EN, std::array<std::byte, 1>{std::byte{0x00}}});
-
-  switch (config_.interface) {
+void ILI9341Panel::StartInit(const Config& config,
+                             span<const uint8_t> window_sequence,
+                             InitSequencer& sequencer) {
+  span<const uint8_t> rgb_interface;
+  switch (config.interface) {
     case InterfaceType::SPI:
       break;
     case InterfaceType::WithDE:
-      WriteCommand(
-          transaction,
-          {CMD_RGB_INTERFACE, std::array<std::byte, 1>{std::byte{kRGBWithDE}}});
+      rgb_interface = kRGBWithDESequence;
       break;
     case InterfaceType::WithoutDE:
-      WriteCommand(transaction,
-                   {CMD_RGB_INTERFACE,
-                    std::array<std::byte, 1>{std::byte{kRGBWithoutDE}}});
+      rgb_interface = kRGBWithoutDESequence;
       break;
   }
 
-  // Display Function Control
-  WriteCommand(transaction,
-               {CMD_DFC,
-                std::array<std::byte, 4>{
-                    std::byte{0x0A},
-                    std::byte{0xA7},
-                    std::byte{0x27},
-                    std::byte{0x04},
-                }});
-
-  // Max pixel coordinates in portrait mode.
-  constexpr uint16_t kMinX = 0;
-  constexpr uint16_t kMaxX = 240 - 1;
-  constexpr uint16_t kMinY = 0;
-  constexpr uint16_t kMaxY = 320 - 1;
-
-  // Landscape drawing Column Address Set
-  const uint16_t kMinColumn = config_.swap_row_col ? kMinX : kMinY;
-  const uint16_t kMaxColumn = config_.swap_row_col ? kMaxX : kMaxY;
-  WriteCommand(transaction,
-               {CMD_COLUMN_ADDR,
-                std::array<std::byte, 4>{
-                    std::byte{HighByte(kMinColumn)},
-                    std::byte{LowByte(kMinColumn)},
-                    std::byte{HighByte(kMaxColumn)},
-                    std::byte{LowByte(kMaxColumn)},
-                }});
-
-  // Page Address Set
-  const uint16_t kMinRow = config_.swap_row_col ? kMinY : kMinX;
-  const uint16_t kMaxRow = config_.swap_row_col ? kMaxY : kMaxX;
-  WriteCommand(transaction,
-               {CMD_PAGE_ADDR,
-                std::array<std::byte, 4>{
-                    std::byte{HighByte(kMinRow)},
-                    std::byte{LowByte(kMinRow)},
-                    std::byte{HighByte(kMaxRow)},
-                    std::byte{LowByte(kMaxRow)},
-                }});
-
-  if (config_.interface != InterfaceType::SPI) {
-    WriteCommand(transaction,
-                 {CMD_INTERFACE,
-                  std::array<std::byte, 3>{
-                      std::byte{0x00},
-                      std::byte{0x01},
-                      std::byte{0x06},
-                  }});
-  }
-
-  WriteCommand(transaction, {CMD_GRAM, kEmptyByteArray});
-  pw::spin_delay::WaitMillis(200);
-
-  // Gamma Set
-  WriteCommand(transaction,
-               {CMD_GAMMA, std::array<std::byte, 1>{std::byte{0x01}}});
-
-  // Positive Gamma Correction
-  WriteCommand(transaction,
-               {CMD_PGAMMA,
-                std::array<std::byte, 15>{
-                    std::byte{0x0F},
-                    std::byte{0x31},
-                    std::byte{0x2B},
-                    std::byte{0x0C},
-                    std::byte{0x0E},
-                    std::byte{0x08},
-                    std::byte{0x4E},
-                    std::byte{0xF1},
-                    std::byte{0x37},
-                    std::byte{0x07},
-                    std::byte{0x10},
-                    std::byte{0x03},
-                    std::byte{0x0E},
-                    std::byte{0x09},
-                    std::byte{0x00},
-                }});
-
-  // Negative Gamma Correction
-  WriteCommand(transaction,
-               {CMD_NGAMMA,
-                std::array<std::byte, 15>{
-                    std::byte{0x00},
-                    std::byte{0x0E},
-                    std::byte{0x14},
-                    std::byte{0x03},
-                    std::byte{0x11},
-                    std::byte{0x07},
-                    std::byte{0x31},
-                    std::byte{0xC1},
-                    std::byte{0x48},
-                    std::byte{0x08},
-                    std::byte{0x0F},
-                    std::byte{0x0C},
-                    std::byte{0x31},
-                    std::byte{0x36},
-                    std::byte{0x0F},
-                }});
-
-  WriteCommand(transaction, {CMD_SLEEP_OUT, kEmptyByteArray});
-  pw::spin_delay::WaitMillis(200);
-
-  WriteCommand(transaction, {CMD_DISPLAY_ON, kEmptyByteArray});
-
-  WriteCommand(transaction, {CMD_NORMAL_MODE_ON, kEmptyByteArray});
-
-  WriteCommand(transaction, {CMD_GRAM, kEmptyByteArray});
-
-  return OkStatus();
-}
-
-void DisplayDriverILI9341::WriteFramebuffer(Framebuffer frame_buffer,
-                                            WriteCallback write_callback) {
-  PW_ASSERT(frame_buffer.is_valid());
-  PW_ASSERT(frame_buffer.pixel_format() == PixelFormat::RGB565);
-  if (config_.pixel_pusher) {
-    config_.pixel_pusher->WriteFramebuffer(std::move(frame_buffer),
-                                           std::move(write_callback));
-    return;
-  }
-  auto transaction = config_.spi_device_16_bit.StartTransaction(
-      ChipSelectBehavior::kPerTransaction);
-  const uint16_t* fb_data = static_cast<const uint16_t*>(frame_buffer.data());
-  Status s;
-  // TODO(cmumford): Figure out why the STM32F429I cannot send the entire
-  // framebuffer in a single write, but another display can.
-#if 1
-  constexpr int kNumRowsPerSend = 10;
-  static_assert(!(kDisplayHeight % kNumRowsPerSend),
-                "Cannot send fractional number of rows");
-  constexpr int kNumSends = kDisplayHeight / kNumRowsPerSend;
-  constexpr size_t kNumPixelsInSend = kDisplayWidth * kNumRowsPerSend;
-
-  for (int i = 0; i < kNumSends && s.ok(); i++) {
-    const uint8_t* data = reinterpret_cast<const uint8_t*>(
-        &fb_data[kDisplayWidth * (kNumRowsPerSend * i)]);
-    // At this point the SPI bus is in 16-bit mode, so we send the number
-    // of 16-bit values (i.e. pixels).
-    s = transaction.Write(ConstByteSpan(
-        reinterpret_cast<const std::byte*>(data), kNumPixelsInSend));
-  }
-#else
-  s = transaction.Write(ConstByteSpan(
-      reinterpret_cast<const std::byte*>(fb_data), kDisplayNumPixels));
-#endif
-  write_callback(std::move(frame_buffer), s);
-}
-
-Status DisplayDriverILI9341::WriteRow(span<uint16_t> row_pixels,
-                                      uint16_t row_idx,
-                                      uint16_t col_idx) {
-  {
-    // Let controller know a write is coming.
-    auto transaction = config_.spi_device_8_bit.StartTransaction(
-        ChipSelectBehavior::kPerWriteRead);
-    // Landscape drawing Column Address Set
-    const uint16_t max_col_idx = std::max(
-        kDisplayWidth - 1, col_idx + static_cast<int>(row_pixels.size()));
-    WriteCommand(transaction,
-                 {CMD_COLUMN_ADDR,
-                  std::array<std::byte, 4>{
-                      std::byte{HighByte(col_idx)},
-                      std::byte{LowByte(col_idx)},
-                      std::byte{HighByte(max_col_idx)},
-                      std::byte{LowByte(max_col_idx)},
-                  }});
-
-    // Page Address Set
-    uint16_t max_row_idx = row_idx;
-    WriteCommand(transaction,
-                 {CMD_PAGE_ADDR,
-                  std::array<std::byte, 4>{
-                      std::byte{HighByte(row_idx)},
-                      std::byte{LowByte(row_idx)},
-                      std::byte{HighByte(max_row_idx)},
-                      std::byte{LowByte(max_row_idx)},
-                  }});
-    PW_TRY(WriteCommand(transaction, {CMD_GRAM, kEmptyByteArray}));
-  }
-
-  auto transaction = config_.spi_device_16_bit.StartTransaction(
-      ChipSelectBehavior::kPerTransaction);
-  return transaction.Write(
-      ConstByteSpan(reinterpret_cast<const std::byte*>(row_pixels.data()),
-                    row_pixels.size()));
-}
-
-uint16_t DisplayDriverILI9341::GetWidth() const { return kDisplayWidth; }
-
-uint16_t DisplayDriverILI9341::GetHeight() const { return kDisplayHeight; }
-
-Status DisplayDriverILI9341::Reset() {
-  if (!config_.reset_gpio)
-    return Status::Unavailable();
-  auto s = config_.reset_gpio->SetStateActive();
-  if (!s.ok())
-    return s;
-  pw::spin_delay::WaitMillis(100);
-  s = config_.reset_gpio->SetStateInactive();
-  pw::spin_delay::WaitMillis(100);
-  return s;
+  sequencer.Start({
+      kInitStartSequence,
+      rgb_interface,
+      kDisplayFunctionSequence,
+      window_sequence,
+      config.interface != InterfaceType::SPI
+          ? span<const uint8_t>(kInterfaceControlSequence)
+          : span<const uint8_t>(),
+      kInitEndSequence,
+  });
 }
 
 }  // namespace pw::display_driver
@@ -13,18 +13,20 @@
 // the License.
 #pragma once
 
-#include <cstddef>
+#include <cstdint>
 
 #include "pw_digital_io/digital_io.h"
-#include "pw_display_driver/display_driver.h"
-#include "pw_framebuffer_pool/framebuffer_pool.h"
+#include "pw_display_driver/init_sequence.h"
+#include "pw_display_driver/mipi_dcs.h"
+#include "pw_math/size.h"
 #include "pw_pixel_pusher/pixel_pusher.h"
+#include "pw_span/span.h"
 #include "pw_spi/device.h"
 
 namespace pw::display_driver {
 
-class DisplayDriverILI9341 : public DisplayDriver {
- public:
+// The ILI9341 panel descriptor for DisplayDriverMipiDcs.
+struct ILI9341Panel {
   enum class InterfaceType {
     SPI,        // Use SPI instead of RGB interface.
     WithDE,     // With data enable.
@@ -50,41 +52,37 @@ class DisplayDriverILI9341 : public DisplayDriver {
     pw::pixel_pusher::PixelPusher* pixel_pusher = nullptr;
   };
 
-  DisplayDriverILI9341(const Config& config);
-
-  // DisplayDriver implementation:
-  Status Init() override;
-  void WriteFramebuffer(pw::framebuffer::Framebuffer framebuffer,
-                        WriteCallback write_callback) override;
-  Status WriteRow(span<uint16_t> row_pixels,
-                  uint16_t row_idx,
-                  uint16_t col_idx) override;
-  uint16_t GetWidth() const override;
-  uint16_t GetHeight() const override;
+  // The ILI9341 is hard-coded at 320x240.
+  static constexpr uint16_t kWidth = 320;
+  static constexpr uint16_t kHeight = 240;
 
- private:
-  enum class Mode {
-    kData,
-    kCommand,
-  };
+  static constexpr uint16_t kColumnOffset = 0;
+  static constexpr uint16_t kRowOffset = 0;
+  // TODO(cmumford): Figure out why the STM32F429I cannot send the entire
+  // framebuffer in a single write, but another display can.
+  static constexpr int kMaxRowsPerWrite = 10;
+  // TODO(cmumford): Figure out why kPerTransaction is flakey for this.
+  // Seems to be OK on the Pico's display, but not the STM32F429I-DISC1.
+  static constexpr pw::spi::ChipSelectBehavior kInitChipSelect =
+      pw::spi::ChipSelectBehavior::kPerWriteRead;
 
-  // A command and optional data to write to the ILI9341.
-  struct Command {
-    uint8_t command;
-    ConstByteSpan command_data;
-  };
+  static pw::math::Size<uint16_t> ScreenSize(const Config& config) {
+    if (config.swap_row_col) {
+      return {kHeight, kWidth};
+    }
+    return {kWidth, kHeight};
+  }
 
-  // Toggle the reset GPIO line to reset the display controller.
-  Status Reset();
+  static void StartInit(const Config& config,
+                        span<const uint8_t> window_sequence,
+                        InitSequencer& sequencer);
+};
 
-  // Set the command/data mode of the display controller.
-  void SetMode(Mode mode);
-  // Write the command to the display controller.
-  Status WriteCommand(pw::spi::Device::Transaction& transaction,
-                      const Command& command);
+class DisplayDriverILI9341 : public DisplayDriverMipiDcs<ILI9341Panel> {
+ public:
+  using InterfaceType = ILI9341Panel::InterfaceType;
 
-  Config config_;
-  size_t next_fb_idx_ = 0;
+  using DisplayDriverMipiDcs::DisplayDriverMipiDcs;
 };
 
 }  // namespace pw::display_driver
@@ -29,12 +29,15 @@
 #endif
 #include <GLFW/glfw3.h>  // Will pull in system OpenGL headers
 
-#include "pw_framebuffer/reader.h"
+#include "pw_framebuffer/pixel_format_traits.h"
+#include "pw_framebuffer/typed_reader.h"
 
 using pw::color::color_rgb565_t;
 using pw::framebuffer::Framebuffer;
-using pw::framebuffer::FramebufferReader;
 using pw::framebuffer::PixelFormat;
+using pw::framebuffer::Rgb565Traits;
+using pw::framebuffer::TypedFramebufferReader;
+using pw::math::Rect;
 
 namespace pw::display_driver {
 
@@ -101,6 +104,23 @@ void _SetTexturePixel(GLuint x, GLuint y, color_rgb565_t rgb565) {
   _SetTexturePixel(x, y, c.r, c.g, c.b, 255);
 }
 
+// Copy the pixels of the RGB565 |framebuffer| which are within |region| of
+// the display to the texture. |region| is in display coordinates.
+void CopyToTexture(const Framebuffer& framebuffer,
+                   const Rect<uint16_t>& region) {
+  const TypedFramebufferReader<Rgb565Traits> reader(framebuffer);
+  const Rect<uint16_t> window = region.Intersect(framebuffer.bounds());
+  const int origin_x = framebuffer.origin().x;
+  const int origin_y = framebuffer.origin().y;
+  for (int y = window.y; y < window.y + window.height; y++) {
+    for (int x = window.x; x < window.x + window.width; x++) {
+      if (auto c = reader.GetPixel(x - origin_x, y - origin_y); c.ok()) {
+        _SetTexturePixel(x, y, c.value());
+      }
+    }
+  }
+}
+
 void UpdateLcdTexture() {
   // Set current texture
   glBindTexture(GL_TEXTURE_2D, lcd_texture);
@@ -398,15 +418,21 @@ void DisplayDriverImgUI::WriteFramebuffer(Framebuffer framebuffer,
   PW_ASSERT(framebuffer.pixel_format() == PixelFormat::RGB565);
   RecreateLcdTexture();
 
-  FramebufferReader reader(framebuffer);
   // Copy frame_buffer into lcd_pixel_data
-  for (GLuint x = 0; x < kDisplayWidth; x++) {
-    for (GLuint y = 0; y < kDisplayHeight; y++) {
-      if (auto c = reader.GetPixel(x, y); c.ok()) {
-        _SetTexturePixel(x, y, c.value());
-      }
-    }
-  }
+  CopyToTexture(framebuffer, {0, 0, kDisplayWidth, kDisplayHeight});
+
+  Render();
+  write_callback(std::move(framebuffer), OkStatus());
+}
+
+void DisplayDriverImgUI::WriteRegion(Framebuffer framebuffer,
+                                     const Rect<uint16_t>& region,
+                                     WriteCallback write_callback) {
+  PW_ASSERT(framebuffer.is_valid());
+  PW_ASSERT(framebuffer.pixel_format() == PixelFormat::RGB565);
+  RecreateLcdTexture();
+
+  CopyToTexture(framebuffer, region);
 
   Render();
   write_callback(std::move(framebuffer), OkStatus());
@@ -426,6 +452,26 @@ Status DisplayDriverImgUI::WriteRow(span<uint16_t> row_pixels,
   return OkStatus();
 }
 
+Status DisplayDriverImgUI::WriteRect(span<uint16_t> pixels,
+                                     const Rect<uint16_t>& rect,
+                                     uint16_t stride) {
+  RecreateLcdTexture();
+
+  const Rect<uint16_t> window =
+      rect.Intersect({0, 0, kDisplayWidth, kDisplayHeight});
+  for (int y = window.y; y < window.y + window.height; y++) {
+    const uint16_t* row = &pixels[(y - rect.y) * stride + window.x - rect.x];
+    for (int i = 0; i < window.width; i++) {
+      _SetTexturePixel(window.x + i, y, row[i]);
+    }
+  }
+
+  // Render once for all of the rows, rather than for each row as WriteRow()
+  // does.
+  Render();
+  return OkStatus();
+}
+
 uint16_t DisplayDriverImgUI::GetWidth() const { return kDisplayWidth; }
 
 uint16_t DisplayDriverImgUI::GetHeight() const { return kDisplayHeight; }
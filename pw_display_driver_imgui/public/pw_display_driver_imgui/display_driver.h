@@ -38,11 +38,18 @@ class DisplayDriverImgUI : public DisplayDriver {
   Status Init() override;
   void WriteFramebuffer(pw::framebuffer::Framebuffer framebuffer,
                         WriteCallback write_callback) override;
+  void WriteRegion(pw::framebuffer::Framebuffer framebuffer,
+                   const pw::math::Rect<uint16_t>& region,
+                   WriteCallback write_callback) override;
   Status WriteRow(span<uint16_t> row_pixels,
                   uint16_t row_idx,
                   uint16_t col_idx) override;
+  Status WriteRect(span<uint16_t> pixels,
+                   const pw::math::Rect<uint16_t>& rect,
+                   uint16_t stride) override;
   uint16_t GetWidth() const override;
   uint16_t GetHeight() const override;
+  bool SupportsRegionWrite() const override { return true; }
 
  private:
   void RecreateLcdTexture();
@@ -34,6 +34,11 @@ class DisplayDriverNULL : public DisplayDriver {
   Status WriteRow(span<uint16_t>, uint16_t, uint16_t) override {
     return pw::OkStatus();
   }
+  Status WriteRect(span<uint16_t>,
+                   const pw::math::Rect<uint16_t>&,
+                   uint16_t) override {
+    return pw::OkStatus();
+  }
   uint16_t GetWidth() const override { return 0; };
   uint16_t GetHeight() const override { return 0; };
 };
@@ -14,27 +14,10 @@
 
 #include "pw_display_driver_st7735/display_driver.h"
 
-#include <array>
-#include <cstddef>
-
-#include "pw_digital_io/digital_io.h"
-#include "pw_framebuffer/framebuffer.h"
-#include "pw_spin_delay/delay.h"
-
-using pw::digital_io::State;
-using pw::framebuffer::Framebuffer;
-using pw::framebuffer::PixelFormat;
-using pw::spi::ChipSelectBehavior;
-using pw::spi::Device;
-using std::array;
-using std::byte;
-
 namespace pw::display_driver {
 
 namespace {
 
-constexpr array<byte, 0> kEmptyArray;
-
 // ST7735 Display Registers
 // clang-format off
 #define ST7735_SWRESET  0x01
@@ -97,256 +80,60 @@ constexpr array<byte, 0> kEmptyArray;
 
 // clang-format on
 
-constexpr uint8_t HighByte(uint16_t val) { return val >> 8; }
-
-constexpr uint8_t LowByte(uint16_t val) { return val & 0xff; }
-
-}  // namespace
-
-// The ST7735 supports a max display size of 162x132. This was developed with
-// a ST7735 development board with a 160x128 pixel screen - hence the row/col
-// start values. These should be parameterized.
-DisplayDriverST7735::DisplayDriverST7735(const Config& config)
-    : config_(config), row_start_(2), col_start_(1) {}
-
-void DisplayDriverST7735::SetMode(Mode mode) {
-  // Set the D/CX pin to indicate data or command values.
-  if (mode == Mode::kData) {
-    config_.data_cmd_gpio.SetState(State::kActive);
-  } else {
-    config_.data_cmd_gpio.SetState(State::kInactive);
-  }
-}
-
-Status DisplayDriverST7735::WriteCommand(Device::Transaction& transaction,
-                                         const Command& command) {
-  SetMode(Mode::kCommand);
-  byte buff[1]{static_cast<byte>(command.command)};
-  auto s = transaction.Write(buff);
-  if (!s.ok())
-    return s;
-
-  SetMode(Mode::kData);
-  if (command.command_data.empty()) {
-    return OkStatus();
-  }
-  return transaction.Write(command.command_data);
-}
-
-Status DisplayDriverST7735::Init() {
-  auto transaction = config_.spi_device_8_bit.StartTransaction(
-      ChipSelectBehavior::kPerWriteRead);
-
-  WriteCommand(transaction, {ST7735_SWRESET, kEmptyArray});  // Software reset
-  pw::spin_delay::WaitMillis(150);
-  WriteCommand(transaction, {ST7735_SLPOUT, kEmptyArray});
-  pw::spin_delay::WaitMillis(500);
-
-  WriteCommand(transaction,
-               {ST7735_FRMCTR1,
-                array<byte, 3>{
-                    byte{0x00},
-                    byte{0x06},
-                    byte{0x03},
-                }});
-  pw::spin_delay::WaitMillis(10);
-
-  WriteCommand(transaction,
-               {ST7735_DISSET5,
-                array<byte, 2>{
-                    byte{0x15},
-                    byte{0x02},
-                }});
-
-  constexpr uint8_t inversion_val =
-      ST7735_INVCTR_NLA | ST7735_INVCTR_NLB | ST7735_INVCTR_NLC;
+constexpr uint8_t kInversion =
+    ST7735_INVCTR_NLA | ST7735_INVCTR_NLB | ST7735_INVCTR_NLC;
 
-  WriteCommand(transaction,
-               {ST7735_INVCTR,
-                array<byte, 1>{
-                    byte{inversion_val},
-                }});
+constexpr bool kRotate180 = false;
+constexpr uint8_t kMADCTL =
+    (kRotate180 ? ST7735_MADCTL_ROW_ORDER : ST7735_MADCTL_COL_ORDER) |
+    ST7735_MADCTL_SWAP_XY | ST7735_MADCTL_SCAN_ORDER;
 
-  WriteCommand(transaction, {ST7735_TEON, kEmptyArray});
-  WriteCommand(transaction, {ST7735_COLMOD, array<byte, 1>{byte{0x05}}});
-  pw::spin_delay::WaitMillis(10);
-
-  WriteCommand(transaction,
-               {ST7735_PORCTRL,
-                array<byte, 5>{
-                    byte{0x0c},
-                    byte{0x0c},
-                    byte{0x00},
-                    byte{0x33},
-                    byte{0x33},
-                }});
-  WriteCommand(transaction,
-               {ST7735_PWCTR1,
-                array<byte, 2>{
-                    byte{0x02},  // GVDD = 4.7V.
-                    byte{0x70},  // 1.0uA.
-                }});
-  pw::spin_delay::WaitMillis(10);
-  WriteCommand(transaction,
-               {ST7735_PWCTR2,
-                array<byte, 1>{
-                    byte{0x05},
-                }});
-  WriteCommand(transaction,
-               {ST7735_PWCTR3,
-                array<byte, 2>{
-                    byte{0x01},
-                    byte{0x02},
-                }});
-  WriteCommand(transaction,
-               {ST7735_VMCTR1,
-                array<byte, 2>{
-                    byte{0x3c},
-                    byte{0x38},
-                }});
-  pw::spin_delay::WaitMillis(10);
-  WriteCommand(transaction,
-               {ST7735_PWCTR6,
-                array<byte, 2>{
-                    byte{0x11},
-                    byte{0x15},
-                }});
-
-  WriteCommand(transaction, {ST7735_VRHS, array<byte, 1>{byte{0x12}}});
-  WriteCommand(transaction, {ST7735_VDVS, array<byte, 1>{byte{0x20}}});
-  WriteCommand(transaction,
-               {ST7735_PWCTRL1,
-                array<byte, 2>{
-                    byte{0xa4},
-                    byte{0xa1},
-                }});
-  WriteCommand(transaction, {ST7735_FRCTRL2, array<byte, 1>{byte{0x0f}}});
-
-  WriteCommand(transaction, {ST7735_INVOFF, kEmptyArray});
-
-  WriteCommand(transaction,
-               {ST7735_GMCTRP1,
-                array<byte, 16>{
-                    byte{0x09},
-                    byte{0x16},
-                    byte{0x09},
-                    byte{0x20},
-                    byte{0x21},
-                    byte{0x1B},
-                    byte{0x13},
-                    byte{0x19},
-                    byte{0x17},
-                    byte{0x15},
-                    byte{0x1E},
-                    byte{0x2B},
-                    byte{0x04},
-                    byte{0x05},
-                    byte{0x02},
-                    byte{0x0E},
-                }});
-  WriteCommand(transaction,
-               {ST7735_GMCTRN1,
-                array<byte, 16>{
-                    byte{0x0B},
-                    byte{0x14},
-                    byte{0x08},
-                    byte{0x1E},
-                    byte{0x22},
-                    byte{0x1D},
-                    byte{0x18},
-                    byte{0x1E},
-                    byte{0x1B},
-                    byte{0x1A},
-                    byte{0x24},
-                    byte{0x2B},
-                    byte{0x06},
-                    byte{0x06},
-                    byte{0x02},
-                    byte{0x0F},
-                }});
-  pw::spin_delay::WaitMillis(10);
-
-  // Landscape drawing Column Address Set
-  const uint16_t max_column = config_.screen_width + col_start_ - 1;
-  WriteCommand(transaction,
-               {ST7735_CASET,
-                array<byte, 4>{
-                    byte{HighByte(col_start_)},
-                    byte{LowByte(col_start_)},
-                    byte{HighByte(max_column)},
-                    byte{LowByte(max_column)},
-                }});
-
-  // Page Address Set
-  const uint16_t max_row = config_.screen_height + row_start_ - 1;
-  WriteCommand(transaction,
-               {ST7735_RASET,
-                array<byte, 4>{
-                    byte{HighByte(row_start_)},
-                    byte{LowByte(row_start_)},
-                    byte{HighByte(max_row)},
-                    byte{LowByte(max_row)},
-                }});
-
-  constexpr bool rotate_180 = false;
-  uint8_t madctl = ST7735_MADCTL_COL_ORDER;
-  if (rotate_180)
-    madctl = ST7735_MADCTL_ROW_ORDER;
-  madctl |= ST7735_MADCTL_SWAP_XY | ST7735_MADCTL_SCAN_ORDER;
-  WriteCommand(transaction, {ST7735_MADCTL, array<byte, 1>{byte{madctl}}});
-
-  WriteCommand(transaction, {ST7735_NORON, kEmptyArray});
-  pw::spin_delay::WaitMillis(10);
-
-  WriteCommand(transaction, {ST7735_DISPON, kEmptyArray});
-  pw::spin_delay::WaitMillis(500);
-
-  return OkStatus();
-}
-
-void DisplayDriverST7735::WriteFramebuffer(Framebuffer framebuffer,
-                                           WriteCallback write_callback) {
-  PW_ASSERT(framebuffer.is_valid());
-  PW_ASSERT(framebuffer.pixel_format() == PixelFormat::RGB565);
-  Status s;
-  // Let controller know a write is coming.
-  {
-    auto transaction = config_.spi_device_8_bit.StartTransaction(
-        ChipSelectBehavior::kPerWriteRead);
-    s = WriteCommand(transaction, {ST7735_RAMWR, kEmptyArray});
-    if (!s.ok()) {
-      write_callback(std::move(framebuffer), s);
-      return;
-    }
-  }
+// The initialization commands before the address window, which depends on
+// the configuration, and those after it.
+// clang-format off
+constexpr uint8_t kInitStartSequence[] = {
+    ST7735_SWRESET, kInitDelay, 150,  // Software reset
+    ST7735_SLPOUT,  kInitDelay, kInitDelayLong,
+    ST7735_FRMCTR1, kInitDelay | 3, 0x00, 0x06, 0x03, 10,
+    ST7735_DISSET5, 2, 0x15, 0x02,
+    ST7735_INVCTR,  1, kInversion,
+    ST7735_TEON,    0,
+    ST7735_COLMOD,  kInitDelay | 1, 0x05, 10,
+    ST7735_PORCTRL, 5, 0x0c, 0x0c, 0x00, 0x33, 0x33,
+    // GVDD = 4.7V, 1.0uA.
+    ST7735_PWCTR1,  kInitDelay | 2, 0x02, 0x70, 10,
+    ST7735_PWCTR2,  1, 0x05,
+    ST7735_PWCTR3,  2, 0x01, 0x02,
+    ST7735_VMCTR1,  kInitDelay | 2, 0x3c, 0x38, 10,
+    ST7735_PWCTR6,  2, 0x11, 0x15,
+    ST7735_VRHS,    1, 0x12,
+    ST7735_VDVS,    1, 0x20,
+    ST7735_PWCTRL1, 2, 0xa4, 0xa1,
+    ST7735_FRCTRL2, 1, 0x0f,
+    ST7735_INVOFF,  0,
+    ST7735_GMCTRP1, 16, 0x09, 0x16, 0x09, 0x20, 0x21, 0x1B, 0x13, 0x19,
+                        0x17, 0x15, 0x1E, 0x2B, 0x04, 0x05, 0x02, 0x0E,
+    ST7735_GMCTRN1, kInitDelay | 16,
+                        0x0B, 0x14, 0x08, 0x1E, 0x22, 0x1D, 0x18, 0x1E,
+                        0x1B, 0x1A, 0x24, 0x2B, 0x06, 0x06, 0x02, 0x0F, 10,
+};
+
+constexpr uint8_t kInitEndSequence[] = {
+    ST7735_MADCTL,  1, kMADCTL,
+    ST7735_NORON,   kInitDelay, 10,
+    ST7735_DISPON,  kInitDelay, kInitDelayLong,
+};
+// clang-format on
 
-  // Write the pixel data.
-  auto transaction = config_.spi_device_16_bit.StartTransaction(
-      ChipSelectBehavior::kPerWriteRead);
-  const uint16_t* fb_data = static_cast<const uint16_t*>(framebuffer.data());
-  const size_t num_pixels = config_.screen_width * config_.screen_height;
-  s = transaction.Write(
-      ConstByteSpan(reinterpret_cast<const byte*>(fb_data), num_pixels));
-  write_callback(std::move(framebuffer), s);
-}
+static_assert(IsValidInitSequence(kInitStartSequence));
+static_assert(IsValidInitSequence(kInitEndSequence));
 
-Status DisplayDriverST7735::WriteRow(span<uint16_t> row_pixels,
-                                     uint16_t row_idx,
-                                     uint16_t col_idx) {
-  PW_ASSERT(false);
-  return Status::Unimplemented();
-}
+}  // namespace
 
-Status DisplayDriverST7735::Reset() {
-  if (!config_.reset_gpio)
-    return Status::Unavailable();
-  PW_TRY(config_.reset_gpio->SetStateInactive());
-  pw::spin_delay::WaitMillis(100);
-  PW_TRY(config_.reset_gpio->SetStateActive());
-  pw::spin_delay::WaitMillis(100);
-  PW_TRY(config_.reset_gpio->SetStateInactive());
-  pw::spin_delay::WaitMillis(100);
-  return OkStatus();
+void ST7735Panel::StartInit(const Config&,
+                            span<const uint8_t> window_sequence,
+                            InitSequencer& sequencer) {
+  sequencer.Start({kInitStartSequence, window_sequence, kInitEndSequence});
 }
 
 }  // namespace pw::display_driver
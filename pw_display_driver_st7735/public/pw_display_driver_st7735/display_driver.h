@@ -13,16 +13,20 @@
 // the License.
 #pragma once
 
-#include <cstddef>
+#include <cstdint>
 
 #include "pw_digital_io/digital_io.h"
-#include "pw_display_driver/display_driver.h"
+#include "pw_display_driver/init_sequence.h"
+#include "pw_display_driver/mipi_dcs.h"
+#include "pw_math/size.h"
+#include "pw_pixel_pusher/pixel_pusher.h"
+#include "pw_span/span.h"
 #include "pw_spi/device.h"
 
 namespace pw::display_driver {
 
-class DisplayDriverST7735 : public DisplayDriver {
- public:
+// The ST7735 panel descriptor for DisplayDriverMipiDcs.
+struct ST7735Panel {
   // DisplayDriverST7735 configuration parameters.
   struct Config {
     // The GPIO line to use when specifying data/command mode for the display
@@ -38,44 +42,31 @@ class DisplayDriverST7735 : public DisplayDriver {
     pw::spi::Device& spi_device_16_bit;
     uint16_t screen_width = 160;
     uint16_t screen_height = 128;
+    // The pixel pusher.
+    pw::pixel_pusher::PixelPusher* pixel_pusher = nullptr;
   };
 
-  // A command and optional data to write to the ST7735.
-  struct Command {
-    uint8_t command;
-    ConstByteSpan command_data;
-  };
-
-  DisplayDriverST7735(const Config& config);
-
-  // DisplayDriver implementation:
-  Status Init() override;
-  void WriteFramebuffer(pw::framebuffer::Framebuffer framebuffer,
-                        WriteCallback write_callback) override;
-  Status WriteRow(span<uint16_t> row_pixels,
-                  uint16_t row_idx,
-                  uint16_t col_idx) override;
-  uint16_t GetWidth() const override { return config_.screen_width; }
-  uint16_t GetHeight() const override { return config_.screen_height; }
+  // The ST7735 supports a max display size of 162x132. This was developed
+  // with a ST7735 development board with a 160x128 pixel screen - hence the
+  // row/col start values. These should be parameterized.
+  static constexpr uint16_t kColumnOffset = 1;
+  static constexpr uint16_t kRowOffset = 2;
+  static constexpr int kMaxRowsPerWrite = 0;
+  static constexpr pw::spi::ChipSelectBehavior kInitChipSelect =
+      pw::spi::ChipSelectBehavior::kPerTransaction;
 
- private:
-  enum class Mode {
-    kData,
-    kCommand,
-  };
-
-  // Toggle the reset GPIO line to reset the display controller.
-  Status Reset();
+  static pw::math::Size<uint16_t> ScreenSize(const Config& config) {
+    return {config.screen_width, config.screen_height};
+  }
 
-  // Set the command/data mode of the display controller.
-  void SetMode(Mode mode);
-  // Write the command to the display controller.
-  Status WriteCommand(pw::spi::Device::Transaction& transaction,
-                      const Command& command);
+  static void StartInit(const Config& config,
+                        span<const uint8_t> window_sequence,
+                        InitSequencer& sequencer);
+};
 
-  Config config_;
-  const uint16_t row_start_;
-  const uint16_t col_start_;
+class DisplayDriverST7735 : public DisplayDriverMipiDcs<ST7735Panel> {
+ public:
+  using DisplayDriverMipiDcs::DisplayDriverMipiDcs;
 };
 
 }  // namespace pw::display_driver
@@ -0,0 +1,74 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#include "pw_display/dirty_region.h"
+
+using pw::math::Rect;
+
+namespace pw::display {
+
+namespace {
+
+uint32_t Area(const Rect<uint16_t>& rect) {
+  return uint32_t{rect.width} * rect.height;
+}
+
+}  // namespace
+
+DirtyRegion::DirtyRegion(pw::math::Size<uint16_t> bounds) : bounds_(bounds) {}
+
+void DirtyRegion::Add(const Rect<uint16_t>& rect) {
+  Rect<uint16_t> region =
+      rect.Intersect({0, 0, bounds_.width, bounds_.height});
+  if (region.IsEmpty()) {
+    return;
+  }
+
+  // Absorb every existing rectangle that can be merged without sending more
+  // pixels than the two would separately. Each merge may enable others, so
+  // repeat until nothing changes.
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (auto it = rects_.begin(); it != rects_.end(); ++it) {
+      const Rect<uint16_t> merged_region = it->Union(region);
+      if (Area(merged_region) <= Area(*it) + Area(region)) {
+        region = merged_region;
+        rects_.erase(it);
+        merged = true;
+        break;
+      }
+    }
+  }
+
+  if (rects_.full()) {
+    // Out of space: merge with the rectangle that grows the least.
+    auto best = rects_.begin();
+    uint32_t best_growth = UINT32_MAX;
+    for (auto it = rects_.begin(); it != rects_.end(); ++it) {
+      const uint32_t growth = Area(it->Union(region)) - Area(*it);
+      if (growth < best_growth) {
+        best = it;
+        best_growth = growth;
+      }
+    }
+    region = best->Union(region);
+    rects_.erase(best);
+    Add(region);
+    return;
+  }
+
+  rects_.push_back(region);
+}
+
+}  // namespace pw::display
@@ -0,0 +1,76 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#include "pw_display/dirty_region.h"
+
+#include "gtest/gtest.h"
+
+using Rect = pw::math::Rect<uint16_t>;
+
+namespace pw::display {
+namespace {
+
+TEST(DirtyRegion, StartsEmpty) {
+  DirtyRegion region({320, 240});
+  EXPECT_TRUE(region.IsEmpty());
+  EXPECT_EQ(0u, region.rects().size());
+}
+
+TEST(DirtyRegion, ClipsToBounds) {
+  DirtyRegion region({320, 240});
+  region.Add({300, 230, 40, 40});
+  region.Add({320, 0, 10, 10});
+  region.Add({0, 0, 0, 10});
+  ASSERT_EQ(1u, region.rects().size());
+  EXPECT_EQ((Rect{300, 230, 20, 10}), region.rects()[0]);
+}
+
+TEST(DirtyRegion, MergesOverlappingAndAdjacent) {
+  DirtyRegion region({320, 240});
+  // Adjacent glyph cells merge into a single span of text.
+  region.Add({0, 0, 6, 8});
+  region.Add({6, 0, 6, 8});
+  region.Add({12, 0, 6, 8});
+  // Contained rectangles are absorbed.
+  region.Add({2, 2, 2, 2});
+  ASSERT_EQ(1u, region.rects().size());
+  EXPECT_EQ((Rect{0, 0, 18, 8}), region.rects()[0]);
+
+  region.Clear();
+  EXPECT_TRUE(region.IsEmpty());
+}
+
+TEST(DirtyRegion, KeepsDistantRectsSeparate) {
+  DirtyRegion region({320, 240});
+  region.Add({0, 0, 10, 10});
+  region.Add({300, 220, 10, 10});
+  ASSERT_EQ(2u, region.rects().size());
+  EXPECT_EQ((Rect{0, 0, 10, 10}), region.rects()[0]);
+  EXPECT_EQ((Rect{300, 220, 10, 10}), region.rects()[1]);
+}
+
+TEST(DirtyRegion, MergesWhenFull) {
+  DirtyRegion region({320, 240});
+  for (uint16_t i = 0; i < DirtyRegion::kMaxRects; i++) {
+    region.Add({static_cast<uint16_t>(i * 40), 0, 2, 2});
+  }
+  ASSERT_EQ(DirtyRegion::kMaxRects, region.rects().size());
+
+  // No room: the new rect merges with the closest one.
+  region.Add({0, 4, 2, 2});
+  ASSERT_EQ(DirtyRegion::kMaxRects, region.rects().size());
+  EXPECT_EQ((Rect{0, 0, 2, 6}), region.rects().back());
+}
+
+}  // namespace
+}  // namespace pw::display
@@ -13,10 +13,13 @@
 // the License.
 #include "pw_display/display.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <utility>
 
 #include "pw_assert/assert.h"
 #include "pw_color/color.h"
+#include "pw_framebuffer/expand.h"
 #include "pw_framebuffer/framebuffer.h"
 #include "pw_framebuffer_pool/framebuffer_pool.h"
 #include "pw_status/try.h"
@@ -32,61 +35,449 @@ Display::Display(pw::display_driver::DisplayDriver& display_driver,
                  pw::framebuffer_pool::FramebufferPool& framebuffer_pool)
     : display_driver_(display_driver),
       size_(size),
-      framebuffer_pool_(framebuffer_pool) {}
+      framebuffer_pool_(framebuffer_pool),
+      dirty_region_(size) {}
 
 Display::~Display() = default;
 
 #if DISPLAY_RESIZE
-Status Display::UpdateNearestNeighbor(const Framebuffer& framebuffer) {
+namespace {
+
+// Advance |index| and |remainder| to the next step of mapping [0, dst_last]
+// onto [0, src_last], which is index = dst * src_last / dst_last, without
+// dividing. |remainder| is always less than |dst_last|.
+inline void StepNearestNeighbor(int src_last,
+                                int dst_last,
+                                int& index,
+                                int& remainder) {
+  remainder += src_last;
+  while (remainder >= dst_last) {
+    remainder -= dst_last;
+    index++;
+  }
+}
+
+const color_rgb565_t* SourceRow(const Framebuffer& framebuffer, int row) {
+  return reinterpret_cast<const color_rgb565_t*>(
+      static_cast<const std::byte*>(framebuffer.data()) +
+      row * framebuffer.row_bytes());
+}
+
+#if DISPLAY_RESIZE_FILTERS
+// With the green channel of an RGB565 pixel moved to the upper half of a 32
+// bit word, the channels are far enough apart that they can be blended with a
+// single multiply, or up to 32 pixels summed, without overflowing into each
+// other.
+constexpr uint32_t kWideMask = 0x07e0f81f;
+// The most framebuffer pixels in each direction which kBox averages.
+constexpr int kMaxBoxSize = 32;
+
+inline uint32_t Widen(color_rgb565_t pixel) {
+  return (pixel | (uint32_t{pixel} << 16)) & kWideMask;
+}
+
+inline color_rgb565_t Narrow(uint32_t wide) {
+  return static_cast<color_rgb565_t>(wide | (wide >> 16));
+}
+
+// Blend from |a| to |b| with |weight| in the range 0..32.
+inline uint32_t LerpWide(uint32_t a, uint32_t b, uint32_t weight) {
+  return (a + (((b - a) * weight) >> 5)) & kWideMask;
+}
+
+// Divide each channel of |sum|, the sum of up to kMaxBoxSize widened pixels,
+// by the number of pixels, given as |scale| = 32768 / count.
+inline uint32_t AverageWide(uint32_t sum, uint32_t scale) {
+  const uint32_t blue = ((sum & 0x3ff) * scale + 0x4000) >> 15;
+  const uint32_t red = (((sum >> 11) & 0x3ff) * scale + 0x4000) >> 15;
+  const uint32_t green = ((sum >> 21) * scale + 0x4000) >> 15;
+  return blue | (red << 11) | (green << 21);
+}
+
+inline uint16_t BoxScale(int count) {
+  return static_cast<uint16_t>((32768 + count / 2) / count);
+}
+
+// The framebuffer position of each display row or column with kBilinear, as
+// a 16.16 fixed point step which maps the first and last display pixels onto
+// the first and last framebuffer pixels.
+inline uint32_t BilinearStep(int src_size, int dst_size) {
+  if (dst_size < 2)
+    return 0;
+  return (static_cast<uint32_t>(src_size - 1) << 16) /
+         static_cast<uint32_t>(dst_size - 1);
+}
+
+// Split a 16.16 fixed point |position| into the framebuffer pixel |index| and
+// the 0..31 weight of the pixel after it.
+inline void SplitPosition(uint32_t position, int& index, uint32_t& weight) {
+  index = static_cast<int>(position >> 16);
+  weight = ((position & 0xffff) + 0x400) >> 11;
+  if (weight == 32) {
+    index++;
+    weight = 0;
+  }
+}
+
+#endif  // DISPLAY_RESIZE_FILTERS
+
+}  // namespace
+
+void Display::BuildResizeColumns(uint16_t fb_width) {
+  const int num_dst_cols = size_.width;
+  switch (resize_mode_) {
+    case ResizeMode::kNearestNeighbor: {
+      const int src_last = fb_width - 1;
+      const int dst_last = num_dst_cols - 1;
+      int src_col = 0;
+      int remainder = 0;
+      for (int dst_col = 0; dst_col < num_dst_cols; dst_col++) {
+        resize_columns_[dst_col] = static_cast<uint16_t>(src_col);
+        if (dst_last > 0) {
+          StepNearestNeighbor(src_last, dst_last, src_col, remainder);
+        }
+      }
+      break;
+    }
+#if DISPLAY_RESIZE_FILTERS
+    case ResizeMode::kBilinear: {
+      const uint32_t step = BilinearStep(fb_width, num_dst_cols);
+      for (int dst_col = 0; dst_col < num_dst_cols; dst_col++) {
+        int src_col;
+        uint32_t weight;
+        SplitPosition(dst_col * step, src_col, weight);
+        resize_columns_[dst_col] = static_cast<uint16_t>(src_col);
+        resize_column_weights_[dst_col] = static_cast<uint16_t>(weight);
+      }
+      break;
+    }
+    case ResizeMode::kBox: {
+      // Box |dst_col| spans framebuffer columns [dst_col * fb_width /
+      // num_dst_cols, (dst_col + 1) * fb_width / num_dst_cols), and at least
+      // one column.
+      int src_col = 0;
+      int remainder = 0;
+      for (int dst_col = 0; dst_col < num_dst_cols; dst_col++) {
+        const int first_col = src_col;
+        StepNearestNeighbor(fb_width, num_dst_cols, src_col, remainder);
+        const int count = std::clamp(src_col - first_col, 1, kMaxBoxSize);
+        resize_columns_[dst_col] = static_cast<uint16_t>(first_col);
+        resize_column_weights_[dst_col] = BoxScale(count);
+      }
+      break;
+    }
+#endif  // DISPLAY_RESIZE_FILTERS
+  }
+  resize_columns_width_ = fb_width;
+  resize_columns_mode_ = resize_mode_;
+}
+
+template <typename ResizeRowFunction>
+Status Display::WriteResized(ResizeRowFunction&& resize_row) {
+  const int num_dst_cols = size_.width;
+  const int rows_per_burst =
+      static_cast<int>(kResizeBufferNumPixels) / num_dst_cols;
+  for (int burst_row = 0; burst_row < size_.height;
+       burst_row += rows_per_burst) {
+    const int num_rows = std::min(rows_per_burst, size_.height - burst_row);
+    for (int i = 0; i < num_rows; i++) {
+      resize_row(&resize_buffer_[i * num_dst_cols]);
+    }
+    // The driver must finish with the rows before returning, as
+    // resize_buffer_ is reused for the next burst.
+    PW_TRY(display_driver_.WriteRect(
+        span(resize_buffer_.data(), num_rows * num_dst_cols),
+        {0,
+         static_cast<uint16_t>(burst_row),
+         size_.width,
+         static_cast<uint16_t>(num_rows)},
+        size_.width));
+  }
+  return OkStatus();
+}
+
+Status Display::Resize(const Framebuffer& framebuffer) {
   PW_ASSERT(framebuffer.is_valid());
   if (!framebuffer.size().width || !framebuffer.size().height)
     return Status::Internal();
+  if (size_.width > kMaxResizeWidth)
+    return Status::OutOfRange();
+
+  // The column map only changes with the framebuffer width and the resize
+  // mode, so is usually built once.
+  if (resize_columns_width_ != framebuffer.size().width ||
+      resize_columns_mode_ != resize_mode_) {
+    BuildResizeColumns(framebuffer.size().width);
+  }
 
-  const int fb_last_row_idx = framebuffer.size().height - 1;
-  const int fb_last_col_idx = framebuffer.size().width - 1;
+  switch (resize_mode_) {
+    case ResizeMode::kNearestNeighbor:
+      return ResizeNearestNeighbor(framebuffer);
+#if DISPLAY_RESIZE_FILTERS
+    case ResizeMode::kBilinear:
+      return ResizeBilinear(framebuffer);
+    case ResizeMode::kBox:
+      return ResizeBox(framebuffer);
+#endif  // DISPLAY_RESIZE_FILTERS
+  }
+  return Status::InvalidArgument();
+}
 
-  constexpr int kResizeBufferNumPixels = 80;
-  color_rgb565_t resize_buffer[kResizeBufferNumPixels];
+Status Display::ResizeNearestNeighbor(const Framebuffer& framebuffer) {
+  const int num_dst_cols = size_.width;
+  const int src_last_row = framebuffer.size().height - 1;
+  const int dst_last_row = size_.height - 1;
+  int src_row = 0;
+  int remainder = 0;
 
-  const color_rgb565_t* fbdata =
-      static_cast<const color_rgb565_t*>(framebuffer.data());
-  constexpr int kBytesPerPixel = sizeof(color_rgb565_t);
-  const int num_src_row_pixels = framebuffer.row_bytes() / kBytesPerPixel;
+  // The most recently resized row, which is copied rather than resized again
+  // when the next display row comes from the same framebuffer row.
+  const color_rgb565_t* last_row = nullptr;
+  int last_src_row = -1;
 
-  const int num_dst_rows = size_.height;
+  return WriteResized([&](color_rgb565_t* dst) {
+    if (src_row == last_src_row) {
+      if (dst != last_row) {
+        std::copy_n(last_row, num_dst_cols, dst);
+      }
+    } else {
+      const color_rgb565_t* src = SourceRow(framebuffer, src_row);
+      for (int dst_col = 0; dst_col < num_dst_cols; dst_col++) {
+        dst[dst_col] = src[resize_columns_[dst_col]];
+      }
+      last_src_row = src_row;
+    }
+    last_row = dst;
+    if (dst_last_row > 0) {
+      StepNearestNeighbor(src_last_row, dst_last_row, src_row, remainder);
+    }
+  });
+}
+
+#if DISPLAY_RESIZE_FILTERS
+
+Status Display::ResizeBilinear(const Framebuffer& framebuffer) {
   const int num_dst_cols = size_.width;
-  for (int dst_row_idx = 0; dst_row_idx < num_dst_rows; dst_row_idx++) {
-    int src_row_idx = dst_row_idx * fb_last_row_idx / (num_dst_rows - 1);
-    PW_ASSERT(src_row_idx >= 0);
-    PW_ASSERT(src_row_idx < framebuffer.size().height);
-    int next_buff_idx = 0;
-    int dst_col_write_idx = 0;
-    for (int dst_col_idx = 0; dst_col_idx < num_dst_cols; dst_col_idx++) {
-      int src_col_idx = dst_col_idx * fb_last_col_idx / (num_dst_cols - 1);
-      PW_ASSERT(src_col_idx >= 0);
-      PW_ASSERT(src_col_idx < framebuffer.size().width);
-      int src_pixel_idx = src_row_idx * num_src_row_pixels + src_col_idx;
-      resize_buffer[next_buff_idx++] = fbdata[src_pixel_idx];
-      if (next_buff_idx == kResizeBufferNumPixels) {
-        // Buffer is full, flush it.
-        PW_TRY(display_driver_.WriteRow(
-            span(resize_buffer, kResizeBufferNumPixels),
-            dst_row_idx,
-            dst_col_write_idx));
-        next_buff_idx = 0;
-        dst_col_write_idx += kResizeBufferNumPixels;
+  const uint32_t row_step =
+      BilinearStep(framebuffer.size().height, size_.height);
+  uint32_t row_position = 0;
+
+  // Each framebuffer row is resized horizontally into one of resize_lines_
+  // once, and kept while the display rows between it and the next one are
+  // blended from them.
+  int line_rows[2] = {-1, -1};
+  auto resized_line = [&](int src_row, int keep_row) -> const uint32_t* {
+    for (int i = 0; i < 2; i++) {
+      if (line_rows[i] == src_row) {
+        return resize_lines_[i].data();
       }
     }
+    const int i = line_rows[0] == keep_row ? 1 : 0;
+    uint32_t* line = resize_lines_[i].data();
+    const color_rgb565_t* src = SourceRow(framebuffer, src_row);
+    for (int dst_col = 0; dst_col < num_dst_cols; dst_col++) {
+      const int src_col = resize_columns_[dst_col];
+      const uint32_t weight = resize_column_weights_[dst_col];
+      const uint32_t left = Widen(src[src_col]);
+      line[dst_col] =
+          weight ? LerpWide(left, Widen(src[src_col + 1]), weight) : left;
+    }
+    line_rows[i] = src_row;
+    return line;
+  };
 
-    if (next_buff_idx) {
-      // Pixels in buffer, flush them.
-      PW_TRY(display_driver_.WriteRow(
-          span(resize_buffer, next_buff_idx), dst_row_idx, dst_col_write_idx));
+  return WriteResized([&](color_rgb565_t* dst) {
+    int src_row;
+    uint32_t weight;
+    SplitPosition(row_position, src_row, weight);
+    row_position += row_step;
+    const uint32_t* top = resized_line(src_row, src_row + 1);
+    if (weight == 0) {
+      for (int dst_col = 0; dst_col < num_dst_cols; dst_col++) {
+        dst[dst_col] = Narrow(top[dst_col]);
+      }
+      return;
+    }
+    const uint32_t* bottom = resized_line(src_row + 1, src_row);
+    for (int dst_col = 0; dst_col < num_dst_cols; dst_col++) {
+      dst[dst_col] = Narrow(LerpWide(top[dst_col], bottom[dst_col], weight));
+    }
+  });
+}
+
+Status Display::ResizeBox(const Framebuffer& framebuffer) {
+  const int num_dst_cols = size_.width;
+  const int src_width = framebuffer.size().width;
+  const int src_height = framebuffer.size().height;
+  int src_row = 0;
+  int remainder = 0;
+  const color_rgb565_t* last_row = nullptr;
+  int last_src_row = -1;
+  uint32_t* sums = resize_lines_[0].data();
+  const int max_box_width = std::min(
+      (src_width + num_dst_cols - 1) / num_dst_cols, kMaxBoxSize);
+
+  return WriteResized([&](color_rgb565_t* dst) {
+    const int first_row = src_row;
+    StepNearestNeighbor(src_height, size_.height, src_row, remainder);
+    const int num_rows = std::clamp(src_row - first_row, 1, kMaxBoxSize);
+
+    // When enlarging, display rows which show the same framebuffer row are
+    // copied, as with kNearestNeighbor.
+    if (num_rows == 1 && first_row == last_src_row) {
+      if (dst != last_row) {
+        std::copy_n(last_row, num_dst_cols, dst);
+      }
+      last_row = dst;
+      return;
+    }
+
+    // Boxes of up to kMaxBoxSize pixels are summed whole and then averaged.
+    // Larger ones are averaged a row at a time, and the averages summed.
+    const bool sum_boxes = max_box_width * num_rows <= kMaxBoxSize;
+    for (int row = 0; row < num_rows; row++) {
+      const color_rgb565_t* src = SourceRow(framebuffer, first_row + row);
+      for (int dst_col = 0; dst_col < num_dst_cols; dst_col++) {
+        const int first_col = resize_columns_[dst_col];
+        const uint32_t scale = resize_column_weights_[dst_col];
+        uint32_t sum = Widen(src[first_col]);
+        if (scale != 32768) {
+          const int next_col = dst_col + 1 < num_dst_cols
+                                   ? resize_columns_[dst_col + 1]
+                                   : src_width;
+          const int end_col = std::min(next_col, first_col + kMaxBoxSize);
+          for (int src_col = first_col + 1; src_col < end_col; src_col++) {
+            sum += Widen(src[src_col]);
+          }
+          if (!sum_boxes) {
+            sum = AverageWide(sum, scale);
+          }
+        }
+        sums[dst_col] = row ? sums[dst_col] + sum : sum;
+      }
+    }
+
+    const bool average_columns = sum_boxes && max_box_width > 1;
+    const uint32_t row_scale = BoxScale(num_rows);
+    for (int dst_col = 0; dst_col < num_dst_cols; dst_col++) {
+      uint32_t sum = sums[dst_col];
+      if (average_columns) {
+        sum = AverageWide(sum, resize_column_weights_[dst_col]);
+      }
+      if (num_rows > 1) {
+        sum = AverageWide(sum, row_scale);
+      }
+      dst[dst_col] = Narrow(sum);
+    }
+    last_src_row = num_rows == 1 ? first_row : -1;
+    last_row = dst;
+  });
+}
+
+#endif  // DISPLAY_RESIZE_FILTERS
+
+#endif  // DISPLAY_RESIZE
+
+Status Display::WriteIndexed(const Framebuffer& framebuffer) {
+  PW_ASSERT(!framebuffer.palette().empty());
+  const pw::math::Rect<uint16_t> bounds{
+      0,
+      0,
+      std::min(framebuffer.size().width, size_.width),
+      std::min(framebuffer.size().height, size_.height)};
+  // flush_rects_ may be in use by a region write which is still in flight.
+  const span<const pw::math::Rect<uint16_t>> rects =
+      dirty_region_.IsEmpty() ? span(&bounds, 1) : dirty_region_.rects();
+
+  const int bits_per_pixel =
+      pw::framebuffer::BitsPerPixel(framebuffer.pixel_format());
+  const auto* data = static_cast<const uint8_t*>(framebuffer.data());
+  for (const pw::math::Rect<uint16_t>& dirty_rect : rects) {
+    const pw::math::Rect<uint16_t> rect = dirty_rect.Intersect(bounds);
+    if (rect.width == 0 || rect.height == 0)
+      continue;
+    // Rows wider than indexed_buffer_ are sent in several parts.
+    const int part_width =
+        std::min(static_cast<int>(rect.width),
+                 static_cast<int>(kIndexedBufferNumPixels));
+    const int rows_per_burst =
+        static_cast<int>(kIndexedBufferNumPixels) / part_width;
+    for (int burst_row = rect.y; burst_row < rect.y + rect.height;
+         burst_row += rows_per_burst) {
+      const int num_rows =
+          std::min(rows_per_burst, rect.y + rect.height - burst_row);
+      for (int col = rect.x; col < rect.x + rect.width; col += part_width) {
+        const int num_cols = std::min(part_width, rect.x + rect.width - col);
+        for (int i = 0; i < num_rows; i++) {
+          pw::framebuffer::ExpandIndexedPixels(
+              data + (burst_row + i) * framebuffer.row_bytes(),
+              bits_per_pixel,
+              col,
+              num_cols,
+              framebuffer.palette(),
+              &indexed_buffer_[i * num_cols]);
+        }
+        PW_TRY(display_driver_.WriteRect(
+            span(indexed_buffer_.data(), num_rows * num_cols),
+            {static_cast<uint16_t>(col),
+             static_cast<uint16_t>(burst_row),
+             static_cast<uint16_t>(num_cols),
+             static_cast<uint16_t>(num_rows)},
+            static_cast<uint16_t>(num_cols)));
+      }
     }
   }
   return OkStatus();
 }
-#endif  // DISPLAY_RESIZE
+
+Status Display::DrawBands(const DrawBandFunction& draw_band) {
+  const int band_height = framebuffer_pool_.dimensions().height;
+  if (band_height == 0) {
+    return Status::FailedPrecondition();
+  }
+  dirty_region_.Clear();
+  const pw::math::Rect<uint16_t> display_bounds{
+      0, 0, size_.width, size_.height};
+  for (int band_y = 0; band_y < size_.height; band_y += band_height) {
+    Framebuffer band = framebuffer_pool_.GetFramebuffer();
+    PW_ASSERT(band.is_valid());
+    PW_ASSERT(band.pixel_format() == PixelFormat::RGB565);
+    band.set_origin({0, static_cast<uint16_t>(band_y)});
+    draw_band(band);
+    // The last band may extend below the display.
+    const pw::math::Rect<uint16_t> region =
+        band.bounds().Intersect(display_bounds);
+    PW_TRY(WriteBand(std::move(band), region));
+  }
+  return OkStatus();
+}
+
+Status Display::WriteBand(Framebuffer band,
+                          const pw::math::Rect<uint16_t>& region) {
+  framebuffer_pool_.MarkInFlight(band).IgnoreError();
+  if (display_driver_.SupportsRegionWrite()) {
+    display_driver_.WriteRegion(
+        std::move(band), region, [this](Framebuffer fb, Status status) {
+          FinishWrite(std::move(fb), status);
+        });
+    return TakeWriteError();
+  }
+
+  // WriteRect() is synchronous, so the band can be released afterwards. It
+  // takes RGB565 pixels, and its stride is counted in pixels.
+  PW_ASSERT(band.pixel_format() == PixelFormat::RGB565);
+  PW_ASSERT(band.row_bytes() % sizeof(uint16_t) == 0);
+  const uint16_t stride = band.row_bytes() / sizeof(uint16_t);
+  uint16_t* pixels = static_cast<uint16_t*>(band.data()) +
+                     (region.y - band.origin().y) * stride +
+                     (region.x - band.origin().x);
+  const Status status = display_driver_.WriteRect(
+      span(pixels, (region.height - 1) * stride + region.width),
+      region,
+      stride);
+  PW_ASSERT_OK(framebuffer_pool_.ReleaseFramebuffer(std::move(band)));
+  return status;
+}
 
 Framebuffer Display::GetFramebuffer() {
   return framebuffer_pool_.GetFramebuffer();
@@ -94,30 +485,75 @@ Framebuffer Display::GetFramebuffer() {
 
 // This may be async
 Status Display::ReleaseFramebuffer(Framebuffer framebuffer) {
-  pw::framebuffer_pool::FramebufferPool& fb_pool = framebuffer_pool_;
-  auto write_cb = [&fb_pool](pw::framebuffer::Framebuffer fb, Status status) {
-    PW_ASSERT_OK(status);
-    fb_pool.ReleaseFramebuffer(std::move(fb));
+  auto write_cb = [this](Framebuffer fb, Status status) {
+    FinishWrite(std::move(fb), status);
   };
   if (!framebuffer.is_valid())
     return Status::InvalidArgument();
+  // Buffer state is only tracked for diagnostics, and pools which hand out
+  // buffers owned by the display hardware do not track it at all.
+  framebuffer_pool_.MarkInFlight(framebuffer).IgnoreError();
+  if (pw::framebuffer::IsIndexed(framebuffer.pixel_format())) {
+    Status result = WriteIndexed(framebuffer);
+    dirty_region_.Clear();
+    PW_ASSERT_OK(framebuffer_pool_.ReleaseFramebuffer(std::move(framebuffer)));
+    return result;
+  }
   if (framebuffer.size() != size_) {
 #if DISPLAY_RESIZE
     if (display_driver_.SupportsResize()) {
       display_driver_.WriteFramebuffer(std::move(framebuffer), write_cb);
-      return OkStatus();
+      return TakeWriteError();
     } else {
-      Status result = UpdateNearestNeighbor(framebuffer);
-      write_cb(std::move(framebuffer), result);
+      Status result = Resize(framebuffer);
+      PW_ASSERT_OK(
+          framebuffer_pool_.ReleaseFramebuffer(std::move(framebuffer)));
       return result;
     }
 #endif
     // Rely on display driver's ability to support size mismatch. It is
     // expected to return an error if it cannot.
+  } else if (!dirty_region_.IsEmpty() &&
+             display_driver_.SupportsRegionWrite() &&
+             !flush_in_flight_.exchange(true)) {
+    // Nothing else uses flush_rects_ until the last region has been written.
+    const auto rects = dirty_region_.rects();
+    flush_rects_.assign(rects.begin(), rects.end());
+    next_flush_rect_ = 0;
+    dirty_region_.Clear();
+    WriteNextRegion(std::move(framebuffer));
+    return TakeWriteError();
   }
 
+  dirty_region_.Clear();
   display_driver_.WriteFramebuffer(std::move(framebuffer), write_cb);
-  return OkStatus();
+  return TakeWriteError();
+}
+
+void Display::WriteNextRegion(Framebuffer framebuffer) {
+  const pw::math::Rect<uint16_t> region = flush_rects_[next_flush_rect_++];
+  display_driver_.WriteRegion(
+      std::move(framebuffer), region, [this](Framebuffer fb, Status status) {
+        if (status.ok() && next_flush_rect_ < flush_rects_.size()) {
+          WriteNextRegion(std::move(fb));
+        } else {
+          flush_in_flight_ = false;
+          FinishWrite(std::move(fb), status);
+        }
+      });
+}
+
+void Display::FinishWrite(Framebuffer framebuffer, Status status) {
+  if (!status.ok()) {
+    // Keep the first error until it is returned.
+    Status::Code expected = OkStatus().code();
+    write_error_.compare_exchange_strong(expected, status.code());
+  }
+  PW_ASSERT_OK(framebuffer_pool_.ReleaseFramebuffer(std::move(framebuffer)));
+}
+
+Status Display::TakeWriteError() {
+  return write_error_.exchange(OkStatus().code());
 }
 
 }  // namespace pw::display
@@ -14,17 +14,26 @@
 
 #include "pw_display/display.h"
 
+#include <algorithm>
 #include <array>
+#include <iterator>
 #include <utility>
 
 #include "gtest/gtest.h"
 #include "pw_color/color.h"
+#include "pw_display_driver/fake_spi_bus.h"
+#include "pw_display_driver_st7789/display_driver.h"
+#include "pw_framebuffer/writer.h"
 
 using pw::color::color_rgb565_t;
 using pw::display_driver::DisplayDriver;
+using pw::display_driver::DisplayDriverST7789;
+using pw::display_driver::FakeSpiBus;
 using pw::framebuffer::Framebuffer;
+using pw::framebuffer::FramebufferWriter;
 using pw::framebuffer::PixelFormat;
 using pw::framebuffer_pool::FramebufferPool;
+using BufferState = pw::framebuffer_pool::FramebufferPool::BufferState;
 using Size = pw::math::Size<uint16_t>;
 
 namespace pw::display {
@@ -37,6 +46,8 @@ enum class CallFunc {
   Unset,
   GetFramebuffer,
   ReleaseFramebuffer,
+  WriteRect,
+  WriteRegion,
   WriteRow,
 };
 
@@ -45,11 +56,22 @@ struct CallParams {
   struct {
     void* fb_data = nullptr;
   } release_framebuffer;
+  struct {
+    void* fb_data = nullptr;
+    pw::math::Rect<uint16_t> region = {0, 0, 0, 0};
+    pw::math::Vector2<uint16_t> fb_origin = {0, 0};
+  } write_region;
   struct {
     size_t num_pixels = 0;
     uint16_t row_idx = 0;
     uint16_t col_idx = 0;
+    // The first pixels written.
+    std::array<color_rgb565_t, 4> pixels = {};
   } write_row;
+  struct {
+    pw::math::Rect<uint16_t> rect = {0, 0, 0, 0};
+    uint16_t stride = 0;
+  } write_rect;
 };
 
 class TestDisplayDriver : public DisplayDriver {
@@ -68,7 +90,34 @@ class TestDisplayDriver : public DisplayDriver {
           framebuffer.data();
       next_call_param_idx_++;
     }
-    write_callback(std::move(framebuffer), OkStatus());
+    Complete(std::move(framebuffer), std::move(write_callback));
+  }
+
+  void WriteRegion(Framebuffer framebuffer,
+                   const pw::math::Rect<uint16_t>& region,
+                   WriteCallback write_callback) override {
+    if (next_call_param_idx_ < kMaxSavedParams) {
+      call_params_[next_call_param_idx_].call_func = CallFunc::WriteRegion;
+      call_params_[next_call_param_idx_].write_region.fb_data =
+          framebuffer.data();
+      call_params_[next_call_param_idx_].write_region.region = region;
+      call_params_[next_call_param_idx_].write_region.fb_origin =
+          framebuffer.origin();
+      next_call_param_idx_++;
+    }
+    if (!screen_.empty()) {
+      const pw::math::Rect<uint16_t> window =
+          region.Intersect(framebuffer.bounds());
+      for (int y = window.y; y < window.y + window.height; y++) {
+        const auto* src = reinterpret_cast<const color_rgb565_t*>(
+            static_cast<const std::byte*>(framebuffer.data()) +
+            (y - framebuffer.origin().y) * framebuffer.row_bytes());
+        std::copy_n(&src[window.x - framebuffer.origin().x],
+                    window.width,
+                    &screen_[y * GetWidth() + window.x]);
+      }
+    }
+    Complete(std::move(framebuffer), std::move(write_callback));
   }
 
   Status WriteRow(span<uint16_t> pixel_data,
@@ -80,8 +129,36 @@ class TestDisplayDriver : public DisplayDriver {
           pixel_data.size();
       call_params_[next_call_param_idx_].write_row.row_idx = row_idx;
       call_params_[next_call_param_idx_].write_row.col_idx = col_idx;
+      auto& pixels = call_params_[next_call_param_idx_].write_row.pixels;
+      std::copy_n(pixel_data.begin(),
+                  std::min(pixel_data.size(), pixels.size()),
+                  pixels.begin());
       next_call_param_idx_++;
     }
+    if (!screen_.empty()) {
+      std::copy(pixel_data.begin(),
+                pixel_data.end(),
+                &screen_[row_idx * GetWidth() + col_idx]);
+    }
+    return OkStatus();
+  }
+
+  Status WriteRect(span<uint16_t> pixels,
+                   const pw::math::Rect<uint16_t>& rect,
+                   uint16_t stride) override {
+    if (next_call_param_idx_ < kMaxSavedParams) {
+      call_params_[next_call_param_idx_].call_func = CallFunc::WriteRect;
+      call_params_[next_call_param_idx_].write_rect.rect = rect;
+      call_params_[next_call_param_idx_].write_rect.stride = stride;
+      next_call_param_idx_++;
+    }
+    if (!screen_.empty()) {
+      for (int y = 0; y < rect.height; y++) {
+        std::copy_n(&pixels[y * stride],
+                    rect.width,
+                    &screen_[(rect.y + y) * GetWidth() + rect.x]);
+      }
+    }
     return OkStatus();
   }
 
@@ -89,6 +166,33 @@ class TestDisplayDriver : public DisplayDriver {
 
   uint16_t GetHeight() const override { return framebuffer_.size().height; }
 
+  bool SupportsRegionWrite() const override { return supports_region_write_; }
+
+  void SetSupportsRegionWrite(bool supported) {
+    supports_region_write_ = supported;
+  }
+
+  // Copy every pixel written into |screen|, which holds GetWidth() x
+  // GetHeight() pixels.
+  void SetScreen(span<color_rgb565_t> screen) { screen_ = screen; }
+
+  // Hold the completion callbacks of WriteFramebuffer() and WriteRegion()
+  // until CompleteNextWrite() is called, like an asynchronous driver.
+  void SetAsync(bool async) { async_ = async; }
+
+  // Call the oldest held completion callback with |status|. Returns false if
+  // there are none.
+  bool CompleteNextWrite(Status status = OkStatus()) {
+    if (num_pending_ == 0) {
+      return false;
+    }
+    PendingWrite write = std::move(pending_[0]);
+    std::move(&pending_[1], &pending_[num_pending_], &pending_[0]);
+    num_pending_--;
+    write.callback(std::move(write.framebuffer), status);
+    return true;
+  }
+
   int GetNumCalls() const {
     int count = 0;
     for (size_t i = 0;
@@ -109,6 +213,26 @@ class TestDisplayDriver : public DisplayDriver {
   size_t next_call_param_idx_ = 0;
   std::array<CallParams, kMaxSavedParams> call_params_;
   const Framebuffer framebuffer_;
+  struct PendingWrite {
+    Framebuffer framebuffer;
+    WriteCallback callback;
+  };
+
+  void Complete(Framebuffer framebuffer, WriteCallback write_callback) {
+    if (!async_) {
+      write_callback(std::move(framebuffer), OkStatus());
+      return;
+    }
+    PW_ASSERT(num_pending_ < pending_.size());
+    pending_[num_pending_++] = {std::move(framebuffer),
+                                std::move(write_callback)};
+  }
+
+  bool supports_region_write_ = false;
+  span<color_rgb565_t> screen_;
+  bool async_ = false;
+  std::array<PendingWrite, 4> pending_;
+  size_t num_pending_ = 0;
 };
 
 TEST(Display, ReleaseNoResize) {
@@ -142,131 +266,789 @@ TEST(Display, ReleaseNoResize) {
   EXPECT_EQ(pixel_data, call.release_framebuffer.fb_data);
 }
 
-#if DISPLAY_RESIZE
-TEST(Display, ReleaseSmallResize) {
-  constexpr Size kDisplaySize = {8, 4};
-  constexpr pw::math::Size<uint16_t> kFramebufferSize{2, 1};
+TEST(Display, ReleaseDirtyRegions) {
+  constexpr pw::math::Size<uint16_t> kFramebufferSize{64, 32};
+  constexpr uint16_t kFramebufferRowBytes =
+      sizeof(color_rgb565_t) * kFramebufferSize.width;
+  color_rgb565_t pixel_data[kFramebufferSize.width * kFramebufferSize.height];
+  pw::Vector<void*, 1> pixel_buffers{pixel_data};
+  FramebufferPool fb_pool({
+      .fb_addr = pixel_buffers,
+      .dimensions = kFramebufferSize,
+      .row_bytes = kFramebufferRowBytes,
+      .pixel_format = PixelFormat::RGB565,
+  });
+
+  TestDisplayDriver test_driver(Framebuffer(
+      pixel_data, PixelFormat::RGB565, kFramebufferSize, kFramebufferRowBytes));
+  test_driver.SetSupportsRegionWrite(true);
+  Display display(test_driver, kFramebufferSize, fb_pool);
+
+  Framebuffer fb = display.GetFramebuffer();
+  display.MarkDirty({0, 0, 8, 8});
+  display.MarkDirty({8, 0, 8, 8});
+  display.MarkDirty({40, 20, 4, 4});
+  EXPECT_EQ(OkStatus(), display.ReleaseFramebuffer(std::move(fb)));
+  ASSERT_EQ(2, test_driver.GetNumCalls());
+  auto call = test_driver.GetCall(0);
+  EXPECT_EQ(CallFunc::WriteRegion, call.call_func);
+  EXPECT_EQ(pixel_data, call.write_region.fb_data);
+  EXPECT_EQ((pw::math::Rect<uint16_t>{0, 0, 16, 8}), call.write_region.region);
+  call = test_driver.GetCall(1);
+  EXPECT_EQ(CallFunc::WriteRegion, call.call_func);
+  EXPECT_EQ((pw::math::Rect<uint16_t>{40, 20, 4, 4}),
+            call.write_region.region);
+
+  // The framebuffer was returned to the pool, and the dirty regions were
+  // cleared, so the next release sends the entire framebuffer.
+  fb = display.GetFramebuffer();
+  EXPECT_TRUE(fb.is_valid());
+  EXPECT_EQ(OkStatus(), display.ReleaseFramebuffer(std::move(fb)));
+  ASSERT_EQ(3, test_driver.GetNumCalls());
+  EXPECT_EQ(CallFunc::ReleaseFramebuffer, test_driver.GetCall(2).call_func);
+}
+
+TEST(Display, ReleaseDirtyRegionsAsync) {
+  constexpr pw::math::Size<uint16_t> kFramebufferSize{64, 32};
+  constexpr uint16_t kFramebufferRowBytes =
+      sizeof(color_rgb565_t) * kFramebufferSize.width;
   constexpr size_t kNumPixels =
       kFramebufferSize.width * kFramebufferSize.height;
+  color_rgb565_t pixel_data1[kNumPixels];
+  color_rgb565_t pixel_data2[kNumPixels];
+  pw::Vector<void*, 2> pixel_buffers{pixel_data1, pixel_data2};
+  FramebufferPool fb_pool({
+      .fb_addr = pixel_buffers,
+      .dimensions = kFramebufferSize,
+      .row_bytes = kFramebufferRowBytes,
+      .pixel_format = PixelFormat::RGB565,
+  });
+
+  TestDisplayDriver test_driver(Framebuffer(pixel_data1,
+                                            PixelFormat::RGB565,
+                                            kFramebufferSize,
+                                            kFramebufferRowBytes));
+  test_driver.SetSupportsRegionWrite(true);
+  test_driver.SetAsync(true);
+  Display display(test_driver, kFramebufferSize, fb_pool);
+
+  Framebuffer fb = display.GetFramebuffer();
+  void* first_fb_data = fb.data();
+  display.MarkDirty({0, 0, 8, 8});
+  display.MarkDirty({40, 20, 4, 4});
+  EXPECT_EQ(OkStatus(), display.ReleaseFramebuffer(std::move(fb)));
+  ASSERT_EQ(1, test_driver.GetNumCalls());
+
+  // The first framebuffer's regions are still being written, so the second
+  // framebuffer is sent in its entirety.
+  fb = display.GetFramebuffer();
+  void* second_fb_data = fb.data();
+  display.MarkDirty({0, 0, 4, 4});
+  EXPECT_EQ(OkStatus(), display.ReleaseFramebuffer(std::move(fb)));
+  ASSERT_EQ(2, test_driver.GetNumCalls());
+  EXPECT_EQ(CallFunc::ReleaseFramebuffer, test_driver.GetCall(1).call_func);
+  EXPECT_EQ(second_fb_data,
+            test_driver.GetCall(1).release_framebuffer.fb_data);
+
+  while (test_driver.CompleteNextWrite()) {
+  }
+  ASSERT_EQ(3, test_driver.GetNumCalls());
+  auto call = test_driver.GetCall(0);
+  EXPECT_EQ(CallFunc::WriteRegion, call.call_func);
+  EXPECT_EQ(first_fb_data, call.write_region.fb_data);
+  EXPECT_EQ((pw::math::Rect<uint16_t>{0, 0, 8, 8}), call.write_region.region);
+  call = test_driver.GetCall(2);
+  EXPECT_EQ(CallFunc::WriteRegion, call.call_func);
+  EXPECT_EQ(first_fb_data, call.write_region.fb_data);
+  EXPECT_EQ((pw::math::Rect<uint16_t>{40, 20, 4, 4}),
+            call.write_region.region);
+
+  // Once the regions have been written, region writes are used again.
+  fb = display.GetFramebuffer();
+  display.MarkDirty({0, 0, 4, 4});
+  EXPECT_EQ(OkStatus(), display.ReleaseFramebuffer(std::move(fb)));
+  ASSERT_EQ(4, test_driver.GetNumCalls());
+  EXPECT_EQ(CallFunc::WriteRegion, test_driver.GetCall(3).call_func);
+  while (test_driver.CompleteNextWrite()) {
+  }
+}
+
+TEST(Display, ReleaseDirtyRegionsAsyncError) {
+  constexpr pw::math::Size<uint16_t> kFramebufferSize{64, 32};
   constexpr uint16_t kFramebufferRowBytes =
       sizeof(color_rgb565_t) * kFramebufferSize.width;
+  constexpr size_t kNumPixels =
+      kFramebufferSize.width * kFramebufferSize.height;
   color_rgb565_t pixel_data[kNumPixels];
+  pw::Vector<void*, 1> pixel_buffers{pixel_data};
   FramebufferPool fb_pool({
-      .fb_addr = pixel_data,
-      .size = kFramebufferSize,
+      .fb_addr = pixel_buffers,
+      .dimensions = kFramebufferSize,
       .row_bytes = kFramebufferRowBytes,
       .pixel_format = PixelFormat::RGB565,
   });
 
-  TestDisplayDriver test_driver(
-      Framebuffer(pixel_data, kFramebufferSize, kFramebufferRowBytes));
-  Display display(test_driver, kDisplaySize, fb_pool);
+  TestDisplayDriver test_driver(Framebuffer(
+      pixel_data, PixelFormat::RGB565, kFramebufferSize, kFramebufferRowBytes));
+  test_driver.SetSupportsRegionWrite(true);
+  test_driver.SetAsync(true);
+  Display display(test_driver, kFramebufferSize, fb_pool);
+
   Framebuffer fb = display.GetFramebuffer();
-  EXPECT_TRUE(fb.is_valid());
-  EXPECT_EQ(kFramebufferSize, fb.size());
-  EXPECT_EQ(0, test_driver.GetNumCalls());
+  display.MarkDirty({0, 0, 8, 8});
+  display.MarkDirty({40, 20, 4, 4});
+  EXPECT_EQ(OkStatus(), display.ReleaseFramebuffer(std::move(fb)));
 
-  display.ReleaseFramebuffer(std::move(fb));
+  // A failed region ends the write, and the framebuffer is released.
+  EXPECT_TRUE(test_driver.CompleteNextWrite(Status::Internal()));
+  EXPECT_FALSE(test_driver.CompleteNextWrite());
+  EXPECT_EQ(1, test_driver.GetNumCalls());
+  EXPECT_EQ(BufferState::kFree, fb_pool.buffer_state(0));
+
+  // The error is returned by the next release, and only once.
+  fb = display.GetFramebuffer();
+  display.MarkDirty({0, 0, 4, 4});
+  EXPECT_EQ(Status::Internal(), display.ReleaseFramebuffer(std::move(fb)));
+  EXPECT_TRUE(test_driver.CompleteNextWrite());
+  fb = display.GetFramebuffer();
+  EXPECT_EQ(OkStatus(), display.ReleaseFramebuffer(std::move(fb)));
+  EXPECT_TRUE(test_driver.CompleteNextWrite());
+  EXPECT_EQ(BufferState::kFree, fb_pool.buffer_state(0));
+}
+
+// A MIPI DCS driver without a pixel pusher cannot write a framebuffer which is
+// not the size of its screen.
+TEST(Display, ReleaseWrongSizeToMipiDcsDriver) {
+  constexpr Size kDisplaySize{32, 16};
+  constexpr Size kFramebufferSize{16, 8};
+  constexpr uint16_t kFramebufferRowBytes =
+      sizeof(color_rgb565_t) * kFramebufferSize.width;
+  color_rgb565_t pixel_data[kFramebufferSize.width * kFramebufferSize.height];
+  pw::Vector<void*, 1> pixel_buffers{pixel_data};
+  FramebufferPool fb_pool({
+      .fb_addr = pixel_buffers,
+      .dimensions = kFramebufferSize,
+      .row_bytes = kFramebufferRowBytes,
+      .pixel_format = PixelFormat::RGB565,
+  });
+
+  FakeSpiBus bus;
+  DisplayDriverST7789 driver({
+      .data_cmd_gpio = bus.data_cmd_gpio(),
+      .spi_cs_gpio = bus.chip_select_gpio(),
+      .reset_gpio = nullptr,
+      .tear_effect_gpio = nullptr,
+      .spi_device_8_bit = bus.device_8_bit(),
+      .spi_device_16_bit = bus.device_16_bit(),
+      .screen_width = kDisplaySize.width,
+      .screen_height = kDisplaySize.height,
+  });
+  Display display(driver, kDisplaySize, fb_pool);
+
+  Framebuffer fb = display.GetFramebuffer();
+  ASSERT_TRUE(fb.is_valid());
+  const Status status = display.ReleaseFramebuffer(std::move(fb));
+#if DISPLAY_RESIZE
+  // The display resizes the framebuffer itself.
+  EXPECT_EQ(OkStatus(), status);
+  EXPECT_LE(kDisplaySize.width * kDisplaySize.height * sizeof(color_rgb565_t),
+            bus.num_data_bytes());
+#else
+  EXPECT_EQ(Status::OutOfRange(), status);
+  EXPECT_EQ(0u, bus.writes().size());
+#endif
+  // Either way the framebuffer is back in the pool.
+  EXPECT_EQ(BufferState::kFree, fb_pool.buffer_state(0));
+}
+
+TEST(Display, ReleaseDirtyRegionsUnsupported) {
+  constexpr pw::math::Size<uint16_t> kFramebufferSize{8, 8};
+  constexpr uint16_t kFramebufferRowBytes =
+      sizeof(color_rgb565_t) * kFramebufferSize.width;
+  color_rgb565_t pixel_data[kFramebufferSize.width * kFramebufferSize.height];
+  pw::Vector<void*, 1> pixel_buffers{pixel_data};
+  FramebufferPool fb_pool({
+      .fb_addr = pixel_buffers,
+      .dimensions = kFramebufferSize,
+      .row_bytes = kFramebufferRowBytes,
+      .pixel_format = PixelFormat::RGB565,
+  });
+
+  TestDisplayDriver test_driver(Framebuffer(
+      pixel_data, PixelFormat::RGB565, kFramebufferSize, kFramebufferRowBytes));
+  Display display(test_driver, kFramebufferSize, fb_pool);
+
+  Framebuffer fb = display.GetFramebuffer();
+  display.MarkDirty({0, 0, 2, 2});
+  EXPECT_EQ(OkStatus(), display.ReleaseFramebuffer(std::move(fb)));
+  ASSERT_EQ(1, test_driver.GetNumCalls());
+  EXPECT_EQ(CallFunc::ReleaseFramebuffer, test_driver.GetCall(0).call_func);
+}
+
+TEST(Display, ReleaseIndexed) {
+  constexpr pw::math::Size<uint16_t> kFramebufferSize{3, 2};
+  constexpr uint16_t kFramebufferRowBytes = 2;
+  constexpr color_rgb565_t kPalette[] = {0x0000, 0xf800, 0x07e0, 0x001f};
+  uint8_t pixel_data[kFramebufferRowBytes * kFramebufferSize.height] = {
+      0x12, 0x30,  // Row 0: 1, 2, 3.
+      0x01, 0x20,  // Row 1: 0, 1, 2.
+  };
+  pw::Vector<void*, 1> pixel_buffers{pixel_data};
+  FramebufferPool fb_pool({
+      .fb_addr = pixel_buffers,
+      .dimensions = kFramebufferSize,
+      .row_bytes = kFramebufferRowBytes,
+      .pixel_format = PixelFormat::I4,
+      .palette = kPalette,
+  });
+
+  TestDisplayDriver test_driver(Framebuffer(
+      pixel_data, PixelFormat::I4, kFramebufferSize, kFramebufferRowBytes));
+  test_driver.SetSupportsRegionWrite(true);
+  Display display(test_driver, kFramebufferSize, fb_pool);
+
+  color_rgb565_t screen[kFramebufferSize.width * kFramebufferSize.height] = {};
+  test_driver.SetScreen(screen);
+
+  // Both rows are converted and sent together.
+  Framebuffer fb = display.GetFramebuffer();
+  EXPECT_EQ(OkStatus(), display.ReleaseFramebuffer(std::move(fb)));
+  ASSERT_EQ(1, test_driver.GetNumCalls());
+  const auto& call = test_driver.GetCall(0);
+  EXPECT_EQ(CallFunc::WriteRect, call.call_func);
+  EXPECT_EQ((pw::math::Rect<uint16_t>{0, 0, 3, 2}), call.write_rect.rect);
+  EXPECT_EQ(3, call.write_rect.stride);
+  constexpr color_rgb565_t kExpected[] = {
+      0xf800, 0x07e0, 0x001f, 0x0000, 0xf800, 0x07e0};
+  EXPECT_TRUE(std::equal(std::begin(kExpected),
+                         std::end(kExpected),
+                         std::begin(screen),
+                         std::end(screen)));
+
+  // The framebuffer was returned to the pool.
+  EXPECT_TRUE(display.GetFramebuffer().is_valid());
+}
+
+TEST(Display, ReleaseIndexedDirtyRegions) {
+  // Three rows fit in the conversion buffer at a time.
+  constexpr pw::math::Size<uint16_t> kFramebufferSize{300, 8};
+  constexpr uint16_t kFramebufferRowBytes = kFramebufferSize.width;
+  color_rgb565_t palette[256];
+  for (size_t i = 0; i < std::size(palette); i++) {
+    palette[i] = static_cast<color_rgb565_t>(i * 3);
+  }
+  uint8_t pixel_data[kFramebufferRowBytes * kFramebufferSize.height];
+  for (size_t i = 0; i < std::size(pixel_data); i++) {
+    pixel_data[i] = static_cast<uint8_t>(i);
+  }
+  pw::Vector<void*, 1> pixel_buffers{pixel_data};
+  FramebufferPool fb_pool({
+      .fb_addr = pixel_buffers,
+      .dimensions = kFramebufferSize,
+      .row_bytes = kFramebufferRowBytes,
+      .pixel_format = PixelFormat::I8,
+      .palette = palette,
+  });
+
+  TestDisplayDriver test_driver(Framebuffer(
+      pixel_data, PixelFormat::I8, kFramebufferSize, kFramebufferRowBytes));
+  Display display(test_driver, kFramebufferSize, fb_pool);
+  color_rgb565_t screen[kFramebufferSize.width * kFramebufferSize.height] = {};
+  test_driver.SetScreen(screen);
+
+  // Only the dirty region is sent, even though the driver does not support
+  // region writes.
+  Framebuffer fb = display.GetFramebuffer();
+  display.MarkDirty({10, 1, 3, 2});
+  EXPECT_EQ(OkStatus(), display.ReleaseFramebuffer(std::move(fb)));
+  ASSERT_EQ(1, test_driver.GetNumCalls());
+  EXPECT_EQ(CallFunc::WriteRect, test_driver.GetCall(0).call_func);
+  EXPECT_EQ((pw::math::Rect<uint16_t>{10, 1, 3, 2}),
+            test_driver.GetCall(0).write_rect.rect);
+  EXPECT_EQ(3, test_driver.GetCall(0).write_rect.stride);
+  EXPECT_EQ(palette[static_cast<uint8_t>(310)], screen[310]);
+  EXPECT_EQ(palette[static_cast<uint8_t>(612)], screen[612]);
+  EXPECT_EQ(0, screen[309]);
+  EXPECT_EQ(0, screen[613]);
+
+  // With nothing marked dirty every row is sent, a burst at a time.
+  fb = display.GetFramebuffer();
+  EXPECT_EQ(OkStatus(), display.ReleaseFramebuffer(std::move(fb)));
   ASSERT_EQ(4, test_driver.GetNumCalls());
+  EXPECT_EQ((pw::math::Rect<uint16_t>{0, 0, 300, 3}),
+            test_driver.GetCall(1).write_rect.rect);
+  EXPECT_EQ((pw::math::Rect<uint16_t>{0, 3, 300, 3}),
+            test_driver.GetCall(2).write_rect.rect);
+  EXPECT_EQ((pw::math::Rect<uint16_t>{0, 6, 300, 2}),
+            test_driver.GetCall(3).write_rect.rect);
+  for (size_t i = 0; i < std::size(screen); i++) {
+    ASSERT_EQ(palette[pixel_data[i]], screen[i]) << "pixel " << i;
+  }
+}
+
+TEST(Display, ReleaseIndexedWideRows) {
+  // Wider than the conversion buffer, so each row is sent in two parts.
+  constexpr pw::math::Size<uint16_t> kFramebufferSize{1100, 2};
+  constexpr uint16_t kFramebufferRowBytes = kFramebufferSize.width / 2;
+  constexpr color_rgb565_t kPalette[] = {0x0000, 0xf800, 0x07e0, 0x001f};
+  uint8_t pixel_data[kFramebufferRowBytes * kFramebufferSize.height];
+  for (size_t i = 0; i < std::size(pixel_data); i++) {
+    pixel_data[i] = static_cast<uint8_t>(i % 4);
+  }
+  pw::Vector<void*, 1> pixel_buffers{pixel_data};
+  FramebufferPool fb_pool({
+      .fb_addr = pixel_buffers,
+      .dimensions = kFramebufferSize,
+      .row_bytes = kFramebufferRowBytes,
+      .pixel_format = PixelFormat::I4,
+      .palette = kPalette,
+  });
+
+  TestDisplayDriver test_driver(Framebuffer(
+      pixel_data, PixelFormat::I4, kFramebufferSize, kFramebufferRowBytes));
+  Display display(test_driver, kFramebufferSize, fb_pool);
+  color_rgb565_t screen[kFramebufferSize.width * kFramebufferSize.height] = {};
+  test_driver.SetScreen(screen);
+
+  Framebuffer fb = display.GetFramebuffer();
+  EXPECT_EQ(OkStatus(), display.ReleaseFramebuffer(std::move(fb)));
+  ASSERT_EQ(4, test_driver.GetNumCalls());
+  EXPECT_EQ((pw::math::Rect<uint16_t>{0, 0, 1024, 1}),
+            test_driver.GetCall(0).write_rect.rect);
+  EXPECT_EQ((pw::math::Rect<uint16_t>{1024, 0, 76, 1}),
+            test_driver.GetCall(1).write_rect.rect);
+  EXPECT_EQ((pw::math::Rect<uint16_t>{0, 1, 1024, 1}),
+            test_driver.GetCall(2).write_rect.rect);
+  EXPECT_EQ((pw::math::Rect<uint16_t>{1024, 1, 76, 1}),
+            test_driver.GetCall(3).write_rect.rect);
+  for (size_t i = 0; i < std::size(screen); i++) {
+    // Each byte holds two pixels, the first in the high nibble.
+    const uint8_t index =
+        i % 2 == 0 ? pixel_data[i / 2] >> 4 : pixel_data[i / 2] & 0xf;
+    ASSERT_EQ(kPalette[index], screen[i]) << "pixel " << i;
+  }
+}
+
+TEST(Display, IsBanded) {
+  constexpr Size kDisplaySize{4, 5};
+  color_rgb565_t pixel_data[kDisplaySize.width * kDisplaySize.height];
+  TestDisplayDriver test_driver(Framebuffer(pixel_data,
+                                            PixelFormat::RGB565,
+                                            kDisplaySize,
+                                            sizeof(color_rgb565_t) * 4));
+
+  pw::Vector<void*, 1> pixel_buffers{pixel_data};
+  FramebufferPool band_pool({
+      .fb_addr = pixel_buffers,
+      .dimensions = {4, 2},
+      .row_bytes = sizeof(color_rgb565_t) * 4,
+      .pixel_format = PixelFormat::RGB565,
+  });
+  EXPECT_TRUE(Display(test_driver, kDisplaySize, band_pool).IsBanded());
+
+  FramebufferPool full_pool({
+      .fb_addr = pixel_buffers,
+      .dimensions = kDisplaySize,
+      .row_bytes = sizeof(color_rgb565_t) * 4,
+      .pixel_format = PixelFormat::RGB565,
+  });
+  EXPECT_FALSE(Display(test_driver, kDisplaySize, full_pool).IsBanded());
+
+  // A pool without buffers, as used with drivers which draw directly.
+  pw::Vector<void*, 1> no_buffers;
+  FramebufferPool empty_pool({
+      .fb_addr = no_buffers,
+      .dimensions = {0, 0},
+      .row_bytes = 0,
+      .pixel_format = PixelFormat::RGB565,
+  });
+  Display empty_display(test_driver, kDisplaySize, empty_pool);
+  EXPECT_FALSE(empty_display.IsBanded());
+  EXPECT_EQ(Status::FailedPrecondition(),
+            empty_display.DrawBands([](Framebuffer&) {}));
+}
+
+TEST(Display, DrawBands) {
+  constexpr Size kDisplaySize{4, 5};
+  constexpr Size kBandSize{4, 2};
+  constexpr uint16_t kBandRowBytes = sizeof(color_rgb565_t) * kBandSize.width;
+  color_rgb565_t band_data[2][kBandSize.width * kBandSize.height];
+  pw::Vector<void*, 2> pixel_buffers{band_data[0], band_data[1]};
+  FramebufferPool fb_pool({
+      .fb_addr = pixel_buffers,
+      .dimensions = kBandSize,
+      .row_bytes = kBandRowBytes,
+      .pixel_format = PixelFormat::RGB565,
+  });
+
+  TestDisplayDriver test_driver(Framebuffer(
+      band_data[0], PixelFormat::RGB565, kDisplaySize, kBandRowBytes));
+  test_driver.SetSupportsRegionWrite(true);
+  Display display(test_driver, kDisplaySize, fb_pool);
+  EXPECT_TRUE(display.IsBanded());
+
+  int num_bands = 0;
+  EXPECT_EQ(OkStatus(), display.DrawBands([&](Framebuffer& band) {
+    EXPECT_EQ(kBandSize, band.size());
+    EXPECT_EQ(num_bands * kBandSize.height, band.origin().y);
+    num_bands++;
+  }));
+  EXPECT_EQ(3, num_bands);
+
+  // The bands alternate between the two buffers, and the last one is clipped
+  // to the display.
+  ASSERT_EQ(3, test_driver.GetNumCalls());
   auto call = test_driver.GetCall(0);
-  EXPECT_EQ(CallFunc::WriteRow, call.call_func);
-  EXPECT_EQ(8U, call.write_row.num_pixels);
-  EXPECT_EQ(0, call.write_row.row_idx);
-  EXPECT_EQ(0, call.write_row.col_idx);
+  EXPECT_EQ(CallFunc::WriteRegion, call.call_func);
+  EXPECT_EQ(band_data[0], call.write_region.fb_data);
+  EXPECT_EQ((pw::math::Rect<uint16_t>{0, 0, 4, 2}), call.write_region.region);
+  call = test_driver.GetCall(1);
+  EXPECT_EQ(band_data[1], call.write_region.fb_data);
+  EXPECT_EQ((pw::math::Rect<uint16_t>{0, 2, 4, 2}), call.write_region.region);
+  EXPECT_EQ(2, call.write_region.fb_origin.y);
+  call = test_driver.GetCall(2);
+  EXPECT_EQ(band_data[0], call.write_region.fb_data);
+  EXPECT_EQ((pw::math::Rect<uint16_t>{0, 4, 4, 1}), call.write_region.region);
+  EXPECT_EQ(4, call.write_region.fb_origin.y);
+
+  // Both buffers were returned to the pool.
+  EXPECT_TRUE(fb_pool.TryGetFramebuffer().is_valid());
+  EXPECT_TRUE(fb_pool.TryGetFramebuffer().is_valid());
+}
 
+TEST(Display, DrawBandsWithoutRegionWrite) {
+  constexpr Size kDisplaySize{3, 3};
+  constexpr Size kBandSize{3, 2};
+  constexpr uint16_t kBandRowBytes = sizeof(color_rgb565_t) * kBandSize.width;
+  color_rgb565_t band_data[kBandSize.width * kBandSize.height];
+  pw::Vector<void*, 1> pixel_buffers{band_data};
+  FramebufferPool fb_pool({
+      .fb_addr = pixel_buffers,
+      .dimensions = kBandSize,
+      .row_bytes = kBandRowBytes,
+      .pixel_format = PixelFormat::RGB565,
+  });
+
+  TestDisplayDriver test_driver(Framebuffer(
+      band_data, PixelFormat::RGB565, kDisplaySize, kBandRowBytes));
+  std::array<color_rgb565_t, kDisplaySize.width * kDisplaySize.height> screen;
+  test_driver.SetScreen(screen);
+  Display display(test_driver, kDisplaySize, fb_pool);
+
+  // Every band draws the whole display in display coordinates.
+  EXPECT_EQ(OkStatus(), display.DrawBands([](Framebuffer& band) {
+    FramebufferWriter writer(band);
+    writer.Fill(0x1111);
+    writer.SetPixel(1, 0, 0xf800);
+    writer.FillSpan(2, 0, 1, 0x07e0);
+  }));
+
+  // Each band is sent with a single WriteRect(), clipped to the display.
+  ASSERT_EQ(2, test_driver.GetNumCalls());
+  auto call = test_driver.GetCall(0);
+  EXPECT_EQ(CallFunc::WriteRect, call.call_func);
+  EXPECT_EQ((pw::math::Rect<uint16_t>{0, 0, 3, 2}), call.write_rect.rect);
+  EXPECT_EQ(3, call.write_rect.stride);
   call = test_driver.GetCall(1);
-  EXPECT_EQ(CallFunc::WriteRow, call.call_func);
-  EXPECT_EQ(8U, call.write_row.num_pixels);
-  EXPECT_EQ(1, call.write_row.row_idx);
-  EXPECT_EQ(0, call.write_row.col_idx);
+  EXPECT_EQ(CallFunc::WriteRect, call.call_func);
+  EXPECT_EQ((pw::math::Rect<uint16_t>{0, 2, 3, 1}), call.write_rect.rect);
 
-  call = test_driver.GetCall(2);
-  EXPECT_EQ(CallFunc::WriteRow, call.call_func);
-  EXPECT_EQ(8U, call.write_row.num_pixels);
-  EXPECT_EQ(2, call.write_row.row_idx);
-  EXPECT_EQ(0, call.write_row.col_idx);
-
-  call = test_driver.GetCall(3);
-  EXPECT_EQ(CallFunc::WriteRow, call.call_func);
-  EXPECT_EQ(8U, call.write_row.num_pixels);
-  EXPECT_EQ(3, call.write_row.row_idx);
-  EXPECT_EQ(0, call.write_row.col_idx);
+  constexpr std::array<color_rgb565_t, kDisplaySize.width * kDisplaySize.height>
+      kExpected = {
+          0x1111, 0xf800, 0x1111,  //
+          0x1111, 0x1111, 0x1111,  //
+          0x07e0, 0x07e0, 0x1111,  //
+      };
+  EXPECT_EQ(kExpected, screen);
 }
 
-TEST(Display, ReleaseWideResize) {
-  // Display width > resize buffer (80 px.) will cause two writes per row.
-  constexpr Size kDisplaySize = {90, 4};
-  constexpr pw::math::Size<uint16_t> kFramebufferSize{2, 1};
-  constexpr size_t kNumPixels =
-      kFramebufferSize.width * kFramebufferSize.height;
+#if DISPLAY_RESIZE
+TEST(Display, ReleaseSmallResize) {
+  constexpr Size kDisplaySize = {8, 4};
+  constexpr Size kFramebufferSize{2, 1};
   constexpr uint16_t kFramebufferRowBytes =
       sizeof(color_rgb565_t) * kFramebufferSize.width;
-  color_rgb565_t pixel_data[kNumPixels];
+  color_rgb565_t pixel_data[] = {0xf800, 0x001f};
+  pw::Vector<void*, 1> pixel_buffers{pixel_data};
   FramebufferPool fb_pool({
-      .fb_addr = pixel_data,
-      .size = kFramebufferSize,
+      .fb_addr = pixel_buffers,
+      .dimensions = kFramebufferSize,
       .row_bytes = kFramebufferRowBytes,
       .pixel_format = PixelFormat::RGB565,
   });
 
-  TestDisplayDriver test_driver(
-      Framebuffer(pixel_data, kFramebufferSize, kFramebufferRowBytes));
-  Display display(test_driver, kDisplaySize);
+  TestDisplayDriver test_driver(Framebuffer(pixel_data,
+                                            PixelFormat::RGB565,
+                                            kDisplaySize,
+                                            kDisplaySize.width * 2));
+  Display display(test_driver, kDisplaySize, fb_pool);
   Framebuffer fb = display.GetFramebuffer();
   EXPECT_TRUE(fb.is_valid());
   EXPECT_EQ(kFramebufferSize, fb.size());
   EXPECT_EQ(0, test_driver.GetNumCalls());
 
+  // All of the display rows are resized into one buffer, and sent together.
   display.ReleaseFramebuffer(std::move(fb));
-  ASSERT_EQ(8, test_driver.GetNumCalls());
+  ASSERT_EQ(1, test_driver.GetNumCalls());
   auto call = test_driver.GetCall(0);
-  EXPECT_EQ(CallFunc::WriteRow, call.call_func);
-  EXPECT_EQ(80U, call.write_row.num_pixels);
-  EXPECT_EQ(0, call.write_row.row_idx);
-  EXPECT_EQ(0, call.write_row.col_idx);
+  EXPECT_EQ(CallFunc::WriteRect, call.call_func);
+  EXPECT_EQ((pw::math::Rect<uint16_t>{0, 0, 8, 4}), call.write_rect.rect);
+  EXPECT_EQ(8, call.write_rect.stride);
+}
 
-  call = test_driver.GetCall(1);
-  EXPECT_EQ(CallFunc::WriteRow, call.call_func);
-  EXPECT_EQ(10U, call.write_row.num_pixels);
-  EXPECT_EQ(0, call.write_row.row_idx);
-  EXPECT_EQ(80, call.write_row.col_idx);
+TEST(Display, ReleaseWideResize) {
+  constexpr Size kDisplaySize = {90, 4};
+  constexpr Size kFramebufferSize{2, 1};
+  constexpr uint16_t kFramebufferRowBytes =
+      sizeof(color_rgb565_t) * kFramebufferSize.width;
+  color_rgb565_t pixel_data[] = {0xf800, 0x001f};
+  pw::Vector<void*, 1> pixel_buffers{pixel_data};
+  FramebufferPool fb_pool({
+      .fb_addr = pixel_buffers,
+      .dimensions = kFramebufferSize,
+      .row_bytes = kFramebufferRowBytes,
+      .pixel_format = PixelFormat::RGB565,
+  });
 
-  call = test_driver.GetCall(2);
-  EXPECT_EQ(CallFunc::WriteRow, call.call_func);
-  EXPECT_EQ(80U, call.write_row.num_pixels);
-  EXPECT_EQ(1, call.write_row.row_idx);
-  EXPECT_EQ(0, call.write_row.col_idx);
-
-  call = test_driver.GetCall(3);
-  EXPECT_EQ(CallFunc::WriteRow, call.call_func);
-  EXPECT_EQ(10U, call.write_row.num_pixels);
-  EXPECT_EQ(1, call.write_row.row_idx);
-  EXPECT_EQ(80, call.write_row.col_idx);
-
-  call = test_driver.GetCall(4);
-  EXPECT_EQ(CallFunc::WriteRow, call.call_func);
-  EXPECT_EQ(80U, call.write_row.num_pixels);
-  EXPECT_EQ(2, call.write_row.row_idx);
-  EXPECT_EQ(0, call.write_row.col_idx);
-
-  call = test_driver.GetCall(5);
-  EXPECT_EQ(CallFunc::WriteRow, call.call_func);
-  EXPECT_EQ(10U, call.write_row.num_pixels);
-  EXPECT_EQ(2, call.write_row.row_idx);
-  EXPECT_EQ(80, call.write_row.col_idx);
-
-  call = test_driver.GetCall(6);
-  EXPECT_EQ(CallFunc::WriteRow, call.call_func);
-  EXPECT_EQ(80U, call.write_row.num_pixels);
-  EXPECT_EQ(3, call.write_row.row_idx);
-  EXPECT_EQ(0, call.write_row.col_idx);
-
-  call = test_driver.GetCall(7);
-  EXPECT_EQ(CallFunc::WriteRow, call.call_func);
-  EXPECT_EQ(10U, call.write_row.num_pixels);
-  EXPECT_EQ(3, call.write_row.row_idx);
-  EXPECT_EQ(80, call.write_row.col_idx);
+  TestDisplayDriver test_driver(Framebuffer(pixel_data,
+                                            PixelFormat::RGB565,
+                                            kDisplaySize,
+                                            kDisplaySize.width * 2));
+  std::array<color_rgb565_t, kDisplaySize.width * kDisplaySize.height> screen;
+  test_driver.SetScreen(screen);
+  Display display(test_driver, kDisplaySize, fb_pool);
+  display.ReleaseFramebuffer(display.GetFramebuffer());
+
+  ASSERT_EQ(1, test_driver.GetNumCalls());
+  EXPECT_EQ((pw::math::Rect<uint16_t>{0, 0, 90, 4}),
+            test_driver.GetCall(0).write_rect.rect);
+  for (uint16_t row = 0; row < kDisplaySize.height; row++) {
+    // Only the last column is past the midpoint of the framebuffer.
+    for (int col = 0; col < kDisplaySize.width; col++) {
+      EXPECT_EQ(col == 89 ? 0x001f : 0xf800,
+                screen[row * kDisplaySize.width + col]);
+    }
+  }
+}
+
+// Resize a framebuffer of |fb_size| to a 100x30 display, and check every pixel
+// against the nearest-neighbor mapping.
+void ExpectResize(Size fb_size) {
+  constexpr Size kDisplaySize = {100, 30};
+  std::array<color_rgb565_t, 250 * 70> pixel_data;
+  ASSERT_LE(fb_size.width * fb_size.height, pixel_data.size());
+  for (size_t i = 0; i < pixel_data.size(); i++) {
+    pixel_data[i] = static_cast<color_rgb565_t>(i);
+  }
+  pw::Vector<void*, 1> pixel_buffers{pixel_data.data()};
+  FramebufferPool fb_pool({
+      .fb_addr = pixel_buffers,
+      .dimensions = fb_size,
+      .row_bytes = static_cast<uint16_t>(fb_size.width * 2),
+      .pixel_format = PixelFormat::RGB565,
+  });
+
+  TestDisplayDriver test_driver(Framebuffer(
+      pixel_data.data(), PixelFormat::RGB565, kDisplaySize, 200));
+  std::array<color_rgb565_t, kDisplaySize.width * kDisplaySize.height> screen;
+  test_driver.SetScreen(screen);
+  Display display(test_driver, kDisplaySize, fb_pool);
+  EXPECT_EQ(OkStatus(), display.ReleaseFramebuffer(display.GetFramebuffer()));
+
+  // Rows are sent in bursts which fill the resize buffer.
+  ASSERT_EQ(2, test_driver.GetNumCalls());
+  EXPECT_EQ(CallFunc::WriteRect, test_driver.GetCall(0).call_func);
+  EXPECT_EQ((pw::math::Rect<uint16_t>{0, 0, 100, 19}),
+            test_driver.GetCall(0).write_rect.rect);
+  EXPECT_EQ((pw::math::Rect<uint16_t>{0, 19, 100, 11}),
+            test_driver.GetCall(1).write_rect.rect);
+
+  for (int row = 0; row < kDisplaySize.height; row++) {
+    const int src_row = row * (fb_size.height - 1) / (kDisplaySize.height - 1);
+    for (int col = 0; col < kDisplaySize.width; col++) {
+      const int src_col = col * (fb_size.width - 1) / (kDisplaySize.width - 1);
+      ASSERT_EQ(pixel_data[src_row * fb_size.width + src_col],
+                screen[row * kDisplaySize.width + col])
+          << col << "," << row;
+    }
+  }
+}
+
+TEST(Display, ReleaseResizeUp) { ExpectResize({37, 11}); }
+
+TEST(Display, ReleaseResizeDown) { ExpectResize({250, 70}); }
+
+#if DISPLAY_RESIZE_FILTERS
+
+// Resize |pixels|, a framebuffer of |fb_size|, to a display of |display_size|
+// with |mode|, writing the display's pixels to |screen|.
+void ResizeToScreen(span<color_rgb565_t> pixels,
+                    Size fb_size,
+                    Size display_size,
+                    Display::ResizeMode mode,
+                    span<color_rgb565_t> screen) {
+  ASSERT_EQ(pixels.size(), static_cast<size_t>(fb_size.width * fb_size.height));
+  ASSERT_EQ(screen.size(),
+            static_cast<size_t>(display_size.width * display_size.height));
+  pw::Vector<void*, 1> pixel_buffers{pixels.data()};
+  FramebufferPool fb_pool({
+      .fb_addr = pixel_buffers,
+      .dimensions = fb_size,
+      .row_bytes = static_cast<uint16_t>(fb_size.width * 2),
+      .pixel_format = PixelFormat::RGB565,
+  });
+
+  TestDisplayDriver test_driver(
+      Framebuffer(pixels.data(),
+                  PixelFormat::RGB565,
+                  display_size,
+                  static_cast<uint16_t>(display_size.width * 2)));
+  test_driver.SetScreen(screen);
+  Display display(test_driver, display_size, fb_pool);
+  EXPECT_EQ(Display::ResizeMode::kNearestNeighbor, display.GetResizeMode());
+  display.SetResizeMode(mode);
+  EXPECT_EQ(OkStatus(), display.ReleaseFramebuffer(display.GetFramebuffer()));
+}
+
+TEST(Display, ResizeBilinearUp) {
+  constexpr Size kFramebufferSize{3, 2};
+  constexpr Size kDisplaySize{5, 3};
+  color_rgb565_t pixels[] = {
+      0xf800, 0x07e0, 0x001f,  // Red, green, blue.
+      0x0000, 0xffff, 0x8410,  // Black, white, grey.
+  };
+  std::array<color_rgb565_t, kDisplaySize.width * kDisplaySize.height> screen;
+  ResizeToScreen(pixels,
+                 kFramebufferSize,
+                 kDisplaySize,
+                 Display::ResizeMode::kBilinear,
+                 screen);
+
+  // The corners are the framebuffer's corners, and every other pixel is
+  // halfway between two or four framebuffer pixels.
+  constexpr std::array<color_rgb565_t, kDisplaySize.width * kDisplaySize.height>
+      kExpected = {
+          // clang-format off
+          0xf800, 0x7be0, 0x07e0, 0x03ef, 0x001f,
+          0x7800, 0x7be7, 0x7fef, 0x5cf3, 0x4217,
+          0x0000, 0x7bef, 0xffff, 0xbdf7, 0x8410,
+          // clang-format on
+      };
+  EXPECT_EQ(kExpected, screen);
+}
+
+TEST(Display, ResizeBoxDown) {
+  constexpr Size kFramebufferSize{6, 4};
+  constexpr Size kDisplaySize{4, 2};
+  color_rgb565_t pixels[] = {
+      0xf800, 0xf800, 0x07e0, 0x07e0, 0x001f, 0x0000,  //
+      0xf800, 0x0000, 0x07e0, 0x07e0, 0x001f, 0x0000,  //
+      0xffff, 0xffff, 0x0000, 0xffff, 0x8410, 0x8410,  //
+      0xffff, 0xffff, 0xffff, 0x0000, 0x8410, 0x8410,  //
+  };
+  std::array<color_rgb565_t, kDisplaySize.width * kDisplaySize.height> screen;
+  ResizeToScreen(pixels,
+                 kFramebufferSize,
+                 kDisplaySize,
+                 Display::ResizeMode::kBox,
+                 screen);
+
+  // Display columns alternate between averaging one and two framebuffer
+  // columns, and each display row averages two framebuffer rows.
+  constexpr std::array<color_rgb565_t, kDisplaySize.width * kDisplaySize.height>
+      kExpected = {
+          // clang-format off
+          0xf800, 0x4400, 0x07e0, 0x0010,
+          0xffff, 0xc618, 0x8410, 0x8410,
+          // clang-format on
+      };
+  EXPECT_EQ(kExpected, screen);
+}
+
+TEST(Display, ResizeBoxUp) {
+  constexpr Size kFramebufferSize{2, 2};
+  constexpr Size kDisplaySize{4, 3};
+  color_rgb565_t pixels[] = {0xf800, 0x07e0, 0x001f, 0x8410};
+  std::array<color_rgb565_t, kDisplaySize.width * kDisplaySize.height> screen;
+  ResizeToScreen(pixels,
+                 kFramebufferSize,
+                 kDisplaySize,
+                 Display::ResizeMode::kBox,
+                 screen);
+
+  // Each framebuffer pixel becomes a block of display pixels.
+  constexpr std::array<color_rgb565_t, kDisplaySize.width * kDisplaySize.height>
+      kExpected = {
+          0xf800, 0xf800, 0x07e0, 0x07e0,  //
+          0xf800, 0xf800, 0x07e0, 0x07e0,  //
+          0x001f, 0x001f, 0x8410, 0x8410,  //
+      };
+  EXPECT_EQ(kExpected, screen);
+}
+
+TEST(Display, ResizeFilteredSolidColor) {
+  // Blending or averaging pixels of the same color leaves it unchanged.
+  constexpr Size kSizes[] = {{7, 5}, {40, 27}, {200, 90}};
+  constexpr Size kDisplaySize{40, 27};
+  std::array<color_rgb565_t, 200 * 90> pixels;
+  std::array<color_rgb565_t, kDisplaySize.width * kDisplaySize.height> screen;
+  for (Display::ResizeMode mode :
+       {Display::ResizeMode::kBilinear, Display::ResizeMode::kBox}) {
+    for (Size fb_size : kSizes) {
+      if (fb_size == kDisplaySize) {
+        continue;
+      }
+      const size_t num_pixels = fb_size.width * fb_size.height;
+      std::fill_n(pixels.begin(), num_pixels, color_rgb565_t{0xa5a5});
+      screen.fill(0);
+      ResizeToScreen(span(pixels.data(), num_pixels),
+                     fb_size,
+                     kDisplaySize,
+                     mode,
+                     screen);
+      for (color_rgb565_t pixel : screen) {
+        ASSERT_EQ(0xa5a5, pixel);
+      }
+    }
+  }
+}
+
+TEST(Display, ResizeBilinearGradient) {
+  // A horizontal ramp of green stays a ramp, with each display pixel within
+  // one step of the exact blend, and the ends matching the framebuffer.
+  constexpr Size kFramebufferSize{64, 3};
+  constexpr Size kDisplaySize{150, 7};
+  std::array<color_rgb565_t, kFramebufferSize.width * kFramebufferSize.height>
+      pixels;
+  for (int row = 0; row < kFramebufferSize.height; row++) {
+    for (int col = 0; col < kFramebufferSize.width; col++) {
+      pixels[row * kFramebufferSize.width + col] =
+          static_cast<color_rgb565_t>(col << 5);
+    }
+  }
+  std::array<color_rgb565_t, kDisplaySize.width * kDisplaySize.height> screen;
+  ResizeToScreen(pixels,
+                 kFramebufferSize,
+                 kDisplaySize,
+                 Display::ResizeMode::kBilinear,
+                 screen);
+
+  for (int row = 0; row < kDisplaySize.height; row++) {
+    const color_rgb565_t* line = &screen[row * kDisplaySize.width];
+    EXPECT_EQ(0, line[0]);
+    EXPECT_EQ(63 << 5, line[kDisplaySize.width - 1]);
+    for (int col = 0; col < kDisplaySize.width; col++) {
+      const int green = line[col] >> 5;
+      const double exact = col * 63.0 / (kDisplaySize.width - 1);
+      EXPECT_NEAR(exact, green, 1.0) << col << "," << row;
+      EXPECT_EQ(0, line[col] & 0xf81f);
+      if (col > 0) {
+        EXPECT_GE(line[col], line[col - 1]);
+      }
+    }
+  }
 }
+#endif  // if DISPLAY_RESIZE_FILTERS
 #endif  // if DISPLAY_RESIZE
 
 }  // namespace
@@ -0,0 +1,94 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#include "pw_display/present_queue.h"
+
+#include <utility>
+
+#include "pw_assert/assert.h"
+
+using pw::framebuffer::Framebuffer;
+
+namespace pw::display {
+
+PresentQueue::PresentQueue(Display& display, const Config& config)
+    : display_(display),
+      queue_depth_(config.queue_depth),
+      dirty_region_({display.GetWidth(), display.GetHeight()}),
+      num_presented_(0),
+      num_written_(0),
+      stop_requested_(false) {
+  PW_ASSERT(queue_depth_ >= 1 && queue_depth_ <= kMaxQueueDepth);
+  free_frames_.release(queue_depth_);
+}
+
+PresentQueue::Fence PresentQueue::Present(Framebuffer framebuffer) {
+  PW_ASSERT(framebuffer.is_valid());
+  free_frames_.acquire();
+
+  const uint32_t sequence = num_presented_.load() + 1;
+  Frame& frame = frames_[present_index_];
+  present_index_ = (present_index_ + 1) % queue_depth_;
+  frame.framebuffer = std::move(framebuffer);
+  const auto rects = dirty_region_.rects();
+  frame.dirty_rects.assign(rects.begin(), rects.end());
+  dirty_region_.Clear();
+
+  num_presented_.store(sequence);
+  queued_frames_.release();
+  return Fence(sequence);
+}
+
+bool PresentQueue::IsSignaled(Fence fence) const {
+  // Compare as signed so that the frame counters may wrap.
+  return static_cast<int32_t>(num_written_.load() - fence.sequence_) >= 0;
+}
+
+void PresentQueue::WaitForFence(Fence fence) {
+  while (!IsSignaled(fence)) {
+    frame_written_.acquire();
+  }
+}
+
+void PresentQueue::RequestStop() {
+  stop_requested_.store(true);
+  queued_frames_.release();
+}
+
+void PresentQueue::Run() {
+  while (true) {
+    queued_frames_.acquire();
+    const uint32_t num_written = num_written_.load();
+    if (num_written == num_presented_.load()) {
+      // Woken without a frame, which only happens when stopping.
+      PW_ASSERT(stop_requested_.load());
+      return;
+    }
+
+    Frame& frame = frames_[write_index_];
+    write_index_ = (write_index_ + 1) % queue_depth_;
+    for (const pw::math::Rect<uint16_t>& rect : frame.dirty_rects) {
+      display_.MarkDirty(rect);
+    }
+    // The display returns the framebuffer to its pool even if the write
+    // fails, so a frame which cannot be written is dropped and the queue
+    // carries on.
+    display_.ReleaseFramebuffer(std::move(frame.framebuffer)).IgnoreError();
+
+    num_written_.store(num_written + 1);
+    free_frames_.release();
+    frame_written_.release();
+  }
+}
+
+}  // namespace pw::display
@@ -0,0 +1,210 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#include "pw_display/present_queue.h"
+
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "pw_color/color.h"
+#include "pw_containers/vector.h"
+#include "pw_display/display.h"
+#include "pw_display_driver/display_driver.h"
+#include "pw_framebuffer/writer.h"
+#include "pw_framebuffer_pool/framebuffer_pool.h"
+#include "pw_sync/counting_semaphore.h"
+#include "pw_sync/thread_notification.h"
+#include "pw_thread/test_threads.h"
+#include "pw_thread/thread.h"
+
+using pw::color::color_rgb565_t;
+using pw::display_driver::DisplayDriver;
+using pw::framebuffer::Framebuffer;
+using pw::framebuffer::FramebufferWriter;
+using pw::framebuffer::PixelFormat;
+using pw::framebuffer_pool::FramebufferPool;
+using Rect = pw::math::Rect<uint16_t>;
+
+namespace pw::display {
+namespace {
+
+constexpr pw::math::Size<uint16_t> kSize{8, 4};
+constexpr uint16_t kRowBytes = sizeof(color_rgb565_t) * kSize.width;
+
+// A display driver whose writes don't complete until the test allows them,
+// standing in for a slow SPI transfer.
+class SlowDisplayDriver : public DisplayDriver {
+ public:
+  Status Init() override { return OkStatus(); }
+
+  void WriteFramebuffer(Framebuffer framebuffer,
+                        WriteCallback write_callback) override {
+    Write(std::move(framebuffer), {0, 0, 0, 0}, std::move(write_callback));
+  }
+
+  void WriteRegion(Framebuffer framebuffer,
+                   const Rect& region,
+                   WriteCallback write_callback) override {
+    Write(std::move(framebuffer), region, std::move(write_callback));
+  }
+
+  Status WriteRow(span<uint16_t>, uint16_t, uint16_t) override {
+    return OkStatus();
+  }
+
+  uint16_t GetWidth() const override { return kSize.width; }
+  uint16_t GetHeight() const override { return kSize.height; }
+  bool SupportsRegionWrite() const override { return true; }
+
+  // Released each time a write starts.
+  pw::sync::ThreadNotification write_started;
+  // Acquired by each write before it completes.
+  pw::sync::CountingSemaphore write_allowed;
+
+  // The framebuffer and region (empty for full writes) of each write, in
+  // order.
+  pw::Vector<void*, 8> written_buffers;
+  pw::Vector<Rect, 8> written_regions;
+
+ private:
+  void Write(Framebuffer framebuffer,
+             const Rect& region,
+             WriteCallback write_callback) {
+    write_started.release();
+    write_allowed.acquire();
+    written_buffers.push_back(framebuffer.data());
+    written_regions.push_back(region);
+    write_callback(std::move(framebuffer), OkStatus());
+  }
+};
+
+TEST(PresentQueue, DrawOverlapsWrite) {
+  color_rgb565_t pixel_data[2][kSize.width * kSize.height];
+  pw::Vector<void*, 2> pixel_buffers{pixel_data[0], pixel_data[1]};
+  FramebufferPool fb_pool({
+      .fb_addr = pixel_buffers,
+      .dimensions = kSize,
+      .row_bytes = kRowBytes,
+      .pixel_format = PixelFormat::RGB565,
+  });
+  SlowDisplayDriver driver;
+  Display display(driver, kSize, fb_pool);
+  PresentQueue present_queue(display, {.queue_depth = 2});
+  pw::thread::Thread present_thread(pw::thread::test::TestOptionsThread0(),
+                                    present_queue);
+
+  Framebuffer fb = present_queue.GetFramebuffer();
+  void* const first_buffer = fb.data();
+  const PresentQueue::Fence first_fence = present_queue.Present(std::move(fb));
+
+  // Wait until the first frame is stuck being written to the display.
+  driver.write_started.acquire();
+  EXPECT_FALSE(present_queue.IsSignaled(first_fence));
+
+  // Draw and present the next frame while the first is still being written.
+  fb = present_queue.GetFramebuffer();
+  void* const second_buffer = fb.data();
+  EXPECT_NE(first_buffer, second_buffer);
+  {
+    FramebufferWriter writer(fb);
+    writer.Fill(0x1234);
+  }
+  const PresentQueue::Fence second_fence = present_queue.Present(std::move(fb));
+  EXPECT_FALSE(present_queue.IsSignaled(first_fence));
+  EXPECT_FALSE(present_queue.IsSignaled(second_fence));
+
+  // Let both writes finish.
+  driver.write_allowed.release(2);
+  present_queue.WaitForFence(second_fence);
+  EXPECT_TRUE(present_queue.IsSignaled(first_fence));
+  EXPECT_TRUE(present_queue.IsSignaled(second_fence));
+
+  present_queue.RequestStop();
+  present_thread.join();
+
+  EXPECT_EQ(2u, driver.written_buffers.size());
+  EXPECT_EQ(first_buffer, driver.written_buffers[0]);
+  EXPECT_EQ(second_buffer, driver.written_buffers[1]);
+}
+
+TEST(PresentQueue, DirtyRegionsFollowTheirFrame) {
+  color_rgb565_t pixel_data[2][kSize.width * kSize.height];
+  pw::Vector<void*, 2> pixel_buffers{pixel_data[0], pixel_data[1]};
+  FramebufferPool fb_pool({
+      .fb_addr = pixel_buffers,
+      .dimensions = kSize,
+      .row_bytes = kRowBytes,
+      .pixel_format = PixelFormat::RGB565,
+  });
+  SlowDisplayDriver driver;
+  driver.write_allowed.release(8);
+  Display display(driver, kSize, fb_pool);
+  PresentQueue present_queue(display, {.queue_depth = 1});
+  pw::thread::Thread present_thread(pw::thread::test::TestOptionsThread0(),
+                                    present_queue);
+
+  Framebuffer fb = present_queue.GetFramebuffer();
+  present_queue.MarkDirty({1, 1, 2, 2});
+  present_queue.Present(std::move(fb));
+
+  fb = present_queue.GetFramebuffer();
+  const PresentQueue::Fence fence = present_queue.Present(std::move(fb));
+  present_queue.WaitForFence(fence);
+
+  present_queue.RequestStop();
+  present_thread.join();
+
+  // The first frame only wrote its dirty region, and the second (with no
+  // dirty regions) wrote the entire framebuffer.
+  EXPECT_EQ(2u, driver.written_regions.size());
+  EXPECT_EQ((Rect{1, 1, 2, 2}), driver.written_regions[0]);
+  EXPECT_EQ((Rect{0, 0, 0, 0}), driver.written_regions[1]);
+}
+
+TEST(PresentQueue, FramesWrittenInOrderAroundTheRing) {
+  color_rgb565_t pixel_data[2][kSize.width * kSize.height];
+  pw::Vector<void*, 2> pixel_buffers{pixel_data[0], pixel_data[1]};
+  FramebufferPool fb_pool({
+      .fb_addr = pixel_buffers,
+      .dimensions = kSize,
+      .row_bytes = kRowBytes,
+      .pixel_format = PixelFormat::RGB565,
+  });
+  SlowDisplayDriver driver;
+  driver.write_allowed.release(8);
+  Display display(driver, kSize, fb_pool);
+  // A queue depth which is not a power of two, used several times over.
+  PresentQueue present_queue(display, {.queue_depth = 3});
+  pw::thread::Thread present_thread(pw::thread::test::TestOptionsThread0(),
+                                    present_queue);
+
+  constexpr uint16_t kNumFrames = 8;
+  PresentQueue::Fence fence;
+  for (uint16_t i = 0; i < kNumFrames; i++) {
+    Framebuffer fb = present_queue.GetFramebuffer();
+    present_queue.MarkDirty({i, 0, 1, 1});
+    fence = present_queue.Present(std::move(fb));
+  }
+  present_queue.WaitForFence(fence);
+
+  present_queue.RequestStop();
+  present_thread.join();
+
+  ASSERT_EQ(kNumFrames, driver.written_regions.size());
+  for (uint16_t i = 0; i < kNumFrames; i++) {
+    EXPECT_EQ((Rect{i, 0, 1, 1}), driver.written_regions[i]);
+  }
+}
+
+}  // namespace
+}  // namespace pw::display
@@ -0,0 +1,59 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_containers/vector.h"
+#include "pw_math/rect.h"
+#include "pw_math/size.h"
+#include "pw_span/span.h"
+
+namespace pw::display {
+
+// A set of rectangles covering the areas of a framebuffer that have changed
+// since it was last sent to the display.
+//
+// Rectangles are clipped to the framebuffer bounds as they are added.
+// Overlapping or touching rectangles are merged when their union is no larger
+// than the two separately, so a burst of small damage (e.g. the characters of
+// a changed string) collapses into a few larger rectangles. When the set is
+// full, the new rectangle is merged into whichever existing one grows the
+// least.
+class DirtyRegion {
+ public:
+  static constexpr size_t kMaxRects = 8;
+
+  DirtyRegion(pw::math::Size<uint16_t> bounds);
+
+  // Mark |rect| as changed.
+  void Add(const pw::math::Rect<uint16_t>& rect);
+
+  // Remove all rectangles.
+  void Clear() { rects_.clear(); }
+
+  bool IsEmpty() const { return rects_.empty(); }
+
+  // Return the changed rectangles. Rectangles may overlap.
+  span<const pw::math::Rect<uint16_t>> rects() const {
+    return span(rects_.data(), rects_.size());
+  }
+
+ private:
+  const pw::math::Size<uint16_t> bounds_;
+  pw::Vector<pw::math::Rect<uint16_t>, kMaxRects> rects_;
+};
+
+}  // namespace pw::display
@@ -13,9 +13,19 @@
 // the License.
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_color/color.h"
+#include "pw_containers/vector.h"
+#include "pw_display/dirty_region.h"
 #include "pw_display_driver/display_driver.h"
 #include "pw_framebuffer/framebuffer.h"
 #include "pw_framebuffer_pool/framebuffer_pool.h"
+#include "pw_function/function.h"
+#include "pw_math/rect.h"
 #include "pw_math/size.h"
 #include "pw_math/vector3.h"
 #include "pw_status/status.h"
@@ -42,16 +52,106 @@ class Display {
 
   // Release the framebuffer back to the display. The display will
   // send the framebuffer data to the screen. This function will block until
-  // the transfer has completed.
+  // the transfer has completed. Use a PresentQueue to draw the next frame
+  // while this one is being sent.
   //
   // This function should only be passed a valid framebuffer returned by
   // a paired call to GetFramebuffer.
   //
+  // The framebuffer is returned to the pool even if the display driver fails
+  // to write it. The driver's error is returned by this call if the driver
+  // wrote synchronously, and otherwise by the next call to
+  // ReleaseFramebuffer() or DrawBands(). For example a display driver which
+  // cannot resize reports OutOfRange for a framebuffer of the wrong size when
+  // pw_display_DISPLAY_RESIZE is not set.
+  //
   // If The pw_display_DISPLAY_RESIZE build variable is set and the display
   // size is different than the framebuffer size then the framebuffer contents
-  // will be resized using the nearest-neighbor algorithm.
+  // will be resized using the algorithm chosen with SetResizeMode(). The
+  // resized rows are sent several at a time with DisplayDriver::WriteRect().
+  //
+  // If any regions were marked dirty with MarkDirty() since the previous
+  // release, and the display driver supports region writes, only those
+  // regions are sent to the display. Otherwise the entire framebuffer is sent.
+  // The regions are written one after another from a single list, so only one
+  // framebuffer's regions can be in flight at a time: with a display driver
+  // which writes asynchronously, a framebuffer released while the previous
+  // one's regions are still being written is sent in its entirety instead.
+  //
+  // Framebuffers with an indexed pixel format are converted to RGB565 with
+  // their palette while they are sent, a few rows at a time, so only a small
+  // conversion buffer is needed. Each group of rows is sent with a single
+  // DisplayDriver::WriteRect(). Only the dirty regions are converted and sent,
+  // whether or not the driver supports region writes, and the framebuffer is
+  // clipped to the display rather than resized.
   Status ReleaseFramebuffer(pw::framebuffer::Framebuffer framebuffer);
 
+  // Mark |rect| of the framebuffer being drawn as different from what is
+  // currently on the screen, so that the next ReleaseFramebuffer() will send
+  // it. Pixels outside of all marked rectangles must be unchanged from the
+  // previously released framebuffer.
+  void MarkDirty(const pw::math::Rect<uint16_t>& rect) {
+    dirty_region_.Add(rect);
+  }
+
+  // Called by DrawBands() to draw one band of the display.
+  using DrawBandFunction = pw::Function<void(pw::framebuffer::Framebuffer&)>;
+
+  // Return true if the framebuffer pool's buffers are shorter than the
+  // display, so that the display must be drawn with DrawBands(). A pool
+  // without buffers (of height 0) is not banded.
+  bool IsBanded() const {
+    const uint16_t height = framebuffer_pool_.dimensions().height;
+    return height > 0 && height < size_.height;
+  }
+
+  // Draw the display a band at a time, so that only a few rows of pixel memory
+  // are needed rather than a framebuffer the size of the display. Each of the
+  // framebuffer pool's buffers holds one band, the width of the display and
+  // the buffer's height in rows, and must be RGB565.
+  //
+  // |draw_band| is called for each band from top to bottom, with a framebuffer
+  // whose origin() is the band's position on the display. pw_draw takes
+  // display coordinates, so |draw_band| can draw the whole display every time:
+  // everything outside of the band is clipped.
+  //
+  // Each band is sent to the display driver as soon as it has been drawn,
+  // with a region write if the driver supports them and otherwise with
+  // DisplayDriver::WriteRect(). With two or more band buffers and a driver
+  // which writes asynchronously, the next band is drawn while the previous one
+  // is sent.
+  // The whole display is redrawn, so regions marked with MarkDirty() are
+  // discarded.
+  Status DrawBands(const DrawBandFunction& draw_band);
+
+#if DISPLAY_RESIZE
+  // How a framebuffer is resized when its size is different than the
+  // display's. All of them work on RGB565 framebuffers only. kBilinear and
+  // kBox are only available if the pw_display_RESIZE_FILTERS build variable
+  // is also set, as their buffers add about 4.7 KB to each Display.
+  enum class ResizeMode {
+    // Each display pixel is a copy of the nearest framebuffer pixel, and each
+    // framebuffer row is resized only once, however many display rows it
+    // fills. The fastest, but text and thin lines become uneven.
+    kNearestNeighbor,
+#if DISPLAY_RESIZE_FILTERS
+    // Each display pixel is blended from the four nearest framebuffer pixels,
+    // with 5 bit weights. Best for enlarging a framebuffer which was drawn at
+    // a lower resolution.
+    kBilinear,
+    // Each display pixel is the average of the framebuffer pixels it covers,
+    // up to 32x32 of them. Best for shrinking. When enlarging, each
+    // framebuffer pixel becomes a block of display pixels.
+    kBox,
+#endif  // if DISPLAY_RESIZE_FILTERS
+  };
+
+  // Choose how framebuffers are resized. The default is kNearestNeighbor.
+  void SetResizeMode(ResizeMode mode) { resize_mode_ = mode; }
+
+  ResizeMode GetResizeMode() const { return resize_mode_; }
+#endif  // if DISPLAY_RESIZE
+
   // Return the width (in pixels) of the associated display.
   uint16_t GetWidth() const { return size_.width; }
 
@@ -60,14 +160,97 @@ class Display {
 
  private:
 #if DISPLAY_RESIZE
-  // Update screen while scaling the framebuffer using nearest
-  // neighbor algorithm.
-  Status UpdateNearestNeighbor(const pw::framebuffer::Framebuffer& framebuffer);
+  // The widest display which a framebuffer can be resized to.
+  static constexpr uint16_t kMaxResizeWidth = 480;
+  // The number of resized pixels which are sent to the display together.
+  static constexpr size_t kResizeBufferNumPixels = 4 * kMaxResizeWidth;
+
+  // Update the screen while resizing the framebuffer with resize_mode_.
+  Status Resize(const pw::framebuffer::Framebuffer& framebuffer);
+
+  // Resize the rows of |framebuffer| with each of the resize modes.
+  Status ResizeNearestNeighbor(const pw::framebuffer::Framebuffer& framebuffer);
+#if DISPLAY_RESIZE_FILTERS
+  Status ResizeBilinear(const pw::framebuffer::Framebuffer& framebuffer);
+  Status ResizeBox(const pw::framebuffer::Framebuffer& framebuffer);
+#endif  // if DISPLAY_RESIZE_FILTERS
+
+  // Fill resize_columns_ and resize_column_weights_ for framebuffers
+  // |fb_width| pixels wide and the current resize mode.
+  void BuildResizeColumns(uint16_t fb_width);
+
+  // Call |resize_row| with a pointer to each display row in turn, from top to
+  // bottom, for it to fill with resized pixels, and send them to the display
+  // in bursts.
+  template <typename ResizeRowFunction>
+  Status WriteResized(ResizeRowFunction&& resize_row);
 #endif  // if DISPLAY_RESIZE
 
+  // The number of pixels of an indexed framebuffer which are converted to
+  // RGB565 and sent to the display together.
+  static constexpr size_t kIndexedBufferNumPixels = 1024;
+
+  // Convert the dirty regions of an indexed |framebuffer| (or all of it if
+  // none are dirty) to RGB565 and send them to the display driver in bursts
+  // of rows that fit in indexed_buffer_.
+  Status WriteIndexed(const pw::framebuffer::Framebuffer& framebuffer);
+
+  // Send |region| of the display from |band|, releasing it back to the pool
+  // once it has been written. |band| must be RGB565.
+  Status WriteBand(pw::framebuffer::Framebuffer band,
+                   const pw::math::Rect<uint16_t>& region);
+
+  // Send the next of |flush_rects_| to the display driver, releasing the
+  // framebuffer back to the pool and clearing flush_in_flight_ once all have
+  // been written or one has failed.
+  void WriteNextRegion(pw::framebuffer::Framebuffer framebuffer);
+
+  // Called when the display driver has finished with |framebuffer| to release
+  // it back to the pool, keeping |status| for TakeWriteError() if it is the
+  // first error since the last call.
+  void FinishWrite(pw::framebuffer::Framebuffer framebuffer, Status status);
+
+  // Return and clear the error kept by FinishWrite(), or OkStatus() if none.
+  Status TakeWriteError();
+
   pw::display_driver::DisplayDriver& display_driver_;
   const pw::math::Size<uint16_t> size_;
   pw::framebuffer_pool::FramebufferPool& framebuffer_pool_;
+  // Regions changed in the framebuffer currently being drawn.
+  DirtyRegion dirty_region_;
+  // Regions of the released framebuffer which are being sent to the display.
+  // Only used while flush_in_flight_ is set.
+  pw::Vector<pw::math::Rect<uint16_t>, DirtyRegion::kMaxRects> flush_rects_;
+  size_t next_flush_rect_ = 0;
+  // True from the start of a dirty region write until its last region has
+  // been written, which may be in the display driver's completion callback.
+  std::atomic<bool> flush_in_flight_{false};
+  // The first error reported by a display driver write callback which has not
+  // yet been returned. Written from the driver's completion context.
+  std::atomic<Status::Code> write_error_{OkStatus().code()};
+  // Converted rows of an indexed framebuffer waiting to be sent.
+  std::array<pw::color::color_rgb565_t, kIndexedBufferNumPixels>
+      indexed_buffer_;
+#if DISPLAY_RESIZE
+  ResizeMode resize_mode_ = ResizeMode::kNearestNeighbor;
+  // The framebuffer column shown in each display column, or the first column
+  // of its box, for framebuffers resize_columns_width_ pixels wide (or 0 if
+  // not yet built) and resize_columns_mode_.
+  std::array<uint16_t, kMaxResizeWidth> resize_columns_;
+  uint16_t resize_columns_width_ = 0;
+  ResizeMode resize_columns_mode_ = ResizeMode::kNearestNeighbor;
+#if DISPLAY_RESIZE_FILTERS
+  // The weight (0..32) of the next framebuffer column in each display column
+  // with kBilinear, or 32768 divided by the box width with kBox.
+  std::array<uint16_t, kMaxResizeWidth> resize_column_weights_;
+  // Two framebuffer rows which have been resized horizontally, with the
+  // channels of each pixel spread out so that they can be blended or summed
+  // together.
+  std::array<std::array<uint32_t, kMaxResizeWidth>, 2> resize_lines_;
+#endif  // if DISPLAY_RESIZE_FILTERS
+  // Resized display rows waiting to be sent.
+  std::array<pw::color::color_rgb565_t, kResizeBufferNumPixels> resize_buffer_;
+#endif  // if DISPLAY_RESIZE
 };
 
 }  // namespace pw::display
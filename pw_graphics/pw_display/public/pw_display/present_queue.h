@@ -0,0 +1,147 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_containers/vector.h"
+#include "pw_display/dirty_region.h"
+#include "pw_display/display.h"
+#include "pw_framebuffer/framebuffer.h"
+#include "pw_math/rect.h"
+#include "pw_sync/counting_semaphore.h"
+#include "pw_sync/thread_notification.h"
+#include "pw_thread/thread_core.h"
+
+namespace pw::display {
+
+// A pipelined presentation queue for a Display.
+//
+// Display::ReleaseFramebuffer() does not return until the display driver has
+// accepted the framebuffer, which for most drivers means until every pixel
+// has been sent. PresentQueue moves that work onto a separate thread so the
+// next frame can be drawn, into another framebuffer from the display's
+// FramebufferPool, while the previous one is being sent to the screen.
+//
+// The queue is a pw::thread::ThreadCore, and the application supplies the
+// thread it runs on:
+//
+//   PresentQueue present_queue(display, {.queue_depth = 2});
+//   pw::thread::Thread present_thread(thread_options, present_queue);
+//
+//   while (true) {
+//     Framebuffer framebuffer = present_queue.GetFramebuffer();
+//     Draw(framebuffer);
+//     present_queue.Present(std::move(framebuffer));
+//   }
+//
+// Once a PresentQueue is running, the Display must only be used through it.
+// GetFramebuffer(), MarkDirty(), Present() and WaitForFence() must all be
+// called from a single (drawing) thread.
+class PresentQueue : public pw::thread::ThreadCore {
+ public:
+  static constexpr size_t kMaxQueueDepth = 3;
+
+  struct Config {
+    // The maximum number of presented frames which have not yet been written
+    // to the display. Present() blocks once this many are outstanding. Must
+    // be between 1 and kMaxQueueDepth. For the drawing and writing of frames
+    // to overlap the FramebufferPool must have at least queue_depth + 1
+    // framebuffers.
+    size_t queue_depth = 2;
+  };
+
+  // Identifies a presented frame. A fence is signaled once its frame has been
+  // handed to the display (see Display::ReleaseFramebuffer()).
+  class Fence {
+   public:
+    // A fence which is always signaled.
+    constexpr Fence() : sequence_(0) {}
+
+   private:
+    friend class PresentQueue;
+
+    constexpr explicit Fence(uint32_t sequence) : sequence_(sequence) {}
+
+    uint32_t sequence_;
+  };
+
+  PresentQueue(Display& display, const Config& config);
+
+  // Return a framebuffer from the display's pool to draw into. Blocks until
+  // one is available.
+  pw::framebuffer::Framebuffer GetFramebuffer() {
+    return display_.GetFramebuffer();
+  }
+
+  // Mark |rect| of the framebuffer being drawn as changed. See
+  // Display::MarkDirty().
+  void MarkDirty(const pw::math::Rect<uint16_t>& rect) {
+    dirty_region_.Add(rect);
+  }
+
+  // Queue |framebuffer|, along with the regions marked dirty since the last
+  // call, to be written to the display. Blocks while queue_depth frames are
+  // already outstanding. Returns a fence which is signaled once the frame has
+  // been written, or dropped because the display driver failed to write it.
+  Fence Present(pw::framebuffer::Framebuffer framebuffer);
+
+  // Return true if the frame identified by |fence| has been written.
+  bool IsSignaled(Fence fence) const;
+
+  // Block until the frame identified by |fence| has been written.
+  void WaitForFence(Fence fence);
+
+  // Ask Run() to return once all presented frames have been written.
+  void RequestStop();
+
+ private:
+  struct Frame {
+    pw::framebuffer::Framebuffer framebuffer;
+    pw::Vector<pw::math::Rect<uint16_t>, DirtyRegion::kMaxRects> dirty_rects;
+  };
+
+  // pw::thread::ThreadCore implementation. Writes queued frames to the
+  // display until stopped.
+  void Run() override;
+
+  Display& display_;
+  const size_t queue_depth_;
+  // Regions changed in the framebuffer currently being drawn.
+  DirtyRegion dirty_region_;
+  // Ring of presented frames, of which the first queue_depth_ are used.
+  std::array<Frame, kMaxQueueDepth> frames_;
+  // The slots of the next frame to be presented and written. They are kept
+  // modulo queue_depth_ rather than derived from the frame counters, which
+  // would skip slots when the counters wrap unless queue_depth_ is a power
+  // of two. Each is used only by the drawing and presentation thread
+  // respectively.
+  size_t present_index_ = 0;
+  size_t write_index_ = 0;
+  // Released by the drawing thread per presented frame (and on stop).
+  pw::sync::CountingSemaphore queued_frames_;
+  // Released by the presentation thread as each frame is written.
+  pw::sync::CountingSemaphore free_frames_;
+  pw::sync::ThreadNotification frame_written_;
+  // Number of frames presented and written. Each is written only by the
+  // drawing and presentation thread respectively.
+  std::atomic<uint32_t> num_presented_;
+  std::atomic<uint32_t> num_written_;
+  std::atomic<bool> stop_requested_;
+};
+
+}  // namespace pw::display
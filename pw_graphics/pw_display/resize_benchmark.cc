@@ -0,0 +1,112 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Host benchmark of resizing framebuffers to a 320x240 display with each of
+// Display's resize modes, from a quarter resolution framebuffer up to one
+// twice the size of the display.
+
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "pw_color/color.h"
+#include "pw_display/display.h"
+#include "pw_display_driver_null/display_driver.h"
+#include "pw_framebuffer/framebuffer.h"
+#include "pw_framebuffer_pool/framebuffer_pool.h"
+#include "pw_log/log.h"
+#include "pw_math/size.h"
+
+static_assert(DISPLAY_RESIZE && DISPLAY_RESIZE_FILTERS,
+              "Depend on pw_display:pw_display_with_resize");
+
+using pw::color::color_rgb565_t;
+using pw::display::Display;
+using pw::framebuffer::PixelFormat;
+using pw::framebuffer_pool::FramebufferPool;
+using Size = pw::math::Size<uint16_t>;
+
+namespace {
+
+constexpr int kIterations = 200;
+constexpr Size kDisplaySize{320, 240};
+constexpr Size kFramebufferSizes[] = {
+    {160, 120},
+    {240, 180},
+    {400, 300},
+    {640, 480},
+};
+
+// Discards everything written to it, as quickly as possible.
+class BenchmarkDisplayDriver : public pw::display_driver::DisplayDriverNULL {
+ public:
+  uint16_t GetWidth() const override { return kDisplaySize.width; }
+  uint16_t GetHeight() const override { return kDisplaySize.height; }
+  bool SupportsRegionWrite() const override { return true; }
+};
+
+const char* ModeName(Display::ResizeMode mode) {
+  switch (mode) {
+    case Display::ResizeMode::kNearestNeighbor:
+      return "nearest";
+    case Display::ResizeMode::kBilinear:
+      return "bilinear";
+    case Display::ResizeMode::kBox:
+      return "box";
+  }
+  return "";
+}
+
+}  // namespace
+
+int main() {
+  BenchmarkDisplayDriver display_driver;
+  for (const Size& fb_size : kFramebufferSizes) {
+    std::vector<color_rgb565_t> pixels(fb_size.width * fb_size.height);
+    uint32_t seed = 1;
+    for (color_rgb565_t& pixel : pixels) {
+      seed = seed * 1664525 + 1013904223;
+      pixel = static_cast<color_rgb565_t>(seed >> 16);
+    }
+    pw::Vector<void*, 1> pixel_buffers{pixels.data()};
+    FramebufferPool fb_pool({
+        .fb_addr = pixel_buffers,
+        .dimensions = fb_size,
+        .row_bytes = static_cast<uint16_t>(fb_size.width * 2),
+        .pixel_format = PixelFormat::RGB565,
+    });
+    Display display(display_driver, kDisplaySize, fb_pool);
+
+    for (Display::ResizeMode mode : {Display::ResizeMode::kNearestNeighbor,
+                                     Display::ResizeMode::kBilinear,
+                                     Display::ResizeMode::kBox}) {
+      display.SetResizeMode(mode);
+      const auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < kIterations; i++) {
+        display.ReleaseFramebuffer(display.GetFramebuffer()).IgnoreError();
+      }
+      const std::chrono::duration<double, std::micro> elapsed =
+          std::chrono::steady_clock::now() - start;
+      PW_LOG_INFO("%dx%d -> %dx%d %-8s: %.1f us/frame",
+                  fb_size.width,
+                  fb_size.height,
+                  kDisplaySize.width,
+                  kDisplaySize.height,
+                  ModeName(mode),
+                  elapsed.count() / kIterations);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,115 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Host benchmark comparing DrawCircle() against the per-pixel midpoint loop it
+// replaced. Filled circles are now drawn as spans, and outlines with the same
+// midpoint loop through a writer for the framebuffer's pixel format.
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "pw_color/color.h"
+#include "pw_draw/draw.h"
+#include "pw_framebuffer/framebuffer.h"
+#include "pw_framebuffer/writer.h"
+#include "pw_log/log.h"
+
+using pw::color::color_rgb565_t;
+using pw::framebuffer::Framebuffer;
+using pw::framebuffer::FramebufferWriter;
+using pw::framebuffer::PixelFormat;
+
+namespace {
+
+constexpr int kIterations = 2000;
+constexpr int kWidth = 320;
+constexpr int kHeight = 240;
+constexpr int kRadii[] = {4, 18, 50, 119};
+constexpr color_rgb565_t kColor = 0xfd00;
+
+// The DrawCircle() implementation prior to span rasterization.
+__attribute__((noinline)) void PerPixelDrawCircle(Framebuffer& fb,
+                                                  int center_x,
+                                                  int center_y,
+                                                  int radius,
+                                                  color_rgb565_t pen_color,
+                                                  bool filled) {
+  int fx = 0, fy = 0;
+  int x = -radius, y = 0;
+  int error_value = 2 - 2 * radius;
+  FramebufferWriter writer(fb);
+  while (x < 0) {
+    if (!filled) {
+      fx = x;
+      fy = y;
+    }
+    for (int i = x; i <= fx; i++) {
+      writer.SetPixel(center_x - i, center_y + y, pen_color);
+      writer.SetPixel(center_x + i, center_y - y, pen_color);
+    }
+    for (int i = fy; i <= y; i++) {
+      writer.SetPixel(center_x - i, center_y - x, pen_color);
+      writer.SetPixel(center_x + i, center_y + x, pen_color);
+    }
+    radius = error_value;
+    if (radius <= y) {
+      y++;
+      error_value += y * 2 + 1;
+    }
+    if (radius > x || error_value > y) {
+      x++;
+      error_value += x * 2 + 1;
+    }
+  }
+}
+
+template <typename DrawFunction>
+double CirclesPerSecond(Framebuffer& fb,
+                        int radius,
+                        bool filled,
+                        DrawFunction draw) {
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterations; i++) {
+    draw(fb, kWidth / 2, kHeight / 2, radius, kColor, filled);
+  }
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return kIterations / elapsed.count();
+}
+
+}  // namespace
+
+int main() {
+  std::vector<color_rgb565_t> pixels(kWidth * kHeight);
+  Framebuffer fb(pixels.data(),
+                 PixelFormat::RGB565,
+                 {kWidth, kHeight},
+                 kWidth * sizeof(color_rgb565_t));
+  for (bool filled : {false, true}) {
+    for (int radius : kRadii) {
+      const double per_pixel =
+          CirclesPerSecond(fb, radius, filled, PerPixelDrawCircle);
+      const double current =
+          CirclesPerSecond(fb, radius, filled, pw::draw::DrawCircle);
+      PW_LOG_INFO("%s radius=%d: per-pixel %.0f/s, DrawCircle %.0f/s (%.1fx)",
+                  filled ? "filled" : "outline",
+                  radius,
+                  per_pixel,
+                  current,
+                  current / per_pixel);
+    }
+  }
+  return 0;
+}
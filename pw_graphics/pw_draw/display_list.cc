@@ -0,0 +1,416 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#include "pw_draw/display_list.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+
+#include "pw_assert/assert.h"
+
+using pw::color::color_rgb565_t;
+using pw::framebuffer::Framebuffer;
+using pw::math::Rect;
+
+namespace pw::draw {
+
+namespace {
+
+// Bounds of a command which draws the entire framebuffer. Framebuffer origins
+// and sizes are uint16_t, so this contains any framebuffer.
+constexpr Rect<int> kEverywhere = {0, 0, 0x20000, 0x20000};
+
+// Return |value| limited to just outside kEverywhere, which doesn't change
+// which framebuffer pixels a rectangle covers but keeps its edges and size
+// far from overflowing int.
+int ClampToEverywhere(int value) {
+  constexpr int kLimit = kEverywhere.x + kEverywhere.width;
+  return std::clamp(value, kEverywhere.x - 1, kLimit);
+}
+
+// The maximum number of opaque commands which are checked when deciding
+// whether an earlier command is hidden in a tile.
+constexpr size_t kMaxOccluders = 8;
+
+// A later opaque command, clipped to the tile being drawn.
+struct Occluder {
+  size_t index;
+  Rect<int> rect;
+};
+
+// Return the width DrawString() advances by for |ch|. Characters which are not
+// in the font are skipped.
+int CharacterWidth(wchar_t ch, const FontSet& font) {
+  if (ch == ' ' || ch == '\0' ||
+      (ch >= font.starting_character && ch <= font.ending_character)) {
+    return font.width;
+  }
+  return 0;
+}
+
+// Remove the characters of |str| which lie entirely outside |left| to |right|
+// (exclusive) when drawn at |x|, advancing |x| past those removed from the
+// start. Glyphs are then only looked up for the visible characters.
+std::wstring_view VisibleCharacters(std::wstring_view str,
+                                    const FontSet& font,
+                                    int left,
+                                    int right,
+                                    int& x) {
+  size_t first = 0;
+  while (first < str.size() &&
+         x + CharacterWidth(str[first], font) <= left) {
+    x += CharacterWidth(str[first], font);
+    first++;
+  }
+  size_t end = first;
+  for (int end_x = x; end < str.size() && end_x < right; end++) {
+    end_x += CharacterWidth(str[end], font);
+  }
+  return str.substr(first, end - first);
+}
+
+}  // namespace
+
+DisplayList::DisplayList(span<std::byte> arena)
+    : arena_begin_(arena.data()), arena_end_(arena.data() + arena.size()) {
+  void* begin = arena.data();
+  size_t space = arena.size();
+  if (std::align(alignof(Command), sizeof(Command), begin, space) == nullptr) {
+    // Too small to hold a single command.
+    begin = arena_end_;
+  }
+  commands_ = static_cast<Command*>(begin);
+  strings_begin_ = arena_end_;
+}
+
+DisplayList::Command* DisplayList::AddCommand(CommandType type,
+                                              const Rect<int>& bounds) {
+  std::byte* commands_end =
+      reinterpret_cast<std::byte*>(commands_ + num_commands_);
+  if (static_cast<size_t>(strings_begin_ - commands_end) < sizeof(Command)) {
+    return nullptr;
+  }
+  Command* command = new (commands_end) Command{};
+  command->type = type;
+  command->bounds = bounds;
+  num_commands_++;
+  return command;
+}
+
+Status DisplayList::Fill(color_rgb565_t pen_color) {
+  Command* command = AddCommand(CommandType::kFill, kEverywhere);
+  if (command == nullptr) {
+    return Status::ResourceExhausted();
+  }
+  command->color = pen_color;
+  return OkStatus();
+}
+
+Status DisplayList::DrawRectWH(
+    int x, int y, int w, int h, color_rgb565_t pen_color, bool filled) {
+  Command* command = AddCommand(CommandType::kRect, {x, y, w, h});
+  if (command == nullptr) {
+    return Status::ResourceExhausted();
+  }
+  command->color = pen_color;
+  command->filled = filled;
+  return OkStatus();
+}
+
+Status DisplayList::DrawLine(
+    int x1, int y1, int x2, int y2, color_rgb565_t pen_color) {
+  // Clamped first, so that extreme endpoints can't overflow the size.
+  const int left = ClampToEverywhere(std::min(x1, x2));
+  const int right = ClampToEverywhere(std::max(x1, x2));
+  const int top = ClampToEverywhere(std::min(y1, y2));
+  const int bottom = ClampToEverywhere(std::max(y1, y2));
+  const Rect<int> bounds = {left, top, right - left + 1, bottom - top + 1};
+  Command* command = AddCommand(CommandType::kLine, bounds);
+  if (command == nullptr) {
+    return Status::ResourceExhausted();
+  }
+  command->color = pen_color;
+  command->line = {x1, y1, x2, y2};
+  return OkStatus();
+}
+
+Status DisplayList::DrawCircle(int center_x,
+                               int center_y,
+                               int radius,
+                               color_rgb565_t pen_color,
+                               bool filled) {
+  const Rect<int> bounds = {
+      center_x - radius, center_y - radius, 2 * radius + 1, 2 * radius + 1};
+  Command* command = AddCommand(CommandType::kCircle, bounds);
+  if (command == nullptr) {
+    return Status::ResourceExhausted();
+  }
+  command->color = pen_color;
+  command->filled = filled;
+  command->circle = {center_x, center_y, radius};
+  return OkStatus();
+}
+
+Status DisplayList::DrawString(std::wstring_view str,
+                               pw::math::Vector2<int> pos,
+                               color_rgb565_t fg_color,
+                               color_rgb565_t bg_color,
+                               const FontSet& font) {
+  // Characters which are not in the font take no space, so this may be wider
+  // than the drawn string.
+  const Rect<int> bounds = {pos.x,
+                            pos.y,
+                            static_cast<int>(str.size()) * font.width,
+                            font.height};
+
+  // Make room for the characters and the command together, so that nothing is
+  // recorded if either does not fit.
+  const size_t string_bytes = str.size() * sizeof(wchar_t);
+  std::byte* const commands_end =
+      reinterpret_cast<std::byte*>(commands_ + num_commands_);
+  const size_t space = static_cast<size_t>(strings_begin_ - commands_end);
+  if (space < sizeof(Command) + string_bytes + alignof(wchar_t)) {
+    return Status::ResourceExhausted();
+  }
+  std::byte* chars = strings_begin_ - string_bytes;
+  chars -= reinterpret_cast<uintptr_t>(chars) % alignof(wchar_t);
+  strings_begin_ = chars;
+  Command* command = AddCommand(CommandType::kString, bounds);
+  PW_ASSERT(command != nullptr);
+  std::memcpy(chars, str.data(), string_bytes);
+  command->color = fg_color;
+  command->bg_color = bg_color;
+  command->string = {
+      reinterpret_cast<const wchar_t*>(chars), str.size(), &font};
+  return OkStatus();
+}
+
+Status DisplayList::DrawSprite(int x,
+                               int y,
+                               const SpriteSheet& sprite_sheet,
+                               int integer_scale,
+                               SpriteFlip flip) {
+  Command* command = AddCommand(CommandType::kSprite,
+                                {x,
+                                 y,
+                                 sprite_sheet.width * integer_scale,
+                                 sprite_sheet.height * integer_scale});
+  if (command == nullptr) {
+    return Status::ResourceExhausted();
+  }
+  command->flip = flip;
+  command->sprite = {&sprite_sheet, sprite_sheet.current_index, integer_scale};
+  return OkStatus();
+}
+
+Status DisplayList::DrawSprite(int x,
+                               int y,
+                               const RleSpriteSheet& sprite_sheet,
+                               int integer_scale,
+                               SpriteFlip flip) {
+  Command* command = AddCommand(CommandType::kRleSprite,
+                                {x,
+                                 y,
+                                 sprite_sheet.width * integer_scale,
+                                 sprite_sheet.height * integer_scale});
+  if (command == nullptr) {
+    return Status::ResourceExhausted();
+  }
+  command->flip = flip;
+  command->sprite = {&sprite_sheet, sprite_sheet.current_index, integer_scale};
+  return OkStatus();
+}
+
+void DisplayList::DrawCommand(const Command& command,
+                              Framebuffer& framebuffer,
+                              GlyphCache* glyph_cache) const {
+  switch (command.type) {
+    case CommandType::kFill:
+      pw::draw::Fill(framebuffer, command.color);
+      break;
+    case CommandType::kRect:
+      pw::draw::DrawRectWH(framebuffer,
+                           command.bounds.x,
+                           command.bounds.y,
+                           command.bounds.width,
+                           command.bounds.height,
+                           command.color,
+                           command.filled);
+      break;
+    case CommandType::kLine:
+      pw::draw::DrawLine(framebuffer,
+                         command.line.x1,
+                         command.line.y1,
+                         command.line.x2,
+                         command.line.y2,
+                         command.color);
+      break;
+    case CommandType::kCircle:
+      pw::draw::DrawCircle(framebuffer,
+                           command.circle.center_x,
+                           command.circle.center_y,
+                           command.circle.radius,
+                           command.color,
+                           command.filled);
+      break;
+    case CommandType::kString: {
+      const Rect<uint16_t> fb_bounds = framebuffer.bounds();
+      pw::math::Vector2<int> pos = {command.bounds.x, command.bounds.y};
+      const std::wstring_view str = VisibleCharacters(
+          {command.string.chars, command.string.length},
+          *command.string.font,
+          fb_bounds.x,
+          fb_bounds.x + fb_bounds.width,
+          pos.x);
+      if (glyph_cache != nullptr) {
+        pw::draw::DrawString(str,
+                             pos,
+                             command.color,
+                             command.bg_color,
+                             *command.string.font,
+                             framebuffer,
+                             *glyph_cache);
+      } else {
+        pw::draw::DrawString(str,
+                             pos,
+                             command.color,
+                             command.bg_color,
+                             *command.string.font,
+                             framebuffer);
+      }
+      break;
+    }
+    case CommandType::kSprite: {
+      // Draw a copy of the sheet showing the recorded sprite.
+      SpriteSheet sheet =
+          *static_cast<const SpriteSheet*>(command.sprite.sheet);
+      sheet.current_index = command.sprite.index;
+      pw::draw::DrawSprite(framebuffer,
+                           command.bounds.x,
+                           command.bounds.y,
+                           &sheet,
+                           command.sprite.scale,
+                           command.flip);
+      break;
+    }
+    case CommandType::kRleSprite: {
+      RleSpriteSheet sheet =
+          *static_cast<const RleSpriteSheet*>(command.sprite.sheet);
+      sheet.current_index = command.sprite.index;
+      pw::draw::DrawSprite(framebuffer,
+                           command.bounds.x,
+                           command.bounds.y,
+                           &sheet,
+                           command.sprite.scale,
+                           command.flip);
+      break;
+    }
+  }
+}
+
+template <typename CommandIndex>
+size_t DisplayList::ReplayCommands(Framebuffer& framebuffer,
+                                   size_t count,
+                                   CommandIndex command_index,
+                                   GlyphCache* glyph_cache) const {
+  const Rect<uint16_t> fb_bounds = framebuffer.bounds();
+  const Rect<int> tile = {
+      fb_bounds.x, fb_bounds.y, fb_bounds.width, fb_bounds.height};
+
+  // Walk backwards to find the last opaque command covering the whole tile,
+  // as nothing before it is visible, and the latest opaque commands which
+  // cover part of it.
+  size_t first = 0;
+  std::array<Occluder, kMaxOccluders> occluders;
+  size_t num_occluders = 0;
+  for (size_t i = count; i-- > 0;) {
+    const Command& command = commands_[command_index(i)];
+    if (!command.IsOpaque()) {
+      continue;
+    }
+    const Rect<int> rect = command.bounds.Intersect(tile);
+    if (rect.IsEmpty()) {
+      continue;
+    }
+    if (rect == tile) {
+      first = i;
+      break;
+    }
+    if (num_occluders < occluders.size()) {
+      occluders[num_occluders++] = {i, rect};
+    }
+  }
+
+  size_t num_drawn = 0;
+  for (size_t i = first; i < count; i++) {
+    const Command& command = commands_[command_index(i)];
+    const Rect<int> rect = command.bounds.Intersect(tile);
+    if (rect.IsEmpty()) {
+      continue;
+    }
+    // Occluders are in decreasing index order, so stop at the first one which
+    // is not after this command.
+    bool hidden = false;
+    for (size_t j = 0; j < num_occluders && occluders[j].index > i; j++) {
+      if (occluders[j].rect.Contains(rect)) {
+        hidden = true;
+        break;
+      }
+    }
+    if (hidden) {
+      continue;
+    }
+    DrawCommand(command, framebuffer, glyph_cache);
+    num_drawn++;
+  }
+  return num_drawn;
+}
+
+size_t DisplayList::Replay(Framebuffer& framebuffer,
+                           GlyphCache* glyph_cache) const {
+  return ReplayCommands(
+      framebuffer, num_commands_, [](size_t i) { return i; }, glyph_cache);
+}
+
+size_t DisplayList::Replay(Framebuffer& framebuffer,
+                           span<const uint32_t> command_indices,
+                           GlyphCache* glyph_cache) const {
+  return ReplayCommands(
+      framebuffer,
+      command_indices.size(),
+      [command_indices, this](size_t i) {
+        PW_ASSERT(command_indices[i] < num_commands_);
+        return command_indices[i];
+      },
+      glyph_cache);
+}
+
+void DisplayList::Clear() {
+  num_commands_ = 0;
+  strings_begin_ = arena_end_;
+}
+
+size_t DisplayList::bytes_used() const {
+  if (num_commands_ == 0) {
+    return 0;
+  }
+  const std::byte* commands_end =
+      reinterpret_cast<const std::byte*>(commands_ + num_commands_);
+  return (commands_end - arena_begin_) + (arena_end_ - strings_begin_);
+}
+
+}  // namespace pw::draw
@@ -0,0 +1,288 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#include "pw_draw/display_list.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+#include "gtest/gtest.h"
+#include "pw_color/color.h"
+#include "pw_color/colors_pico8.h"
+#include "pw_draw/draw.h"
+#include "pw_draw/font_set.h"
+#include "pw_draw/glyph_cache.h"
+#include "pw_draw/rle_sprite_sheet.h"
+#include "pw_draw/sprite_sheet.h"
+#include "pw_framebuffer/framebuffer.h"
+
+using pw::color::color_rgb565_t;
+using pw::framebuffer::Framebuffer;
+using pw::framebuffer::PixelFormat;
+
+namespace pw::draw {
+namespace {
+
+constexpr int kWidth = 40;
+constexpr int kHeight = 30;
+constexpr color_rgb565_t kBlack = 0x0;
+constexpr color_rgb565_t kTransparent = 0xf81f;
+const color_rgb565_t kRed = color::colors_pico8_rgb565[8];
+const color_rgb565_t kIndigo = color::colors_pico8_rgb565[12];
+
+// Two 4x3 sprites, with a transparent corner.
+constexpr color_rgb565_t kSpriteData[] = {
+    kTransparent, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11,
+    12, 13, 14, kTransparent, 15, 16, 17, 18, 19, 20, 21, 22,
+};
+SpriteSheet sprite_sheet = {4, 3, 2, kTransparent, kSpriteData};
+
+// One 3x2 sprite, stored as runs of opaque pixels.
+constexpr uint16_t kRleData[] = {1, 1, 2, 0x1234, 0x5678, 1, 0, 1, 0x9abc};
+constexpr uint32_t kRleRowOffsets[] = {0, 5};
+RleSpriteSheet rle_sprite_sheet = {3, 2, 1, kRleRowOffsets, kRleData};
+
+// Record a scene with every kind of command, some of it off the display.
+void RecordScene(DisplayList& display_list) {
+  sprite_sheet.current_index = 1;
+  ASSERT_EQ(display_list.Fill(kBlack), OkStatus());
+  ASSERT_EQ(display_list.DrawLine(-5, 3, 44, 25, kIndigo), OkStatus());
+  ASSERT_EQ(display_list.DrawLine(7, -100, 9, 100, kRed), OkStatus());
+  ASSERT_EQ(display_list.DrawCircle(30, 12, 9, kIndigo, /*filled=*/true),
+            OkStatus());
+  ASSERT_EQ(display_list.DrawRectWH(1, 5, 14, 20, kRed, /*filled=*/false),
+            OkStatus());
+  ASSERT_EQ(display_list.DrawRectWH(20, 22, 30, 5, kIndigo, /*filled=*/true),
+            OkStatus());
+  ASSERT_EQ(display_list.DrawSprite(
+                10, -1, sprite_sheet, 3, SpriteFlip::kHorizontal),
+            OkStatus());
+  ASSERT_EQ(
+      display_list.DrawSprite(-2, 12, rle_sprite_sheet, 2, SpriteFlip::kNone),
+      OkStatus());
+  ASSERT_EQ(display_list.DrawString(L"Tiles", {3, 11}, kRed, kBlack, font6x8),
+            OkStatus());
+}
+
+// Draw the same scene as RecordScene() directly into |fb|.
+void DrawScene(Framebuffer& fb) {
+  sprite_sheet.current_index = 1;
+  Fill(fb, kBlack);
+  DrawLine(fb, -5, 3, 44, 25, kIndigo);
+  DrawLine(fb, 7, -100, 9, 100, kRed);
+  DrawCircle(fb, 30, 12, 9, kIndigo, /*filled=*/true);
+  DrawRectWH(fb, 1, 5, 14, 20, kRed, /*filled=*/false);
+  DrawRectWH(fb, 20, 22, 30, 5, kIndigo, /*filled=*/true);
+  DrawSprite(fb, 10, -1, &sprite_sheet, 3, SpriteFlip::kHorizontal);
+  DrawSprite(fb, -2, 12, &rle_sprite_sheet, 2, SpriteFlip::kNone);
+  DrawString(L"Tiles", {3, 11}, kRed, kBlack, font6x8, fb);
+}
+
+// Replay |display_list| into tiles of the given size, and check that each tile
+// matches the same part of |expected|.
+void ExpectTilesMatch(const DisplayList& display_list,
+                      const color_rgb565_t* expected,
+                      int tile_width,
+                      int tile_height) {
+  std::array<color_rgb565_t, kWidth * kHeight> tile_data;
+  for (int tile_y = 0; tile_y < kHeight; tile_y += tile_height) {
+    for (int tile_x = 0; tile_x < kWidth; tile_x += tile_width) {
+      Framebuffer tile(tile_data.data(),
+                       PixelFormat::RGB565,
+                       {static_cast<uint16_t>(tile_width),
+                        static_cast<uint16_t>(tile_height)},
+                       tile_width * sizeof(tile_data[0]));
+      tile.set_origin(
+          {static_cast<uint16_t>(tile_x), static_cast<uint16_t>(tile_y)});
+      display_list.Replay(tile);
+      const int num_rows = std::min(tile_height, kHeight - tile_y);
+      const int num_columns = std::min(tile_width, kWidth - tile_x);
+      for (int y = 0; y < num_rows; y++) {
+        ASSERT_EQ(std::memcmp(&tile_data[y * tile_width],
+                              &expected[(tile_y + y) * kWidth + tile_x],
+                              num_columns * sizeof(tile_data[0])),
+                  0)
+            << "tile " << tile_x << "," << tile_y << " row " << y;
+      }
+    }
+  }
+}
+
+TEST(DisplayList, ReplayMatchesDirectDrawing) {
+  std::array<color_rgb565_t, kWidth * kHeight> expected_data;
+  std::array<color_rgb565_t, kWidth * kHeight> data;
+  Framebuffer expected(expected_data.data(),
+                       PixelFormat::RGB565,
+                       {kWidth, kHeight},
+                       kWidth * sizeof(expected_data[0]));
+  Framebuffer fb(
+      data.data(), PixelFormat::RGB565, {kWidth, kHeight}, kWidth * 2);
+  DrawScene(expected);
+
+  std::array<std::byte, 1024> arena;
+  DisplayList display_list(arena);
+  RecordScene(display_list);
+  EXPECT_EQ(display_list.size(), 9u);
+
+  // The sprite drawn is the one current when it was recorded.
+  sprite_sheet.current_index = 0;
+  GlyphCache glyph_cache;
+  EXPECT_EQ(display_list.Replay(fb, &glyph_cache), 9u);
+  EXPECT_EQ(data, expected_data);
+}
+
+TEST(DisplayList, ReplayTiles) {
+  std::array<color_rgb565_t, kWidth * kHeight> expected_data;
+  Framebuffer expected(expected_data.data(),
+                       PixelFormat::RGB565,
+                       {kWidth, kHeight},
+                       kWidth * sizeof(expected_data[0]));
+  DrawScene(expected);
+
+  std::array<std::byte, 1024> arena;
+  DisplayList display_list(arena);
+  RecordScene(display_list);
+
+  ExpectTilesMatch(display_list, expected_data.data(), kWidth, 7);
+  ExpectTilesMatch(display_list, expected_data.data(), 16, 16);
+  ExpectTilesMatch(display_list, expected_data.data(), 3, 5);
+}
+
+TEST(DisplayList, SkipsCommandsOutsideTile) {
+  std::array<color_rgb565_t, 8 * 4> data;
+  Framebuffer tile(data.data(), PixelFormat::RGB565, {8, 4}, 8 * 2);
+  tile.set_origin({8, 4});
+
+  std::array<std::byte, 512> arena;
+  DisplayList display_list(arena);
+  ASSERT_EQ(display_list.DrawRectWH(0, 0, 8, 8, kRed, true), OkStatus());
+  ASSERT_EQ(display_list.DrawLine(0, 6, 30, 6, kRed), OkStatus());
+  ASSERT_EQ(display_list.DrawCircle(20, 20, 3, kRed, false), OkStatus());
+  ASSERT_EQ(display_list.DrawString(L"ab", {16, 4}, kRed, kBlack, font6x8),
+            OkStatus());
+  ASSERT_EQ(display_list.DrawString(L"ab", {5, 4}, kRed, kBlack, font6x8),
+            OkStatus());
+
+  // Only the line and the second string overlap the tile.
+  EXPECT_EQ(display_list.Replay(tile), 2u);
+}
+
+TEST(DisplayList, ExtremeLineBounds) {
+  std::array<std::byte, 512> arena;
+  DisplayList display_list(arena);
+  constexpr int kMin = std::numeric_limits<int>::min();
+  constexpr int kMax = std::numeric_limits<int>::max();
+  ASSERT_EQ(display_list.DrawLine(kMin, 5, kMax, 5, kRed), OkStatus());
+  ASSERT_EQ(display_list.DrawLine(7, kMax, 7, kMin, kRed), OkStatus());
+
+  const pw::math::Rect<int> framebuffer = {0, 0, 0xffff, 0xffff};
+  EXPECT_EQ(display_list.bounds(0).Intersect(framebuffer),
+            (pw::math::Rect<int>{0, 5, 0xffff, 1}));
+  EXPECT_EQ(display_list.bounds(1).Intersect(framebuffer),
+            (pw::math::Rect<int>{7, 0, 1, 0xffff}));
+}
+
+TEST(DisplayList, SkipsHiddenCommands) {
+  std::array<color_rgb565_t, 16 * 16> data;
+  Framebuffer fb(data.data(), PixelFormat::RGB565, {16, 16}, 16 * 2);
+
+  std::array<std::byte, 1024> arena;
+  DisplayList display_list(arena);
+  ASSERT_EQ(display_list.DrawCircle(8, 8, 5, kRed, true), OkStatus());
+  ASSERT_EQ(display_list.Fill(kBlack), OkStatus());
+  ASSERT_EQ(display_list.DrawString(L"x", {2, 2}, kRed, kBlack, font6x8),
+            OkStatus());
+  ASSERT_EQ(display_list.DrawLine(0, 12, 15, 12, kRed), OkStatus());
+  ASSERT_EQ(display_list.DrawRectWH(1, 1, 10, 10, kIndigo, true), OkStatus());
+  ASSERT_EQ(display_list.DrawRectWH(4, 4, 2, 2, kRed, true), OkStatus());
+
+  // The circle is hidden by the fill, and the string by the first rectangle.
+  EXPECT_EQ(display_list.Replay(fb), 4u);
+  for (int y = 0; y < 16; y++) {
+    for (int x = 0; x < 16; x++) {
+      color_rgb565_t expected = kBlack;
+      if (x >= 4 && x < 6 && y >= 4 && y < 6) {
+        expected = kRed;
+      } else if (x >= 1 && x < 11 && y >= 1 && y < 11) {
+        expected = kIndigo;
+      } else if (y == 12) {
+        expected = kRed;
+      }
+      ASSERT_EQ(data[y * 16 + x], expected) << x << "," << y;
+    }
+  }
+
+  // In a tile inside the first rectangle, only the rectangles are visible.
+  std::array<color_rgb565_t, 4 * 4> tile_data;
+  Framebuffer tile(tile_data.data(), PixelFormat::RGB565, {4, 4}, 4 * 2);
+  tile.set_origin({2, 2});
+  EXPECT_EQ(display_list.Replay(tile), 2u);
+}
+
+TEST(DisplayList, ArenaFull) {
+  std::array<std::byte, 256> arena;
+  DisplayList display_list(arena);
+  size_t num_recorded = 0;
+  while (display_list.DrawLine(0, 0, 1, 1, kRed).ok()) {
+    num_recorded++;
+  }
+  EXPECT_GT(num_recorded, 0u);
+  EXPECT_EQ(display_list.size(), num_recorded);
+  EXPECT_LE(display_list.bytes_used(), arena.size());
+  EXPECT_EQ(display_list.DrawString(L"a", {0, 0}, kRed, kBlack, font6x8),
+            Status::ResourceExhausted());
+  EXPECT_EQ(display_list.size(), num_recorded);
+
+  display_list.Clear();
+  EXPECT_TRUE(display_list.empty());
+  EXPECT_EQ(display_list.bytes_used(), 0u);
+
+  // A string which does not fit records nothing.
+  std::array<wchar_t, 64> long_string;
+  long_string.fill(L'a');
+  EXPECT_EQ(display_list.DrawString(
+                {long_string.data(), long_string.size()},
+                {0, 0},
+                kRed,
+                kBlack,
+                font6x8),
+            Status::ResourceExhausted());
+  EXPECT_TRUE(display_list.empty());
+  EXPECT_EQ(display_list.DrawString(L"abc", {0, 0}, kRed, kBlack, font6x8),
+            OkStatus());
+  EXPECT_EQ(display_list.size(), 1u);
+}
+
+TEST(DisplayList, CopiesStrings) {
+  std::array<color_rgb565_t, 12 * 8> expected_data;
+  std::array<color_rgb565_t, 12 * 8> data;
+  Framebuffer expected(
+      expected_data.data(), PixelFormat::RGB565, {12, 8}, 12 * 2);
+  Framebuffer fb(data.data(), PixelFormat::RGB565, {12, 8}, 12 * 2);
+  DrawString(L"hi", {0, 0}, kRed, kBlack, font6x8, expected);
+
+  std::array<std::byte, 256> arena;
+  DisplayList display_list(arena);
+  wchar_t str[] = L"hi";
+  ASSERT_EQ(display_list.DrawString(str, {0, 0}, kRed, kBlack, font6x8),
+            OkStatus());
+  str[0] = L'x';
+  display_list.Replay(fb);
+  EXPECT_EQ(data, expected_data);
+}
+
+}  // namespace
+}  // namespace pw::draw
@@ -16,14 +16,36 @@
 
 #include <math.h>
 
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
 #include "pw_color/color.h"
+#include "pw_draw/glyph_cache.h"
+#include "pw_draw/indexed_sprite_sheet.h"
+#include "pw_draw/rle_sprite_sheet.h"
 #include "pw_draw/sprite_sheet.h"
+#include "pw_framebuffer/expand.h"
 #include "pw_framebuffer/framebuffer.h"
+#include "pw_framebuffer/pixel_format_traits.h"
+#include "pw_framebuffer/typed_writer.h"
 #include "pw_framebuffer/writer.h"
+#include "pw_math/rect.h"
 
 using pw::color::color_rgb565_t;
+using pw::framebuffer::ExpandIndexedPixels;
 using pw::framebuffer::Framebuffer;
 using pw::framebuffer::FramebufferWriter;
+using pw::framebuffer::GetPixelIndex;
+using pw::framebuffer::Rgb565Traits;
+using pw::framebuffer::TypedFramebufferWriter;
+using pw::math::Rect;
 using pw::math::Size;
 using pw::math::Vector2;
 
@@ -31,63 +53,652 @@ namespace pw::draw {
 
 namespace {
 
+// Writes to a framebuffer in display coordinates, like FramebufferWriter, but
+// with the pixel format described by |Traits| known at compile time. Drawing
+// functions get one from VisitDrawWriter() and convert their colors to Pixels
+// up front, so that the pixel format is checked once per call rather than for
+// every span or pixel.
+template <typename Traits>
+class DrawWriter {
+ public:
+  using Pixel = typename Traits::Pixel;
+
+  explicit DrawWriter(Framebuffer& framebuffer)
+      : writer_(framebuffer),
+        origin_x_(framebuffer.origin().x),
+        origin_y_(framebuffer.origin().y) {}
+
+  // Convert a pen color (or palette index) to a pixel.
+  static Pixel ToPixel(color_rgb565_t color) {
+    return Traits::FromValue(color);
+  }
+
+  void SetPixel(int x, int y, Pixel pixel) {
+    writer_.SetPixel(LocalX(x), LocalY(y), pixel);
+  }
+
+  void FillSpan(int y, int x0, int x1, Pixel pixel) {
+    writer_.FillSpan(LocalY(y), LocalX(x0), LocalX(x1), pixel);
+  }
+
+  void FillRect(int x, int y, int width, int height, Pixel pixel) {
+    writer_.FillRect(LocalX(x), LocalY(y), width, height, pixel);
+  }
+
+  void CopyPixels(int x, int y, span<const Pixel> pixels) {
+    writer_.CopySpan(LocalX(x), LocalY(y), pixels);
+  }
+
+  // Same as CopyPixels(), converting each of |colors| to a pixel.
+  void CopyColors(int x, int y, span<const color_rgb565_t> colors) {
+    if constexpr (std::is_same_v<Traits, Rgb565Traits>) {
+      writer_.CopySpan(LocalX(x), LocalY(y), colors);
+    } else {
+      writer_.CopySpan(LocalX(x), LocalY(y), colors, Traits::FromValue);
+    }
+  }
+
+ private:
+  // Subtract the framebuffer origin, clamping positions so far left or above
+  // the framebuffer that they would overflow.
+  static int ToLocal(int value, int origin) {
+    if (value < std::numeric_limits<int>::min() + origin) {
+      return std::numeric_limits<int>::min();
+    }
+    return value - origin;
+  }
+  int LocalX(int x) const { return ToLocal(x, origin_x_); }
+  int LocalY(int y) const { return ToLocal(y, origin_y_); }
+
+  TypedFramebufferWriter<Traits> writer_;
+  const int origin_x_;
+  const int origin_y_;
+};
+
+// Call |function| with a DrawWriter for the pixel format of |framebuffer|.
+template <typename Function>
+void VisitDrawWriter(Framebuffer& framebuffer, Function&& function) {
+  pw::framebuffer::VisitPixelFormat(
+      framebuffer.pixel_format(), [&](auto traits) {
+        DrawWriter<decltype(traits)> writer(framebuffer);
+        function(writer);
+      });
+}
+
 // Erase a rectangle the size of a font glyph to the background color.
 Size<int> DrawSpace(Vector2<int> pos,
                     color_rgb565_t bg_color,
                     const FontSet& font,
                     Framebuffer& framebuffer) {
   FramebufferWriter writer(framebuffer);
-  for (int font_row = 0; font_row < font.height; font_row++) {
-    for (int font_column = 0; font_column < font.width; font_column++) {
-      writer.SetPixel(pos.x + font_column, pos.y + font_row, bg_color);
+  writer.FillRect(pos.x, pos.y, font.width, font.height, bg_color);
+  return Size<int>{font.width, font.height};
+}
+
+// Return |rect| with int coordinates, for clipping arbitrary int positions.
+Rect<int> ToIntRect(const Rect<uint16_t>& rect) {
+  return Rect<int>{rect.x, rect.y, rect.width, rect.height};
+}
+
+// Cohen-Sutherland outcode bits, set when a point is beyond an edge.
+constexpr int kOutsideLeft = 1;
+constexpr int kOutsideRight = 2;
+constexpr int kOutsideTop = 4;
+constexpr int kOutsideBottom = 8;
+
+int OutCode(int x, int y, const Rect<int>& bounds) {
+  int code = 0;
+  if (x < bounds.x) {
+    code |= kOutsideLeft;
+  } else if (x >= bounds.x + bounds.width) {
+    code |= kOutsideRight;
+  }
+  if (y < bounds.y) {
+    code |= kOutsideTop;
+  } else if (y >= bounds.y + bounds.height) {
+    code |= kOutsideBottom;
+  }
+  return code;
+}
+
+// Draw the line from (x1, y1) to (x2, y2) with Bresenham's algorithm, only
+// visiting the pixels which are inside |bounds|. The pixels drawn are the
+// same as for an unclipped line. Coordinates may be anywhere in the int range.
+template <typename Writer>
+void DrawClippedLine(Writer& writer,
+                     const Rect<int>& bounds,
+                     int x1,
+                     int y1,
+                     int x2,
+                     int y2,
+                     typename Writer::Pixel pen) {
+  // Horizontal and vertical lines are a single clipped span.
+  if (y1 == y2) {
+    writer.FillSpan(y1, std::min(x1, x2), std::max(x1, x2), pen);
+    return;
+  }
+  if (x1 == x2) {
+    const int top = std::max(std::min(y1, y2), bounds.y);
+    const int bottom =
+        std::min(std::max(y1, y2), bounds.y + bounds.height - 1);
+    if (top <= bottom) {
+      writer.FillRect(x1, top, 1, bottom - top + 1, pen);
     }
+    return;
+  }
+
+  // Step along the major axis |a|, occasionally stepping the minor axis |b|.
+  // Coordinates are relative to the upper left corner of |bounds|.
+  const bool steep =
+      std::abs(int64_t{y2} - y1) > std::abs(int64_t{x2} - x1);
+  const int a_origin = steep ? bounds.y : bounds.x;
+  const int b_origin = steep ? bounds.x : bounds.y;
+  int64_t a1 = int64_t{steep ? y1 : x1} - a_origin;
+  int64_t b1 = int64_t{steep ? x1 : y1} - b_origin;
+  int64_t a2 = int64_t{steep ? y2 : x2} - a_origin;
+  int64_t b2 = int64_t{steep ? x2 : y2} - b_origin;
+  const int a_limit = steep ? bounds.height : bounds.width;
+  const int b_limit = steep ? bounds.width : bounds.height;
+  if (a1 > a2) {
+    std::swap(a1, a2);
+    std::swap(b1, b2);
+  }
+  const int b_step = b1 < b2 ? 1 : -1;
+  const int64_t da = a2 - a1;
+  const int64_t db = std::abs(b2 - b1);
+  const int64_t initial_error = da / 2;
+
+  // Pixel i of the line is at a1 + i, and has taken
+  //   steps(i) = (i * db - initial_error + da - 1) / da
+  // minor axis steps. Both deltas fit in 32 bits, so the products are done
+  // in uint64_t. Return the first pixel which has taken |steps| steps.
+  auto first_pixel_with_steps = [&](int64_t steps) -> int64_t {
+    if (steps <= 0) {
+      return 0;
+    }
+    if (steps > db) {
+      return da + 1;
+    }
+    const uint64_t numerator =
+        uint64_t(steps - 1) * uint64_t(da) + uint64_t(initial_error) + 1;
+    return (numerator + db - 1) / uint64_t(db);
+  };
+  // The range of minor axis steps which keep b within the bounds.
+  const int64_t min_steps = b_step > 0 ? -b1 : b1 - (b_limit - 1);
+  const int64_t max_steps = b_step > 0 ? b_limit - 1 - b1 : b1;
+  const int64_t first = std::max(
+      {int64_t{0}, -a1, first_pixel_with_steps(min_steps)});
+  const int64_t last = std::min({da,
+                                 a_limit - 1 - a1,
+                                 first_pixel_with_steps(max_steps + 1) - 1});
+  if (first > last) {
+    return;
+  }
+
+  // Resume Bresenham's algorithm at the first visible pixel. From here on,
+  // every coordinate is within the bounds.
+  const uint64_t steps =
+      (uint64_t(first) * uint64_t(db) + uint64_t(da - 1 - initial_error)) /
+      uint64_t(da);
+  int64_t error = static_cast<int64_t>(uint64_t(initial_error) +
+                                       steps * uint64_t(da) -
+                                       uint64_t(first) * uint64_t(db));
+  int b = static_cast<int>(b1 + b_step * static_cast<int64_t>(steps));
+  const int a_first = static_cast<int>(a1 + first);
+  const int a_last = static_cast<int>(a1 + last);
+
+  // Pixels with the same minor coordinate form a run, which is written as a
+  // single span (or a one pixel wide column for steep lines).
+  int run_start = a_first;
+  for (int a = a_first; a <= a_last; a++) {
+    error -= db;
+    if (error < 0 || a == a_last) {
+      if (steep) {
+        writer.FillRect(
+            b + b_origin, run_start + a_origin, 1, a - run_start + 1, pen);
+      } else {
+        writer.FillSpan(b + b_origin, run_start + a_origin, a + a_origin, pen);
+      }
+      run_start = a + 1;
+    }
+    if (error < 0) {
+      b += b_step;
+      error += da;
+    }
+  }
+}
+
+// Streams the half-widths of the rows of a circle, from the center row
+// outward, using the same midpoint walk as the original per-pixel DrawCircle.
+class CircleProfile {
+ public:
+  explicit CircleProfile(int radius)
+      : radius_(radius), x_(-radius), error_(2 - 2 * radius) {}
+
+  // Return the half-width of the row |dy| rows from the center, or -1 if the
+  // row is outside of the circle. |dy| must not decrease between calls.
+  int HalfWidth(int dy) {
+    if (dy > radius_) {
+      return -1;
+    }
+    while (x_ < 0 && y_ < dy) {
+      Step();
+    }
+    // Rows which the walk ends before reaching only contain the center column.
+    return y_ == dy ? -x_ : 0;
+  }
+
+ private:
+  void Step() {
+    const int prev_error = error_;
+    if (prev_error <= y_) {
+      y_++;
+      error_ += y_ * 2 + 1;
+    }
+    if (prev_error > x_ || error_ > y_) {
+      x_++;
+      error_ += x_ * 2 + 1;
+    }
+  }
+
+  const int radius_;
+  int x_;
+  int y_ = 0;
+  int error_;
+};
+
+// Plot a one pixel wide circle outline with the midpoint walk, a pixel in each
+// quadrant per step. Most outline rows are only a pixel or two wide, so this
+// is faster than splitting each row into spans.
+template <typename Writer>
+void DrawCircleOutline(Writer& writer,
+                       int center_x,
+                       int center_y,
+                       int radius,
+                       typename Writer::Pixel pen) {
+  if (radius == 0) {
+    writer.SetPixel(center_x, center_y, pen);
+    return;
+  }
+  int x = -radius;
+  int y = 0;
+  int error_value = 2 - 2 * radius;
+  while (x < 0) {
+    writer.SetPixel(center_x - x, center_y + y, pen);  // Lower right
+    writer.SetPixel(center_x + x, center_y - y, pen);  // Upper left
+    writer.SetPixel(center_x - y, center_y - x, pen);  // Lower left
+    writer.SetPixel(center_x + y, center_y + x, pen);  // Upper right
+    const int prev_error = error_value;
+    if (prev_error <= y) {
+      y++;
+      error_value += y * 2 + 1;
+    }
+    if (prev_error > x || error_value > y) {
+      x++;
+      error_value += x * 2 + 1;
+    }
+  }
+}
+
+// Streams the half-widths of the rows of an axis-aligned ellipse, from the
+// center row outward. A pixel is inside when its center is inside an ellipse
+// half a pixel larger than the radii, so equal radii give a round circle.
+class EllipseProfile {
+ public:
+  EllipseProfile(int radius_x, int radius_y)
+      : radius_y_(radius_y),
+        diameter_x_sq_(Square(2 * radius_x + 1)),
+        diameter_y_sq_(Square(2 * radius_y + 1)),
+        half_width_(radius_x) {}
+
+  // Return the half-width of the row |dy| rows from the center, or -1 if the
+  // row is outside of the ellipse. |dy| must not decrease between calls.
+  int HalfWidth(int dy) {
+    if (dy > radius_y_) {
+      return -1;
+    }
+    // Inside when (2x / dx)^2 + (2y / dy)^2 <= 1, for diameters dx and dy.
+    const int64_t row_term = 4 * Square(dy) * diameter_x_sq_;
+    const int64_t limit = diameter_x_sq_ * diameter_y_sq_;
+    while (half_width_ > 0 &&
+           4 * Square(half_width_) * diameter_y_sq_ + row_term > limit) {
+      half_width_--;
+    }
+    return half_width_;
+  }
+
+ private:
+  static int64_t Square(int64_t value) { return value * value; }
+
+  const int radius_y_;
+  const int64_t diameter_x_sq_;
+  const int64_t diameter_y_sq_;
+  int half_width_;
+};
+
+// Rasterizes a shape built from the four quadrants of a profile, calling
+// |emit_span(y, x0, x1)| exactly once for every row the shape covers. The
+// quadrants are centered at |left_x| and |right_x| horizontally, and at |top_y|
+// and |bottom_y| vertically. Rows between |top_y| and |bottom_y| continue the
+// sides straight down, so equal centers give a circle or ellipse and distinct
+// centers give a rounded rectangle. Outlines are one pixel wide, and are
+// emitted as at most two spans per row.
+template <typename Profile, typename EmitSpan>
+void RasterizeQuadrants(Profile& profile,
+                        int left_x,
+                        int right_x,
+                        int top_y,
+                        int bottom_y,
+                        bool filled,
+                        EmitSpan&& emit_span) {
+  // Emit a row whose outer pixels are |outer| pixels beyond the quadrant
+  // centers, and whose outline reaches |inner| pixels beyond them. A negative
+  // |inner| draws the whole row.
+  auto emit_row = [&](int y, int outer, int inner) {
+    const int x0 = left_x - outer;
+    const int x1 = right_x + outer;
+    if (filled || inner < 0 || left_x - inner + 1 >= right_x + inner) {
+      emit_span(y, x0, x1);
+      return;
+    }
+    emit_span(y, x0, left_x - inner);
+    emit_span(y, right_x + inner, x1);
+  };
+
+  const int center_half_width = profile.HalfWidth(0);
+  if (center_half_width < 0) {
+    return;
+  }
+  for (int y = top_y + 1; y < bottom_y; y++) {
+    emit_row(y, center_half_width, center_half_width);
+  }
+
+  int half_width = center_half_width;
+  for (int dy = 0; half_width >= 0; dy++) {
+    const int next_half_width = profile.HalfWidth(dy + 1);
+    // The outline must reach one pixel past the next row out to stay
+    // connected. The last row is drawn in full.
+    const int inner =
+        next_half_width < 0 ? -1 : std::min(next_half_width + 1, half_width);
+    emit_row(top_y - dy, half_width, inner);
+    if (dy > 0 || bottom_y != top_y) {
+      emit_row(bottom_y + dy, half_width, inner);
+    }
+    half_width = next_half_width;
   }
-  return Size<int>{font.width, font.height};
 }
 
+// The largest radius that shape rasterization supports without overflow.
+constexpr int kMaxRadius = 16383;
+
+// Return floor(numerator / denominator) for a positive |denominator|.
+int FloorDiv(int numerator, int denominator) {
+  if (numerator >= 0) {
+    return numerator / denominator;
+  }
+  return -((-numerator + denominator - 1) / denominator);
+}
+
+// An inclusive range of columns. Empty when first > last.
+struct ColumnRange {
+  int first;
+  int last;
+};
+
+// Restricts spans to the part of a circle between two angles.
+class ArcClipper {
+ public:
+  ArcClipper(int center_x, int center_y, int start_angle, int sweep)
+      : center_x_(center_x),
+        center_y_(center_y),
+        start_(AngleVector(start_angle)),
+        end_(AngleVector(start_angle + sweep)),
+        wide_(sweep > 180) {}
+
+  // Call |emit_span| with the parts of the span that are inside the arc.
+  template <typename EmitSpan>
+  void ClipSpan(int y, int x0, int x1, EmitSpan&& emit_span) const {
+    const int dy = y - center_y_;
+    // Points clockwise of the start direction, i.e. cross(start, p) >= 0.
+    ColumnRange after_start =
+        Intersect(x0, x1, SolveAtMost(start_.y, start_.x * dy));
+    // Points counter-clockwise of the end direction, i.e. cross(p, end) >= 0.
+    ColumnRange before_end =
+        Intersect(x0, x1, SolveAtMost(-end_.y, -end_.x * dy));
+    if (!wide_) {
+      emit_span(y,
+                std::max(after_start.first, before_end.first),
+                std::min(after_start.last, before_end.last));
+      return;
+    }
+    // Arcs over 180 degrees are the union of both half-planes. Emit ranges
+    // which overlap or touch as a single span.
+    if (after_start.first > after_start.last) {
+      emit_span(y, before_end.first, before_end.last);
+    } else if (before_end.first > before_end.last) {
+      emit_span(y, after_start.first, after_start.last);
+    } else if (after_start.first <= before_end.last + 1 &&
+               before_end.first <= after_start.last + 1) {
+      emit_span(y,
+                std::min(after_start.first, before_end.first),
+                std::max(after_start.last, before_end.last));
+    } else {
+      emit_span(y, after_start.first, after_start.last);
+      emit_span(y, before_end.first, before_end.last);
+    }
+  }
+
+ private:
+  static constexpr int kAngleScale = 1 << 14;
+
+  // Return the direction |degrees| clockwise from the positive x axis.
+  static Vector2<int> AngleVector(int degrees) {
+    constexpr float kRadiansPerDegree = 3.14159265f / 180.0f;
+    const float radians = static_cast<float>(degrees) * kRadiansPerDegree;
+    return Vector2<int>{
+        static_cast<int>(lroundf(cosf(radians) * kAngleScale)),
+        static_cast<int>(lroundf(sinf(radians) * kAngleScale))};
+  }
+
+  // Return the columns x, relative to the center, where coefficient * x <=
+  // limit.
+  static ColumnRange SolveAtMost(int coefficient, int limit) {
+    if (coefficient > 0) {
+      return ColumnRange{INT_MIN, FloorDiv(limit, coefficient)};
+    }
+    if (coefficient < 0) {
+      return ColumnRange{-FloorDiv(limit, -coefficient), INT_MAX};
+    }
+    return limit >= 0 ? ColumnRange{INT_MIN, INT_MAX} : ColumnRange{1, 0};
+  }
+
+  // Return the absolute columns of |range| which are within x0..x1.
+  ColumnRange Intersect(int x0, int x1, ColumnRange range) const {
+    if (range.first > range.last) {
+      return range;
+    }
+    const int first = range.first == INT_MIN ? x0 : center_x_ + range.first;
+    const int last = range.last == INT_MAX ? x1 : center_x_ + range.last;
+    return ColumnRange{std::max(x0, first), std::min(x1, last)};
+  }
+
+  const int center_x_;
+  const int center_y_;
+  const Vector2<int> start_;
+  const Vector2<int> end_;
+  // True when the arc covers more than 180 degrees.
+  const bool wide_;
+};
+
+// Draws the rows of a sprite which has been scaled, flipped and positioned in
+// a framebuffer, through |writer|. Pixels are expanded into a line buffer once
+// per sprite row, and then copied to each of the framebuffer rows which they
+// cover.
+template <typename Writer>
+class SpriteBlitter {
+ public:
+  SpriteBlitter(Writer& writer,
+                const Framebuffer& fb,
+                int x,
+                int y,
+                int width,
+                int height,
+                int scale,
+                SpriteFlip flip)
+      : writer_(writer),
+        fb_left_(fb.bounds().x),
+        fb_top_(fb.bounds().y),
+        fb_right_(fb.bounds().x + fb.bounds().width),
+        fb_bottom_(fb.bounds().y + fb.bounds().height),
+        x_(x),
+        y_(y),
+        width_(width),
+        height_(height),
+        scale_(scale),
+        flip_x_(flip == SpriteFlip::kHorizontal || flip == SpriteFlip::kBoth),
+        flip_y_(flip == SpriteFlip::kVertical || flip == SpriteFlip::kBoth) {
+    if (scale < 1 || x >= fb_right_ || y >= fb_bottom_) {
+      return;
+    }
+    // The range of sprite columns and rows, in drawing order, which land at
+    // least partly inside the framebuffer.
+    const int first_column = x < fb_left_ ? (fb_left_ - x) / scale : 0;
+    const int last_column = std::min(width - 1, (fb_right_ - 1 - x) / scale);
+    const int first_row = y < fb_top_ ? (fb_top_ - y) / scale : 0;
+    const int last_row = std::min(height - 1, (fb_bottom_ - 1 - y) / scale);
+    first_column_ = flip_x_ ? width - 1 - last_column : first_column;
+    last_column_ = flip_x_ ? width - 1 - first_column : last_column;
+    first_row_ = flip_y_ ? height - 1 - last_row : first_row;
+    last_row_ = flip_y_ ? height - 1 - first_row : last_row;
+  }
+
+  // The visible sprite columns and rows. Empty if the sprite is not visible.
+  int first_column() const { return first_column_; }
+  int last_column() const { return last_column_; }
+  int first_row() const { return first_row_; }
+  int last_row() const { return last_row_; }
+
+  // Draw |pixels|, which start at sprite column |column| of sprite row |row|.
+  // Pixels outside of the visible columns are skipped.
+  void DrawRun(int row, int column, span<const color_rgb565_t> pixels) {
+    const int first = std::max(column, first_column_);
+    const int end =
+        std::min(column + static_cast<int>(pixels.size()), last_column_ + 1);
+    if (first >= end) {
+      return;
+    }
+    const int dst_row = flip_y_ ? height_ - 1 - row : row;
+    const int dst_y0 = std::max(y_ + dst_row * scale_, fb_top_);
+    const int dst_y1 = std::min(y_ + dst_row * scale_ + scale_, fb_bottom_);
+    if (scale_ == 1 && !flip_x_) {
+      const auto visible = pixels.subspan(first - column, end - first);
+      for (int dst_y = dst_y0; dst_y < dst_y1; dst_y++) {
+        writer_.CopyColors(x_ + first, dst_y, visible);
+      }
+      return;
+    }
+
+    // The run's columns in drawing order.
+    const int dst_first = flip_x_ ? width_ - end : first;
+    const int dst_end = flip_x_ ? width_ - first : end;
+    auto color_at = [&](int dst_column) {
+      return pixels[(flip_x_ ? width_ - 1 - dst_column : dst_column) - column];
+    };
+    // Expand the run a line buffer at a time, skipping pixels left of the
+    // framebuffer.
+    int dst_x = std::max(x_ + dst_first * scale_, fb_left_);
+    const int dst_x_end = std::min(x_ + dst_end * scale_, fb_right_);
+    while (dst_x < dst_x_end) {
+      const int count = std::min(dst_x_end - dst_x, kLinePixels);
+      int src_column = (dst_x - x_) / scale_;
+      int repeat = scale_ - (dst_x - x_) % scale_;
+      for (int i = 0; i < count; i++) {
+        line_[i] = color_at(src_column);
+        if (--repeat == 0) {
+          src_column++;
+          repeat = scale_;
+        }
+      }
+      const span<const color_rgb565_t> expanded(line_.data(), count);
+      for (int dst_y = dst_y0; dst_y < dst_y1; dst_y++) {
+        writer_.CopyColors(dst_x, dst_y, expanded);
+      }
+      dst_x += count;
+    }
+  }
+
+ private:
+  static constexpr int kLinePixels = 128;
+
+  Writer& writer_;
+  // The framebuffer bounds, in drawing coordinates.
+  const int fb_left_;
+  const int fb_top_;
+  const int fb_right_;
+  const int fb_bottom_;
+  const int x_;
+  const int y_;
+  const int width_;
+  const int height_;
+  const int scale_;
+  const bool flip_x_;
+  const bool flip_y_;
+  int first_column_ = 0;
+  int last_column_ = -1;
+  int first_row_ = 0;
+  int last_row_ = -1;
+  std::array<color_rgb565_t, kLinePixels> line_;
+};
+
+// Maps every 8 bit index to itself, to copy the indices of indexed sprites
+// into indexed framebuffers.
+constexpr std::array<color_rgb565_t, 256> kIdentityPalette = [] {
+  std::array<color_rgb565_t, 256> palette = {};
+  for (size_t i = 0; i < palette.size(); i++) {
+    palette[i] = static_cast<color_rgb565_t>(i);
+  }
+  return palette;
+}();
+
 }  // namespace
 
 void DrawLine(
     Framebuffer& fb, int x1, int y1, int x2, int y2, color_rgb565_t pen_color) {
-  // Bresenham's Line Algorithm
-  int16_t steep_gradient = abs(y2 - y1) > abs(x2 - x1);
-  // Swap values
-  int16_t temp;
-  if (steep_gradient) {
-    temp = x1;
-    x1 = y1;
-    y1 = temp;
-    temp = x2;
-    x2 = y2;
-    y2 = temp;
-  }
-  if (x1 > x2) {
-    temp = x1;
-    x1 = x2;
-    x2 = temp;
-    temp = y1;
-    y1 = y2;
-    y2 = temp;
-  }
-
-  int16_t dx = x2 - x1;
-  int16_t dy = abs(y2 - y1);
-  int16_t error_value = dx / 2;
-  int16_t ystep = y1 < y2 ? 1 : -1;
+  const Rect<int> bounds = ToIntRect(fb.bounds());
+  // Lines entirely beyond one edge of the framebuffer draw nothing.
+  if (OutCode(x1, y1, bounds) & OutCode(x2, y2, bounds)) {
+    return;
+  }
+  VisitDrawWriter(fb, [&](auto& writer) {
+    DrawClippedLine(
+        writer, bounds, x1, y1, x2, y2, writer.ToPixel(pen_color));
+  });
+}
 
-  FramebufferWriter writer(fb);
-  for (; x1 <= x2; x1++) {
-    if (steep_gradient) {
-      writer.SetPixel(y1, x1, pen_color);
-    } else {
-      writer.SetPixel(x1, y1, pen_color);
+void DrawPolyline(Framebuffer& fb,
+                  span<const Vector2<int>> points,
+                  color_rgb565_t pen_color) {
+  if (points.empty()) {
+    return;
+  }
+  const Rect<int> bounds = ToIntRect(fb.bounds());
+  VisitDrawWriter(fb, [&](auto& writer) {
+    const auto pen = writer.ToPixel(pen_color);
+    if (points.size() == 1) {
+      writer.FillSpan(points[0].y, points[0].x, points[0].x, pen);
+      return;
     }
-    error_value -= dy;
-    if (error_value < 0) {
-      y1 += ystep;
-      error_value += dx;
+    int prev_code = OutCode(points[0].x, points[0].y, bounds);
+    for (size_t i = 1; i < points.size(); i++) {
+      const Vector2<int>& p1 = points[i - 1];
+      const Vector2<int>& p2 = points[i];
+      const int code = OutCode(p2.x, p2.y, bounds);
+      if (!(prev_code & code)) {
+        DrawClippedLine(writer, bounds, p1.x, p1.y, p2.x, p2.y, pen);
+      }
+      prev_code = code;
     }
-  }
+  });
 }
 
 // Draw a circle at center_x, center_y with given radius and color. Only a
@@ -98,46 +709,128 @@ void DrawCircle(Framebuffer& fb,
                 int radius,
                 color_rgb565_t pen_color,
                 bool filled = false) {
-  int fx = 0, fy = 0;
-  int x = -radius, y = 0;
-  int error_value = 2 - 2 * radius;
-  FramebufferWriter writer(fb);
-  while (x < 0) {
+  if (radius < 0 || radius > kMaxRadius) {
+    return;
+  }
+  VisitDrawWriter(fb, [&](auto& writer) {
+    const auto pen = writer.ToPixel(pen_color);
     if (!filled) {
-      fx = x;
-      fy = y;
-    }
-    // Draw each quarter circle
-    for (int i = x; i <= fx; i++) {
-      // Lower right
-      writer.SetPixel(center_x - i, center_y + y, pen_color);
-      // Upper left
-      writer.SetPixel(center_x + i, center_y - y, pen_color);
-    }
-    for (int i = fy; i <= y; i++) {
-      // Lower left
-      writer.SetPixel(center_x - i, center_y - x, pen_color);
-      // Upper right
-      writer.SetPixel(center_x + i, center_y + x, pen_color);
-    }
-    radius = error_value;
-    if (radius <= y) {
-      y++;
-      error_value += y * 2 + 1;
-    }
-    if (radius > x || error_value > y) {
-      x++;
-      error_value += x * 2 + 1;
+      DrawCircleOutline(writer, center_x, center_y, radius, pen);
+      return;
     }
+    CircleProfile profile(radius);
+    RasterizeQuadrants(profile,
+                       center_x,
+                       center_x,
+                       center_y,
+                       center_y,
+                       filled,
+                       [&writer, pen](int y, int x0, int x1) {
+                         writer.FillSpan(y, x0, x1, pen);
+                       });
+  });
+}
+
+void DrawEllipse(Framebuffer& fb,
+                 int center_x,
+                 int center_y,
+                 int radius_x,
+                 int radius_y,
+                 color_rgb565_t pen_color,
+                 bool filled) {
+  if (radius_x < 0 || radius_y < 0 || radius_x > kMaxRadius ||
+      radius_y > kMaxRadius) {
+    return;
   }
+  VisitDrawWriter(fb, [&](auto& writer) {
+    const auto pen = writer.ToPixel(pen_color);
+    EllipseProfile profile(radius_x, radius_y);
+    RasterizeQuadrants(profile,
+                       center_x,
+                       center_x,
+                       center_y,
+                       center_y,
+                       filled,
+                       [&writer, pen](int y, int x0, int x1) {
+                         writer.FillSpan(y, x0, x1, pen);
+                       });
+  });
+}
+
+void DrawRoundRect(Framebuffer& fb,
+                   int x,
+                   int y,
+                   int w,
+                   int h,
+                   int radius,
+                   color_rgb565_t pen_color,
+                   bool filled) {
+  if (w <= 0 || h <= 0) {
+    return;
+  }
+  radius = std::clamp(radius, 0, std::min(w - 1, h - 1) / 2);
+  VisitDrawWriter(fb, [&](auto& writer) {
+    const auto pen = writer.ToPixel(pen_color);
+    CircleProfile profile(radius);
+    RasterizeQuadrants(profile,
+                       x + radius,
+                       x + w - 1 - radius,
+                       y + radius,
+                       y + h - 1 - radius,
+                       filled,
+                       [&writer, pen](int row, int x0, int x1) {
+                         writer.FillSpan(row, x0, x1, pen);
+                       });
+  });
+}
+
+void DrawArc(Framebuffer& fb,
+             int center_x,
+             int center_y,
+             int radius,
+             int start_angle,
+             int end_angle,
+             color_rgb565_t pen_color,
+             bool filled) {
+  if (end_angle - start_angle >= 360) {
+    DrawCircle(fb, center_x, center_y, radius, pen_color, filled);
+    return;
+  }
+  const int sweep = ((end_angle - start_angle) % 360 + 360) % 360;
+  if (radius < 0 || radius > kMaxRadius || sweep == 0) {
+    return;
+  }
+  const ArcClipper clipper(center_x, center_y, start_angle % 360, sweep);
+  VisitDrawWriter(fb, [&](auto& writer) {
+    const auto pen = writer.ToPixel(pen_color);
+    CircleProfile profile(radius);
+    auto fill_span = [&writer, pen](int y, int x0, int x1) {
+      writer.FillSpan(y, x0, x1, pen);
+    };
+    RasterizeQuadrants(profile,
+                       center_x,
+                       center_x,
+                       center_y,
+                       center_y,
+                       filled,
+                       [&clipper, &fill_span](int y, int x0, int x1) {
+                         clipper.ClipSpan(y, x0, x1, fill_span);
+                       });
+  });
 }
 
 void DrawHLine(
     Framebuffer& fb, int x1, int x2, int y, color_rgb565_t pen_color) {
   FramebufferWriter writer(fb);
-  for (int i = x1; i <= x2; i++) {
-    writer.SetPixel(i, y, pen_color);
-  }
+  writer.FillSpan(y, x1, x2, pen_color);
+}
+
+// Return |value| limited to just outside the coordinates of any framebuffer
+// pixel. Framebuffer origins and sizes are uint16_t, so this doesn't change
+// which pixels a rectangle covers, but keeps its size far from overflowing int.
+int ClampToFramebufferRange(int64_t value) {
+  constexpr int64_t kLimit = 0x20000;
+  return static_cast<int>(std::clamp<int64_t>(value, -1, kLimit));
 }
 
 void DrawRect(Framebuffer& fb,
@@ -147,20 +840,23 @@ void DrawRect(Framebuffer& fb,
               int y2,
               color_rgb565_t pen_color,
               bool filled = false) {
-  // Draw top and bottom lines.
-  DrawHLine(fb, x1, x2, y1, pen_color);
-  DrawHLine(fb, x1, x2, y2, pen_color);
-  if (filled) {
-    for (int y = y1 + 1; y < y2; y++) {
-      DrawHLine(fb, x1, x2, y, pen_color);
-    }
-  } else {
-    FramebufferWriter writer(fb);
-    for (int y = y1 + 1; y < y2; y++) {
-      writer.SetPixel(x1, y, pen_color);
-      writer.SetPixel(x2, y, pen_color);
+  x1 = ClampToFramebufferRange(x1);
+  y1 = ClampToFramebufferRange(y1);
+  x2 = ClampToFramebufferRange(x2);
+  y2 = ClampToFramebufferRange(y2);
+  VisitDrawWriter(fb, [&](auto& writer) {
+    const auto pen = writer.ToPixel(pen_color);
+    if (filled) {
+      writer.FillRect(x1, y1, x2 - x1 + 1, y2 - y1 + 1, pen);
+      return;
     }
-  }
+    // Draw top and bottom lines.
+    writer.FillSpan(y1, x1, x2, pen);
+    writer.FillSpan(y2, x1, x2, pen);
+    // Draw the left and right sides.
+    writer.FillRect(x1, y1 + 1, 1, y2 - y1 - 1, pen);
+    writer.FillRect(x2, y1 + 1, 1, y2 - y1 - 1, pen);
+  });
 }
 
 void DrawRectWH(Framebuffer& fb,
@@ -170,7 +866,13 @@ void DrawRectWH(Framebuffer& fb,
                 int h,
                 color_rgb565_t pen_color,
                 bool filled = false) {
-  DrawRect(fb, x, y, x - 1 + w, y - 1 + h, pen_color, filled);
+  DrawRect(fb,
+           x,
+           y,
+           ClampToFramebufferRange(int64_t{x} - 1 + w),
+           ClampToFramebufferRange(int64_t{y} - 1 + h),
+           pen_color,
+           filled);
 }
 
 void Fill(Framebuffer& fb, color_rgb565_t pen_color) {
@@ -183,40 +885,160 @@ void DrawSprite(Framebuffer& fb,
                 int y,
                 pw::draw::SpriteSheet* sprite_sheet,
                 int integer_scale = 1) {
-  uint16_t color;
-  int start_x, start_y;
-  FramebufferWriter writer(fb);
-  for (int current_x = 0; current_x < sprite_sheet->width; current_x++) {
-    for (int current_y = 0; current_y < sprite_sheet->height; current_y++) {
-      color = sprite_sheet->GetColor(
-          current_x, current_y, sprite_sheet->current_index);
-      if (color != sprite_sheet->transparent_color) {
-        if (integer_scale == 1) {
-          writer.SetPixel(x + current_x, y + current_y, color);
+  DrawSprite(fb, x, y, sprite_sheet, integer_scale, SpriteFlip::kNone);
+}
+
+void DrawSprite(Framebuffer& fb,
+                int x,
+                int y,
+                pw::draw::SpriteSheet* sprite_sheet,
+                int integer_scale,
+                SpriteFlip flip) {
+  VisitDrawWriter(fb, [&](auto& writer) {
+    SpriteBlitter blitter(writer,
+                          fb,
+                          x,
+                          y,
+                          sprite_sheet->width,
+                          sprite_sheet->height,
+                          integer_scale,
+                          flip);
+    const color_rgb565_t transparent_color = sprite_sheet->transparent_color;
+    for (int row = blitter.first_row(); row <= blitter.last_row(); row++) {
+      const color_rgb565_t* src =
+          sprite_sheet->GetRow(row, sprite_sheet->current_index);
+      int column = blitter.first_column();
+      while (column <= blitter.last_column()) {
+        // Skip the transparent run, then find the end of the opaque run.
+        while (column <= blitter.last_column() &&
+               src[column] == transparent_color) {
+          column++;
+        }
+        const int run_start = column;
+        while (column <= blitter.last_column() &&
+               src[column] != transparent_color) {
+          column++;
         }
-        // If integer_scale > 1: draw a rectangle
-        else if (integer_scale > 1) {
-          start_x = x + (integer_scale * current_x);
-          start_y = y + (integer_scale * current_y);
-          DrawRectWH(
-              fb, start_x, start_y, integer_scale, integer_scale, color, true);
+        if (run_start < column) {
+          blitter.DrawRun(
+              row, run_start, span(src + run_start, column - run_start));
         }
       }
     }
-  }
+  });}
+
+void DrawSprite(Framebuffer& fb,
+                int x,
+                int y,
+                const RleSpriteSheet* sprite_sheet,
+                int integer_scale,
+                SpriteFlip flip) {
+  VisitDrawWriter(fb, [&](auto& writer) {
+    SpriteBlitter blitter(writer,
+                          fb,
+                          x,
+                          y,
+                          sprite_sheet->width,
+                          sprite_sheet->height,
+                          integer_scale,
+                          flip);
+    for (int row = blitter.first_row(); row <= blitter.last_row(); row++) {
+      const uint16_t* src =
+          sprite_sheet->GetRow(row, sprite_sheet->current_index);
+      const int num_runs = *src++;
+      int column = 0;
+      for (int run = 0; run < num_runs; run++) {
+        column += src[0];
+        const int length = src[1];
+        src += 2;
+        if (column > blitter.last_column()) {
+          break;
+        }
+        blitter.DrawRun(row, column, span(src, length));
+        src += length;
+        column += length;
+      }
+    }
+  });}
+
+void DrawSprite(Framebuffer& fb,
+                int x,
+                int y,
+                const IndexedSpriteSheet* sprite_sheet,
+                int integer_scale,
+                SpriteFlip flip) {
+  const span<const color_rgb565_t> palette =
+      pw::framebuffer::IsIndexed(fb.pixel_format())
+          ? span<const color_rgb565_t>(kIdentityPalette)
+          : sprite_sheet->palette;
+  DrawSprite(fb, x, y, sprite_sheet, palette, integer_scale, flip);
 }
 
+void DrawSprite(Framebuffer& fb,
+                int x,
+                int y,
+                const IndexedSpriteSheet* sprite_sheet,
+                span<const color_rgb565_t> palette,
+                int integer_scale,
+                SpriteFlip flip) {
+  VisitDrawWriter(fb, [&](auto& writer) {
+    SpriteBlitter blitter(writer,
+                          fb,
+                          x,
+                          y,
+                          sprite_sheet->width,
+                          sprite_sheet->height,
+                          integer_scale,
+                          flip);
+    const int bits_per_pixel = sprite_sheet->bits_per_pixel;
+    const int transparent_index = sprite_sheet->transparent_index;
+    constexpr int kRunPixels = 64;
+    std::array<color_rgb565_t, kRunPixels> run_colors;
+    for (int row = blitter.first_row(); row <= blitter.last_row(); row++) {
+      const uint8_t* src =
+          sprite_sheet->GetRow(row, sprite_sheet->current_index);
+      auto is_transparent = [&](int column) {
+        return GetPixelIndex(src, bits_per_pixel, column) == transparent_index;
+      };
+      int column = blitter.first_column();
+      while (column <= blitter.last_column()) {
+        while (column <= blitter.last_column() && is_transparent(column)) {
+          column++;
+        }
+        const int run_start = column;
+        while (column <= blitter.last_column() && !is_transparent(column)) {
+          column++;
+        }
+        // Expand the opaque run to colors a chunk at a time.
+        for (int start = run_start; start < column; start += kRunPixels) {
+          const int length = std::min(column - start, kRunPixels);
+          ExpandIndexedPixels(
+              src, bits_per_pixel, start, length, palette, run_colors.data());
+          blitter.DrawRun(row, start, span(run_colors.data(), length));
+        }
+      }
+    }
+  });}
+
 void DrawTestPattern(Framebuffer& fb) {
   color_rgb565_t color = pw::color::ColorRGBA(0x00, 0xFF, 0xFF).ToRgb565();
-  // Create a Test Pattern
-  FramebufferWriter writer(fb);
-  for (int x = 0; x < fb.size().width; x++) {
-    for (int y = 0; y < fb.size().height; y++) {
-      if (y % 10 != x % 10) {
-        writer.SetPixel(x, y, color);
+  // Create a Test Pattern: every pixel is set except for those where
+  // (x % 10) == (y % 10), so fill the runs between the skipped pixels.
+  const Rect<int> bounds = ToIntRect(fb.bounds());
+  const int right = bounds.x + bounds.width;
+  VisitDrawWriter(fb, [&](auto& writer) {
+    const auto pen = writer.ToPixel(color);
+    for (int y = bounds.y; y < bounds.y + bounds.height; y++) {
+      int x = bounds.x;
+      for (int skip_x = bounds.x + (y - bounds.x % 10 + 10) % 10;
+           skip_x < right;
+           skip_x += 10) {
+        writer.FillSpan(y, x, skip_x - 1, pen);
+        x = skip_x + 1;
       }
+      writer.FillSpan(y, x, right - 1, pen);
     }
-  }
+  });
 }
 
 Size<int> DrawCharacter(int ch,
@@ -234,17 +1056,29 @@ Size<int> DrawCharacter(int ch,
   }
   const int character_index = (int)ch - font.starting_character;
 
-  FramebufferWriter writer(framebuffer);
-  for (int font_row = 0; font_row < font.height; font_row++) {
-    for (int font_column = 0; font_column < font.width; font_column++) {
-      const bool pixel_on =
-          PW_FONT_BIT(font.width - font_column - 1,
-                      font.data[font.height * character_index + font_row]);
-      writer.SetPixel(pos.x + font_column,
-                      pos.y + font_row,
-                      pixel_on ? fg_color : bg_color);
+  VisitDrawWriter(framebuffer, [&](auto& writer) {
+    using Pixel = typename std::remove_reference_t<decltype(writer)>::Pixel;
+    const Pixel fg = writer.ToPixel(fg_color);
+    const Pixel bg = writer.ToPixel(bg_color);
+    // Each row of the glyph is expanded to pixels and written as a span.
+    constexpr int kRowPixels = 32;
+    std::array<Pixel, kRowPixels> row_pixels;
+    for (int font_row = 0; font_row < font.height; font_row++) {
+      const uint8_t row_bits =
+          font.data[font.height * character_index + font_row];
+      for (int first = 0; first < font.width; first += kRowPixels) {
+        const int count = std::min(font.width - first, kRowPixels);
+        for (int i = 0; i < count; i++) {
+          const bool pixel_on =
+              PW_FONT_BIT(font.width - (first + i) - 1, row_bits);
+          row_pixels[i] = pixel_on ? fg : bg;
+        }
+        writer.CopyPixels(pos.x + first,
+                          pos.y + font_row,
+                          span<const Pixel>(row_pixels.data(), count));
+      }
     }
-  }
+  });
   return Size<int>{font.width, font.height};
 }
 
@@ -264,4 +1098,51 @@ Size<int> DrawString(std::wstring_view str,
   return string_dimensions;
 }
 
+Size<int> DrawString(std::wstring_view str,
+                     Vector2<int> pos,
+                     color_rgb565_t fg_color,
+                     color_rgb565_t bg_color,
+                     const FontSet& font,
+                     Framebuffer& framebuffer,
+                     GlyphCache& glyph_cache) {
+  if (!GlyphCache::CanCache(font))
+    return DrawString(str, pos, fg_color, bg_color, font, framebuffer);
+
+  // The string is drawn in runs of glyphs. Every glyph in a run stays in the
+  // cache while the run is drawn, as the run is shorter than the cache.
+  constexpr size_t kMaxRunGlyphs = 16;
+  static_assert(kMaxRunGlyphs <= GlyphCache::kNumEntries);
+  std::array<color_rgb565_t, kMaxRunGlyphs * GlyphCache::kMaxGlyphWidth>
+      row_pixels;
+  std::array<span<const color_rgb565_t>, kMaxRunGlyphs> glyphs;
+
+  Size<int> string_dimensions{0, font.height};
+  VisitDrawWriter(framebuffer, [&](auto& writer) {
+    while (!str.empty()) {
+      const size_t num_glyphs = std::min(str.size(), kMaxRunGlyphs);
+      for (size_t i = 0; i < num_glyphs; i++) {
+        glyphs[i] = glyph_cache.GetGlyph(font, str[i], fg_color, bg_color);
+      }
+      str.remove_prefix(num_glyphs);
+
+      int run_width = 0;
+      for (int font_row = 0; font_row < font.height; font_row++) {
+        color_rgb565_t* dst = row_pixels.data();
+        for (size_t i = 0; i < num_glyphs; i++) {
+          if (glyphs[i].empty())
+            continue;
+          dst =
+              std::copy_n(&glyphs[i][font_row * font.width], font.width, dst);
+        }
+        run_width = dst - row_pixels.data();
+        writer.CopyColors(
+            pos.x, pos.y + font_row, span(row_pixels.data(), run_width));
+      }
+      pos.x += run_width;
+      string_dimensions.width += run_width;
+    }
+  });
+  return string_dimensions;
+}
+
 }  // namespace pw::draw
@@ -14,12 +14,25 @@
 
 #include "pw_draw/draw.h"
 
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+
 #include "gtest/gtest.h"
 #include "pw_color/color.h"
 #include "pw_color/colors_pico8.h"
 #include "pw_draw/font_set.h"
+#include "pw_draw/indexed_sprite_sheet.h"
+#include "pw_draw/pigweed_farm.h"
+#include "pw_draw/pigweed_farm_indexed.h"
+#include "pw_draw/pigweed_farm_rle.h"
+#include "pw_draw/rle_sprite_sheet.h"
 #include "pw_draw/text_area.h"
+#include "pw_framebuffer/expand.h"
 #include "pw_framebuffer/framebuffer.h"
+#include "pw_framebuffer/reader.h"
 #include "pw_framebuffer/writer.h"
 #include "pw_log/log.h"
 #include "pw_string/string_builder.h"
@@ -67,6 +80,25 @@ void PrintFramebufferAsANSI(const Framebuffer& fb) {
   }
 }
 
+// Expect each pixel of |fb| to be |color| where |rows| has an 'x', and to be
+// kBlack elsewhere.
+void ExpectPixels(const Framebuffer& fb,
+                  std::initializer_list<const char*> rows,
+                  color_rgb565_t color) {
+  ASSERT_EQ(rows.size(), static_cast<size_t>(fb.size().height));
+  FramebufferReader reader(fb);
+  int y = 0;
+  for (const char* row : rows) {
+    for (int x = 0; x < fb.size().width; x++) {
+      auto c = reader.GetPixel(x, y);
+      ASSERT_TRUE(c.ok());
+      EXPECT_EQ(c.value(), row[x] == 'x' ? color : kBlack)
+          << "at (" << x << ", " << y << ")";
+    }
+    y++;
+  }
+}
+
 TEST(DrawLine, Diagonal) {
   color_rgb565_t data[4 * 4];
   Framebuffer fb(data, PixelFormat::RGB565, {4, 4}, 4 * sizeof(data[0]));
@@ -93,6 +125,184 @@ TEST(DrawLine, Diagonal) {
   }
 }
 
+TEST(DrawLine, ClippedMatchesUnclipped) {
+  // Draw the same lines into a large framebuffer, and into a small one whose
+  // origin is at (kOffset, kOffset) within it, so that most lines are clipped.
+  constexpr int kLargeSize = 32;
+  constexpr int kSmallWidth = 12;
+  constexpr int kSmallHeight = 10;
+  constexpr int kOffset = 11;
+  color_rgb565_t large_data[kLargeSize * kLargeSize];
+  color_rgb565_t small_data[kSmallWidth * kSmallHeight];
+  Framebuffer large(large_data,
+                    PixelFormat::RGB565,
+                    {kLargeSize, kLargeSize},
+                    kLargeSize * sizeof(large_data[0]));
+  Framebuffer small(small_data,
+                    PixelFormat::RGB565,
+                    {kSmallWidth, kSmallHeight},
+                    kSmallWidth * sizeof(small_data[0]));
+  FramebufferWriter large_writer(large);
+  FramebufferWriter small_writer(small);
+  color_rgb565_t indigo = color::colors_pico8_rgb565[12];
+
+  for (int x1 = 0; x1 < kLargeSize; x1 += 5) {
+    for (int y2 = 0; y2 < kLargeSize; y2 += 3) {
+      large_writer.Fill(0);
+      small_writer.Fill(0);
+      DrawLine(large, x1, 0, kLargeSize - 1 - x1 / 2, y2, indigo);
+      DrawLine(small,
+               x1 - kOffset,
+               -kOffset,
+               kLargeSize - 1 - x1 / 2 - kOffset,
+               y2 - kOffset,
+               indigo);
+      for (int y = 0; y < kSmallHeight; y++) {
+        for (int x = 0; x < kSmallWidth; x++) {
+          ASSERT_EQ(small_writer.GetPixel(x, y).value(),
+                    large_writer.GetPixel(x + kOffset, y + kOffset).value());
+        }
+      }
+    }
+  }
+}
+
+// Draw a scene using every kind of shape, in display coordinates.
+void DrawBandTestScene(Framebuffer& fb) {
+  const color_rgb565_t indigo = color::colors_pico8_rgb565[12];
+  const color_rgb565_t red = color::colors_pico8_rgb565[8];
+  const pw::math::Vector2<int> kPoints[] = {
+      {2, 28}, {20, 1}, {38, 27}, {2, 28}};
+  Fill(fb, kBlack);
+  DrawLine(fb, -5, 3, 44, 25, indigo);
+  DrawLine(fb, 7, -100, 9, 100, red);
+  DrawPolyline(fb, kPoints, red);
+  DrawCircle(fb, 30, 12, 9, indigo, /*filled=*/true);
+  DrawRoundRect(fb, 1, 5, 14, 20, 4, red, /*filled=*/false);
+  pigweed_farm_sprite_sheet.current_index = 0;
+  DrawSprite(
+      fb, 10, -3, &pigweed_farm_sprite_sheet, 1, SpriteFlip::kHorizontal);
+  DrawSprite(fb, -6, 12, &pigweed_farm_rle_sprite_sheet, 2, SpriteFlip::kNone);
+  DrawString(L"Band", {3, 11}, red, kBlack, font6x8, fb);
+}
+
+TEST(DrawBands, MatchesFullFramebuffer) {
+  // Draw the same scene into a full framebuffer, and into framebuffers
+  // covering 7 row bands of it.
+  constexpr int kWidth = 40;
+  constexpr int kHeight = 30;
+  constexpr int kBandHeight = 7;
+  color_rgb565_t full_data[kWidth * kHeight];
+  color_rgb565_t band_data[kWidth * kBandHeight];
+  Framebuffer full(full_data,
+                   PixelFormat::RGB565,
+                   {kWidth, kHeight},
+                   kWidth * sizeof(full_data[0]));
+  DrawBandTestScene(full);
+
+  for (int band_y = 0; band_y < kHeight; band_y += kBandHeight) {
+    Framebuffer band(band_data,
+                     PixelFormat::RGB565,
+                     {kWidth, kBandHeight},
+                     kWidth * sizeof(band_data[0]));
+    band.set_origin({0, static_cast<uint16_t>(band_y)});
+    DrawBandTestScene(band);
+    const int num_rows = std::min(kBandHeight, kHeight - band_y);
+    ASSERT_EQ(std::memcmp(band_data,
+                          &full_data[band_y * kWidth],
+                          num_rows * kWidth * sizeof(band_data[0])),
+              0);
+  }
+}
+
+TEST(DrawBands, TestPattern) {
+  constexpr int kWidth = 24;
+  constexpr int kHeight = 12;
+  color_rgb565_t full_data[kWidth * kHeight];
+  color_rgb565_t band_data[6 * 5];
+  Framebuffer full(full_data,
+                   PixelFormat::RGB565,
+                   {kWidth, kHeight},
+                   kWidth * sizeof(full_data[0]));
+  Framebuffer band(
+      band_data, PixelFormat::RGB565, {6, 5}, 6 * sizeof(band_data[0]));
+  band.set_origin({13, 4});
+  Fill(full, kBlack);
+  Fill(band, kBlack);
+  DrawTestPattern(full);
+  DrawTestPattern(band);
+
+  FramebufferReader full_reader(full);
+  for (int y = 0; y < 5; y++) {
+    for (int x = 0; x < 6; x++) {
+      ASSERT_EQ(band_data[y * 6 + x],
+                full_reader.GetPixel(x + 13, y + 4).value());
+    }
+  }
+}
+
+TEST(DrawLine, FarOffscreenEndpoints) {
+  color_rgb565_t data[8 * 4];
+  Framebuffer fb(data, PixelFormat::RGB565, {8, 4}, 8 * sizeof(data[0]));
+  FramebufferWriter writer(fb);
+  color_rgb565_t indigo = color::colors_pico8_rgb565[12];
+  writer.Fill(0);
+
+  // A diagonal whose length overflows 16-bit coordinates.
+  DrawLine(fb, -1000000, -1000000, 1000007, 1000003, indigo);
+
+  ExpectPixels(fb,
+               {
+                   "..x.....",
+                   "...x....",
+                   "....x...",
+                   ".....x..",
+               },
+               indigo);
+}
+
+TEST(DrawLine, Vertical) {
+  color_rgb565_t data[4 * 4];
+  Framebuffer fb(data, PixelFormat::RGB565, {4, 4}, 4 * sizeof(data[0]));
+  FramebufferWriter writer(fb);
+  color_rgb565_t indigo = color::colors_pico8_rgb565[12];
+  writer.Fill(0);
+
+  DrawLine(fb, 2, 100, 2, 1, indigo);
+  DrawLine(fb, 4, 0, 4, 3, indigo);
+
+  ExpectPixels(fb,
+               {
+                   "....",
+                   "..x.",
+                   "..x.",
+                   "..x.",
+               },
+               indigo);
+}
+
+TEST(DrawPolyline, Closed) {
+  color_rgb565_t data[8 * 6];
+  Framebuffer fb(data, PixelFormat::RGB565, {8, 6}, 8 * sizeof(data[0]));
+  FramebufferWriter writer(fb);
+  color_rgb565_t indigo = color::colors_pico8_rgb565[12];
+  writer.Fill(0);
+
+  const pw::math::Vector2<int> points[] = {{0, 0}, {7, 3}, {0, 5}, {0, 0}};
+  DrawPolyline(fb, points, indigo);
+
+  ExpectPixels(fb,
+               {
+                   "xx......",
+                   "x.xx....",
+                   "x...xx..",
+                   "x.....xx",
+                   "x.xxxx..",
+                   "xx......",
+               },
+               indigo);
+}
+
 TEST(DrawHLine, Top) {
   color_rgb565_t data[4 * 4];
   Framebuffer fb(data, PixelFormat::RGB565, {4, 4}, 4 * sizeof(data[0]));
@@ -390,6 +600,29 @@ TEST(DrawRectWH, WidthHeightCorrect) {
   EXPECT_EQ(c.value(), 0);
 }
 
+TEST(DrawRect, ExtremeCorners) {
+  constexpr int kMax = std::numeric_limits<int>::max();
+  constexpr int kMin = std::numeric_limits<int>::min();
+  color_rgb565_t data[5 * 4];
+  Framebuffer fb(data, PixelFormat::RGB565, {5, 4}, 5 * sizeof(data[0]));
+  FramebufferWriter(fb).Fill(kBlack);
+  constexpr color_rgb565_t kColor = 0x1234;
+
+  // Sizes which overflow int are clipped, not wrapped.
+  DrawRect(fb, kMin, kMin, kMax, 0, kColor, true);
+  DrawRect(fb, 1, kMin, kMax, 2, kColor, false);
+  DrawRectWH(fb, 3, 3, kMax, kMax, kColor, true);
+  DrawRectWH(fb, kMax, kMax, kMax, kMax, kColor, true);
+  ExpectPixels(fb,
+               {
+                   "xxxxx",
+                   ".x...",
+                   ".xxxx",
+                   "...xx",
+               },
+               kColor);
+}
+
 TEST(DrawCircle, Empty) {
   color_rgb565_t data[7 * 7];
   Framebuffer fb(data, PixelFormat::RGB565, {7, 7}, 7 * sizeof(data[0]));
@@ -565,6 +798,497 @@ TEST(DrawCircle, Empty) {
   EXPECT_EQ(c.value(), 0);
 }
 
+TEST(DrawCircle, Filled) {
+  color_rgb565_t data[7 * 7];
+  Framebuffer fb(data, PixelFormat::RGB565, {7, 7}, 7 * sizeof(data[0]));
+  FramebufferWriter writer(fb);
+  color_rgb565_t indigo = color::colors_pico8_rgb565[12];
+  writer.Fill(0);
+
+  DrawCircle(fb, 3, 3, 3, indigo, true);
+
+  ExpectPixels(fb,
+               {
+                   "..xxx..",
+                   ".xxxxx.",
+                   "xxxxxxx",
+                   "xxxxxxx",
+                   "xxxxxxx",
+                   ".xxxxx.",
+                   "..xxx..",
+               },
+               indigo);
+}
+
+TEST(DrawCircle, ClippedToFramebuffer) {
+  color_rgb565_t data[5 * 5];
+  Framebuffer fb(data, PixelFormat::RGB565, {5, 5}, 5 * sizeof(data[0]));
+  FramebufferWriter writer(fb);
+  color_rgb565_t indigo = color::colors_pico8_rgb565[12];
+  writer.Fill(0);
+
+  DrawCircle(fb, 0, 0, 3, indigo, true);
+
+  ExpectPixels(fb,
+               {
+                   "xxxx.",
+                   "xxxx.",
+                   "xxx..",
+                   "xx...",
+                   ".....",
+               },
+               indigo);
+}
+
+TEST(DrawEllipse, Outline) {
+  color_rgb565_t data[9 * 5];
+  Framebuffer fb(data, PixelFormat::RGB565, {9, 5}, 9 * sizeof(data[0]));
+  FramebufferWriter writer(fb);
+  color_rgb565_t indigo = color::colors_pico8_rgb565[12];
+  writer.Fill(0);
+
+  DrawEllipse(fb, 4, 2, 4, 2, indigo, false);
+
+  ExpectPixels(fb,
+               {
+                   "..xxxxx..",
+                   "xx.....xx",
+                   "x.......x",
+                   "xx.....xx",
+                   "..xxxxx..",
+               },
+               indigo);
+}
+
+TEST(DrawEllipse, Filled) {
+  color_rgb565_t data[9 * 5];
+  Framebuffer fb(data, PixelFormat::RGB565, {9, 5}, 9 * sizeof(data[0]));
+  FramebufferWriter writer(fb);
+  color_rgb565_t indigo = color::colors_pico8_rgb565[12];
+  writer.Fill(0);
+
+  DrawEllipse(fb, 4, 2, 4, 2, indigo, true);
+
+  ExpectPixels(fb,
+               {
+                   "..xxxxx..",
+                   "xxxxxxxxx",
+                   "xxxxxxxxx",
+                   "xxxxxxxxx",
+                   "..xxxxx..",
+               },
+               indigo);
+}
+
+TEST(DrawRoundRect, Outline) {
+  color_rgb565_t data[10 * 7];
+  Framebuffer fb(data, PixelFormat::RGB565, {10, 7}, 10 * sizeof(data[0]));
+  FramebufferWriter writer(fb);
+  color_rgb565_t indigo = color::colors_pico8_rgb565[12];
+  writer.Fill(0);
+
+  DrawRoundRect(fb, 0, 0, 10, 7, 2, indigo, false);
+
+  ExpectPixels(fb,
+               {
+                   ".xxxxxxxx.",
+                   "x........x",
+                   "x........x",
+                   "x........x",
+                   "x........x",
+                   "x........x",
+                   ".xxxxxxxx.",
+               },
+               indigo);
+}
+
+TEST(DrawRoundRect, Filled) {
+  color_rgb565_t data[10 * 7];
+  Framebuffer fb(data, PixelFormat::RGB565, {10, 7}, 10 * sizeof(data[0]));
+  FramebufferWriter writer(fb);
+  color_rgb565_t indigo = color::colors_pico8_rgb565[12];
+  writer.Fill(0);
+
+  DrawRoundRect(fb, 0, 0, 10, 7, 2, indigo, true);
+
+  ExpectPixels(fb,
+               {
+                   ".xxxxxxxx.",
+                   "xxxxxxxxxx",
+                   "xxxxxxxxxx",
+                   "xxxxxxxxxx",
+                   "xxxxxxxxxx",
+                   "xxxxxxxxxx",
+                   ".xxxxxxxx.",
+               },
+               indigo);
+}
+
+TEST(DrawArc, FilledQuarter) {
+  color_rgb565_t data[7 * 7];
+  Framebuffer fb(data, PixelFormat::RGB565, {7, 7}, 7 * sizeof(data[0]));
+  FramebufferWriter writer(fb);
+  color_rgb565_t indigo = color::colors_pico8_rgb565[12];
+  writer.Fill(0);
+
+  // Clockwise from 3 o'clock to 6 o'clock.
+  DrawArc(fb, 3, 3, 3, 0, 90, indigo, true);
+
+  ExpectPixels(fb,
+               {
+                   ".......",
+                   ".......",
+                   ".......",
+                   "...xxxx",
+                   "...xxxx",
+                   "...xxx.",
+                   "...xx..",
+               },
+               indigo);
+}
+
+TEST(DrawArc, OutlineOverHalfCircle) {
+  color_rgb565_t data[7 * 7];
+  Framebuffer fb(data, PixelFormat::RGB565, {7, 7}, 7 * sizeof(data[0]));
+  FramebufferWriter writer(fb);
+  color_rgb565_t indigo = color::colors_pico8_rgb565[12];
+  writer.Fill(0);
+
+  // Everything except the upper right quarter.
+  DrawArc(fb, 3, 3, 3, 0, 270, indigo, false);
+
+  ExpectPixels(fb,
+               {
+                   "..xx...",
+                   ".x.....",
+                   "x......",
+                   "x.....x",
+                   "x.....x",
+                   ".x...x.",
+                   "..xxx..",
+               },
+               indigo);
+}
+
+// A 3x2 sprite sheet holding two sprites, with kT as the transparent color.
+constexpr color_rgb565_t kT = 0xf81f;
+constexpr color_rgb565_t kSpriteData[] = {
+    1, kT, 2,  // Sprite 0
+    3, 4,  kT,
+    5, 5,  5,  // Sprite 1
+    5, 5,  5,
+};
+
+void ExpectData(const color_rgb565_t* data,
+                std::initializer_list<color_rgb565_t> expected) {
+  int i = 0;
+  for (color_rgb565_t color : expected) {
+    EXPECT_EQ(data[i], color) << "at index " << i;
+    i++;
+  }
+}
+
+TEST(DrawSprite, ScaledWithTransparency) {
+  color_rgb565_t data[7 * 4];
+  Framebuffer fb(data, PixelFormat::RGB565, {7, 4}, 7 * sizeof(data[0]));
+  FramebufferWriter writer(fb);
+  writer.Fill(0);
+  SpriteSheet sprite_sheet = {3, 2, 2, kT, kSpriteData};
+
+  DrawSprite(fb, 1, 0, &sprite_sheet, 2);
+
+  ExpectData(data,
+             {
+                 0, 1, 1, 0, 0, 2, 2,  //
+                 0, 1, 1, 0, 0, 2, 2,  //
+                 0, 3, 3, 4, 4, 0, 0,  //
+                 0, 3, 3, 4, 4, 0, 0,  //
+             });
+}
+
+TEST(DrawSprite, Flipped) {
+  color_rgb565_t data[3 * 2];
+  Framebuffer fb(data, PixelFormat::RGB565, {3, 2}, 3 * sizeof(data[0]));
+  FramebufferWriter writer(fb);
+  SpriteSheet sprite_sheet = {3, 2, 2, kT, kSpriteData};
+
+  writer.Fill(0);
+  DrawSprite(fb, 0, 0, &sprite_sheet, 1, SpriteFlip::kHorizontal);
+  ExpectData(data, {2, 0, 1, 0, 4, 3});
+
+  writer.Fill(0);
+  DrawSprite(fb, 0, 0, &sprite_sheet, 1, SpriteFlip::kVertical);
+  ExpectData(data, {3, 4, 0, 1, 0, 2});
+
+  writer.Fill(0);
+  DrawSprite(fb, 0, 0, &sprite_sheet, 1, SpriteFlip::kBoth);
+  ExpectData(data, {0, 4, 3, 2, 0, 1});
+}
+
+TEST(DrawSprite, Clipped) {
+  color_rgb565_t data[4 * 3];
+  Framebuffer fb(data, PixelFormat::RGB565, {4, 3}, 4 * sizeof(data[0]));
+  FramebufferWriter writer(fb);
+  writer.Fill(0);
+  SpriteSheet sprite_sheet = {3, 2, 2, kT, kSpriteData};
+  sprite_sheet.current_index = 1;
+
+  // The scaled sprite covers (-5, -4) through (3, 1).
+  DrawSprite(fb, -5, -4, &sprite_sheet, 3);
+
+  ExpectData(data,
+             {
+                 5, 5, 5, 5,  //
+                 5, 5, 5, 5,  //
+                 0, 0, 0, 0,  //
+             });
+}
+
+TEST(DrawSprite, RunLengthEncoded) {
+  color_rgb565_t data[7 * 4];
+  Framebuffer fb(data, PixelFormat::RGB565, {7, 4}, 7 * sizeof(data[0]));
+  FramebufferWriter writer(fb);
+  writer.Fill(0);
+  // The first sprite of kSpriteData.
+  constexpr uint16_t kRleData[] = {
+      2, 0, 1, 1, 1, 1, 2,  // Row 0: runs {1} and {2}.
+      1, 0, 2, 3, 4,        // Row 1: run {3, 4}.
+  };
+  constexpr uint32_t kRowOffsets[] = {0, 7};
+  RleSpriteSheet sprite_sheet = {3, 2, 1, kRowOffsets, kRleData};
+
+  DrawSprite(fb, 1, 0, &sprite_sheet, 2, SpriteFlip::kNone);
+
+  ExpectData(data,
+             {
+                 0, 1, 1, 0, 0, 2, 2,  //
+                 0, 1, 1, 0, 0, 2, 2,  //
+                 0, 3, 3, 4, 4, 0, 0,  //
+                 0, 3, 3, 4, 4, 0, 0,  //
+             });
+}
+
+TEST(DrawSprite, RunLengthEncodedMatchesUncompressed) {
+  constexpr int kWidth = 64;
+  constexpr int kHeight = 24;
+  color_rgb565_t expected_data[kWidth * kHeight];
+  color_rgb565_t actual_data[kWidth * kHeight];
+  Framebuffer expected(expected_data,
+                       PixelFormat::RGB565,
+                       {kWidth, kHeight},
+                       kWidth * sizeof(expected_data[0]));
+  Framebuffer actual(actual_data,
+                     PixelFormat::RGB565,
+                     {kWidth, kHeight},
+                     kWidth * sizeof(actual_data[0]));
+  FramebufferWriter expected_writer(expected);
+  FramebufferWriter actual_writer(actual);
+
+  for (int index = 0; index < pigweed_farm_sprite_sheet.count; index++) {
+    pigweed_farm_sprite_sheet.current_index = index;
+    pigweed_farm_rle_sprite_sheet.current_index = index;
+    for (SpriteFlip flip : {SpriteFlip::kNone,
+                            SpriteFlip::kHorizontal,
+                            SpriteFlip::kVertical,
+                            SpriteFlip::kBoth}) {
+      for (int scale = 1; scale <= 3; scale++) {
+        for (int x : {-50, -3, 0, 30}) {
+          expected_writer.Fill(0);
+          actual_writer.Fill(0);
+          DrawSprite(
+              expected, x, -2, &pigweed_farm_sprite_sheet, scale, flip);
+          DrawSprite(
+              actual, x, -2, &pigweed_farm_rle_sprite_sheet, scale, flip);
+          ASSERT_EQ(std::memcmp(
+                        expected_data, actual_data, sizeof(expected_data)),
+                    0);
+        }
+      }
+    }
+  }
+}
+
+TEST(DrawSprite, Indexed) {
+  color_rgb565_t data[7 * 4];
+  Framebuffer fb(data, PixelFormat::RGB565, {7, 4}, 7 * sizeof(data[0]));
+  FramebufferWriter writer(fb);
+  writer.Fill(0);
+  // The first sprite of kSpriteData, with index 0 transparent.
+  constexpr color_rgb565_t kPalette[] = {kT, 1, 2, 3, 4};
+  constexpr uint8_t kIndices[] = {
+      0x10, 0x20,  // Row 0: 1, 0, 2.
+      0x34, 0x00,  // Row 1: 3, 4, 0.
+  };
+  IndexedSpriteSheet sprite_sheet = {3, 2, 1, 4, 0, kIndices, kPalette};
+
+  DrawSprite(fb, 1, 0, &sprite_sheet, 2, SpriteFlip::kNone);
+
+  ExpectData(data,
+             {
+                 0, 1, 1, 0, 0, 2, 2,  //
+                 0, 1, 1, 0, 0, 2, 2,  //
+                 0, 3, 3, 4, 4, 0, 0,  //
+                 0, 3, 3, 4, 4, 0, 0,  //
+             });
+
+  // Draw again with a different palette.
+  constexpr color_rgb565_t kOtherPalette[] = {kT, 5, 6, 7, 8};
+  DrawSprite(fb, 1, 0, &sprite_sheet, kOtherPalette, 1, SpriteFlip::kNone);
+
+  ExpectData(data,
+             {
+                 0, 5, 1, 6, 0, 2, 2,  //
+                 0, 7, 8, 0, 0, 2, 2,  //
+                 0, 3, 3, 4, 4, 0, 0,  //
+                 0, 3, 3, 4, 4, 0, 0,  //
+             });
+}
+
+TEST(DrawSprite, IndexedFramebuffer) {
+  uint8_t data[4 * 4];
+  Framebuffer fb(data, PixelFormat::I4, {7, 4}, 4);
+  FramebufferWriter writer(fb);
+  writer.Fill(0xe);
+  constexpr color_rgb565_t kPalette[] = {kT, 1, 2, 3, 4};
+  constexpr uint8_t kIndices[] = {0x10, 0x20, 0x34, 0x00};
+  IndexedSpriteSheet sprite_sheet = {3, 2, 1, 4, 0, kIndices, kPalette};
+
+  // Indices are written as they are, not converted to the sheet's colors.
+  DrawSprite(fb, 1, 0, &sprite_sheet, 2, SpriteFlip::kNone);
+  DrawLine(fb, 0, 3, 6, 3, 0x9);
+
+  const uint8_t kExpected[4][7] = {
+      {0xe, 1, 1, 0xe, 0xe, 2, 2},
+      {0xe, 1, 1, 0xe, 0xe, 2, 2},
+      {0xe, 3, 3, 4, 4, 0xe, 0xe},
+      {9, 9, 9, 9, 9, 9, 9},
+  };
+  for (uint16_t y = 0; y < 4; y++) {
+    for (uint16_t x = 0; x < 7; x++) {
+      EXPECT_EQ(writer.GetPixel(x, y).value(), kExpected[y][x])
+          << "x=" << x << " y=" << y;
+    }
+  }
+}
+
+TEST(DrawSprite, IndexedMatchesUncompressed) {
+  constexpr int kWidth = 64;
+  constexpr int kHeight = 24;
+  color_rgb565_t expected_data[kWidth * kHeight];
+  color_rgb565_t actual_data[kWidth * kHeight];
+  Framebuffer expected(expected_data,
+                       PixelFormat::RGB565,
+                       {kWidth, kHeight},
+                       kWidth * sizeof(expected_data[0]));
+  Framebuffer actual(actual_data,
+                     PixelFormat::RGB565,
+                     {kWidth, kHeight},
+                     kWidth * sizeof(actual_data[0]));
+  FramebufferWriter expected_writer(expected);
+  FramebufferWriter actual_writer(actual);
+
+  for (int index = 0; index < pigweed_farm_sprite_sheet.count; index++) {
+    pigweed_farm_sprite_sheet.current_index = index;
+    pigweed_farm_indexed_sprite_sheet.current_index = index;
+    for (SpriteFlip flip : {SpriteFlip::kNone,
+                            SpriteFlip::kHorizontal,
+                            SpriteFlip::kVertical,
+                            SpriteFlip::kBoth}) {
+      for (int scale = 1; scale <= 3; scale++) {
+        for (int x : {-50, -3, 0, 30}) {
+          expected_writer.Fill(0);
+          actual_writer.Fill(0);
+          DrawSprite(
+              expected, x, -2, &pigweed_farm_sprite_sheet, scale, flip);
+          DrawSprite(
+              actual, x, -2, &pigweed_farm_indexed_sprite_sheet, scale, flip);
+          ASSERT_EQ(std::memcmp(
+                        expected_data, actual_data, sizeof(expected_data)),
+                    0);
+        }
+      }
+    }
+  }
+}
+
+TEST(DrawSprite, IndexedPaletteSwap) {
+  // The farm's shadow (sprite 1) is a recoloring of sprite 0, so build the
+  // palette which maps sprite 0's indices to the shadow's colors.
+  const IndexedSpriteSheet& sheet = pigweed_farm_indexed_sprite_sheet;
+  color_rgb565_t shadow_palette[std::size(pigweed_farm_indexed_palette)];
+  std::copy(std::begin(pigweed_farm_indexed_palette),
+            std::end(pigweed_farm_indexed_palette),
+            shadow_palette);
+  for (int y = 0; y < sheet.height; y++) {
+    for (int x = 0; x < sheet.width; x++) {
+      shadow_palette[GetPixelIndex(sheet.GetRow(y, 0), 4, x)] =
+          sheet.palette[GetPixelIndex(sheet.GetRow(y, 1), 4, x)];
+    }
+  }
+
+  constexpr int kWidth = 48;
+  constexpr int kHeight = 12;
+  color_rgb565_t expected_data[kWidth * kHeight];
+  color_rgb565_t actual_data[kWidth * kHeight];
+  Framebuffer expected(expected_data,
+                       PixelFormat::RGB565,
+                       {kWidth, kHeight},
+                       kWidth * sizeof(expected_data[0]));
+  Framebuffer actual(actual_data,
+                     PixelFormat::RGB565,
+                     {kWidth, kHeight},
+                     kWidth * sizeof(actual_data[0]));
+  FramebufferWriter(expected).Fill(0);
+  FramebufferWriter(actual).Fill(0);
+
+  pigweed_farm_sprite_sheet.current_index = 1;
+  DrawSprite(expected, 1, 1, &pigweed_farm_sprite_sheet, 1, SpriteFlip::kNone);
+  pigweed_farm_indexed_sprite_sheet.current_index = 0;
+  DrawSprite(actual,
+             1,
+             1,
+             &pigweed_farm_indexed_sprite_sheet,
+             shadow_palette,
+             1,
+             SpriteFlip::kNone);
+  EXPECT_EQ(std::memcmp(expected_data, actual_data, sizeof(expected_data)), 0);
+}
+
+TEST(DrawText, CharacterMatchesAcrossPixelFormats) {
+  constexpr int kWidth = 8;
+  constexpr int kHeight = 10;
+  color_rgb565_t expected_data[kWidth * kHeight];
+  uint8_t actual_data[kWidth * kHeight * 3];
+  Framebuffer expected(expected_data,
+                       PixelFormat::RGB565,
+                       {kWidth, kHeight},
+                       kWidth * sizeof(expected_data[0]));
+  Framebuffer actual(
+      actual_data, PixelFormat::RGB888, {kWidth, kHeight}, kWidth * 3);
+  FramebufferWriter(expected).Fill(0);
+  FramebufferWriter(actual).Fill(0);
+
+  // Partly off the left and top edges, so the glyph is clipped.
+  const color_rgb565_t fg = color::colors_pico8_rgb565[COLOR_PINK];
+  const color_rgb565_t bg = color::colors_pico8_rgb565[COLOR_DARK_BLUE];
+  DrawCharacter('A', {-2, -1}, fg, bg, font6x8, expected);
+  DrawCharacter('A', {-2, -1}, fg, bg, font6x8, actual);
+
+  FramebufferReader expected_reader(expected);
+  FramebufferReader actual_reader(actual);
+  for (int y = 0; y < kHeight; y++) {
+    for (int x = 0; x < kWidth; x++) {
+      EXPECT_EQ(expected_reader.GetPixel(x, y).value(),
+                actual_reader.GetPixel(x, y).value())
+          << "x=" << x << " y=" << y;
+    }
+  }
+  // The six pixel wide glyph covers columns 0 to 3 and rows 0 to 6.
+  EXPECT_EQ(expected_reader.GetPixel(0, 6).value(), bg);
+  EXPECT_EQ(expected_reader.GetPixel(4, 0).value(), 0);
+  EXPECT_EQ(expected_reader.GetPixel(0, 7).value(), 0);
+}
+
 TEST(DrawText, WithFgBg) {
   color_rgb565_t data[(5 * 6) * (3 * 8)];
   Framebuffer fb(
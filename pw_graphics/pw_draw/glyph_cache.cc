@@ -0,0 +1,86 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_draw/glyph_cache.h"
+
+#include <algorithm>
+
+#include "pw_assert/assert.h"
+
+using pw::color::color_rgb565_t;
+
+namespace pw::draw {
+
+GlyphCache::GlyphCache() { Clear(); }
+
+void GlyphCache::Clear() {
+  for (Entry& entry : entries_) {
+    entry.font = nullptr;
+    entry.last_used = 0;
+  }
+  use_counter_ = 0;
+}
+
+span<const color_rgb565_t> GlyphCache::GetGlyph(const FontSet& font,
+                                                int ch,
+                                                color_rgb565_t fg_color,
+                                                color_rgb565_t bg_color) {
+  PW_ASSERT(CanCache(font));
+  const bool is_space = ch == ' ' || ch == '\0';
+  if (!is_space &&
+      (ch < font.starting_character || ch > font.ending_character)) {
+    return span<const color_rgb565_t>();
+  }
+  const size_t num_pixels = font.width * font.height;
+
+  // Find a matching entry, remembering the least recently used one in case
+  // there is none. Empty entries have a last_used value of zero so are
+  // replaced first.
+  use_counter_++;
+  Entry* victim = &entries_[0];
+  for (Entry& entry : entries_) {
+    if (entry.font == &font && entry.ch == ch && entry.fg_color == fg_color &&
+        entry.bg_color == bg_color) {
+      entry.last_used = use_counter_;
+      hits_++;
+      return span(entry.pixels.data(), num_pixels);
+    }
+    if (entry.last_used < victim->last_used)
+      victim = &entry;
+  }
+
+  misses_++;
+  victim->font = &font;
+  victim->ch = ch;
+  victim->fg_color = fg_color;
+  victim->bg_color = bg_color;
+  victim->last_used = use_counter_;
+  if (is_space) {
+    // The font doesn't have a space glyph, so use an empty cell.
+    std::fill_n(victim->pixels.begin(), num_pixels, bg_color);
+  } else {
+    const uint8_t* glyph_rows =
+        &font.data[font.height * (ch - font.starting_character)];
+    color_rgb565_t* pixel = victim->pixels.data();
+    for (int font_row = 0; font_row < font.height; font_row++) {
+      const uint8_t bits = glyph_rows[font_row];
+      for (int font_column = font.width - 1; font_column >= 0; font_column--) {
+        *pixel++ = ((bits >> font_column) & 1) ? fg_color : bg_color;
+      }
+    }
+  }
+  return span(victim->pixels.data(), num_pixels);
+}
+
+}  // namespace pw::draw
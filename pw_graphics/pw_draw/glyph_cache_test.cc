@@ -0,0 +1,121 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_draw/glyph_cache.h"
+
+#include <array>
+#include <string_view>
+
+#include "gtest/gtest.h"
+#include "pw_color/color.h"
+#include "pw_draw/draw.h"
+#include "pw_draw/font_set.h"
+#include "pw_framebuffer/framebuffer.h"
+#include "pw_framebuffer/writer.h"
+
+using pw::color::color_rgb565_t;
+using pw::framebuffer::Framebuffer;
+using pw::framebuffer::FramebufferWriter;
+using pw::framebuffer::PixelFormat;
+
+namespace pw::draw {
+namespace {
+
+constexpr color_rgb565_t kFgColor = 0xf800;
+constexpr color_rgb565_t kBgColor = 0x001f;
+
+TEST(GlyphCache, ExpandsGlyph) {
+  GlyphCache cache;
+  auto glyph = cache.GetGlyph(font6x8, '!', kFgColor, kBgColor);
+  ASSERT_EQ(glyph.size(), 6u * 8u);
+  // The '!' glyph is a single column of pixels with a gap above the bottom.
+  for (int y = 0; y < 8; y++) {
+    for (int x = 0; x < 6; x++) {
+      const bool on = x == 2 && y != 5 && y != 7;
+      EXPECT_EQ(glyph[y * 6 + x], on ? kFgColor : kBgColor);
+    }
+  }
+
+  auto space = cache.GetGlyph(font6x8, ' ', kFgColor, kBgColor);
+  ASSERT_EQ(space.size(), 6u * 8u);
+  for (color_rgb565_t pixel : space) {
+    EXPECT_EQ(pixel, kBgColor);
+  }
+
+  EXPECT_TRUE(cache.GetGlyph(font6x8, 0x2580, kFgColor, kBgColor).empty());
+}
+
+TEST(GlyphCache, HitsAndMisses) {
+  GlyphCache cache;
+  cache.GetGlyph(font6x8, 'a', kFgColor, kBgColor);
+  cache.GetGlyph(font6x8, 'a', kFgColor, kBgColor);
+  cache.GetGlyph(font6x8, 'a', kBgColor, kFgColor);
+  cache.GetGlyph(font6x8, 'a', kFgColor, kBgColor);
+  EXPECT_EQ(cache.misses(), 2u);
+  EXPECT_EQ(cache.hits(), 2u);
+}
+
+TEST(GlyphCache, EvictsLeastRecentlyUsed) {
+  GlyphCache cache;
+  const int first = font6x8.starting_character + 1;
+  for (size_t i = 0; i < GlyphCache::kNumEntries; i++) {
+    cache.GetGlyph(font6x8, first + i, kFgColor, kBgColor);
+  }
+  EXPECT_EQ(cache.misses(), GlyphCache::kNumEntries);
+
+  // Use the first glyph again, so the second becomes the oldest and is the one
+  // replaced by a new glyph.
+  cache.GetGlyph(font6x8, first, kFgColor, kBgColor);
+  cache.GetGlyph(font6x8, first + GlyphCache::kNumEntries, kFgColor, kBgColor);
+  EXPECT_EQ(cache.hits(), 1u);
+  cache.GetGlyph(font6x8, first, kFgColor, kBgColor);
+  EXPECT_EQ(cache.hits(), 2u);
+  cache.GetGlyph(font6x8, first + 1, kFgColor, kBgColor);
+  EXPECT_EQ(cache.hits(), 2u);
+}
+
+TEST(GlyphCache, DrawStringMatchesUncached) {
+  constexpr uint16_t kWidth = 100;
+  constexpr uint16_t kHeight = 12;
+  std::array<color_rgb565_t, kWidth * kHeight> expected_data;
+  std::array<color_rgb565_t, kWidth * kHeight> actual_data;
+  Framebuffer expected(expected_data.data(),
+                       PixelFormat::RGB565,
+                       {kWidth, kHeight},
+                       kWidth * sizeof(color_rgb565_t));
+  Framebuffer actual(actual_data.data(),
+                     PixelFormat::RGB565,
+                     {kWidth, kHeight},
+                     kWidth * sizeof(color_rgb565_t));
+  GlyphCache cache;
+
+  // Longer than one glyph run, clipped on every side, and containing a
+  // character which is not in the font.
+  constexpr std::wstring_view kText = L"Hello, World!\x2580 The quick fox";
+  const pw::math::Vector2<int> kPositions[] = {{0, 0}, {-3, -2}, {4, 7}};
+  for (const auto& pos : kPositions) {
+    FramebufferWriter(expected).Fill(0);
+    FramebufferWriter(actual).Fill(0);
+    auto expected_size =
+        DrawString(kText, pos, kFgColor, kBgColor, font6x8, expected);
+    auto actual_size =
+        DrawString(kText, pos, kFgColor, kBgColor, font6x8, actual, cache);
+    EXPECT_EQ(actual_size.width, expected_size.width);
+    EXPECT_EQ(actual_size.height, expected_size.height);
+    EXPECT_EQ(actual_data, expected_data);
+  }
+}
+
+}  // namespace
+}  // namespace pw::draw
@@ -0,0 +1,194 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "pw_color/color.h"
+#include "pw_draw/draw.h"
+#include "pw_draw/font_set.h"
+#include "pw_draw/glyph_cache.h"
+#include "pw_draw/rle_sprite_sheet.h"
+#include "pw_draw/sprite_sheet.h"
+#include "pw_framebuffer/framebuffer.h"
+#include "pw_math/rect.h"
+#include "pw_math/vector2.h"
+#include "pw_span/span.h"
+#include "pw_status/status.h"
+
+namespace pw::draw {
+
+// A DisplayList records drawing commands, along with the bounding box of each,
+// so that a frame can be drawn one tile (or band) at a time into framebuffers
+// which each cover only part of the display.
+//
+// Replay() draws only the commands which intersect the framebuffer, and skips
+// commands which are entirely hidden by a later opaque command (Fill() or a
+// filled rectangle). Drawing a tile produces exactly the pixels that drawing
+// every command into a full framebuffer would produce within that tile.
+//
+// Commands are stored in a caller provided arena, which must outlive the
+// display list. Strings are copied into the arena when recorded. Fonts and
+// sprite sheets are referenced, and must outlive the display list, but the
+// sprite shown is the sheet's current_index at the time it is recorded.
+//
+// Positions are display coordinates, as with the drawing functions in draw.h.
+// Replay() does not modify the display list, so one display list may be
+// replayed into several framebuffers at the same time.
+class DisplayList {
+ public:
+  explicit DisplayList(span<std::byte> arena);
+
+  DisplayList(const DisplayList&) = delete;
+  DisplayList& operator=(const DisplayList&) = delete;
+
+  // Each of the following records a command which draws the same pixels as
+  // the function of the same name in draw.h. Returns RESOURCE_EXHAUSTED, and
+  // records nothing, if the arena is full.
+  Status Fill(pw::color::color_rgb565_t pen_color);
+  Status DrawRectWH(int x,
+                    int y,
+                    int w,
+                    int h,
+                    pw::color::color_rgb565_t pen_color,
+                    bool filled);
+  Status DrawLine(
+      int x1, int y1, int x2, int y2, pw::color::color_rgb565_t pen_color);
+  Status DrawCircle(int center_x,
+                    int center_y,
+                    int radius,
+                    pw::color::color_rgb565_t pen_color,
+                    bool filled);
+  Status DrawString(std::wstring_view str,
+                    pw::math::Vector2<int> pos,
+                    pw::color::color_rgb565_t fg_color,
+                    pw::color::color_rgb565_t bg_color,
+                    const FontSet& font);
+  Status DrawSprite(int x,
+                    int y,
+                    const SpriteSheet& sprite_sheet,
+                    int integer_scale,
+                    SpriteFlip flip);
+  Status DrawSprite(int x,
+                    int y,
+                    const RleSpriteSheet& sprite_sheet,
+                    int integer_scale,
+                    SpriteFlip flip);
+
+  // Draw the commands which are visible in |framebuffer|, in the order in
+  // which they were recorded. Strings are drawn with |glyph_cache| if it is
+  // not null. Returns the number of commands drawn.
+  size_t Replay(pw::framebuffer::Framebuffer& framebuffer,
+                GlyphCache* glyph_cache = nullptr) const;
+
+  // Same as above, but only the commands at |command_indices|, which must be
+  // in increasing order, are considered. This allows the commands which
+  // overlap each tile to be found once (see bounds()) rather than every tile
+  // testing every command.
+  size_t Replay(pw::framebuffer::Framebuffer& framebuffer,
+                span<const uint32_t> command_indices,
+                GlyphCache* glyph_cache = nullptr) const;
+
+  // The area which command |index| may draw to.
+  pw::math::Rect<int> bounds(size_t index) const {
+    return commands_[index].bounds;
+  }
+
+  // Discard all recorded commands.
+  void Clear();
+
+  // The number of recorded commands.
+  size_t size() const { return num_commands_; }
+  bool empty() const { return num_commands_ == 0; }
+
+  // The number of arena bytes used by the recorded commands and strings.
+  size_t bytes_used() const;
+
+ private:
+  enum class CommandType : uint8_t {
+    kFill,
+    kRect,
+    kLine,
+    kCircle,
+    kString,
+    kSprite,
+    kRleSprite,
+  };
+
+  struct Command {
+    CommandType type;
+    bool filled;
+    SpriteFlip flip;
+    pw::color::color_rgb565_t color;
+    pw::color::color_rgb565_t bg_color;
+    // The area which the command may draw to. Rectangles, fills and sprites
+    // are drawn at bounds.x, bounds.y.
+    pw::math::Rect<int> bounds;
+    union {
+      struct {
+        int x1;
+        int y1;
+        int x2;
+        int y2;
+      } line;
+      struct {
+        int center_x;
+        int center_y;
+        int radius;
+      } circle;
+      struct {
+        const wchar_t* chars;
+        size_t length;
+        const FontSet* font;
+      } string;
+      struct {
+        const void* sheet;
+        int index;
+        int scale;
+      } sprite;
+    };
+
+    // Return true if every pixel in bounds is overwritten by this command.
+    bool IsOpaque() const {
+      return type == CommandType::kFill ||
+             (type == CommandType::kRect && filled);
+    }
+  };
+
+  // Return a new command of |type| with the given bounds, or nullptr if the
+  // arena is full.
+  Command* AddCommand(CommandType type, const pw::math::Rect<int>& bounds);
+
+  // Replay commands command_index(0) to command_index(count - 1).
+  template <typename CommandIndex>
+  size_t ReplayCommands(pw::framebuffer::Framebuffer& framebuffer,
+                        size_t count,
+                        CommandIndex command_index,
+                        GlyphCache* glyph_cache) const;
+
+  void DrawCommand(const Command& command,
+                   pw::framebuffer::Framebuffer& framebuffer,
+                   GlyphCache* glyph_cache) const;
+
+  // Commands are stored from the start of the arena, and strings from the end.
+  std::byte* arena_begin_;
+  std::byte* arena_end_;
+  Command* commands_;
+  size_t num_commands_ = 0;
+  std::byte* strings_begin_;
+};
+
+}  // namespace pw::draw
@@ -19,13 +19,29 @@
 
 #include "pw_color/color.h"
 #include "pw_draw/font_set.h"
+#include "pw_draw/glyph_cache.h"
+#include "pw_draw/indexed_sprite_sheet.h"
+#include "pw_draw/rle_sprite_sheet.h"
 #include "pw_draw/sprite_sheet.h"
 #include "pw_framebuffer/framebuffer.h"
 #include "pw_math/size.h"
 #include "pw_math/vector2.h"
+#include "pw_span/span.h"
 
 namespace pw::draw {
 
+// Positions are display coordinates: drawing into a framebuffer which only
+// covers part of the display (see Framebuffer::origin()) draws the part of the
+// shape within that framebuffer.
+//
+// In framebuffers with an indexed pixel format, pen and text colors are palette
+// indices. SpriteSheet and RleSpriteSheet sprites are stored as RGB565 colors,
+// so can only be drawn into RGB565 framebuffers.
+
+// Draw a line from x1, y1 to x2, y2 inclusive. The line is clipped to the
+// framebuffer before it is rasterized, so lines which are mostly (or entirely)
+// off-screen are cheap, and any int coordinates may be used. Horizontal and
+// vertical lines are drawn as a single span.
 void DrawLine(pw::framebuffer::Framebuffer& fb,
               int x1,
               int y1,
@@ -33,8 +49,19 @@ void DrawLine(pw::framebuffer::Framebuffer& fb,
               int y2,
               pw::color::color_rgb565_t pen_color);
 
+// Draw lines connecting each of |points| to the next. The same pixels are drawn
+// as calling DrawLine() for each segment, but the framebuffer bounds and the
+// clipping of each point are only computed once.
+void DrawPolyline(pw::framebuffer::Framebuffer& fb,
+                  span<const pw::math::Vector2<int>> points,
+                  pw::color::color_rgb565_t pen_color);
+
 // Draw a circle at center_x, center_y with given radius and color. Only a
 // one-pixel outline is drawn if filled is false.
+//
+// Circles, ellipses, rounded rectangles and arcs are rasterized as horizontal
+// spans, with each covered row written once and clipped to the framebuffer.
+// Radii larger than 16383 are not drawn.
 void DrawCircle(pw::framebuffer::Framebuffer& fb,
                 int center_x,
                 int center_y,
@@ -42,6 +69,41 @@ void DrawCircle(pw::framebuffer::Framebuffer& fb,
                 pw::color::color_rgb565_t pen_color,
                 bool filled);
 
+// Draw an axis-aligned ellipse at center_x, center_y with the given horizontal
+// and vertical radii. Only a one-pixel outline is drawn if filled is false.
+void DrawEllipse(pw::framebuffer::Framebuffer& fb,
+                 int center_x,
+                 int center_y,
+                 int radius_x,
+                 int radius_y,
+                 pw::color::color_rgb565_t pen_color,
+                 bool filled);
+
+// Draw a w by h rectangle at x, y with corners rounded to the given radius.
+// The radius is reduced to fit if the rectangle is too small. Only a one-pixel
+// outline is drawn if filled is false.
+void DrawRoundRect(pw::framebuffer::Framebuffer& fb,
+                   int x,
+                   int y,
+                   int w,
+                   int h,
+                   int radius,
+                   pw::color::color_rgb565_t pen_color,
+                   bool filled);
+
+// Draw the part of a circle from start_angle to end_angle. Angles are in
+// degrees clockwise from the positive x axis (3 o'clock), and the arc runs
+// clockwise from start_angle. A pie slice is drawn if filled is true,
+// otherwise only the one-pixel outline of the circle between the angles.
+void DrawArc(pw::framebuffer::Framebuffer& fb,
+             int center_x,
+             int center_y,
+             int radius,
+             int start_angle,
+             int end_angle,
+             pw::color::color_rgb565_t pen_color,
+             bool filled);
+
 void DrawHLine(pw::framebuffer::Framebuffer& fb,
                int x1,
                int x2,
@@ -73,7 +135,60 @@ void DrawSprite(pw::framebuffer::Framebuffer& fb,
                 pw::draw::SpriteSheet* sprite_sheet,
                 int integer_scale);
 
-void DrawTestPattern();
+// Mirroring applied by DrawSprite().
+enum class SpriteFlip {
+  kNone,
+  kHorizontal,
+  kVertical,
+  kBoth,
+};
+
+// Draw the current sprite of |sprite_sheet| with its upper left corner at x, y,
+// with each pixel scaled to integer_scale x integer_scale pixels and the
+// sprite mirrored as specified by |flip|. Pixels equal to the sheet's
+// transparent_color are not drawn.
+//
+// Each sprite row is expanded once into a line buffer, skipping transparent
+// runs, and then copied to every framebuffer row which it covers. Only the
+// part of the sprite inside the framebuffer is processed.
+void DrawSprite(pw::framebuffer::Framebuffer& fb,
+                int x,
+                int y,
+                pw::draw::SpriteSheet* sprite_sheet,
+                int integer_scale,
+                SpriteFlip flip);
+
+// Same as above, for a sprite sheet stored as runs of opaque pixels. The runs
+// are copied directly, without examining any transparent pixels.
+void DrawSprite(pw::framebuffer::Framebuffer& fb,
+                int x,
+                int y,
+                const pw::draw::RleSpriteSheet* sprite_sheet,
+                int integer_scale,
+                SpriteFlip flip);
+
+// Same as above, for a palette-indexed sprite sheet. Only the opaque runs of
+// each row are converted to colors, with a table lookup per pixel. In an
+// indexed framebuffer the sprite's indices are copied unchanged.
+void DrawSprite(pw::framebuffer::Framebuffer& fb,
+                int x,
+                int y,
+                const pw::draw::IndexedSpriteSheet* sprite_sheet,
+                int integer_scale,
+                SpriteFlip flip);
+
+// Same as above, but using |palette| instead of the sheet's palette. |palette|
+// must have an entry for every index used by the sprite, and holds the pixel
+// values to write: colors, or palette indices in an indexed framebuffer.
+void DrawSprite(pw::framebuffer::Framebuffer& fb,
+                int x,
+                int y,
+                const pw::draw::IndexedSpriteSheet* sprite_sheet,
+                span<const pw::color::color_rgb565_t> palette,
+                int integer_scale,
+                SpriteFlip flip);
+
+void DrawTestPattern(pw::framebuffer::Framebuffer& fb);
 
 pw::math::Size<int> DrawCharacter(int ch,
                                   pw::math::Vector2<int> pos,
@@ -89,4 +204,15 @@ pw::math::Size<int> DrawString(std::wstring_view str,
                                const FontSet& font,
                                pw::framebuffer::Framebuffer& framebuffer);
 
+// Draw |str| using glyphs expanded by |glyph_cache|. Each glyph is looked up
+// once, and the string is then written one framebuffer row at a time. Falls
+// back to per-pixel drawing if |font| is too large to be cached.
+pw::math::Size<int> DrawString(std::wstring_view str,
+                               pw::math::Vector2<int> pos,
+                               pw::color::color_rgb565_t fg_color,
+                               pw::color::color_rgb565_t bg_color,
+                               const FontSet& font,
+                               pw::framebuffer::Framebuffer& framebuffer,
+                               GlyphCache& glyph_cache);
+
 }  // namespace pw::draw
@@ -0,0 +1,83 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_color/color.h"
+#include "pw_draw/font_set.h"
+#include "pw_span/span.h"
+
+namespace pw::draw {
+
+// GlyphCache holds a small number of font glyphs which have already been
+// expanded from their 1bpp font data to RGB565 pixels for a given foreground
+// and background color. Text can then be drawn by copying whole glyph rows
+// instead of testing and setting each pixel. When the cache is full the least
+// recently used glyph is replaced.
+//
+// A GlyphCache is not thread-safe.
+class GlyphCache {
+ public:
+  // Font glyphs are stored one byte per row, so are at most 8 pixels wide.
+  static constexpr int kMaxGlyphWidth = 8;
+  static constexpr int kMaxGlyphHeight = 8;
+  static constexpr size_t kNumEntries = 32;
+
+  GlyphCache();
+
+  // Return true if glyphs of |font| fit into a cache entry.
+  static constexpr bool CanCache(const FontSet& font) {
+    return font.width <= kMaxGlyphWidth && font.height <= kMaxGlyphHeight;
+  }
+
+  // Return the width * height pixels, in row-major order, of character |ch|
+  // in |font| drawn with the given colors. Space and NUL characters are drawn
+  // with the background color. Returns an empty span if |ch| is not in |font|.
+  // The returned pixels remain valid until kNumEntries other glyphs have been
+  // looked up.
+  //
+  // |font| must satisfy CanCache().
+  span<const pw::color::color_rgb565_t> GetGlyph(
+      const FontSet& font,
+      int ch,
+      pw::color::color_rgb565_t fg_color,
+      pw::color::color_rgb565_t bg_color);
+
+  // Discard all cached glyphs.
+  void Clear();
+
+  size_t hits() const { return hits_; }
+  size_t misses() const { return misses_; }
+
+ private:
+  struct Entry {
+    const FontSet* font;
+    int ch;
+    pw::color::color_rgb565_t fg_color;
+    pw::color::color_rgb565_t bg_color;
+    uint32_t last_used;  // Value of use_counter_ when last looked up.
+    std::array<pw::color::color_rgb565_t, kMaxGlyphWidth * kMaxGlyphHeight>
+        pixels;
+  };
+
+  std::array<Entry, kNumEntries> entries_;
+  uint32_t use_counter_ = 0;
+  size_t hits_ = 0;
+  size_t misses_ = 0;
+};
+
+}  // namespace pw::draw
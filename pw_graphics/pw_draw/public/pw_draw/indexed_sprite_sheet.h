@@ -0,0 +1,50 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstdint>
+
+#include "pw_color/color.h"
+#include "pw_span/span.h"
+
+namespace pw::draw {
+
+// A sprite sheet stored as 4 or 8 bit indices into a palette of RGB565 colors.
+// Each sprite row starts on a byte boundary, and with 4 bits per pixel the
+// first pixel of each byte is in the high nibble.
+//
+// Sprites can be drawn with a different palette of the same size, so a
+// recolored version of a sprite does not need to be stored separately.
+class IndexedSpriteSheet {
+ public:
+  const int width;
+  const int height;
+  const int count;
+  // 4 or 8.
+  const int bits_per_pixel;
+  // The index of transparent pixels, or -1 if every pixel is opaque.
+  const int transparent_index;
+  const uint8_t* data;
+  const span<const pw::color::color_rgb565_t> palette;
+
+  int current_index = 0;
+
+  // Return the number of bytes in each sprite row.
+  int row_bytes() const { return (width * bits_per_pixel + 7) / 8; }
+
+  // Return the packed indices of row |y| of sprite |sprite_index|.
+  const uint8_t* GetRow(int y, int sprite_index) const;
+};
+
+}  // namespace pw::draw
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cinttypes>
+
+#include "pw_color/color.h"
+#include "pw_draw/indexed_sprite_sheet.h"
+
+const pw::color::color_rgb565_t pigweed_farm_indexed_palette[] = {
+    0xf81f,  // #ff00ff
+    0x726,   // #00e436
+    0xff9d,  // #fff1e8
+    0x383,   // #00721b
+    0x83ce,  // #807874
+    0xf809,  // #ff004d
+    0x8004,  // #800026
+    0xfbb5,  // #ff77a8
+    0x81ca,  // #803b54
+    0x42a,   // #008751
+    0x205,   // #004328
+    0xaa86,  // #ab5236
+    0x5143,  // #55291b
+};
+
+const uint8_t pigweed_farm_indexed_data[] = {
+
+    // Sprite 0
+    // Row 0
+    0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x02, 0x22, 0x00, 0x00,
+    // Row 1
+    0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x25, 0x55, 0x20, 0x00,
+    // Row 2
+    0x10, 0x10, 0x10, 0x77, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x70, 0x02, 0x55, 0x25, 0x52, 0x00,
+    // Row 3
+    0x09, 0x19, 0x00, 0x70, 0x70, 0x70, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x70, 0x02, 0x55, 0x55, 0x52, 0x00,
+    // Row 4
+    0x10, 0x90, 0x10, 0x70, 0x70, 0x00, 0x07, 0x70,
+    0x70, 0x00, 0x70, 0x07, 0x70, 0x07, 0x70, 0x07,
+    0x70, 0x25, 0x55, 0x55, 0x55, 0x20,
+    // Row 5
+    0x09, 0x99, 0x00, 0x77, 0x00, 0x70, 0x70, 0x70,
+    0x70, 0x00, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70,
+    0x70, 0x25, 0x22, 0x22, 0x25, 0x20,
+    // Row 6
+    0x10, 0x90, 0x10, 0x70, 0x00, 0x70, 0x77, 0x70,
+    0x70, 0x70, 0x70, 0x77, 0x00, 0x77, 0x00, 0x70,
+    0x70, 0x05, 0x25, 0x25, 0x25, 0x00,
+    // Row 7
+    0x09, 0x99, 0x00, 0x70, 0x00, 0x70, 0x00, 0x70,
+    0x07, 0x07, 0x00, 0x07, 0x70, 0x07, 0x70, 0x07,
+    0x70, 0x05, 0x25, 0x25, 0x25, 0x00,
+    // Row 8
+    0x00, 0x90, 0x00, 0x00, 0x00, 0x00, 0x77, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x05, 0x22, 0x22, 0x25, 0x00,
+    // Row 9
+    0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xb0, 0x00, 0x0b,
+    0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb,
+    0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xb0,
+    // Row 10
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0b, 0xbb, 0xb0,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+
+    // Sprite 1
+    // Row 0
+    0x00, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x04, 0x44, 0x00, 0x00,
+    // Row 1
+    0x00, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x46, 0x66, 0x40, 0x00,
+    // Row 2
+    0x30, 0x30, 0x30, 0x88, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x80, 0x04, 0x66, 0x46, 0x64, 0x00,
+    // Row 3
+    0x0a, 0x3a, 0x00, 0x80, 0x80, 0x80, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x80, 0x04, 0x66, 0x66, 0x64, 0x00,
+    // Row 4
+    0x30, 0xa0, 0x30, 0x80, 0x80, 0x00, 0x08, 0x80,
+    0x80, 0x00, 0x80, 0x08, 0x80, 0x08, 0x80, 0x08,
+    0x80, 0x46, 0x66, 0x66, 0x66, 0x40,
+    // Row 5
+    0x0a, 0xaa, 0x00, 0x88, 0x00, 0x80, 0x80, 0x80,
+    0x80, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x46, 0x44, 0x44, 0x46, 0x40,
+    // Row 6
+    0x30, 0xa0, 0x30, 0x80, 0x00, 0x80, 0x88, 0x80,
+    0x80, 0x80, 0x80, 0x88, 0x00, 0x88, 0x00, 0x80,
+    0x80, 0x06, 0x46, 0x46, 0x46, 0x00,
+    // Row 7
+    0x0a, 0xaa, 0x00, 0x80, 0x00, 0x80, 0x00, 0x80,
+    0x08, 0x08, 0x00, 0x08, 0x80, 0x08, 0x80, 0x08,
+    0x80, 0x06, 0x46, 0x46, 0x46, 0x00,
+    // Row 8
+    0x00, 0xa0, 0x00, 0x00, 0x00, 0x00, 0x88, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x06, 0x44, 0x44, 0x46, 0x00,
+    // Row 9
+    0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xc0, 0x00, 0x0c,
+    0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc,
+    0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xc0,
+    // Row 10
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0xcc, 0xc0,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+
+};
+
+pw::draw::IndexedSpriteSheet pigweed_farm_indexed_sprite_sheet = {
+    .width = 43,
+    .height = 11,
+    .count = 2,
+    .bits_per_pixel = 4,
+    .transparent_index = 0,
+    .data = pigweed_farm_indexed_data,
+    .palette = pigweed_farm_indexed_palette};
@@ -0,0 +1,579 @@
+#pragma once
+
+#include <cinttypes>
+
+#include "pw_draw/rle_sprite_sheet.h"
+
+const uint16_t pigweed_farm_rle_data[] = {
+
+    // Sprite 0
+    2,       // Runs
+    2, 1,    // Skip, length
+    0x726,   // #00e436
+    34, 3,   // Skip, length
+    0xff9d,  // #fff1e8
+    0xff9d,  // #fff1e8
+    0xff9d,  // #fff1e8
+    2,       // Runs
+    2, 1,    // Skip, length
+    0x726,   // #00e436
+    33, 5,   // Skip, length
+    0xff9d,  // #fff1e8
+    0xf809,  // #ff004d
+    0xf809,  // #ff004d
+    0xf809,  // #ff004d
+    0xff9d,  // #fff1e8
+    6,       // Runs
+    0, 1,    // Skip, length
+    0x726,   // #00e436
+    1, 1,    // Skip, length
+    0x726,   // #00e436
+    1, 1,    // Skip, length
+    0x726,   // #00e436
+    1, 2,    // Skip, length
+    0xfbb5,  // #ff77a8
+    0xfbb5,  // #ff77a8
+    24, 1,   // Skip, length
+    0xfbb5,  // #ff77a8
+    2, 7,    // Skip, length
+    0xff9d,  // #fff1e8
+    0xf809,  // #ff004d
+    0xf809,  // #ff004d
+    0xff9d,  // #fff1e8
+    0xf809,  // #ff004d
+    0xf809,  // #ff004d
+    0xff9d,  // #fff1e8
+    6,       // Runs
+    1, 3,    // Skip, length
+    0x42a,   // #008751
+    0x726,   // #00e436
+    0x42a,   // #008751
+    2, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    1, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    1, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    21, 1,   // Skip, length
+    0xfbb5,  // #ff77a8
+    2, 7,    // Skip, length
+    0xff9d,  // #fff1e8
+    0xf809,  // #ff004d
+    0xf809,  // #ff004d
+    0xf809,  // #ff004d
+    0xf809,  // #ff004d
+    0xf809,  // #ff004d
+    0xff9d,  // #fff1e8
+    12,      // Runs
+    0, 1,    // Skip, length
+    0x726,   // #00e436
+    1, 1,    // Skip, length
+    0x42a,   // #008751
+    1, 1,    // Skip, length
+    0x726,   // #00e436
+    1, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    1, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    4, 2,    // Skip, length
+    0xfbb5,  // #ff77a8
+    0xfbb5,  // #ff77a8
+    1, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    3, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    2, 2,    // Skip, length
+    0xfbb5,  // #ff77a8
+    0xfbb5,  // #ff77a8
+    2, 2,    // Skip, length
+    0xfbb5,  // #ff77a8
+    0xfbb5,  // #ff77a8
+    2, 2,    // Skip, length
+    0xfbb5,  // #ff77a8
+    0xfbb5,  // #ff77a8
+    1, 9,    // Skip, length
+    0xff9d,  // #fff1e8
+    0xf809,  // #ff004d
+    0xf809,  // #ff004d
+    0xf809,  // #ff004d
+    0xf809,  // #ff004d
+    0xf809,  // #ff004d
+    0xf809,  // #ff004d
+    0xf809,  // #ff004d
+    0xff9d,  // #fff1e8
+    14,      // Runs
+    1, 3,    // Skip, length
+    0x42a,   // #008751
+    0x42a,   // #008751
+    0x42a,   // #008751
+    2, 2,    // Skip, length
+    0xfbb5,  // #ff77a8
+    0xfbb5,  // #ff77a8
+    2, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    1, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    1, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    1, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    3, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    1, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    1, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    1, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    1, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    1, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    1, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    1, 9,    // Skip, length
+    0xff9d,  // #fff1e8
+    0xf809,  // #ff004d
+    0xff9d,  // #fff1e8
+    0xff9d,  // #fff1e8
+    0xff9d,  // #fff1e8
+    0xff9d,  // #fff1e8
+    0xff9d,  // #fff1e8
+    0xf809,  // #ff004d
+    0xff9d,  // #fff1e8
+    14,      // Runs
+    0, 1,    // Skip, length
+    0x726,   // #00e436
+    1, 1,    // Skip, length
+    0x42a,   // #008751
+    1, 1,    // Skip, length
+    0x726,   // #00e436
+    1, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    3, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    1, 3,    // Skip, length
+    0xfbb5,  // #ff77a8
+    0xfbb5,  // #ff77a8
+    0xfbb5,  // #ff77a8
+    1, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    1, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    1, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    1, 2,    // Skip, length
+    0xfbb5,  // #ff77a8
+    0xfbb5,  // #ff77a8
+    2, 2,    // Skip, length
+    0xfbb5,  // #ff77a8
+    0xfbb5,  // #ff77a8
+    2, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    1, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    2, 7,    // Skip, length
+    0xf809,  // #ff004d
+    0xff9d,  // #fff1e8
+    0xf809,  // #ff004d
+    0xff9d,  // #fff1e8
+    0xf809,  // #ff004d
+    0xff9d,  // #fff1e8
+    0xf809,  // #ff004d
+    10,      // Runs
+    1, 3,    // Skip, length
+    0x42a,   // #008751
+    0x42a,   // #008751
+    0x42a,   // #008751
+    2, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    3, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    3, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    2, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    1, 1,    // Skip, length
+    0xfbb5,  // #ff77a8
+    3, 2,    // Skip, length
+    0xfbb5,  // #ff77a8
+    0xfbb5,  // #ff77a8
+    2, 2,    // Skip, length
+    0xfbb5,  // #ff77a8
+    0xfbb5,  // #ff77a8
+    2, 2,    // Skip, length
+    0xfbb5,  // #ff77a8
+    0xfbb5,  // #ff77a8
+    2, 7,    // Skip, length
+    0xf809,  // #ff004d
+    0xff9d,  // #fff1e8
+    0xf809,  // #ff004d
+    0xff9d,  // #fff1e8
+    0xf809,  // #ff004d
+    0xff9d,  // #fff1e8
+    0xf809,  // #ff004d
+    3,       // Runs
+    2, 1,    // Skip, length
+    0x42a,   // #008751
+    9, 2,    // Skip, length
+    0xfbb5,  // #ff77a8
+    0xfbb5,  // #ff77a8
+    21, 7,   // Skip, length
+    0xf809,  // #ff004d
+    0xff9d,  // #fff1e8
+    0xff9d,  // #fff1e8
+    0xff9d,  // #fff1e8
+    0xff9d,  // #fff1e8
+    0xff9d,  // #fff1e8
+    0xf809,  // #ff004d
+    2,       // Runs
+    0, 11,   // Skip, length
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    4, 28,   // Skip, length
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    1,       // Runs
+    11, 4,   // Skip, length
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+    0xaa86,  // #ab5236
+
+    // Sprite 1
+    2,       // Runs
+    2, 1,    // Skip, length
+    0x383,   // #00721b
+    34, 3,   // Skip, length
+    0x83ce,  // #807874
+    0x83ce,  // #807874
+    0x83ce,  // #807874
+    2,       // Runs
+    2, 1,    // Skip, length
+    0x383,   // #00721b
+    33, 5,   // Skip, length
+    0x83ce,  // #807874
+    0x8004,  // #800026
+    0x8004,  // #800026
+    0x8004,  // #800026
+    0x83ce,  // #807874
+    6,       // Runs
+    0, 1,    // Skip, length
+    0x383,   // #00721b
+    1, 1,    // Skip, length
+    0x383,   // #00721b
+    1, 1,    // Skip, length
+    0x383,   // #00721b
+    1, 2,    // Skip, length
+    0x81ca,  // #803b54
+    0x81ca,  // #803b54
+    24, 1,   // Skip, length
+    0x81ca,  // #803b54
+    2, 7,    // Skip, length
+    0x83ce,  // #807874
+    0x8004,  // #800026
+    0x8004,  // #800026
+    0x83ce,  // #807874
+    0x8004,  // #800026
+    0x8004,  // #800026
+    0x83ce,  // #807874
+    6,       // Runs
+    1, 3,    // Skip, length
+    0x205,   // #004328
+    0x383,   // #00721b
+    0x205,   // #004328
+    2, 1,    // Skip, length
+    0x81ca,  // #803b54
+    1, 1,    // Skip, length
+    0x81ca,  // #803b54
+    1, 1,    // Skip, length
+    0x81ca,  // #803b54
+    21, 1,   // Skip, length
+    0x81ca,  // #803b54
+    2, 7,    // Skip, length
+    0x83ce,  // #807874
+    0x8004,  // #800026
+    0x8004,  // #800026
+    0x8004,  // #800026
+    0x8004,  // #800026
+    0x8004,  // #800026
+    0x83ce,  // #807874
+    12,      // Runs
+    0, 1,    // Skip, length
+    0x383,   // #00721b
+    1, 1,    // Skip, length
+    0x205,   // #004328
+    1, 1,    // Skip, length
+    0x383,   // #00721b
+    1, 1,    // Skip, length
+    0x81ca,  // #803b54
+    1, 1,    // Skip, length
+    0x81ca,  // #803b54
+    4, 2,    // Skip, length
+    0x81ca,  // #803b54
+    0x81ca,  // #803b54
+    1, 1,    // Skip, length
+    0x81ca,  // #803b54
+    3, 1,    // Skip, length
+    0x81ca,  // #803b54
+    2, 2,    // Skip, length
+    0x81ca,  // #803b54
+    0x81ca,  // #803b54
+    2, 2,    // Skip, length
+    0x81ca,  // #803b54
+    0x81ca,  // #803b54
+    2, 2,    // Skip, length
+    0x81ca,  // #803b54
+    0x81ca,  // #803b54
+    1, 9,    // Skip, length
+    0x83ce,  // #807874
+    0x8004,  // #800026
+    0x8004,  // #800026
+    0x8004,  // #800026
+    0x8004,  // #800026
+    0x8004,  // #800026
+    0x8004,  // #800026
+    0x8004,  // #800026
+    0x83ce,  // #807874
+    14,      // Runs
+    1, 3,    // Skip, length
+    0x205,   // #004328
+    0x205,   // #004328
+    0x205,   // #004328
+    2, 2,    // Skip, length
+    0x81ca,  // #803b54
+    0x81ca,  // #803b54
+    2, 1,    // Skip, length
+    0x81ca,  // #803b54
+    1, 1,    // Skip, length
+    0x81ca,  // #803b54
+    1, 1,    // Skip, length
+    0x81ca,  // #803b54
+    1, 1,    // Skip, length
+    0x81ca,  // #803b54
+    3, 1,    // Skip, length
+    0x81ca,  // #803b54
+    1, 1,    // Skip, length
+    0x81ca,  // #803b54
+    1, 1,    // Skip, length
+    0x81ca,  // #803b54
+    1, 1,    // Skip, length
+    0x81ca,  // #803b54
+    1, 1,    // Skip, length
+    0x81ca,  // #803b54
+    1, 1,    // Skip, length
+    0x81ca,  // #803b54
+    1, 1,    // Skip, length
+    0x81ca,  // #803b54
+    1, 9,    // Skip, length
+    0x83ce,  // #807874
+    0x8004,  // #800026
+    0x83ce,  // #807874
+    0x83ce,  // #807874
+    0x83ce,  // #807874
+    0x83ce,  // #807874
+    0x83ce,  // #807874
+    0x8004,  // #800026
+    0x83ce,  // #807874
+    14,      // Runs
+    0, 1,    // Skip, length
+    0x383,   // #00721b
+    1, 1,    // Skip, length
+    0x205,   // #004328
+    1, 1,    // Skip, length
+    0x383,   // #00721b
+    1, 1,    // Skip, length
+    0x81ca,  // #803b54
+    3, 1,    // Skip, length
+    0x81ca,  // #803b54
+    1, 3,    // Skip, length
+    0x81ca,  // #803b54
+    0x81ca,  // #803b54
+    0x81ca,  // #803b54
+    1, 1,    // Skip, length
+    0x81ca,  // #803b54
+    1, 1,    // Skip, length
+    0x81ca,  // #803b54
+    1, 1,    // Skip, length
+    0x81ca,  // #803b54
+    1, 2,    // Skip, length
+    0x81ca,  // #803b54
+    0x81ca,  // #803b54
+    2, 2,    // Skip, length
+    0x81ca,  // #803b54
+    0x81ca,  // #803b54
+    2, 1,    // Skip, length
+    0x81ca,  // #803b54
+    1, 1,    // Skip, length
+    0x81ca,  // #803b54
+    2, 7,    // Skip, length
+    0x8004,  // #800026
+    0x83ce,  // #807874
+    0x8004,  // #800026
+    0x83ce,  // #807874
+    0x8004,  // #800026
+    0x83ce,  // #807874
+    0x8004,  // #800026
+    10,      // Runs
+    1, 3,    // Skip, length
+    0x205,   // #004328
+    0x205,   // #004328
+    0x205,   // #004328
+    2, 1,    // Skip, length
+    0x81ca,  // #803b54
+    3, 1,    // Skip, length
+    0x81ca,  // #803b54
+    3, 1,    // Skip, length
+    0x81ca,  // #803b54
+    2, 1,    // Skip, length
+    0x81ca,  // #803b54
+    1, 1,    // Skip, length
+    0x81ca,  // #803b54
+    3, 2,    // Skip, length
+    0x81ca,  // #803b54
+    0x81ca,  // #803b54
+    2, 2,    // Skip, length
+    0x81ca,  // #803b54
+    0x81ca,  // #803b54
+    2, 2,    // Skip, length
+    0x81ca,  // #803b54
+    0x81ca,  // #803b54
+    2, 7,    // Skip, length
+    0x8004,  // #800026
+    0x83ce,  // #807874
+    0x8004,  // #800026
+    0x83ce,  // #807874
+    0x8004,  // #800026
+    0x83ce,  // #807874
+    0x8004,  // #800026
+    3,       // Runs
+    2, 1,    // Skip, length
+    0x205,   // #004328
+    9, 2,    // Skip, length
+    0x81ca,  // #803b54
+    0x81ca,  // #803b54
+    21, 7,   // Skip, length
+    0x8004,  // #800026
+    0x83ce,  // #807874
+    0x83ce,  // #807874
+    0x83ce,  // #807874
+    0x83ce,  // #807874
+    0x83ce,  // #807874
+    0x8004,  // #800026
+    2,       // Runs
+    0, 11,   // Skip, length
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    4, 28,   // Skip, length
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    1,       // Runs
+    11, 4,   // Skip, length
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+    0x5143,  // #55291b
+
+};
+
+const uint32_t pigweed_farm_rle_row_offsets[] = {
+    0,
+    9,
+    20,
+    46,
+    73,
+    122,
+    176,
+    229,
+    271,
+    288,
+    332,
+    339,
+    348,
+    359,
+    385,
+    412,
+    461,
+    515,
+    568,
+    610,
+    627,
+    671,
+};
+
+pw::draw::RleSpriteSheet pigweed_farm_rle_sprite_sheet = {
+    .width = 43,
+    .height = 11,
+    .count = 2,
+    .row_offsets = pigweed_farm_rle_row_offsets,
+    .data = pigweed_farm_rle_data};
@@ -0,0 +1,46 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstdint>
+
+namespace pw::draw {
+
+// A sprite sheet whose rows are stored as runs of opaque pixels, so that
+// transparent pixels take no space and are skipped without being examined.
+// These are generated by png2cc with --output-mode rgb565_rle.
+//
+// Each row is encoded in |data| as the number of opaque runs in the row,
+// followed by each run: the number of transparent pixels to skip before it,
+// the number of pixels in it, and then its pixel values.
+//
+//   num_runs, (skip, length, pixel[0], ..., pixel[length - 1]) * num_runs
+//
+// |row_offsets| holds the index in |data| at which each row starts, for every
+// row of every sprite.
+class RleSpriteSheet {
+ public:
+  const int width;
+  const int height;
+  const int count;
+  const uint32_t* row_offsets;
+  const uint16_t* data;
+
+  int current_index = 0;
+
+  // Return the encoded row |y| of sprite |sprite_index|.
+  const uint16_t* GetRow(int y, int sprite_index) const;
+};
+
+}  // namespace pw::draw
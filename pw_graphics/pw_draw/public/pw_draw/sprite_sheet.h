@@ -30,6 +30,8 @@ class SpriteSheet {
   int index_direction = 1;
 
   pw::color::color_rgb565_t GetColor(int x, int y, int sprite_index);
+  // Return the |width| pixels of row |y| of sprite |sprite_index|.
+  const pw::color::color_rgb565_t* GetRow(int y, int sprite_index) const;
   void SetIndex(int index);
   void RotateIndexLoop();
   void RotateIndexPingPong();
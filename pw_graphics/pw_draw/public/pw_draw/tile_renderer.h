@@ -0,0 +1,127 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "pw_draw/display_list.h"
+#include "pw_draw/glyph_cache.h"
+#include "pw_framebuffer/framebuffer.h"
+#include "pw_math/size.h"
+
+namespace pw::draw {
+
+// TileRenderer replays a DisplayList into a framebuffer using a pool of
+// threads. The framebuffer is split into tiles small enough to stay in a
+// core's cache while they are drawn, and each tile is a view of the
+// framebuffer's pixels, so no pixels are copied. The result is identical to
+// calling DisplayList::Replay() with the whole framebuffer.
+//
+// Before drawing, the commands are sorted into a bin for each tile which their
+// bounds overlap, so each tile only considers the commands which may draw to
+// it.
+//
+// Each thread starts with an equal, contiguous share of the tiles, taken from
+// the front, and when it runs out steals tiles from the back of another
+// thread's share, so that threads whose tiles are quick to draw help with the
+// busier parts of the frame.
+//
+// This uses std::thread, so is only available on host targets.
+class TileRenderer {
+ public:
+  // 16 KB of RGB565 pixels, which fits in a typical L1 data cache.
+  static constexpr pw::math::Size<int> kDefaultTileSize = {128, 64};
+
+  // Create a renderer which draws with |num_threads| threads, including the
+  // thread calling Render(). Tile widths must be a multiple of 8 so that every
+  // tile starts on a byte boundary.
+  explicit TileRenderer(size_t num_threads,
+                        pw::math::Size<int> tile_size = kDefaultTileSize);
+  ~TileRenderer();
+
+  TileRenderer(const TileRenderer&) = delete;
+  TileRenderer& operator=(const TileRenderer&) = delete;
+
+  // Draw |display_list| into |framebuffer|, returning once every tile has
+  // been drawn. |display_list| must not be modified during the call.
+  void Render(const DisplayList& display_list,
+              pw::framebuffer::Framebuffer& framebuffer);
+
+  size_t num_threads() const { return num_workers_; }
+
+  // The number of tiles drawn by a thread other than the one they were first
+  // assigned to, since the renderer was created.
+  size_t tiles_stolen() const { return tiles_stolen_.load(); }
+
+ private:
+  // Per-thread state. Each worker is on its own cache line so that taking
+  // tiles does not contend with the other workers.
+  struct alignas(64) Worker {
+    // The worker's remaining tiles, [first, end), with end in the upper 32
+    // bits, so that the owner and thieves can update them with a single
+    // compare and exchange.
+    std::atomic<uint64_t> tiles{0};
+    GlyphCache glyph_cache;
+  };
+
+  // Take the next of |worker|'s own tiles. Returns false if it has none left.
+  bool TakeTile(Worker& worker, uint32_t& tile);
+
+  // Take the last tile of another worker. Returns false if all are done.
+  bool StealTile(size_t thief, uint32_t& tile);
+
+  // Sort the commands of display_list_ into bins_ for each tile.
+  void BinCommands();
+
+  // Draw tiles until there are none left to take or steal.
+  void DrawTiles(size_t worker_index);
+  void DrawTile(uint32_t tile, GlyphCache& glyph_cache);
+
+  void WorkerThread(size_t worker_index);
+
+  const pw::math::Size<int> tile_size_;
+  const size_t num_workers_;
+  std::unique_ptr<Worker[]> workers_;
+  std::vector<std::thread> threads_;
+  std::atomic<size_t> tiles_stolen_{0};
+
+  // The frame being rendered.
+  const DisplayList* display_list_ = nullptr;
+  pw::framebuffer::Framebuffer* framebuffer_ = nullptr;
+  int tiles_per_row_ = 0;
+  size_t num_tiles_ = 0;
+
+  // The indices of the commands overlapping tile t are
+  // bin_commands_[bin_starts_[t]] to bin_commands_[bin_starts_[t + 1] - 1].
+  std::vector<uint32_t> bin_starts_;
+  std::vector<uint32_t> bin_commands_;
+  std::vector<uint32_t> bin_ends_;  // Used while filling the bins.
+
+  // Guards starting and finishing a frame.
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable done_;
+  uint32_t generation_ = 0;  // Incremented to start each frame.
+  size_t num_busy_ = 0;      // Threads still drawing the current frame.
+  bool stopping_ = false;
+};
+
+}  // namespace pw::draw
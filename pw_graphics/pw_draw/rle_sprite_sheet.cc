@@ -0,0 +1,22 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#include "pw_draw/rle_sprite_sheet.h"
+
+namespace pw::draw {
+
+const uint16_t* RleSpriteSheet::GetRow(int y, int sprite_index) const {
+  return &data[row_offsets[sprite_index * height + y]];
+}
+
+}  // namespace pw::draw
@@ -22,6 +22,10 @@ color_rgb565_t SpriteSheet::GetColor(int x, int y, int sprite_index = 0) {
   return _data[start_y * width + x];
 }
 
+const color_rgb565_t* SpriteSheet::GetRow(int y, int sprite_index) const {
+  return &_data[(sprite_index * height + y) * width];
+}
+
 void SpriteSheet::SetIndex(int index) { current_index = index; }
 
 void SpriteSheet::RotateIndexLoop() {
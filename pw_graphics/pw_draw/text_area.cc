@@ -149,26 +149,29 @@ void TextArea::ScrollUp(int lines) {
   int start_x = 0;
   int start_y = pixel_height;
 
+  const int width = framebuffer.size().width;
+  const int height = framebuffer.size().height;
+  const int origin_x = framebuffer.origin().x;
+  const int origin_y = framebuffer.origin().y;
   FramebufferWriter writer(framebuffer);
-  for (int current_x = 0; current_x < framebuffer.size().width; current_x++) {
-    for (int current_y = start_y; current_y < framebuffer.size().height;
-         current_y++) {
-      if (auto pixel_color = writer.GetPixel(current_x, current_y);
-          pixel_color.ok()) {
-        writer.SetPixel(start_x + current_x, current_y - start_y, *pixel_color);
-      }
-    }
+  // Move the remaining rows up a row at a time. Each row is copied before it
+  // is overwritten, as rows are copied from the top down.
+  if (start_y > 0 && start_y < height) {
+    const pw::framebuffer::Framebuffer remaining = framebuffer.SubView(
+        {0,
+         static_cast<uint16_t>(start_y),
+         static_cast<uint16_t>(width),
+         static_cast<uint16_t>(height - start_y)});
+    writer.Blit(remaining, origin_x + start_x, origin_y);
   }
 
   // Draw a filled background_color rectangle at the bottom to erase the old
   // text.
-  for (int x = 0; x < framebuffer.size().width; x++) {
-    for (int y = framebuffer.size().height - pixel_height;
-         y < framebuffer.size().height;
-         y++) {
-      writer.SetPixel(x, y, background_color);
-    }
-  }
+  writer.FillRect(origin_x,
+                  origin_y + height - pixel_height,
+                  width,
+                  pixel_height,
+                  background_color);
 }
 
 }  // namespace pw::draw
@@ -0,0 +1,221 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#include "pw_draw/tile_renderer.h"
+
+#include "pw_assert/assert.h"
+#include "pw_math/rect.h"
+
+using pw::framebuffer::Framebuffer;
+
+namespace pw::draw {
+
+namespace {
+
+constexpr uint64_t PackTiles(uint32_t first, uint32_t end) {
+  return (uint64_t{end} << 32) | first;
+}
+constexpr uint32_t FirstTile(uint64_t tiles) {
+  return static_cast<uint32_t>(tiles);
+}
+constexpr uint32_t EndTile(uint64_t tiles) {
+  return static_cast<uint32_t>(tiles >> 32);
+}
+
+}  // namespace
+
+TileRenderer::TileRenderer(size_t num_threads, pw::math::Size<int> tile_size)
+    : tile_size_(tile_size),
+      num_workers_(num_threads),
+      workers_(new Worker[num_threads]) {
+  PW_ASSERT(num_threads > 0);
+  PW_ASSERT(tile_size.width > 0 && tile_size.width % 8 == 0);
+  PW_ASSERT(tile_size.height > 0);
+  // The thread calling Render() is worker 0.
+  for (size_t i = 1; i < num_workers_; i++) {
+    threads_.emplace_back(&TileRenderer::WorkerThread, this, i);
+  }
+}
+
+TileRenderer::~TileRenderer() {
+  {
+    std::lock_guard lock(mutex_);
+    stopping_ = true;
+  }
+  start_.notify_all();
+  for (std::thread& thread : threads_) {
+    thread.join();
+  }
+}
+
+void TileRenderer::Render(const DisplayList& display_list,
+                          Framebuffer& framebuffer) {
+  PW_ASSERT(framebuffer.is_valid());
+  const int width = framebuffer.size().width;
+  const int height = framebuffer.size().height;
+  tiles_per_row_ = (width + tile_size_.width - 1) / tile_size_.width;
+  const int tile_rows = (height + tile_size_.height - 1) / tile_size_.height;
+  num_tiles_ = static_cast<size_t>(tiles_per_row_) * tile_rows;
+  display_list_ = &display_list;
+  framebuffer_ = &framebuffer;
+  BinCommands();
+
+  {
+    std::lock_guard lock(mutex_);
+    // Give each worker a contiguous run of tiles, so that its tiles are
+    // mostly adjacent rows of the framebuffer.
+    for (size_t i = 0; i < num_workers_; i++) {
+      workers_[i].tiles.store(
+          PackTiles(static_cast<uint32_t>(num_tiles_ * i / num_workers_),
+                    static_cast<uint32_t>(num_tiles_ * (i + 1) / num_workers_)),
+          std::memory_order_relaxed);
+    }
+    num_busy_ = threads_.size();
+    generation_++;
+  }
+  start_.notify_all();
+
+  DrawTiles(0);
+
+  std::unique_lock lock(mutex_);
+  done_.wait(lock, [this] { return num_busy_ == 0; });
+  display_list_ = nullptr;
+  framebuffer_ = nullptr;
+}
+
+void TileRenderer::BinCommands() {
+  const pw::math::Rect<uint16_t> fb_bounds = framebuffer_->bounds();
+  const pw::math::Rect<int> fb_rect = {
+      fb_bounds.x, fb_bounds.y, fb_bounds.width, fb_bounds.height};
+
+  // Count the commands in each bin, then place each command once the start of
+  // every bin is known. Commands are visited in order, so each bin is sorted.
+  bin_starts_.assign(num_tiles_ + 1, 0);
+  for (int pass = 0; pass < 2; pass++) {
+    for (size_t i = 0; i < display_list_->size(); i++) {
+      const pw::math::Rect<int> rect =
+          display_list_->bounds(i).Intersect(fb_rect);
+      if (rect.IsEmpty()) {
+        continue;
+      }
+      const int first_column = (rect.x - fb_rect.x) / tile_size_.width;
+      const int last_column =
+          (rect.x + rect.width - 1 - fb_rect.x) / tile_size_.width;
+      const int first_row = (rect.y - fb_rect.y) / tile_size_.height;
+      const int last_row =
+          (rect.y + rect.height - 1 - fb_rect.y) / tile_size_.height;
+      for (int row = first_row; row <= last_row; row++) {
+        for (int column = first_column; column <= last_column; column++) {
+          const size_t tile = row * tiles_per_row_ + column;
+          if (pass == 0) {
+            bin_starts_[tile + 1]++;
+          } else {
+            bin_commands_[bin_ends_[tile]++] = static_cast<uint32_t>(i);
+          }
+        }
+      }
+    }
+    if (pass == 0) {
+      for (size_t tile = 0; tile < num_tiles_; tile++) {
+        bin_starts_[tile + 1] += bin_starts_[tile];
+      }
+      bin_commands_.resize(bin_starts_[num_tiles_]);
+      bin_ends_.assign(bin_starts_.begin(), bin_starts_.end() - 1);
+    }
+  }
+}
+
+bool TileRenderer::TakeTile(Worker& worker, uint32_t& tile) {
+  uint64_t tiles = worker.tiles.load(std::memory_order_relaxed);
+  do {
+    if (FirstTile(tiles) >= EndTile(tiles)) {
+      return false;
+    }
+  } while (!worker.tiles.compare_exchange_weak(
+      tiles,
+      PackTiles(FirstTile(tiles) + 1, EndTile(tiles)),
+      std::memory_order_relaxed));
+  tile = FirstTile(tiles);
+  return true;
+}
+
+bool TileRenderer::StealTile(size_t thief, uint32_t& tile) {
+  for (size_t i = 1; i < num_workers_; i++) {
+    Worker& victim = workers_[(thief + i) % num_workers_];
+    uint64_t tiles = victim.tiles.load(std::memory_order_relaxed);
+    while (FirstTile(tiles) < EndTile(tiles)) {
+      if (victim.tiles.compare_exchange_weak(
+              tiles,
+              PackTiles(FirstTile(tiles), EndTile(tiles) - 1),
+              std::memory_order_relaxed)) {
+        tile = EndTile(tiles) - 1;
+        tiles_stolen_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void TileRenderer::DrawTiles(size_t worker_index) {
+  Worker& worker = workers_[worker_index];
+  uint32_t tile;
+  while (TakeTile(worker, tile) || StealTile(worker_index, tile)) {
+    DrawTile(tile, worker.glyph_cache);
+  }
+}
+
+void TileRenderer::DrawTile(uint32_t tile, GlyphCache& glyph_cache) {
+  const int x = (tile % tiles_per_row_) * tile_size_.width;
+  const int y = (tile / tiles_per_row_) * tile_size_.height;
+  Framebuffer view =
+      framebuffer_->SubView({static_cast<uint16_t>(x),
+                             static_cast<uint16_t>(y),
+                             static_cast<uint16_t>(tile_size_.width),
+                             static_cast<uint16_t>(tile_size_.height)});
+  view.set_origin({static_cast<uint16_t>(framebuffer_->origin().x + x),
+                   static_cast<uint16_t>(framebuffer_->origin().y + y)});
+  const uint32_t* bin = bin_commands_.data() + bin_starts_[tile];
+  display_list_->Replay(
+      view,
+      span<const uint32_t>(bin, bin_starts_[tile + 1] - bin_starts_[tile]),
+      &glyph_cache);
+}
+
+void TileRenderer::WorkerThread(size_t worker_index) {
+  uint32_t generation = 0;
+  while (true) {
+    {
+      std::unique_lock lock(mutex_);
+      start_.wait(lock,
+                  [&] { return stopping_ || generation_ != generation; });
+      if (stopping_) {
+        return;
+      }
+      generation = generation_;
+    }
+
+    DrawTiles(worker_index);
+
+    bool done;
+    {
+      std::lock_guard lock(mutex_);
+      done = --num_busy_ == 0;
+    }
+    if (done) {
+      done_.notify_one();
+    }
+  }
+}
+
+}  // namespace pw::draw
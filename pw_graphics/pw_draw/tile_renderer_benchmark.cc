@@ -0,0 +1,158 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Host benchmark of TileRenderer, comparing a single-threaded
+// DisplayList::Replay() of a frame against rendering it with 1 to N threads,
+// at resolutions from 320x240 up to 1920x1080.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "pw_assert/assert.h"
+#include "pw_color/color.h"
+#include "pw_draw/display_list.h"
+#include "pw_draw/font_set.h"
+#include "pw_draw/glyph_cache.h"
+#include "pw_draw/tile_renderer.h"
+#include "pw_framebuffer/framebuffer.h"
+#include "pw_log/log.h"
+#include "pw_math/size.h"
+#include "pw_status/status.h"
+
+using pw::color::color_rgb565_t;
+using pw::draw::DisplayList;
+using pw::draw::TileRenderer;
+using pw::framebuffer::Framebuffer;
+using pw::framebuffer::PixelFormat;
+
+namespace {
+
+constexpr int kIterations = 50;
+constexpr pw::math::Size<uint16_t> kResolutions[] = {
+    {320, 240},
+    {640, 480},
+    {1280, 720},
+    {1920, 1080},
+};
+
+// Record a frame of panels, text, circles and short lines, with one shape for
+// every 400 pixels of the display.
+void RecordFrame(DisplayList& display_list, int width, int height) {
+  uint32_t seed = 1;
+  auto next = [&seed](int limit) {
+    seed = seed * 1664525 + 1013904223;
+    return static_cast<int>((seed >> 8) % limit);
+  };
+  display_list.Clear();
+  display_list.Fill(0x0000).IgnoreError();
+  const int num_shapes = width * height / 400;
+  for (int i = 0; i < num_shapes; i++) {
+    const int x = next(width);
+    const int y = next(height);
+    const color_rgb565_t color = static_cast<color_rgb565_t>(next(0x10000));
+    pw::Status status;
+    switch (i % 4) {
+      case 0:
+        status = display_list.DrawRectWH(
+            x, y, next(120), next(80), color, /*filled=*/true);
+        break;
+      case 1:
+        status = display_list.DrawString(
+            L"The quick brown fox", {x, y}, color, 0x0000, pw::draw::font6x8);
+        break;
+      case 2:
+        status = display_list.DrawCircle(
+            x, y, next(40), color, /*filled=*/next(2) == 0);
+        break;
+      case 3:
+        status = display_list.DrawLine(
+            x, y, x + next(160) - 80, y + next(160) - 80, color);
+        break;
+    }
+    PW_ASSERT(status.ok());
+  }
+}
+
+template <typename RenderFunction>
+double FramesPerSecond(RenderFunction render) {
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterations; i++) {
+    render();
+  }
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return kIterations / elapsed.count();
+}
+
+}  // namespace
+
+int main() {
+  const size_t max_threads =
+      std::max<size_t>(1, std::thread::hardware_concurrency());
+  std::vector<size_t> thread_counts;
+  for (size_t num_threads = 1; num_threads < max_threads; num_threads *= 2) {
+    thread_counts.push_back(num_threads);
+  }
+  thread_counts.push_back(max_threads);
+
+  std::vector<std::byte> arena(1 << 20);
+  DisplayList display_list(arena);
+
+  for (const pw::math::Size<uint16_t>& size : kResolutions) {
+    const size_t num_pixels = size.width * size.height;
+    std::vector<color_rgb565_t> expected_pixels(num_pixels);
+    std::vector<color_rgb565_t> pixels(num_pixels);
+    Framebuffer expected(expected_pixels.data(),
+                         PixelFormat::RGB565,
+                         size,
+                         size.width * sizeof(color_rgb565_t));
+    Framebuffer fb(pixels.data(),
+                   PixelFormat::RGB565,
+                   size,
+                   size.width * sizeof(color_rgb565_t));
+    RecordFrame(display_list, size.width, size.height);
+
+    // Both paths draw text through a glyph cache, as each TileRenderer thread
+    // has one.
+    pw::draw::GlyphCache glyph_cache;
+    const double single =
+        FramesPerSecond([&] { display_list.Replay(expected, &glyph_cache); });
+    PW_LOG_INFO("%dx%d, %d commands: Replay() %.1f frames/s",
+                size.width,
+                size.height,
+                static_cast<int>(display_list.size()),
+                single);
+
+    for (size_t num_threads : thread_counts) {
+      TileRenderer renderer(num_threads);
+      const double tiled =
+          FramesPerSecond([&] { renderer.Render(display_list, fb); });
+      const bool identical =
+          std::memcmp(pixels.data(),
+                      expected_pixels.data(),
+                      num_pixels * sizeof(color_rgb565_t)) == 0;
+      PW_LOG_INFO("  %2d threads: %.1f frames/s (%.2fx)%s",
+                  static_cast<int>(num_threads),
+                  tiled,
+                  tiled / single,
+                  identical ? "" : " OUTPUT DIFFERS");
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,136 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#include "pw_draw/tile_renderer.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "pw_color/color.h"
+#include "pw_draw/display_list.h"
+#include "pw_draw/font_set.h"
+#include "pw_framebuffer/framebuffer.h"
+
+using pw::color::color_rgb565_t;
+using pw::framebuffer::Framebuffer;
+using pw::framebuffer::PixelFormat;
+
+namespace pw::draw {
+namespace {
+
+constexpr uint16_t kWidth = 100;
+constexpr uint16_t kHeight = 70;
+
+// Record |num_shapes| overlapping shapes, placed pseudo-randomly from |seed|.
+void RecordScene(DisplayList& display_list, uint32_t seed, int num_shapes) {
+  auto next = [&seed](int limit) {
+    seed = seed * 1664525 + 1013904223;
+    return static_cast<int>((seed >> 8) % limit);
+  };
+  ASSERT_EQ(display_list.Fill(0x0000), OkStatus());
+  for (int i = 0; i < num_shapes; i++) {
+    const int x = next(kWidth + 20) - 10;
+    const int y = next(kHeight + 20) - 10;
+    const color_rgb565_t color = static_cast<color_rgb565_t>(next(0x10000));
+    switch (i % 4) {
+      case 0:
+        ASSERT_EQ(display_list.DrawRectWH(
+                      x, y, next(40), next(30), color, next(2) == 0),
+                  OkStatus());
+        break;
+      case 1:
+        ASSERT_EQ(display_list.DrawCircle(x, y, next(20), color, next(2) == 0),
+                  OkStatus());
+        break;
+      case 2:
+        ASSERT_EQ(display_list.DrawLine(
+                      x, y, next(kWidth + 20) - 10, next(kHeight), color),
+                  OkStatus());
+        break;
+      case 3:
+        ASSERT_EQ(display_list.DrawString(
+                      L"Tile 0123", {x, y}, color, 0x0000, font6x8),
+                  OkStatus());
+        break;
+    }
+  }
+}
+
+// Check that rendering |display_list| with |renderer| produces exactly the
+// pixels that replaying it into the whole framebuffer does.
+void ExpectMatchesReplay(TileRenderer& renderer,
+                         const DisplayList& display_list,
+                         pw::math::Vector2<uint16_t> origin) {
+  std::vector<color_rgb565_t> expected_data(kWidth * kHeight);
+  std::vector<color_rgb565_t> data(kWidth * kHeight, 0x1234);
+  Framebuffer expected(expected_data.data(),
+                       PixelFormat::RGB565,
+                       {kWidth, kHeight},
+                       kWidth * sizeof(color_rgb565_t));
+  Framebuffer fb(data.data(),
+                 PixelFormat::RGB565,
+                 {kWidth, kHeight},
+                 kWidth * sizeof(color_rgb565_t));
+  expected.set_origin(origin);
+  fb.set_origin(origin);
+
+  display_list.Replay(expected);
+  renderer.Render(display_list, fb);
+  EXPECT_EQ(data, expected_data);
+}
+
+TEST(TileRenderer, MatchesReplay) {
+  std::vector<std::byte> arena(16384);
+  DisplayList display_list(arena);
+  RecordScene(display_list, /*seed=*/1, /*num_shapes=*/120);
+
+  for (size_t num_threads : {1, 2, 4, 7}) {
+    for (pw::math::Size<int> tile_size :
+         {pw::math::Size<int>{8, 8},
+          pw::math::Size<int>{16, 5},
+          TileRenderer::kDefaultTileSize}) {
+      SCOPED_TRACE(testing::Message() << num_threads << " threads, tiles "
+                                      << tile_size.width << "x"
+                                      << tile_size.height);
+      TileRenderer renderer(num_threads, tile_size);
+      EXPECT_EQ(renderer.num_threads(), num_threads);
+      ExpectMatchesReplay(renderer, display_list, {0, 0});
+    }
+  }
+}
+
+TEST(TileRenderer, FramebufferOrigin) {
+  std::vector<std::byte> arena(16384);
+  DisplayList display_list(arena);
+  RecordScene(display_list, /*seed=*/2, /*num_shapes=*/120);
+
+  TileRenderer renderer(3, {16, 16});
+  ExpectMatchesReplay(renderer, display_list, {20, 35});
+}
+
+TEST(TileRenderer, RendersManyFrames) {
+  std::vector<std::byte> arena(16384);
+  DisplayList display_list(arena);
+  TileRenderer renderer(4, {8, 4});
+  for (uint32_t frame = 0; frame < 20; frame++) {
+    display_list.Clear();
+    RecordScene(display_list, frame, /*num_shapes=*/40);
+    ExpectMatchesReplay(renderer, display_list, {0, 0});
+  }
+}
+
+}  // namespace
+}  // namespace pw::draw
@@ -0,0 +1,56 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#include "pw_framebuffer/expand.h"
+
+#include "pw_assert/assert.h"
+
+using pw::color::color_rgb565_t;
+
+namespace pw::framebuffer {
+
+void ExpandIndexedPixels(const uint8_t* indices,
+                         int bits_per_pixel,
+                         size_t first_pixel,
+                         size_t count,
+                         span<const color_rgb565_t> palette,
+                         color_rgb565_t* dest) {
+  const color_rgb565_t* lut = palette.data();
+  if (bits_per_pixel == 8) {
+    const uint8_t* src = indices + first_pixel;
+    for (size_t i = 0; i < count; i++) {
+      dest[i] = lut[src[i]];
+    }
+    return;
+  }
+  PW_ASSERT(bits_per_pixel == 4);
+
+  // Expand a whole byte (two pixels) at a time, with a single pixel for an odd
+  // head and tail.
+  const uint8_t* src = indices + first_pixel / 2;
+  if (count > 0 && (first_pixel & 1)) {
+    *dest++ = lut[*src++ & 0xf];
+    count--;
+  }
+  for (; count >= 2; count -= 2) {
+    const uint8_t pair = *src++;
+    dest[0] = lut[pair >> 4];
+    dest[1] = lut[pair & 0xf];
+    dest += 2;
+  }
+  if (count > 0) {
+    *dest = lut[*src >> 4];
+  }
+}
+
+}  // namespace pw::framebuffer
@@ -0,0 +1,73 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#include "pw_framebuffer/expand.h"
+
+#include <cstdint>
+
+#include "gtest/gtest.h"
+#include "pw_color/color.h"
+
+using pw::color::color_rgb565_t;
+
+namespace pw::framebuffer {
+namespace {
+
+constexpr color_rgb565_t kGuard = 0x1234;
+
+// A palette whose entry i is easy to recognize from i.
+constexpr color_rgb565_t kPalette[16] = {
+    0xa000, 0xa001, 0xa002, 0xa003, 0xa004, 0xa005, 0xa006, 0xa007,
+    0xa008, 0xa009, 0xa00a, 0xa00b, 0xa00c, 0xa00d, 0xa00e, 0xa00f,
+};
+
+// Expand every (first, count) combination of |indices| into a guarded buffer,
+// and compare against GetPixelIndex().
+void CheckExpand(const uint8_t* indices, int bits_per_pixel, size_t size) {
+  constexpr size_t kBufferSize = 40;
+  color_rgb565_t buffer[kBufferSize];
+  for (size_t first = 0; first < size; first++) {
+    for (size_t count = 0; first + count <= size; count++) {
+      for (auto& pixel : buffer) {
+        pixel = kGuard;
+      }
+      ExpandIndexedPixels(
+          indices, bits_per_pixel, first, count, kPalette, buffer + 1);
+      EXPECT_EQ(buffer[0], kGuard);
+      for (size_t i = 0; i < count; i++) {
+        ASSERT_EQ(buffer[i + 1],
+                  kPalette[GetPixelIndex(indices, bits_per_pixel, first + i)])
+            << "first=" << first << " count=" << count << " i=" << i;
+      }
+      EXPECT_EQ(buffer[count + 1], kGuard);
+    }
+  }
+}
+
+TEST(ExpandIndexedPixels, FourBitsPerPixel) {
+  constexpr uint8_t kIndices[] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd};
+  EXPECT_EQ(GetPixelIndex(kIndices, 4, 0), 0);
+  EXPECT_EQ(GetPixelIndex(kIndices, 4, 1), 1);
+  EXPECT_EQ(GetPixelIndex(kIndices, 4, 13), 13);
+  CheckExpand(kIndices, 4, sizeof(kIndices) * 2);
+}
+
+TEST(ExpandIndexedPixels, EightBitsPerPixel) {
+  constexpr uint8_t kIndices[] = {15, 3, 0, 7, 9, 12, 1};
+  EXPECT_EQ(GetPixelIndex(kIndices, 8, 0), 15);
+  EXPECT_EQ(GetPixelIndex(kIndices, 8, 6), 1);
+  CheckExpand(kIndices, 8, sizeof(kIndices));
+}
+
+}  // namespace
+}  // namespace pw::framebuffer
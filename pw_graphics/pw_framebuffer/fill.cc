@@ -0,0 +1,118 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#include "public/pw_framebuffer/fill.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include "pw_assert/assert.h"
+#include "pw_framebuffer/expand.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+using pw::color::color_rgb565_t;
+
+namespace pw::framebuffer {
+
+namespace {
+
+#if defined(__SSE2__) || defined(__ARM_NEON)
+constexpr size_t kStoreBytes = 16;
+#else
+constexpr size_t kStoreBytes = sizeof(uint32_t);
+#endif
+constexpr size_t kPixelsPerStore = kStoreBytes / sizeof(color_rgb565_t);
+
+bool IsAligned(const color_rgb565_t* ptr) {
+  return reinterpret_cast<uintptr_t>(ptr) % kStoreBytes == 0;
+}
+
+}  // namespace
+
+void FillPixels(color_rgb565_t* dest,
+                size_t count,
+                color_rgb565_t pixel_value) {
+  const uint8_t low_byte = pixel_value & 0xff;
+  const uint8_t high_byte = pixel_value >> 8;
+  if (low_byte == high_byte) {
+    std::memset(dest, low_byte, count * sizeof(color_rgb565_t));
+    return;
+  }
+
+  // Write single pixels until |dest| is aligned for the wide stores.
+  while (count > 0 && !IsAligned(dest)) {
+    *dest++ = pixel_value;
+    count--;
+  }
+
+#if defined(__SSE2__)
+  const __m128i wide_value = _mm_set1_epi16(static_cast<int16_t>(pixel_value));
+  for (; count >= kPixelsPerStore; count -= kPixelsPerStore) {
+    _mm_store_si128(reinterpret_cast<__m128i*>(dest), wide_value);
+    dest += kPixelsPerStore;
+  }
+#elif defined(__ARM_NEON)
+  const uint16x8_t wide_value = vdupq_n_u16(pixel_value);
+  for (; count >= kPixelsPerStore; count -= kPixelsPerStore) {
+    vst1q_u16(dest, wide_value);
+    dest += kPixelsPerStore;
+  }
+#else
+  const uint32_t wide_value = pixel_value * uint32_t{0x00010001};
+  // Unrolled so that the compiler can emit multi-register stores (e.g. STM).
+  for (; count >= 4 * kPixelsPerStore; count -= 4 * kPixelsPerStore) {
+    std::memcpy(dest, &wide_value, kStoreBytes);
+    std::memcpy(dest + kPixelsPerStore, &wide_value, kStoreBytes);
+    std::memcpy(dest + 2 * kPixelsPerStore, &wide_value, kStoreBytes);
+    std::memcpy(dest + 3 * kPixelsPerStore, &wide_value, kStoreBytes);
+    dest += 4 * kPixelsPerStore;
+  }
+  for (; count >= kPixelsPerStore; count -= kPixelsPerStore) {
+    std::memcpy(dest, &wide_value, kStoreBytes);
+    dest += kPixelsPerStore;
+  }
+#endif
+
+  while (count > 0) {
+    *dest++ = pixel_value;
+    count--;
+  }
+}
+
+void FillPixelIndices(uint8_t* indices,
+                      int bits_per_pixel,
+                      size_t first_pixel,
+                      size_t count,
+                      uint8_t index) {
+  if (bits_per_pixel == 8) {
+    std::memset(indices + first_pixel, index, count);
+    return;
+  }
+  PW_ASSERT(bits_per_pixel == 4);
+  if (count > 0 && (first_pixel & 1)) {
+    SetPixelIndex(indices, 4, first_pixel++, index);
+    count--;
+  }
+  const uint8_t pair = static_cast<uint8_t>((index << 4) | (index & 0xf));
+  std::memset(indices + first_pixel / 2, pair, count / 2);
+  if (count & 1) {
+    SetPixelIndex(indices, 4, first_pixel + count - 1, index);
+  }
+}
+
+}  // namespace pw::framebuffer
@@ -0,0 +1,89 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+// Host benchmark comparing FillPixels() against the per-pixel loop previously
+// used by FramebufferWriter::Fill().
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "pw_color/color.h"
+#include "pw_framebuffer/fill.h"
+#include "pw_log/log.h"
+
+using pw::color::color_rgb565_t;
+
+namespace {
+
+constexpr int kIterations = 200;
+
+struct Resolution {
+  int width;
+  int height;
+};
+
+constexpr Resolution kResolutions[] = {
+    {320, 240},
+    {480, 320},
+    {1920, 1080},
+};
+
+// The fill loop used by FramebufferWriter::Fill() prior to FillPixels().
+__attribute__((noinline)) void ScalarFill(color_rgb565_t* data,
+                                          size_t num_pixels,
+                                          color_rgb565_t pixel_value) {
+  for (size_t i = 0; i < num_pixels; i++) {
+    data[i] = pixel_value;
+  }
+}
+
+template <typename FillFunction>
+double MegabytesPerSecond(std::vector<color_rgb565_t>& pixels,
+                          color_rgb565_t pixel_value,
+                          FillFunction fill) {
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterations; i++) {
+    fill(pixels.data(), pixels.size(), pixel_value);
+  }
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  const double bytes = static_cast<double>(pixels.size()) *
+                       sizeof(color_rgb565_t) * kIterations;
+  return bytes / elapsed.count() / 1e6;
+}
+
+constexpr color_rgb565_t kColors[] = {0x0000, 0xfd00};
+
+}  // namespace
+
+int main() {
+  for (const Resolution& resolution : kResolutions) {
+    std::vector<color_rgb565_t> pixels(resolution.width * resolution.height);
+    // 0x0000 takes the memset path; 0xfd00 uses the wide stores.
+    for (color_rgb565_t color : kColors) {
+      const double scalar = MegabytesPerSecond(pixels, color, ScalarFill);
+      const double fill =
+          MegabytesPerSecond(pixels, color, pw::framebuffer::FillPixels);
+      PW_LOG_INFO("%dx%d color=0x%04x: scalar %.0f MB/s, FillPixels %.0f MB/s",
+                  resolution.width,
+                  resolution.height,
+                  color,
+                  scalar,
+                  fill);
+    }
+  }
+  return 0;
+}
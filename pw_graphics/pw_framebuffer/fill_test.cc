@@ -0,0 +1,82 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#include "pw_framebuffer/fill.h"
+
+#include <cstdint>
+
+#include "gtest/gtest.h"
+#include "pw_color/color.h"
+#include "pw_framebuffer/expand.h"
+
+using pw::color::color_rgb565_t;
+
+namespace pw::framebuffer {
+namespace {
+
+constexpr color_rgb565_t kGuard = 0x1234;
+
+// Fill every (offset, count) combination within a guarded buffer to exercise
+// the unaligned head, the wide stores, and the tail.
+void CheckFill(color_rgb565_t pixel_value) {
+  constexpr size_t kBufferSize = 64;
+  alignas(16) color_rgb565_t buffer[kBufferSize];
+  for (size_t offset = 0; offset < 9; offset++) {
+    for (size_t count = 0; offset + count < kBufferSize; count++) {
+      for (auto& pixel : buffer) {
+        pixel = kGuard;
+      }
+      FillPixels(buffer + offset, count, pixel_value);
+      for (size_t i = 0; i < kBufferSize; i++) {
+        const bool filled = i >= offset && i < offset + count;
+        ASSERT_EQ(buffer[i], filled ? pixel_value : kGuard)
+            << "offset=" << offset << " count=" << count << " i=" << i;
+      }
+    }
+  }
+}
+
+TEST(FillPixels, Zero) { CheckFill(0x0000); }
+
+TEST(FillPixels, UniformBytes) { CheckFill(0xabab); }
+
+TEST(FillPixels, NonUniformBytes) { CheckFill(0xfd00); }
+
+// As CheckFill(), for |bits_per_pixel| palette indices.
+void CheckFillIndices(int bits_per_pixel) {
+  constexpr size_t kBufferPixels = 24;
+  constexpr uint8_t kIndex = 0x9;
+  constexpr uint8_t kGuardIndex = 0x6;
+  uint8_t buffer[kBufferPixels];
+  for (size_t offset = 0; offset < 4; offset++) {
+    for (size_t count = 0; offset + count < kBufferPixels; count++) {
+      for (size_t i = 0; i < kBufferPixels; i++) {
+        SetPixelIndex(buffer, bits_per_pixel, i, kGuardIndex);
+      }
+      FillPixelIndices(buffer, bits_per_pixel, offset, count, kIndex);
+      for (size_t i = 0; i < kBufferPixels; i++) {
+        const bool filled = i >= offset && i < offset + count;
+        ASSERT_EQ(GetPixelIndex(buffer, bits_per_pixel, i),
+                  filled ? kIndex : kGuardIndex)
+            << "offset=" << offset << " count=" << count << " i=" << i;
+      }
+    }
+  }
+}
+
+TEST(FillPixelIndices, FourBitsPerPixel) { CheckFillIndices(4); }
+
+TEST(FillPixelIndices, EightBitsPerPixel) { CheckFillIndices(8); }
+
+}  // namespace
+}  // namespace pw::framebuffer
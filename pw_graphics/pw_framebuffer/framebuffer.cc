@@ -19,11 +19,52 @@
 
 namespace pw::framebuffer {
 
+uint8_t BytesPerPixel(PixelFormat pixel_format) {
+  switch (pixel_format) {
+    case PixelFormat::RGB565:
+    case PixelFormat::RGB565ByteSwapped:
+      return sizeof(uint16_t);
+    case PixelFormat::RGB888:
+      return 3;
+    case PixelFormat::ARGB8888:
+      return sizeof(uint32_t);
+    case PixelFormat::I8:
+      return sizeof(uint8_t);
+    case PixelFormat::I4:
+    case PixelFormat::Mono1:
+    case PixelFormat::None:
+      break;
+  }
+  return 0;
+}
+
+uint8_t BitsPerPixel(PixelFormat pixel_format) {
+  switch (pixel_format) {
+    case PixelFormat::RGB565:
+    case PixelFormat::RGB565ByteSwapped:
+      return 16;
+    case PixelFormat::RGB888:
+      return 24;
+    case PixelFormat::ARGB8888:
+      return 32;
+    case PixelFormat::I8:
+      return 8;
+    case PixelFormat::I4:
+      return 4;
+    case PixelFormat::Mono1:
+      return 1;
+    case PixelFormat::None:
+      break;
+  }
+  return 0;
+}
+
 Framebuffer::Framebuffer()
     : pixel_data_(nullptr),
       pixel_format_(PixelFormat::None),
       size_{0, 0},
-      row_bytes_(0) {}
+      row_bytes_(0),
+      origin_{0, 0} {}
 
 Framebuffer::Framebuffer(void* data,
                          PixelFormat pixel_format,
@@ -32,16 +73,20 @@ Framebuffer::Framebuffer(void* data,
     : pixel_data_(data),
       pixel_format_(pixel_format),
       size_(size),
-      row_bytes_(row_bytes) {
+      row_bytes_(row_bytes),
+      origin_{0, 0} {
   PW_ASSERT(data != nullptr);
   PW_ASSERT(pixel_format != PixelFormat::None);
+  PW_ASSERT(row_bytes * 8 >= size.width * BitsPerPixel(pixel_format));
 }
 
 Framebuffer::Framebuffer(Framebuffer&& other)
     : pixel_data_(other.pixel_data_),
       pixel_format_(other.pixel_format_),
       size_(other.size_),
-      row_bytes_(other.row_bytes_) {
+      row_bytes_(other.row_bytes_),
+      origin_(other.origin_),
+      palette_(other.palette_) {
   other.pixel_data_ = nullptr;
   other.pixel_format_ = PixelFormat::None;
 }
@@ -51,9 +96,27 @@ Framebuffer& Framebuffer::operator=(Framebuffer&& rhs) {
   pixel_format_ = rhs.pixel_format_;
   size_ = rhs.size_;
   row_bytes_ = rhs.row_bytes_;
+  origin_ = rhs.origin_;
+  palette_ = rhs.palette_;
   rhs.pixel_data_ = nullptr;
   rhs.pixel_format_ = PixelFormat::None;
   return *this;
 }
 
+Framebuffer Framebuffer::SubView(const pw::math::Rect<uint16_t>& rect) const {
+  PW_ASSERT(is_valid());
+  const pw::math::Rect<uint16_t> bounds{0, 0, size_.width, size_.height};
+  const pw::math::Rect<uint16_t> region = bounds.Intersect(rect);
+  if (region.IsEmpty()) {
+    return Framebuffer();
+  }
+  const int x_bits = region.x * BitsPerPixel(pixel_format_);
+  PW_ASSERT(x_bits % 8 == 0);
+  std::byte* region_data =
+      static_cast<std::byte*>(pixel_data_) + region.y * row_bytes_ + x_bits / 8;
+  Framebuffer view(region_data, pixel_format_, region.size(), row_bytes_);
+  view.set_palette(palette_);
+  return view;
+}
+
 }  // namespace pw::framebuffer
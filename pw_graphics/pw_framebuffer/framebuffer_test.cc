@@ -62,5 +62,78 @@ TEST(Framebuffer, Init) {
   EXPECT_EQ(data, fb.data());
 }
 
+TEST(Framebuffer, SubView) {
+  constexpr pw::math::Size<uint16_t> kDimensions = {8, 6};
+  constexpr uint16_t kRowBytes = kDimensions.width * sizeof(color_rgb565_t);
+
+  color_rgb565_t data[kDimensions.width * kDimensions.height];
+  Framebuffer fb(data, PixelFormat::RGB565, kDimensions, kRowBytes);
+
+  Framebuffer view = fb.SubView({2, 3, 4, 2});
+  EXPECT_TRUE(view.is_valid());
+  EXPECT_EQ(4, view.size().width);
+  EXPECT_EQ(2, view.size().height);
+  EXPECT_EQ(kRowBytes, view.row_bytes());
+  EXPECT_EQ(PixelFormat::RGB565, view.pixel_format());
+  EXPECT_EQ(&data[3 * kDimensions.width + 2], view.data());
+
+  // Drawing into the view writes into the parent's pixel buffer.
+  {
+    FramebufferWriter writer(fb);
+    writer.Fill(0);
+  }
+  {
+    FramebufferWriter writer(view);
+    writer.Fill(0xffff);
+  }
+  for (int y = 0; y < kDimensions.height; y++) {
+    for (int x = 0; x < kDimensions.width; x++) {
+      const bool in_view = x >= 2 && x < 6 && y >= 3 && y < 5;
+      EXPECT_EQ(in_view ? 0xffff : 0, data[y * kDimensions.width + x]);
+    }
+  }
+}
+
+TEST(Framebuffer, SubViewClipped) {
+  constexpr pw::math::Size<uint16_t> kDimensions = {8, 6};
+  constexpr uint16_t kRowBytes = kDimensions.width * sizeof(color_rgb565_t);
+
+  color_rgb565_t data[kDimensions.width * kDimensions.height];
+  Framebuffer fb(data, PixelFormat::RGB565, kDimensions, kRowBytes);
+
+  Framebuffer view = fb.SubView({6, 4, 10, 10});
+  EXPECT_TRUE(view.is_valid());
+  EXPECT_EQ(2, view.size().width);
+  EXPECT_EQ(2, view.size().height);
+
+  view = fb.SubView({8, 0, 2, 2});
+  EXPECT_FALSE(view.is_valid());
+}
+
+TEST(Framebuffer, Indexed) {
+  EXPECT_EQ(16, BitsPerPixel(PixelFormat::RGB565));
+  EXPECT_EQ(8, BitsPerPixel(PixelFormat::I8));
+  EXPECT_EQ(4, BitsPerPixel(PixelFormat::I4));
+  EXPECT_FALSE(IsIndexed(PixelFormat::RGB565));
+  EXPECT_TRUE(IsIndexed(PixelFormat::I4));
+  EXPECT_TRUE(IsIndexed(PixelFormat::I8));
+
+  constexpr pw::math::Size<uint16_t> kDimensions = {7, 4};
+  constexpr uint16_t kRowBytes = 4;
+  constexpr color_rgb565_t kPalette[] = {0x0000, 0xffff};
+  uint8_t data[kRowBytes * kDimensions.height];
+  Framebuffer fb(data, PixelFormat::I4, kDimensions, kRowBytes);
+  EXPECT_TRUE(fb.palette().empty());
+  fb.set_palette(kPalette);
+  EXPECT_EQ(kPalette, fb.palette().data());
+
+  // Views and moved framebuffers keep the palette.
+  Framebuffer view = fb.SubView({2, 1, 4, 2});
+  EXPECT_EQ(&data[1 * kRowBytes + 1], view.data());
+  EXPECT_EQ(kPalette, view.palette().data());
+  Framebuffer moved(std::move(fb));
+  EXPECT_EQ(kPalette, moved.palette().data());
+}
+
 }  // namespace
 }  // namespace pw::framebuffer
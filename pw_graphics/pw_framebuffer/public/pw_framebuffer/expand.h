@@ -0,0 +1,63 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_color/color.h"
+#include "pw_span/span.h"
+
+namespace pw::framebuffer {
+
+// Convert |count| palette indices, starting with index |first_pixel| of
+// |indices|, to RGB565 colors from |palette| and write them to |dest|.
+//
+// |bits_per_pixel| must be 4 or 8. With 4 bits per pixel, indices are packed
+// two per byte with the first pixel in the high nibble. Every index must be
+// less than palette.size(); this is not checked.
+void ExpandIndexedPixels(const uint8_t* indices,
+                         int bits_per_pixel,
+                         size_t first_pixel,
+                         size_t count,
+                         span<const pw::color::color_rgb565_t> palette,
+                         pw::color::color_rgb565_t* dest);
+
+// Return palette index |pixel| of |indices|, packed as for
+// ExpandIndexedPixels().
+inline uint8_t GetPixelIndex(const uint8_t* indices,
+                             int bits_per_pixel,
+                             size_t pixel) {
+  if (bits_per_pixel == 8) {
+    return indices[pixel];
+  }
+  return (pixel & 1) ? indices[pixel / 2] & 0xf : indices[pixel / 2] >> 4;
+}
+
+// Set palette index |pixel| of |indices|, packed as for ExpandIndexedPixels(),
+// to |index|.
+inline void SetPixelIndex(uint8_t* indices,
+                          int bits_per_pixel,
+                          size_t pixel,
+                          uint8_t index) {
+  if (bits_per_pixel == 8) {
+    indices[pixel] = index;
+    return;
+  }
+  uint8_t& pair = indices[pixel / 2];
+  pair = (pixel & 1) ? (pair & 0xf0) | (index & 0xf)
+                     : (pair & 0x0f) | static_cast<uint8_t>(index << 4);
+}
+
+}  // namespace pw::framebuffer
@@ -0,0 +1,43 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "pw_color/color.h"
+
+namespace pw::framebuffer {
+
+// Set |count| consecutive pixels starting at |dest| to |pixel_value|.
+//
+// Colors whose high and low bytes match (including black and white) are
+// written with memset. All other colors are replicated into the widest store
+// available on the target: 128-bit SSE2/NEON stores on host, 32-bit word
+// stores elsewhere (e.g. Cortex-M), with scalar stores for the unaligned head
+// and the tail of the run.
+void FillPixels(pw::color::color_rgb565_t* dest,
+                size_t count,
+                pw::color::color_rgb565_t pixel_value);
+
+// Set |count| consecutive palette indices starting with pixel |first_pixel|
+// of |indices| to |index|. |bits_per_pixel| must be 4 or 8, and indices are
+// packed as for ExpandIndexedPixels(). Whole bytes are written with memset.
+void FillPixelIndices(uint8_t* indices,
+                      int bits_per_pixel,
+                      size_t first_pixel,
+                      size_t count,
+                      uint8_t index);
+
+}  // namespace pw::framebuffer
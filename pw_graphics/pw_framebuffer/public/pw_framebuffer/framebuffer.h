@@ -15,17 +15,57 @@
 
 #include <cstdint>
 
+#include "pw_color/color.h"
+#include "pw_math/rect.h"
 #include "pw_math/size.h"
+#include "pw_math/vector2.h"
+#include "pw_span/span.h"
 
 namespace pw::framebuffer {
 
+// The layout of the pixels of a framebuffer. See pixel_format_traits.h for
+// the details of each format.
 enum class PixelFormat {
   None,
   RGB565,
+  // RGB565 stored most significant byte first.
+  RGB565ByteSwapped,
+  // Red, green and blue bytes.
+  RGB888,
+  // 0xAARRGGBB native endian 32 bit words.
+  ARGB8888,
+  // One bit per pixel, leftmost pixel in the most significant bit.
+  Mono1,
+  // 4 bit indices into the framebuffer's palette, two pixels per byte with the
+  // leftmost pixel in the high nibble.
+  I4,
+  // 8 bit indices into the framebuffer's palette.
+  I8,
 };
 
+// Return the number of bytes used to store a single pixel of |pixel_format|,
+// or 0 for formats with less than one byte per pixel.
+uint8_t BytesPerPixel(PixelFormat pixel_format);
+
+// Return the number of bits used to store a single pixel of |pixel_format|.
+uint8_t BitsPerPixel(PixelFormat pixel_format);
+
+// Return true if pixels of |pixel_format| are palette indices.
+inline bool IsIndexed(PixelFormat pixel_format) {
+  return pixel_format == PixelFormat::I4 || pixel_format == PixelFormat::I8;
+}
+
 // A Framebuffer refers to a buffer of pixel data and the various attributes
 // of that pixel data (such as dimensions, rowbytes, etc.).
+//
+// Rows of pixels are |row_bytes| apart, which may be larger than the number of
+// bytes needed to store |size.width| pixels (i.e. rows may be padded).
+//
+// A framebuffer may cover only part of the display, such as one band of a
+// display which is drawn a band at a time. Its origin() is the display
+// position of its upper left pixel, and FramebufferReader and
+// FramebufferWriter (and so all of pw_draw) take display coordinates, so the
+// same drawing code works whichever part of the display is covered.
 class Framebuffer {
  public:
   // Construct a default invalid framebuffer.
@@ -60,11 +100,40 @@ class Framebuffer {
   // Return the number of bytes per row of pixel data.
   uint16_t row_bytes() const { return row_bytes_; }
 
+  // Return the display position of the upper left pixel. This is (0, 0) for
+  // framebuffers which cover the whole display.
+  pw::math::Vector2<uint16_t> origin() const { return origin_; }
+  void set_origin(pw::math::Vector2<uint16_t> origin) { origin_ = origin; }
+
+  // Return the area of the display covered by this framebuffer.
+  pw::math::Rect<uint16_t> bounds() const {
+    return {origin_.x, origin_.y, size_.width, size_.height};
+  }
+
+  // Return the colors of the palette indices stored by indexed pixel formats.
+  // The palette is not owned by the framebuffer, and may be changed between
+  // frames to recolor the whole framebuffer without redrawing it.
+  span<const pw::color::color_rgb565_t> palette() const { return palette_; }
+  void set_palette(span<const pw::color::color_rgb565_t> palette) {
+    palette_ = palette;
+  }
+
+  // Return a framebuffer which refers to the |rect| region of this
+  // framebuffer's pixel data. No pixels are copied: the returned framebuffer
+  // shares this framebuffer's pixel buffer and row bytes, and must not outlive
+  // it. |rect| is in pixels of this framebuffer (ignoring its origin) and is
+  // clipped to its size, and an invalid framebuffer is returned if the clipped
+  // region is empty. The left edge of the clipped region must be on a byte
+  // boundary. The view's origin is (0, 0).
+  Framebuffer SubView(const pw::math::Rect<uint16_t>& rect) const;
+
  private:
   void* pixel_data_;               // The pixel buffer.
   PixelFormat pixel_format_;       // The pixel format.
   pw::math::Size<uint16_t> size_;  // width/height (in pixels) of |pixel_data_|.
   uint16_t row_bytes_;             // The number of bytes in each row.
+  pw::math::Vector2<uint16_t> origin_;  // Display position of pixel (0, 0).
+  span<const pw::color::color_rgb565_t> palette_;  // For indexed formats.
 };
 
 }  // namespace pw::framebuffer
@@ -0,0 +1,262 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "pw_color/color.h"
+#include "pw_framebuffer/expand.h"
+#include "pw_framebuffer/fill.h"
+#include "pw_framebuffer/framebuffer.h"
+
+namespace pw::framebuffer {
+
+// A pixel format traits type describes how the pixels of one PixelFormat are
+// stored, so that TypedFramebufferReader and TypedFramebufferWriter can access
+// them with no runtime format checks. Each traits type provides:
+//
+//   kFormat          The PixelFormat described.
+//   kBitsPerPixel    The number of bits used by each pixel.
+//   Pixel            The type of a single stored pixel.
+//   FromValue(v)     Convert a pixel value as used by FramebufferWriter (an
+//                    RGB565 color, or a palette index for indexed formats) to
+//                    a Pixel.
+//   ToValue(p)       Convert a Pixel back to a FramebufferWriter pixel value.
+//   Get(row, x)      Return pixel |x| of the row of pixels at |row|.
+//   Set(row, x, p)   Set pixel |x| of the row at |row| to |p|.
+//   Fill(row, x, n, p)
+//                    Set the |n| pixels of the row at |row| starting at pixel
+//                    |x| to |p|.
+
+namespace internal {
+
+// Get, Set and Fill for formats whose pixels are a whole number of bytes.
+template <typename PixelType>
+struct WholeBytePixels {
+  using Pixel = PixelType;
+  static constexpr int kBitsPerPixel = sizeof(Pixel) * 8;
+
+  static Pixel Get(const uint8_t* row, size_t x) {
+    Pixel pixel;
+    std::memcpy(&pixel, row + x * sizeof(Pixel), sizeof(Pixel));
+    return pixel;
+  }
+  static void Set(uint8_t* row, size_t x, Pixel pixel) {
+    std::memcpy(row + x * sizeof(Pixel), &pixel, sizeof(Pixel));
+  }
+  static void Fill(uint8_t* row, size_t x, size_t count, Pixel pixel) {
+    for (size_t i = 0; i < count; i++) {
+      Set(row, x + i, pixel);
+    }
+  }
+};
+
+// Expand RGB565 channels to 8 bits by replicating their high bits, so that
+// black and white stay exact.
+constexpr uint8_t Red8(pw::color::color_rgb565_t color) {
+  const uint8_t red = color >> 11;
+  return static_cast<uint8_t>((red << 3) | (red >> 2));
+}
+constexpr uint8_t Green8(pw::color::color_rgb565_t color) {
+  const uint8_t green = (color >> 5) & 0x3f;
+  return static_cast<uint8_t>((green << 2) | (green >> 4));
+}
+constexpr uint8_t Blue8(pw::color::color_rgb565_t color) {
+  const uint8_t blue = color & 0x1f;
+  return static_cast<uint8_t>((blue << 3) | (blue >> 2));
+}
+
+constexpr pw::color::color_rgb565_t Rgb565(uint8_t red,
+                                           uint8_t green,
+                                           uint8_t blue) {
+  return static_cast<pw::color::color_rgb565_t>(
+      ((red & 0xf8) << 8) | ((green & 0xfc) << 3) | (blue >> 3));
+}
+
+}  // namespace internal
+
+struct Rgb565Traits : internal::WholeBytePixels<pw::color::color_rgb565_t> {
+  static constexpr PixelFormat kFormat = PixelFormat::RGB565;
+
+  static constexpr Pixel FromValue(pw::color::color_rgb565_t value) {
+    return value;
+  }
+  static constexpr pw::color::color_rgb565_t ToValue(Pixel pixel) {
+    return pixel;
+  }
+  static void Fill(uint8_t* row, size_t x, size_t count, Pixel pixel) {
+    FillPixels(reinterpret_cast<Pixel*>(row) + x, count, pixel);
+  }
+};
+
+// RGB565 stored most significant byte first, as sent to most SPI panels.
+struct Rgb565ByteSwappedTraits
+    : internal::WholeBytePixels<pw::color::color_rgb565_t> {
+  static constexpr PixelFormat kFormat = PixelFormat::RGB565ByteSwapped;
+
+  static constexpr Pixel FromValue(pw::color::color_rgb565_t value) {
+    return static_cast<Pixel>((value << 8) | (value >> 8));
+  }
+  static constexpr pw::color::color_rgb565_t ToValue(Pixel pixel) {
+    return FromValue(pixel);
+  }
+  static void Fill(uint8_t* row, size_t x, size_t count, Pixel pixel) {
+    FillPixels(reinterpret_cast<Pixel*>(row) + x, count, pixel);
+  }
+};
+
+// A pixel stored as red, green and blue bytes, in that order.
+struct Rgb888Pixel {
+  uint8_t r;
+  uint8_t g;
+  uint8_t b;
+
+  bool operator==(const Rgb888Pixel& other) const {
+    return r == other.r && g == other.g && b == other.b;
+  }
+  bool operator!=(const Rgb888Pixel& other) const { return !(*this == other); }
+};
+static_assert(sizeof(Rgb888Pixel) == 3);
+
+struct Rgb888Traits : internal::WholeBytePixels<Rgb888Pixel> {
+  static constexpr PixelFormat kFormat = PixelFormat::RGB888;
+
+  static constexpr Pixel FromValue(pw::color::color_rgb565_t value) {
+    return {internal::Red8(value), internal::Green8(value),
+            internal::Blue8(value)};
+  }
+  static constexpr pw::color::color_rgb565_t ToValue(Pixel pixel) {
+    return internal::Rgb565(pixel.r, pixel.g, pixel.b);
+  }
+};
+
+// 0xAARRGGBB in a native endian 32 bit word.
+struct Argb8888Traits : internal::WholeBytePixels<uint32_t> {
+  static constexpr PixelFormat kFormat = PixelFormat::ARGB8888;
+
+  static constexpr Pixel FromValue(pw::color::color_rgb565_t value) {
+    return 0xff000000u | (uint32_t{internal::Red8(value)} << 16) |
+           (uint32_t{internal::Green8(value)} << 8) | internal::Blue8(value);
+  }
+  static constexpr pw::color::color_rgb565_t ToValue(Pixel pixel) {
+    return internal::Rgb565(static_cast<uint8_t>(pixel >> 16),
+                            static_cast<uint8_t>(pixel >> 8),
+                            static_cast<uint8_t>(pixel));
+  }
+};
+
+struct I8Traits : internal::WholeBytePixels<uint8_t> {
+  static constexpr PixelFormat kFormat = PixelFormat::I8;
+
+  static constexpr Pixel FromValue(pw::color::color_rgb565_t value) {
+    return static_cast<Pixel>(value);
+  }
+  static constexpr pw::color::color_rgb565_t ToValue(Pixel pixel) {
+    return pixel;
+  }
+  static void Fill(uint8_t* row, size_t x, size_t count, Pixel pixel) {
+    FillPixelIndices(row, 8, x, count, pixel);
+  }
+};
+
+struct I4Traits {
+  using Pixel = uint8_t;
+  static constexpr PixelFormat kFormat = PixelFormat::I4;
+  static constexpr int kBitsPerPixel = 4;
+
+  static constexpr Pixel FromValue(pw::color::color_rgb565_t value) {
+    return value & 0xf;
+  }
+  static constexpr pw::color::color_rgb565_t ToValue(Pixel pixel) {
+    return pixel;
+  }
+  static Pixel Get(const uint8_t* row, size_t x) {
+    return GetPixelIndex(row, 4, x);
+  }
+  static void Set(uint8_t* row, size_t x, Pixel pixel) {
+    SetPixelIndex(row, 4, x, pixel);
+  }
+  static void Fill(uint8_t* row, size_t x, size_t count, Pixel pixel) {
+    FillPixelIndices(row, 4, x, count, pixel);
+  }
+};
+
+// One bit per pixel, leftmost pixel in the most significant bit. Pixel values
+// are lit (1) when their luma is at least half of full scale.
+struct Mono1Traits {
+  using Pixel = uint8_t;
+  static constexpr PixelFormat kFormat = PixelFormat::Mono1;
+  static constexpr int kBitsPerPixel = 1;
+
+  static constexpr Pixel FromValue(pw::color::color_rgb565_t value) {
+    const int luma = 2 * internal::Red8(value) + 5 * internal::Green8(value) +
+                     internal::Blue8(value);
+    return luma >= 8 * 128 ? 1 : 0;
+  }
+  static constexpr pw::color::color_rgb565_t ToValue(Pixel pixel) {
+    return pixel ? 0xffff : 0x0000;
+  }
+  static Pixel Get(const uint8_t* row, size_t x) {
+    return (row[x / 8] >> (7 - x % 8)) & 1;
+  }
+  static void Set(uint8_t* row, size_t x, Pixel pixel) {
+    const uint8_t mask = 0x80 >> (x % 8);
+    row[x / 8] = pixel ? row[x / 8] | mask : row[x / 8] & ~mask;
+  }
+  static void Fill(uint8_t* row, size_t x, size_t count, Pixel pixel) {
+    for (; count > 0 && x % 8 != 0; count--) {
+      Set(row, x++, pixel);
+    }
+    std::memset(row + x / 8, pixel ? 0xff : 0x00, count / 8);
+    x += count / 8 * 8;
+    for (count %= 8; count > 0; count--) {
+      Set(row, x++, pixel);
+    }
+  }
+};
+
+// Call |function| with a default constructed traits object for
+// |pixel_format|. Nothing is called for PixelFormat::None.
+template <typename Function>
+void VisitPixelFormat(PixelFormat pixel_format, Function&& function) {
+  switch (pixel_format) {
+    case PixelFormat::RGB565:
+      function(Rgb565Traits{});
+      break;
+    case PixelFormat::RGB565ByteSwapped:
+      function(Rgb565ByteSwappedTraits{});
+      break;
+    case PixelFormat::RGB888:
+      function(Rgb888Traits{});
+      break;
+    case PixelFormat::ARGB8888:
+      function(Argb8888Traits{});
+      break;
+    case PixelFormat::I4:
+      function(I4Traits{});
+      break;
+    case PixelFormat::I8:
+      function(I8Traits{});
+      break;
+    case PixelFormat::Mono1:
+      function(Mono1Traits{});
+      break;
+    case PixelFormat::None:
+      break;
+  }
+}
+
+}  // namespace pw::framebuffer
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <cstdint>
+#include <limits>
 
 #include "pw_color/color.h"
 #include "pw_framebuffer/framebuffer.h"
@@ -31,11 +32,27 @@ class FramebufferReader {
  public:
   FramebufferReader(const Framebuffer& framebuffer);
 
-  // Return the pixel value at position (x, y). Bounds are checked.
+  // Return the pixel value at display position (x, y). Bounds are checked.
+  // Pixels are converted to RGB565 colors, except for indexed pixel formats
+  // where this is the palette index.
   Result<pw::color::color_rgb565_t> GetPixel(uint16_t x, uint16_t y) const;
 
  protected:
+  // Convert display coordinates to framebuffer pixel coordinates, by
+  // subtracting the framebuffer's origin. Coordinates so far left or above the
+  // framebuffer that they would overflow are clamped.
+  int LocalX(int x) const { return ToLocal(x, framebuffer_.origin().x); }
+  int LocalY(int y) const { return ToLocal(y, framebuffer_.origin().y); }
+
   const Framebuffer& framebuffer_;
+
+ private:
+  static int ToLocal(int value, uint16_t origin) {
+    if (value < std::numeric_limits<int>::min() + origin) {
+      return std::numeric_limits<int>::min();
+    }
+    return value - origin;
+  }
 };
 
 }  // namespace pw::framebuffer
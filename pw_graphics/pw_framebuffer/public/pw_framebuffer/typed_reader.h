@@ -0,0 +1,59 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <cstdint>
+
+#include "pw_assert/assert.h"
+#include "pw_framebuffer/framebuffer.h"
+#include "pw_framebuffer/pixel_format_traits.h"
+#include "pw_result/result.h"
+
+namespace pw::framebuffer {
+
+// Reads pixels from a framebuffer whose pixel format is known at compile time,
+// described by a pixel format traits type such as Rgb565Traits. Use
+// FramebufferReader when the format is only known at runtime.
+template <typename Traits>
+class TypedFramebufferReader {
+ public:
+  using Pixel = typename Traits::Pixel;
+
+  // |framebuffer| must have the pixel format Traits::kFormat.
+  explicit TypedFramebufferReader(const Framebuffer& framebuffer)
+      : data_(static_cast<uint8_t*>(framebuffer.data())),
+        width_(framebuffer.size().width),
+        height_(framebuffer.size().height),
+        row_bytes_(framebuffer.row_bytes()) {
+    PW_ASSERT(framebuffer.pixel_format() == Traits::kFormat);
+  }
+
+  // Return the pixel at position (x, y). Bounds are checked.
+  Result<Pixel> GetPixel(int x, int y) const {
+    if (x < 0 || x >= width_ || y < 0 || y >= height_) {
+      return Status::OutOfRange();
+    }
+    return Traits::Get(Row(y), x);
+  }
+
+ protected:
+  uint8_t* Row(int y) const { return data_ + y * row_bytes_; }
+
+  uint8_t* const data_;
+  const int width_;
+  const int height_;
+  const int row_bytes_;
+};
+
+}  // namespace pw::framebuffer
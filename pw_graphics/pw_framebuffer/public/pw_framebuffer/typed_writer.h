@@ -0,0 +1,219 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "pw_assert/assert.h"
+#include "pw_framebuffer/framebuffer.h"
+#include "pw_framebuffer/pixel_format_traits.h"
+#include "pw_framebuffer/typed_reader.h"
+#include "pw_math/rect.h"
+#include "pw_span/span.h"
+
+namespace pw::framebuffer {
+
+// Writes pixels to a framebuffer whose pixel format is known at compile time,
+// described by a pixel format traits type such as Rgb565Traits. Every access
+// is resolved at compile time, with no per-pixel or per-call format checks.
+//
+// FramebufferWriter provides the same operations for formats only known at
+// runtime, selecting a TypedFramebufferWriter once per call.
+template <typename Traits>
+class TypedFramebufferWriter : public TypedFramebufferReader<Traits> {
+ public:
+  using Pixel = typename Traits::Pixel;
+
+  // |framebuffer| must have the pixel format Traits::kFormat.
+  explicit TypedFramebufferWriter(Framebuffer& framebuffer)
+      : TypedFramebufferReader<Traits>(framebuffer) {}
+
+  // Set the pixel at (x, y), if within the framebuffer bounds.
+  void SetPixel(int x, int y, Pixel pixel) {
+    if (x < 0 || x >= width_ || y < 0 || y >= height_) {
+      return;
+    }
+    Traits::Set(Row(y), x, pixel);
+  }
+
+  // Set the pixels in row |y| from column |x0| through |x1| (inclusive),
+  // clipped to the framebuffer bounds.
+  void FillSpan(int y, int x0, int x1, Pixel pixel) {
+    if (y < 0 || y >= height_) {
+      return;
+    }
+    x0 = std::max(x0, 0);
+    x1 = std::min(x1, width_ - 1);
+    if (x0 > x1) {
+      return;
+    }
+    if (x0 == x1) {
+      Traits::Set(Row(y), x0, pixel);
+      return;
+    }
+    Traits::Fill(Row(y), x0, x1 - x0 + 1, pixel);
+  }
+
+  // Copy |pixels| into row |y| starting at column |x|. Pixels falling outside
+  // of the framebuffer bounds are skipped.
+  void CopySpan(int x, int y, span<const Pixel> pixels) {
+    if constexpr (Traits::kBitsPerPixel % 8 == 0) {
+      if (y < 0 || y >= height_) {
+        return;
+      }
+      const int first = std::max(-x, 0);
+      const int last = std::min(static_cast<int>(pixels.size()), width_ - x);
+      if (first < last) {
+        std::memcpy(Row(y) + (x + first) * sizeof(Pixel),
+                    pixels.data() + first,
+                    (last - first) * sizeof(Pixel));
+      }
+    } else {
+      CopySpan(x, y, pixels, [](Pixel pixel) { return pixel; });
+    }
+  }
+
+  // Same as above, converting each of |values| to a Pixel with |convert|.
+  template <typename Value, typename Convert>
+  void CopySpan(int x, int y, span<const Value> values, Convert convert) {
+    if (y < 0 || y >= height_) {
+      return;
+    }
+    const int first = std::max(-x, 0);
+    const int last = std::min(static_cast<int>(values.size()), width_ - x);
+    uint8_t* row = Row(y);
+    for (int i = first; i < last; i++) {
+      Traits::Set(row, x + i, convert(values[i]));
+    }
+  }
+
+  // Set all pixels in the |width| x |height| rectangle whose upper left corner
+  // is at (x, y), clipped to the framebuffer bounds. Any position and size may
+  // be given without overflowing.
+  void FillRect(int x, int y, int width, int height, Pixel pixel) {
+    const int x0 = std::max(x, 0);
+    const int y0 = std::max(y, 0);
+    const int x1 = static_cast<int>(
+        std::clamp(int64_t{x} + width, int64_t{0}, int64_t{width_}));
+    const int y1 = static_cast<int>(
+        std::clamp(int64_t{y} + height, int64_t{0}, int64_t{height_}));
+    if (x0 >= x1 || y0 >= y1) {
+      return;
+    }
+    // Full-width rectangles in a framebuffer without row padding are a single
+    // contiguous run of pixels.
+    if (x0 == 0 && x1 == width_ &&
+        row_bytes_ * 8 == width_ * Traits::kBitsPerPixel) {
+      Traits::Fill(Row(y0), 0, static_cast<size_t>(x1) * (y1 - y0), pixel);
+      return;
+    }
+    for (int row = y0; row < y1; row++) {
+      Traits::Fill(Row(row), x0, x1 - x0, pixel);
+    }
+  }
+
+  // Set every pixel of the framebuffer.
+  void Fill(Pixel pixel) { FillRect(0, 0, width_, height_, pixel); }
+
+  // Copy |fb|, which must have the same pixel format, with its upper left
+  // corner at (x, y), clipped to the bounds of this framebuffer.
+  void Blit(const Framebuffer& fb, int x, int y) {
+    const BlitRegion region = ClipBlit(fb, x, y);
+    for (int row = 0; row < region.dst.height; row++) {
+      CopyPixels(Row(region.dst.y + row),
+                 region.dst.x,
+                 SourceRow(fb, region.src_y + row),
+                 region.src_x,
+                 region.dst.width);
+    }
+  }
+
+  // Same as Blit(), but source pixels equal to |transparent| are skipped,
+  // leaving the destination pixel unchanged.
+  void BlitColorKey(const Framebuffer& fb, int x, int y, Pixel transparent) {
+    const BlitRegion region = ClipBlit(fb, x, y);
+    for (int row = 0; row < region.dst.height; row++) {
+      const uint8_t* src = SourceRow(fb, region.src_y + row);
+      uint8_t* dst = Row(region.dst.y + row);
+      // Copy each run of opaque pixels in one go.
+      int col = 0;
+      while (col < region.dst.width) {
+        while (col < region.dst.width &&
+               Traits::Get(src, region.src_x + col) == transparent) {
+          col++;
+        }
+        const int run_start = col;
+        while (col < region.dst.width &&
+               Traits::Get(src, region.src_x + col) != transparent) {
+          col++;
+        }
+        CopyPixels(dst,
+                   region.dst.x + run_start,
+                   src,
+                   region.src_x + run_start,
+                   col - run_start);
+      }
+    }
+  }
+
+ private:
+  using TypedFramebufferReader<Traits>::Row;
+  using TypedFramebufferReader<Traits>::width_;
+  using TypedFramebufferReader<Traits>::height_;
+  using TypedFramebufferReader<Traits>::row_bytes_;
+
+  struct BlitRegion {
+    // Destination rectangle, in destination framebuffer coordinates.
+    pw::math::Rect<int> dst;
+    // Source coordinates of the upper left pixel of |dst|.
+    int src_x;
+    int src_y;
+  };
+
+  BlitRegion ClipBlit(const Framebuffer& src, int x, int y) const {
+    PW_ASSERT(src.pixel_format() == Traits::kFormat);
+    const pw::math::Rect<int> placed{
+        x, y, src.size().width, src.size().height};
+    const pw::math::Rect<int> dst_region =
+        placed.Intersect({0, 0, width_, height_});
+    if (dst_region.IsEmpty()) {
+      return BlitRegion{{0, 0, 0, 0}, 0, 0};
+    }
+    return BlitRegion{dst_region, dst_region.x - x, dst_region.y - y};
+  }
+
+  static const uint8_t* SourceRow(const Framebuffer& fb, int y) {
+    return static_cast<const uint8_t*>(fb.data()) + y * fb.row_bytes();
+  }
+
+  // Copy |count| pixels from pixel |src_x| of |src| to pixel |dst_x| of |dst|.
+  static void CopyPixels(
+      uint8_t* dst, int dst_x, const uint8_t* src, int src_x, int count) {
+    if constexpr (Traits::kBitsPerPixel % 8 == 0) {
+      constexpr int kBytesPerPixel = Traits::kBitsPerPixel / 8;
+      std::memcpy(dst + dst_x * kBytesPerPixel,
+                  src + src_x * kBytesPerPixel,
+                  count * kBytesPerPixel);
+    } else {
+      for (int i = 0; i < count; i++) {
+        Traits::Set(dst, dst_x + i, Traits::Get(src, src_x + i));
+      }
+    }
+  }
+};
+
+}  // namespace pw::framebuffer
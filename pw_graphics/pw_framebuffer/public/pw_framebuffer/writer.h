@@ -18,15 +18,30 @@
 #include "pw_color/color.h"
 #include "pw_framebuffer/framebuffer.h"
 #include "pw_framebuffer/reader.h"
+#include "pw_span/span.h"
 
 namespace pw::framebuffer {
 
 // An interface to Framebuffer to simplify writing (and reading) pixel values
 // from a framebuffer.
 //
-// Note: This implementation is not designed for performance, and is intended
-// to be used for development (testing) and other cases where drawing
-// performance is not important.
+// Note: SetPixel() is not designed for performance, and is intended to be
+// used for development (testing) and other cases where drawing performance is
+// not important. Drawing code should prefer the span/rectangle functions which
+// clip once per run rather than once per pixel.
+//
+// Pixel values are RGB565 colors, which are converted to the framebuffer's
+// pixel format as described by its traits in pixel_format_traits.h. In
+// framebuffers with an indexed pixel format (I4 or I8), pixel values are
+// palette indices rather than colors, and only their low 4 or 8 bits are used.
+//
+// Coordinates are display coordinates, which are offset by the framebuffer's
+// origin() before clipping to the framebuffer.
+//
+// The pixel format is checked once per call, which then runs the matching
+// TypedFramebufferWriter. Code which writes many pixels or spans should check
+// it once instead, with VisitPixelFormat(), and use a TypedFramebufferWriter
+// directly.
 class FramebufferWriter : public FramebufferReader {
  public:
   FramebufferWriter(Framebuffer& framebuffer);
@@ -35,12 +50,49 @@ class FramebufferWriter : public FramebufferReader {
   // specified pixel value.
   void SetPixel(uint16_t x, uint16_t y, pw::color::color_rgb565_t pixel_value);
 
-  // Copy the pixels from another framebuffer into the one managed by this
-  // writer at position (x, y).
-  void Blit(const Framebuffer& fb, uint16_t x, uint16_t y);
+  // Set the pixels in row |y| from column |x0| through |x1| (inclusive) to the
+  // specified pixel value. The span is clipped to the framebuffer bounds once,
+  // and then written as a single contiguous run.
+  void FillSpan(int y, int x0, int x1, pw::color::color_rgb565_t pixel_value);
+
+  // Copy |pixels| into row |y| starting at column |x|. Pixels falling outside
+  // of the framebuffer bounds are skipped.
+  void CopySpan(int x, int y, span<const pw::color::color_rgb565_t> pixels);
+
+  // Set all pixels in the |width| x |height| rectangle whose upper left corner
+  // is at (x, y) to the specified pixel value. The rectangle is clipped to the
+  // framebuffer bounds.
+  void FillRect(int x,
+                int y,
+                int width,
+                int height,
+                pw::color::color_rgb565_t pixel_value);
+
+  // Copy the contents of the source framebuffer into the framebuffer of this
+  // writer with the upper left corner of |fb| at position (x, y). The source
+  // is clipped to the bounds of this framebuffer and copied one row at a time.
+  // Both framebuffers must have the same pixel format.
+  void Blit(const Framebuffer& fb, int x, int y);
+
+  // Same as Blit(), but source pixels equal to |transparent_color| are
+  // skipped, leaving the destination pixel unchanged. This matches the
+  // SpriteSheet::transparent_color convention used by pw_draw.
+  void BlitColorKey(const Framebuffer& fb,
+                    int x,
+                    int y,
+                    pw::color::color_rgb565_t transparent_color);
+
+  // Same as Blit(), but blends each source pixel over the destination with a
+  // constant |alpha| where 0 leaves the destination unchanged and 255 is a
+  // plain copy. Blending is done in RGB565 with 5 bits of alpha precision, and
+  // both framebuffers must be RGB565.
+  void BlitAlpha(const Framebuffer& fb, int x, int y, uint8_t alpha);
 
   // Fill the entire framebuffer with the specified pixel value.
   void Fill(pw::color::color_rgb565_t pixel_value);
+
+ private:
+  Framebuffer& writable_framebuffer_;
 };
 
 }  // namespace pw::framebuffer
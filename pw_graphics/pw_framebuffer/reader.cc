@@ -11,8 +11,11 @@
 // WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
 // License for the specific language governing permissions and limitations under
 // the License.
-#include "public/pw_framebuffer/writer.h"
+#include "public/pw_framebuffer/reader.h"
+
 #include "pw_assert/assert.h"
+#include "pw_framebuffer/pixel_format_traits.h"
+#include "pw_framebuffer/typed_reader.h"
 
 using pw::color::color_rgb565_t;
 
@@ -20,18 +23,28 @@ namespace pw::framebuffer {
 
 FramebufferReader::FramebufferReader(const Framebuffer& framebuffer)
     : framebuffer_(framebuffer) {
-  PW_ASSERT(framebuffer_.pixel_format() == PixelFormat::RGB565);
   PW_ASSERT(framebuffer_.is_valid());
 }
 
 Result<color_rgb565_t> FramebufferReader::GetPixel(uint16_t x,
                                                    uint16_t y) const {
-  if (x >= framebuffer_.size().width || y >= framebuffer_.size().height) {
-    return Status::OutOfRange();
+  Result<color_rgb565_t> result = Status::OutOfRange();
+  const int local_x = LocalX(x);
+  const int local_y = LocalY(y);
+  // Skip the format switch for the common case, as this is called per pixel.
+  if (framebuffer_.pixel_format() == PixelFormat::RGB565) {
+    return TypedFramebufferReader<Rgb565Traits>(framebuffer_)
+        .GetPixel(local_x, local_y);
   }
-  const color_rgb565_t* data =
-      static_cast<const color_rgb565_t*>(framebuffer_.data());
-  return data[y * framebuffer_.size().width + x];
+  VisitPixelFormat(framebuffer_.pixel_format(), [&](auto traits) {
+    using Traits = decltype(traits);
+    const auto pixel = TypedFramebufferReader<Traits>(framebuffer_)
+                           .GetPixel(local_x, local_y);
+    if (pixel.ok()) {
+      result = Traits::ToValue(pixel.value());
+    }
+  });
+  return result;
 }
 
 }  // namespace pw::framebuffer
@@ -0,0 +1,180 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#include "pw_framebuffer/typed_writer.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "pw_color/color.h"
+#include "pw_framebuffer/framebuffer.h"
+#include "pw_framebuffer/pixel_format_traits.h"
+#include "pw_framebuffer/reader.h"
+#include "pw_framebuffer/writer.h"
+
+using pw::color::color_rgb565_t;
+
+namespace pw::framebuffer {
+namespace {
+
+TEST(PixelFormatTraits, ColorRoundTrip) {
+  for (uint32_t value = 0; value <= 0xffff; value++) {
+    const color_rgb565_t color = static_cast<color_rgb565_t>(value);
+    ASSERT_EQ(Rgb888Traits::ToValue(Rgb888Traits::FromValue(color)), color);
+    ASSERT_EQ(Argb8888Traits::ToValue(Argb8888Traits::FromValue(color)),
+              color);
+    ASSERT_EQ(Rgb565ByteSwappedTraits::ToValue(
+                  Rgb565ByteSwappedTraits::FromValue(color)),
+              color);
+  }
+  EXPECT_EQ(Argb8888Traits::FromValue(0xffff), 0xffffffffu);
+  EXPECT_EQ(Argb8888Traits::FromValue(0x07e0), 0xff00ff00u);
+  EXPECT_EQ(Mono1Traits::FromValue(0xffff), 1);
+  EXPECT_EQ(Mono1Traits::FromValue(0x07e0), 1);
+  EXPECT_EQ(Mono1Traits::FromValue(0x001f), 0);
+  EXPECT_EQ(Mono1Traits::FromValue(0x0000), 0);
+}
+
+TEST(TypedFramebufferWriter, Rgb888) {
+  uint8_t data[3 * 3 * 2];
+  Framebuffer fb(data, PixelFormat::RGB888, {3, 2}, 3 * 3);
+  TypedFramebufferWriter<Rgb888Traits> writer(fb);
+  writer.Fill({1, 2, 3});
+  writer.FillSpan(1, 1, 5, {4, 5, 6});
+  const Rgb888Pixel kPixels[] = {{7, 8, 9}, {10, 11, 12}};
+  writer.CopySpan(-1, 0, kPixels);
+
+  const uint8_t kExpected[] = {
+      10, 11, 12, 1, 2, 3, 1, 2, 3,  //
+      1,  2,  3,  4, 5, 6, 4, 5, 6,  //
+  };
+  EXPECT_EQ(std::memcmp(data, kExpected, sizeof(data)), 0);
+  EXPECT_EQ(writer.GetPixel(2, 1).value(), (Rgb888Pixel{4, 5, 6}));
+  EXPECT_FALSE(writer.GetPixel(3, 1).ok());
+}
+
+TEST(TypedFramebufferWriter, BlitColorKey) {
+  uint32_t data[4 * 2];
+  Framebuffer fb(data, PixelFormat::ARGB8888, {4, 2}, 4 * sizeof(data[0]));
+  TypedFramebufferWriter<Argb8888Traits> writer(fb);
+  writer.Fill(0xff000000);
+
+  constexpr uint32_t kKey = 0x00ff00ff;
+  uint32_t sprite_data[2 * 2] = {0xff111111, kKey, kKey, 0xff222222};
+  Framebuffer sprite(
+      sprite_data, PixelFormat::ARGB8888, {2, 2}, 2 * sizeof(sprite_data[0]));
+  writer.BlitColorKey(sprite, 3, 0, kKey);
+  writer.Blit(sprite, 0, 1);
+
+  EXPECT_EQ(data[3], 0xff111111);
+  EXPECT_EQ(data[7], 0xff000000);
+  // Blit() copies key-colored pixels.
+  EXPECT_EQ(data[4], 0xff111111);
+  EXPECT_EQ(data[5], kKey);
+}
+
+TEST(TypedFramebufferWriter, FillRectExtremeSizes) {
+  constexpr int kMax = std::numeric_limits<int>::max();
+  constexpr int kMin = std::numeric_limits<int>::min();
+  color_rgb565_t data[4 * 3] = {};
+  Framebuffer fb(data, PixelFormat::RGB565, {4, 3}, 4 * sizeof(data[0]));
+  TypedFramebufferWriter<Rgb565Traits> writer(fb);
+
+  // Far edges beyond INT_MAX are clipped rather than wrapping around.
+  writer.FillRect(2, 1, kMax, kMax, 0x1111);
+  // Far edges that would overflow below INT_MIN are empty.
+  writer.FillRect(kMin, kMin, -1, -1, 0x2222);
+  writer.FillRect(kMin, 0, kMax, 1, 0x3333);
+  // A rectangle from far off the upper left covers everything up to its far
+  // edges.
+  writer.FillRect(1 - kMax, 1 - kMax, kMax, kMax, 0x4444);
+
+  const color_rgb565_t kExpected[] = {
+      0x4444, 0x0000, 0x0000, 0x0000,  //
+      0x0000, 0x0000, 0x1111, 0x1111,  //
+      0x0000, 0x0000, 0x1111, 0x1111,  //
+  };
+  EXPECT_EQ(std::memcmp(data, kExpected, sizeof(kExpected)), 0);
+}
+
+TEST(FramebufferWriter, ByteSwappedRgb565) {
+  uint16_t data[2 * 2];
+  Framebuffer fb(
+      data, PixelFormat::RGB565ByteSwapped, {2, 2}, 2 * sizeof(data[0]));
+  FramebufferWriter writer(fb);
+  writer.Fill(0x1234);
+  writer.SetPixel(1, 1, 0xf800);
+
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+  EXPECT_EQ(bytes[0], 0x12);
+  EXPECT_EQ(bytes[1], 0x34);
+  EXPECT_EQ(bytes[6], 0xf8);
+  EXPECT_EQ(bytes[7], 0x00);
+  EXPECT_EQ(writer.GetPixel(0, 1).value(), 0x1234);
+  EXPECT_EQ(writer.GetPixel(1, 1).value(), 0xf800);
+}
+
+TEST(FramebufferWriter, Argb8888) {
+  uint32_t data[3];
+  Framebuffer fb(data, PixelFormat::ARGB8888, {3, 1}, sizeof(data));
+  FramebufferWriter writer(fb);
+  writer.Fill(0);
+  constexpr color_rgb565_t kColors[] = {0xf800, 0x07e0, 0x001f};
+  writer.CopySpan(0, 0, kColors);
+
+  EXPECT_EQ(data[0], 0xffff0000);
+  EXPECT_EQ(data[1], 0xff00ff00);
+  EXPECT_EQ(data[2], 0xff0000ff);
+  EXPECT_EQ(writer.GetPixel(1, 0).value(), 0x07e0);
+}
+
+// Return the pixels of a monochrome framebuffer, '#' for lit pixels.
+std::string MonoToString(const Framebuffer& fb) {
+  TypedFramebufferReader<Mono1Traits> reader(fb);
+  std::string result;
+  for (int y = 0; y < fb.size().height; y++) {
+    for (int x = 0; x < fb.size().width; x++) {
+      result += reader.GetPixel(x, y).value() ? '#' : '.';
+    }
+    result += '\n';
+  }
+  return result;
+}
+
+TEST(FramebufferWriter, Mono1) {
+  // 21 pixels per row, padded to 4 bytes.
+  uint8_t data[4 * 3];
+  std::memset(data, 0x55, sizeof(data));
+  Framebuffer fb(data, PixelFormat::Mono1, {21, 3}, 4);
+  FramebufferWriter writer(fb);
+  writer.Fill(0x0000);
+  writer.FillSpan(0, 3, 19, 0xffff);
+  writer.FillRect(-2, 1, 4, 5, 0xffff);
+  writer.SetPixel(20, 2, 0xffff);
+
+  EXPECT_EQ(MonoToString(fb),
+            "...#################.\n"
+            "##...................\n"
+            "##..................#\n");
+  EXPECT_EQ(data[1], 0xff);
+  // Row padding is untouched.
+  EXPECT_EQ(data[2] & 0x07, 0x05);
+  EXPECT_EQ(data[3], 0x55);
+  EXPECT_EQ(writer.GetPixel(0, 1).value(), 0xffff);
+}
+
+}  // namespace
+}  // namespace pw::framebuffer
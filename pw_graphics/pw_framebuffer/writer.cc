@@ -13,48 +13,165 @@
 // the License.
 #include "public/pw_framebuffer/writer.h"
 
-#include <sys/signal.h>
+#include <cstddef>
 
 #include "pw_assert/assert.h"
+#include "pw_framebuffer/pixel_format_traits.h"
+#include "pw_framebuffer/typed_writer.h"
+#include "pw_math/rect.h"
 
 using pw::color::color_rgb565_t;
 
 namespace pw::framebuffer {
 
+namespace {
+
+// Return a pointer to the first pixel in row |y|.
+color_rgb565_t* RowData(const Framebuffer& framebuffer, int y) {
+  return reinterpret_cast<color_rgb565_t*>(
+      static_cast<std::byte*>(framebuffer.data()) +
+      y * framebuffer.row_bytes());
+}
+
+// Blend |src| over |dst| with |alpha5| in the range 0..32. The green channel
+// is moved to the upper half of a 32 bit word so that all three channels can
+// be blended with a single multiply.
+color_rgb565_t BlendRGB565(color_rgb565_t src,
+                           color_rgb565_t dst,
+                           uint32_t alpha5) {
+  constexpr uint32_t kMask = 0x07e0f81f;
+  const uint32_t src_wide = (src | (uint32_t{src} << 16)) & kMask;
+  uint32_t dst_wide = (dst | (uint32_t{dst} << 16)) & kMask;
+  dst_wide = (dst_wide + (((src_wide - dst_wide) * alpha5) >> 5)) & kMask;
+  return static_cast<color_rgb565_t>(dst_wide | (dst_wide >> 16));
+}
+
+}  // namespace
+
 FramebufferWriter::FramebufferWriter(Framebuffer& framebuffer)
-    : FramebufferReader(framebuffer) {}
+    : FramebufferReader(framebuffer), writable_framebuffer_(framebuffer) {}
 
 void FramebufferWriter::SetPixel(uint16_t x,
                                  uint16_t y,
                                  color_rgb565_t pixel_value) {
-  auto fb_size = framebuffer_.size();
-  if (x >= fb_size.width || y >= fb_size.height) {
+  const int local_x = LocalX(x);
+  const int local_y = LocalY(y);
+  // Skip the format switch for the common case, as this is called per pixel.
+  if (framebuffer_.pixel_format() == PixelFormat::RGB565) {
+    TypedFramebufferWriter<Rgb565Traits>(writable_framebuffer_)
+        .SetPixel(local_x, local_y, pixel_value);
+    return;
+  }
+  VisitPixelFormat(framebuffer_.pixel_format(), [&](auto traits) {
+    using Traits = decltype(traits);
+    TypedFramebufferWriter<Traits>(writable_framebuffer_)
+        .SetPixel(local_x, local_y, Traits::FromValue(pixel_value));
+  });
+}
+
+void FramebufferWriter::FillSpan(int y,
+                                 int x0,
+                                 int x1,
+                                 color_rgb565_t pixel_value) {
+  y = LocalY(y);
+  x0 = LocalX(x0);
+  x1 = LocalX(x1);
+  VisitPixelFormat(framebuffer_.pixel_format(), [&](auto traits) {
+    using Traits = decltype(traits);
+    TypedFramebufferWriter<Traits>(writable_framebuffer_)
+        .FillSpan(y, x0, x1, Traits::FromValue(pixel_value));
+  });
+}
+
+void FramebufferWriter::CopySpan(int x,
+                                 int y,
+                                 span<const color_rgb565_t> pixels) {
+  x = LocalX(x);
+  y = LocalY(y);
+  if (framebuffer_.pixel_format() == PixelFormat::RGB565) {
+    TypedFramebufferWriter<Rgb565Traits>(writable_framebuffer_)
+        .CopySpan(x, y, pixels);
+    return;
+  }
+  VisitPixelFormat(framebuffer_.pixel_format(), [&](auto traits) {
+    using Traits = decltype(traits);
+    TypedFramebufferWriter<Traits>(writable_framebuffer_)
+        .CopySpan(x, y, pixels, Traits::FromValue);
+  });
+}
+
+void FramebufferWriter::FillRect(
+    int x, int y, int width, int height, color_rgb565_t pixel_value) {
+  x = LocalX(x);
+  y = LocalY(y);
+  VisitPixelFormat(framebuffer_.pixel_format(), [&](auto traits) {
+    using Traits = decltype(traits);
+    TypedFramebufferWriter<Traits>(writable_framebuffer_)
+        .FillRect(x, y, width, height, Traits::FromValue(pixel_value));
+  });
+}
+
+void FramebufferWriter::Blit(const Framebuffer& fb, int x, int y) {
+  x = LocalX(x);
+  y = LocalY(y);
+  VisitPixelFormat(framebuffer_.pixel_format(), [&](auto traits) {
+    using Traits = decltype(traits);
+    TypedFramebufferWriter<Traits>(writable_framebuffer_).Blit(fb, x, y);
+  });
+}
+
+void FramebufferWriter::BlitColorKey(const Framebuffer& fb,
+                                     int x,
+                                     int y,
+                                     color_rgb565_t transparent_color) {
+  x = LocalX(x);
+  y = LocalY(y);
+  VisitPixelFormat(framebuffer_.pixel_format(), [&](auto traits) {
+    using Traits = decltype(traits);
+    TypedFramebufferWriter<Traits>(writable_framebuffer_)
+        .BlitColorKey(fb, x, y, Traits::FromValue(transparent_color));
+  });
+}
+
+void FramebufferWriter::BlitAlpha(const Framebuffer& fb,
+                                  int x,
+                                  int y,
+                                  uint8_t alpha) {
+  PW_ASSERT(framebuffer_.pixel_format() == PixelFormat::RGB565);
+  PW_ASSERT(fb.pixel_format() == PixelFormat::RGB565);
+  if (alpha == 0xff) {
+    Blit(fb, x, y);
+    return;
+  }
+  // Reduce alpha to 0..32 to match the 5 bit channel precision of RGB565.
+  const uint32_t alpha5 = (alpha + 4) >> 3;
+  if (alpha5 == 0) {
     return;
   }
-  color_rgb565_t* data = static_cast<color_rgb565_t*>(framebuffer_.data());
-  data[y * fb_size.width + x] = pixel_value;
-}
-
-void FramebufferWriter::Blit(const Framebuffer& fb, uint16_t x, uint16_t y) {
-  auto s = fb.size();
-  FramebufferReader reader(fb);
-  for (uint16_t current_x = 0; current_x < s.width; current_x++) {
-    for (uint16_t current_y = 0; current_y < s.height; current_y++) {
-      if (auto pixel_color = reader.GetPixel(current_x, current_y);
-          pixel_color.ok()) {
-        SetPixel(x + current_x, y + current_y, pixel_color.value());
-      }
+  x = LocalX(x);
+  y = LocalY(y);
+  const pw::math::Rect<int> placed{x, y, fb.size().width, fb.size().height};
+  const pw::math::Rect<int> region = placed.Intersect(
+      {0, 0, framebuffer_.size().width, framebuffer_.size().height});
+  if (region.IsEmpty()) {
+    return;
+  }
+  for (int row = 0; row < region.height; row++) {
+    const color_rgb565_t* src =
+        RowData(fb, region.y - y + row) + (region.x - x);
+    color_rgb565_t* dst = RowData(framebuffer_, region.y + row) + region.x;
+    for (int col = 0; col < region.width; col++) {
+      dst[col] = BlendRGB565(src[col], dst[col], alpha5);
     }
   }
 }
 
 void FramebufferWriter::Fill(color_rgb565_t pixel_value) {
-  color_rgb565_t* data = static_cast<color_rgb565_t*>(framebuffer_.data());
-  const size_t num_pixels =
-      framebuffer_.size().width * framebuffer_.size().height;
-  for (size_t i = 0; i < num_pixels; i++) {
-    data[i] = pixel_value;
-  }
+  FillRect(framebuffer_.origin().x,
+           framebuffer_.origin().y,
+           framebuffer_.size().width,
+           framebuffer_.size().height,
+           pixel_value);
 }
 
 }  // namespace pw::framebuffer
@@ -15,6 +15,8 @@
 #include "pw_framebuffer/writer.h"
 
 #include <cstdint>
+#include <cstring>
+#include <string>
 
 #include "gtest/gtest.h"
 #include "pw_color/color.h"
@@ -111,5 +113,236 @@ TEST(FramebufferWriter, Blit) {
   EXPECT_EQ(pixel_data[(8 * 6) + 6], indigo);
 }
 
+TEST(FramebufferWriter, FillSpanClipped) {
+  uint16_t data[8 * 8];
+  Framebuffer fb(data, PixelFormat::RGB565, {8, 8}, 8 * sizeof(data[0]));
+  FramebufferWriter writer(fb);
+  const color_rgb565_t* pixel_data =
+      static_cast<const color_rgb565_t*>(fb.data());
+  constexpr color_rgb565_t kOrange = 0xfd00;
+  writer.Fill(0);
+
+  writer.FillSpan(1, -4, 2, kOrange);
+  writer.FillSpan(2, 6, 20, kOrange);
+  // Completely outside of the framebuffer.
+  writer.FillSpan(-1, 0, 7, kOrange);
+  writer.FillSpan(8, 0, 7, kOrange);
+  writer.FillSpan(3, 9, 12, kOrange);
+
+  for (int x = 0; x < 8; x++) {
+    EXPECT_EQ(pixel_data[8 * 0 + x], 0);
+    EXPECT_EQ(pixel_data[8 * 1 + x], x <= 2 ? kOrange : 0);
+    EXPECT_EQ(pixel_data[8 * 2 + x], x >= 6 ? kOrange : 0);
+    EXPECT_EQ(pixel_data[8 * 3 + x], 0);
+    EXPECT_EQ(pixel_data[8 * 7 + x], 0);
+  }
+}
+
+TEST(FramebufferWriter, CopySpanClipped) {
+  uint16_t data[4 * 2];
+  Framebuffer fb(data, PixelFormat::RGB565, {4, 2}, 4 * sizeof(data[0]));
+  FramebufferWriter writer(fb);
+  const color_rgb565_t* pixel_data =
+      static_cast<const color_rgb565_t*>(fb.data());
+  writer.Fill(0);
+
+  constexpr color_rgb565_t kPixels[] = {1, 2, 3, 4, 5, 6};
+  writer.CopySpan(-2, 0, kPixels);
+  writer.CopySpan(2, 1, kPixels);
+
+  EXPECT_EQ(pixel_data[0], 3);
+  EXPECT_EQ(pixel_data[1], 4);
+  EXPECT_EQ(pixel_data[2], 5);
+  EXPECT_EQ(pixel_data[3], 6);
+  EXPECT_EQ(pixel_data[4], 0);
+  EXPECT_EQ(pixel_data[5], 0);
+  EXPECT_EQ(pixel_data[6], 1);
+  EXPECT_EQ(pixel_data[7], 2);
+}
+
+TEST(FramebufferWriter, FillRectClipped) {
+  uint16_t data[8 * 8];
+  Framebuffer fb(data, PixelFormat::RGB565, {8, 8}, 8 * sizeof(data[0]));
+  FramebufferWriter writer(fb);
+  const color_rgb565_t* pixel_data =
+      static_cast<const color_rgb565_t*>(fb.data());
+  constexpr color_rgb565_t kOrange = 0xfd00;
+  writer.Fill(0);
+
+  writer.FillRect(-2, 5, 4, 10, kOrange);
+
+  for (int y = 0; y < 8; y++) {
+    for (int x = 0; x < 8; x++) {
+      const bool inside = x < 2 && y >= 5;
+      EXPECT_EQ(pixel_data[8 * y + x], inside ? kOrange : 0);
+    }
+  }
+}
+
+TEST(FramebufferWriter, Origin) {
+  // A framebuffer covering (10, 20) through (13, 21) of the display.
+  uint16_t data[4 * 2];
+  Framebuffer fb(data, PixelFormat::RGB565, {4, 2}, 4 * sizeof(data[0]));
+  fb.set_origin({10, 20});
+  EXPECT_EQ((pw::math::Rect<uint16_t>{10, 20, 4, 2}), fb.bounds());
+  FramebufferWriter writer(fb);
+  writer.Fill(0);
+
+  writer.SetPixel(10, 20, 1);
+  writer.SetPixel(1, 1, 9);
+  writer.FillSpan(21, 12, 100, 2);
+  writer.FillRect(-5, 0, 17, 21, 3);
+  const color_rgb565_t kPixels[] = {4, 5};
+  writer.CopySpan(9, 21, kPixels);
+
+  const uint16_t kExpected[] = {
+      3, 3, 0, 0,  //
+      5, 0, 2, 2,  //
+  };
+  EXPECT_EQ(std::memcmp(data, kExpected, sizeof(data)), 0);
+  EXPECT_EQ(writer.GetPixel(13, 21).value(), 2);
+  EXPECT_FALSE(writer.GetPixel(0, 0).ok());
+  EXPECT_FALSE(writer.GetPixel(14, 21).ok());
+}
+
+TEST(FramebufferWriter, HonorsRowBytes) {
+  // A 3x3 framebuffer with two pixels of padding at the end of each row.
+  constexpr uint16_t kRowPixels = 5;
+  constexpr color_rgb565_t kPadding = 0xdead;
+  constexpr color_rgb565_t kOrange = 0xfd00;
+  uint16_t data[kRowPixels * 3];
+  for (auto& pixel : data) {
+    pixel = kPadding;
+  }
+  Framebuffer fb(
+      data, PixelFormat::RGB565, {3, 3}, kRowPixels * sizeof(data[0]));
+  FramebufferWriter writer(fb);
+  writer.Fill(0);
+  writer.SetPixel(2, 2, kOrange);
+
+  for (int y = 0; y < 3; y++) {
+    for (int x = 0; x < kRowPixels; x++) {
+      color_rgb565_t expected = x < 3 ? 0 : kPadding;
+      if (x == 2 && y == 2) {
+        expected = kOrange;
+      }
+      EXPECT_EQ(data[y * kRowPixels + x], expected);
+    }
+  }
+
+  Result<color_rgb565_t> c = writer.GetPixel(2, 2);
+  ASSERT_TRUE(c.ok());
+  EXPECT_EQ(c.value(), kOrange);
+}
+
+TEST(FramebufferWriter, BlitColorKey) {
+  constexpr color_rgb565_t kKey = 0xf81f;
+  constexpr color_rgb565_t kOrange = 0xfd00;
+  uint16_t data[4 * 2];
+  Framebuffer fb(data, PixelFormat::RGB565, {4, 2}, 4 * sizeof(data[0]));
+  FramebufferWriter writer(fb);
+  writer.Fill(0);
+
+  uint16_t sprite_data[3 * 2] = {
+      kOrange, kKey, kOrange,  // Row 0
+      kKey, kKey, kOrange,     // Row 1
+  };
+  Framebuffer sprite(
+      sprite_data, PixelFormat::RGB565, {3, 2}, 3 * sizeof(sprite_data[0]));
+  writer.BlitColorKey(sprite, 2, 0, kKey);
+
+  // The sprite's third column falls off the right edge.
+  EXPECT_EQ(data[0], 0);
+  EXPECT_EQ(data[1], 0);
+  EXPECT_EQ(data[2], kOrange);
+  EXPECT_EQ(data[3], 0);
+  EXPECT_EQ(data[4 + 2], 0);
+  EXPECT_EQ(data[4 + 3], 0);
+}
+
+TEST(FramebufferWriter, BlitAlpha) {
+  uint16_t data[2 * 2];
+  Framebuffer fb(data, PixelFormat::RGB565, {2, 2}, 2 * sizeof(data[0]));
+  FramebufferWriter writer(fb);
+  writer.Fill(0);
+
+  uint16_t red_data[1] = {0xf800};
+  Framebuffer red(red_data, PixelFormat::RGB565, {1, 1}, sizeof(red_data));
+  writer.BlitAlpha(red, 0, 0, 0);
+  EXPECT_EQ(data[0], 0);
+  writer.BlitAlpha(red, 0, 0, 128);
+  EXPECT_EQ(data[0], 0x7800);
+  writer.BlitAlpha(red, 1, 1, 255);
+  EXPECT_EQ(data[3], 0xf800);
+  EXPECT_EQ(data[1], 0);
+  EXPECT_EQ(data[2], 0);
+}
+
+// Return the pixel values of |fb| as a string, one hex digit per pixel.
+std::string IndicesToString(const Framebuffer& fb) {
+  FramebufferReader reader(fb);
+  std::string result;
+  for (uint16_t y = 0; y < fb.size().height; y++) {
+    for (uint16_t x = 0; x < fb.size().width; x++) {
+      result += "0123456789abcdef"[reader.GetPixel(x, y).value() & 0xf];
+    }
+    result += '\n';
+  }
+  return result;
+}
+
+TEST(FramebufferWriter, Indexed4) {
+  // Five pixels per row, padded to four bytes.
+  uint8_t data[4 * 4];
+  std::memset(data, 0x99, sizeof(data));
+  Framebuffer fb(data, PixelFormat::I4, {5, 4}, 4);
+  FramebufferWriter writer(fb);
+  writer.Fill(1);
+  EXPECT_EQ(IndicesToString(fb), "11111\n11111\n11111\n11111\n");
+
+  writer.SetPixel(0, 0, 2);
+  writer.SetPixel(3, 0, 3);
+  writer.FillSpan(1, 1, 10, 4);
+  constexpr color_rgb565_t kIndices[] = {5, 6, 7};
+  writer.CopySpan(-1, 2, kIndices);
+  writer.CopySpan(3, 2, kIndices);
+  writer.FillRect(2, 3, 2, 5, 8);
+  EXPECT_EQ(IndicesToString(fb), "21131\n14444\n67156\n11881\n");
+  // Row padding is untouched.
+  EXPECT_EQ(data[2] & 0xf, 9);
+  EXPECT_EQ(data[3], 0x99);
+}
+
+TEST(FramebufferWriter, Indexed8) {
+  uint8_t data[3 * 2];
+  Framebuffer fb(data, PixelFormat::I8, {3, 2}, 3);
+  FramebufferWriter writer(fb);
+  writer.Fill(0xab);
+  writer.FillSpan(1, 1, 1, 0xcd);
+  writer.SetPixel(2, 0, 0x12);
+  EXPECT_EQ(data[0], 0xab);
+  EXPECT_EQ(data[2], 0x12);
+  EXPECT_EQ(data[3], 0xab);
+  EXPECT_EQ(data[4], 0xcd);
+  EXPECT_EQ(writer.GetPixel(1, 1).value(), 0xcd);
+}
+
+TEST(FramebufferWriter, BlitIndexed) {
+  uint8_t data[3 * 3];
+  Framebuffer fb(data, PixelFormat::I4, {5, 3}, 3);
+  FramebufferWriter writer(fb);
+  writer.Fill(0);
+
+  // A 3x2 sprite using index 0xf as the transparent index.
+  uint8_t sprite_data[2 * 2] = {
+      0x1f, 0x20,  // Row 0: 1, f, 2.
+      0xf3, 0xf0,  // Row 1: f, 3, f.
+  };
+  Framebuffer sprite(sprite_data, PixelFormat::I4, {3, 2}, 2);
+  writer.Blit(sprite, 3, 0);
+  writer.BlitColorKey(sprite, -1, 1, 0xf);
+  EXPECT_EQ(IndicesToString(fb), "0001f\n020f3\n30000\n");
+}
+
 }  // namespace
 }  // namespace pw::framebuffer
@@ -14,6 +14,8 @@
 
 #include "pw_framebuffer_pool/framebuffer_pool.h"
 
+#include "pw_assert/assert.h"
+
 using pw::framebuffer::Framebuffer;
 
 namespace pw::framebuffer_pool {
@@ -23,25 +25,139 @@ FramebufferPool::FramebufferPool(const Config& config)
       buffer_dimensions_(config.dimensions),
       row_bytes_(config.row_bytes),
       pixel_format_(config.pixel_format),
-      next_fb_idx_(0) {
-  framebuffer_semaphore_.release(config.fb_addr.size());
+      palette_(config.palette),
+      free_head_(0),
+      free_tail_(0),
+      acquired_count_(0) {
+  PW_ASSERT(config.fb_addr.size() <= kMaxBuffers);
+  for (size_t i = 0; i < kMaxBuffers; i++) {
+    free_ring_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  for (size_t i = 0; i < config.fb_addr.size(); i++) {
+    buffer_states_[i].store(BufferState::kFree, std::memory_order_relaxed);
+    PushFreeBuffer(i);
+  }
 }
 
 FramebufferPool::~FramebufferPool() = default;
 
 Framebuffer FramebufferPool::GetFramebuffer() {
-  framebuffer_semaphore_.acquire();
-  size_t idx = next_fb_idx_++;
-  if (next_fb_idx_ == buffer_addresses_.size())
-    next_fb_idx_ = 0;
+  while (!FreeBufferReady()) {
+    framebuffer_semaphore_.acquire();
+    acquired_count_++;
+  }
+  return PopFreeBuffer();
+}
+
+Framebuffer FramebufferPool::TryGetFramebuffer() {
+  while (!FreeBufferReady()) {
+    if (!framebuffer_semaphore_.try_acquire())
+      return Framebuffer();
+    acquired_count_++;
+  }
+  return PopFreeBuffer();
+}
+
+Framebuffer FramebufferPool::TryGetFramebufferFor(
+    pw::chrono::SystemClock::duration timeout) {
+  const pw::chrono::SystemClock::time_point deadline =
+      pw::chrono::SystemClock::TimePointAfterAtLeast(timeout);
+  while (!FreeBufferReady()) {
+    if (!framebuffer_semaphore_.try_acquire_until(deadline))
+      return Framebuffer();
+    acquired_count_++;
+  }
+  return PopFreeBuffer();
+}
+
+bool FramebufferPool::FreeBufferReady() const {
+  if (acquired_count_ == 0)
+    return false;
+  const FreeSlot& slot = free_ring_[free_head_ % kMaxBuffers];
+  return slot.sequence.load(std::memory_order_acquire) == free_head_ + 1;
+}
 
-  return Framebuffer(
+Framebuffer FramebufferPool::PopFreeBuffer() {
+  PW_ASSERT(FreeBufferReady());
+  FreeSlot& slot = free_ring_[free_head_ % kMaxBuffers];
+  const size_t idx = slot.buffer_index;
+  // Hand the slot back to the producer that makes push number
+  // |free_head_ + kMaxBuffers|.
+  slot.sequence.store(free_head_ + kMaxBuffers, std::memory_order_release);
+  free_head_++;
+  acquired_count_--;
+
+  buffer_states_[idx].store(BufferState::kDrawing, std::memory_order_relaxed);
+  Framebuffer framebuffer(
       buffer_addresses_[idx], pixel_format_, buffer_dimensions_, row_bytes_);
+  framebuffer.set_palette(palette_);
+  return framebuffer;
 }
 
-Status FramebufferPool::ReleaseFramebuffer(Framebuffer) {
+void FramebufferPool::PushFreeBuffer(size_t idx) {
+  uint32_t tail = free_tail_.load(std::memory_order_relaxed);
+  FreeSlot* slot;
+  while (true) {
+    slot = &free_ring_[tail % kMaxBuffers];
+    const uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+    const int32_t lag = static_cast<int32_t>(sequence - tail);
+    if (lag == 0) {
+      if (free_tail_.compare_exchange_weak(
+              tail, tail + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else {
+      // The ring can never be full: it has room for every buffer, and a
+      // buffer is only pushed once per trip through GetFramebuffer. So a
+      // mismatch means another producer claimed this slot first.
+      PW_ASSERT(lag > 0);
+      tail = free_tail_.load(std::memory_order_relaxed);
+    }
+  }
+  slot->buffer_index = static_cast<uint8_t>(idx);
+  slot->sequence.store(tail + 1, std::memory_order_release);
   framebuffer_semaphore_.release();
+}
+
+Status FramebufferPool::ReleaseFramebuffer(Framebuffer framebuffer) {
+  const size_t idx = BufferIndex(framebuffer.data());
+  if (idx == num_buffers())
+    return Status::InvalidArgument();
+
+  BufferState state = buffer_states_[idx].load(std::memory_order_relaxed);
+  do {
+    if (state == BufferState::kFree)
+      return Status::FailedPrecondition();
+  } while (!buffer_states_[idx].compare_exchange_weak(
+      state, BufferState::kFree, std::memory_order_relaxed));
+
+  PushFreeBuffer(idx);
+  return OkStatus();
+}
+
+Status FramebufferPool::MarkInFlight(const Framebuffer& framebuffer) {
+  const size_t idx = BufferIndex(framebuffer.data());
+  if (idx == num_buffers())
+    return Status::InvalidArgument();
+  BufferState expected = BufferState::kDrawing;
+  if (!buffer_states_[idx].compare_exchange_strong(
+          expected, BufferState::kInFlight, std::memory_order_relaxed)) {
+    return Status::FailedPrecondition();
+  }
   return OkStatus();
 }
 
+FramebufferPool::BufferState FramebufferPool::buffer_state(size_t idx) const {
+  PW_ASSERT(idx < num_buffers());
+  return buffer_states_[idx].load(std::memory_order_relaxed);
+}
+
+size_t FramebufferPool::BufferIndex(const void* data) const {
+  for (size_t i = 0; i < buffer_addresses_.size(); i++) {
+    if (buffer_addresses_[i] == data)
+      return i;
+  }
+  return buffer_addresses_.size();
+}
+
 }  // namespace pw::framebuffer_pool
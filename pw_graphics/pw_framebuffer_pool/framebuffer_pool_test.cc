@@ -0,0 +1,165 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include "pw_framebuffer_pool/framebuffer_pool.h"
+
+#include <array>
+#include <chrono>
+#include <iterator>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "pw_color/color.h"
+
+using pw::color::color_rgb565_t;
+using pw::framebuffer::Framebuffer;
+using pw::framebuffer::PixelFormat;
+using BufferState = pw::framebuffer_pool::FramebufferPool::BufferState;
+
+namespace pw::framebuffer_pool {
+
+namespace {
+
+constexpr uint16_t kWidth = 4;
+constexpr uint16_t kHeight = 2;
+constexpr size_t kNumBuffers = 3;
+
+class FramebufferPoolTest : public ::testing::Test {
+ protected:
+  FramebufferPoolTest()
+      : buffers_{pixel_data_[0].data(),
+                 pixel_data_[1].data(),
+                 pixel_data_[2].data()},
+        pool_({
+            .fb_addr = buffers_,
+            .dimensions = {kWidth, kHeight},
+            .row_bytes = kWidth * sizeof(color_rgb565_t),
+            .pixel_format = PixelFormat::RGB565,
+        }) {}
+
+  std::array<std::array<color_rgb565_t, kWidth * kHeight>, kNumBuffers>
+      pixel_data_;
+  pw::Vector<void*, kNumBuffers> buffers_;
+  FramebufferPool pool_;
+};
+
+TEST_F(FramebufferPoolTest, GetFramebuffer) {
+  Framebuffer fb = pool_.GetFramebuffer();
+  ASSERT_TRUE(fb.is_valid());
+  EXPECT_EQ(fb.data(), pixel_data_[0].data());
+  EXPECT_EQ(fb.size().width, kWidth);
+  EXPECT_EQ(fb.size().height, kHeight);
+  EXPECT_EQ(fb.pixel_format(), PixelFormat::RGB565);
+  EXPECT_EQ(pool_.buffer_state(0), BufferState::kDrawing);
+  EXPECT_EQ(pool_.buffer_state(1), BufferState::kFree);
+  EXPECT_EQ(pool_.ReleaseFramebuffer(std::move(fb)), OkStatus());
+  EXPECT_EQ(pool_.buffer_state(0), BufferState::kFree);
+}
+
+TEST_F(FramebufferPoolTest, ReturnsBuffersInReleaseOrder) {
+  Framebuffer fb0 = pool_.GetFramebuffer();
+  Framebuffer fb1 = pool_.GetFramebuffer();
+  Framebuffer fb2 = pool_.GetFramebuffer();
+
+  // Release out of order: the next buffer handed out must be the one which
+  // was released first, not the next one in round-robin order.
+  EXPECT_EQ(pool_.ReleaseFramebuffer(std::move(fb2)), OkStatus());
+  EXPECT_EQ(pool_.ReleaseFramebuffer(std::move(fb0)), OkStatus());
+
+  Framebuffer fb = pool_.GetFramebuffer();
+  EXPECT_EQ(fb.data(), pixel_data_[2].data());
+  EXPECT_EQ(pool_.ReleaseFramebuffer(std::move(fb1)), OkStatus());
+  EXPECT_EQ(pool_.GetFramebuffer().data(), pixel_data_[0].data());
+  EXPECT_EQ(pool_.GetFramebuffer().data(), pixel_data_[1].data());
+}
+
+TEST_F(FramebufferPoolTest, TryGetFramebufferWhenExhausted) {
+  std::array<Framebuffer, kNumBuffers> fbs;
+  for (Framebuffer& fb : fbs) {
+    fb = pool_.TryGetFramebuffer();
+    EXPECT_TRUE(fb.is_valid());
+  }
+  EXPECT_FALSE(pool_.TryGetFramebuffer().is_valid());
+  EXPECT_FALSE(
+      pool_.TryGetFramebufferFor(std::chrono::milliseconds(1)).is_valid());
+
+  void* released = fbs[1].data();
+  EXPECT_EQ(pool_.ReleaseFramebuffer(std::move(fbs[1])), OkStatus());
+  Framebuffer fb = pool_.TryGetFramebufferFor(std::chrono::milliseconds(1));
+  ASSERT_TRUE(fb.is_valid());
+  EXPECT_EQ(fb.data(), released);
+}
+
+TEST_F(FramebufferPoolTest, MarkInFlight) {
+  Framebuffer fb = pool_.GetFramebuffer();
+  EXPECT_EQ(pool_.MarkInFlight(fb), OkStatus());
+  EXPECT_EQ(pool_.buffer_state(0), BufferState::kInFlight);
+  EXPECT_EQ(pool_.MarkInFlight(fb), Status::FailedPrecondition());
+
+  Framebuffer free_fb(pixel_data_[1].data(),
+                      PixelFormat::RGB565,
+                      {kWidth, kHeight},
+                      kWidth * sizeof(color_rgb565_t));
+  EXPECT_EQ(pool_.MarkInFlight(free_fb), Status::FailedPrecondition());
+
+  EXPECT_EQ(pool_.ReleaseFramebuffer(std::move(fb)), OkStatus());
+  EXPECT_EQ(pool_.buffer_state(0), BufferState::kFree);
+}
+
+TEST_F(FramebufferPoolTest, ReleaseInvalidBuffers) {
+  color_rgb565_t other_data[kWidth * kHeight];
+  Framebuffer other_fb(other_data,
+                       PixelFormat::RGB565,
+                       {kWidth, kHeight},
+                       kWidth * sizeof(color_rgb565_t));
+  EXPECT_EQ(pool_.ReleaseFramebuffer(std::move(other_fb)),
+            Status::InvalidArgument());
+
+  // Releasing a buffer which is already free must not add it to the free list
+  // a second time.
+  Framebuffer free_fb(pixel_data_[0].data(),
+                      PixelFormat::RGB565,
+                      {kWidth, kHeight},
+                      kWidth * sizeof(color_rgb565_t));
+  EXPECT_EQ(pool_.ReleaseFramebuffer(std::move(free_fb)),
+            Status::FailedPrecondition());
+  for (size_t i = 0; i < kNumBuffers; i++) {
+    EXPECT_TRUE(pool_.TryGetFramebuffer().is_valid());
+  }
+  EXPECT_FALSE(pool_.TryGetFramebuffer().is_valid());
+}
+
+TEST(FramebufferPool, IndexedFramebuffersHavePalette) {
+  constexpr color_rgb565_t kPalette[] = {0x0000, 0xf800, 0x07e0, 0x001f};
+  std::array<uint8_t, kWidth * kHeight> pixel_data;
+  pw::Vector<void*, 1> buffers{pixel_data.data()};
+  FramebufferPool pool({
+      .fb_addr = buffers,
+      .dimensions = {kWidth, kHeight},
+      .row_bytes = kWidth,
+      .pixel_format = PixelFormat::I8,
+      .palette = kPalette,
+  });
+
+  Framebuffer fb = pool.GetFramebuffer();
+  ASSERT_TRUE(fb.is_valid());
+  EXPECT_EQ(fb.pixel_format(), PixelFormat::I8);
+  EXPECT_EQ(fb.palette().data(), kPalette);
+  EXPECT_EQ(fb.palette().size(), std::size(kPalette));
+  EXPECT_EQ(pool.ReleaseFramebuffer(std::move(fb)), OkStatus());
+}
+
+}  // namespace
+
+}  // namespace pw::framebuffer_pool
@@ -0,0 +1,139 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+
+#include <array>
+#include <atomic>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "pw_color/color.h"
+#include "pw_containers/vector.h"
+#include "pw_framebuffer_pool/framebuffer_pool.h"
+#include "pw_thread/test_threads.h"
+#include "pw_thread/thread.h"
+#include "pw_thread/thread_core.h"
+#include "pw_thread/yield.h"
+
+using pw::color::color_rgb565_t;
+using pw::framebuffer::Framebuffer;
+using pw::framebuffer::PixelFormat;
+using BufferState = pw::framebuffer_pool::FramebufferPool::BufferState;
+
+namespace pw::framebuffer_pool {
+
+namespace {
+
+constexpr uint16_t kWidth = 2;
+constexpr uint16_t kHeight = 2;
+constexpr size_t kNumBuffers = FramebufferPool::kMaxBuffers;
+constexpr size_t kBuffersPerReleaser = kNumBuffers / 2;
+constexpr int kRounds = 20000;
+
+// Releases the buffers it is handed back to the pool, once per round. Both
+// releasers poll for the round to start so that their releases overlap.
+class Releaser : public pw::thread::ThreadCore {
+ public:
+  Releaser(FramebufferPool& pool, const std::atomic<int>& started_rounds)
+      : pool_(pool), started_rounds_(started_rounds) {}
+
+  std::array<Framebuffer, kBuffersPerReleaser> buffers;
+  std::atomic<int> finished_rounds = 0;
+  int failures = 0;
+
+ private:
+  void Run() override {
+    for (int round = 0; round < kRounds; round++) {
+      while (started_rounds_.load(std::memory_order_acquire) <= round) {
+        pw::this_thread::yield();
+      }
+      for (Framebuffer& fb : buffers) {
+        if (!pool_.ReleaseFramebuffer(std::move(fb)).ok())
+          failures++;
+      }
+      finished_rounds.store(round + 1, std::memory_order_release);
+    }
+  }
+
+  FramebufferPool& pool_;
+  const std::atomic<int>& started_rounds_;
+};
+
+TEST(FramebufferPool, ConcurrentReleases) {
+  std::array<std::array<color_rgb565_t, kWidth * kHeight>, kNumBuffers>
+      pixel_data;
+  pw::Vector<void*, kNumBuffers> buffers;
+  for (auto& data : pixel_data)
+    buffers.push_back(data.data());
+  FramebufferPool pool({
+      .fb_addr = buffers,
+      .dimensions = {kWidth, kHeight},
+      .row_bytes = kWidth * sizeof(color_rgb565_t),
+      .pixel_format = PixelFormat::RGB565,
+  });
+
+  std::atomic<int> started_rounds = 0;
+  Releaser first(pool, started_rounds);
+  Releaser second(pool, started_rounds);
+  pw::thread::Thread first_thread(pw::thread::test::TestOptionsThread0(),
+                                  first);
+  pw::thread::Thread second_thread(pw::thread::test::TestOptionsThread1(),
+                                   second);
+
+  bool lost_buffer = false;
+  for (int round = 0; round < kRounds && !lost_buffer; round++) {
+    // Every buffer must come back exactly once per round. The buffers are
+    // retrieved while the releasers are still pushing them.
+    std::array<Framebuffer, kNumBuffers> retrieved;
+    std::array<bool, kNumBuffers> seen = {};
+    for (Framebuffer& fb : retrieved) {
+      fb = pool.GetFramebuffer();
+      size_t idx = 0;
+      while (idx < kNumBuffers && buffers[idx] != fb.data())
+        idx++;
+      if (idx == kNumBuffers || seen[idx]) {
+        ADD_FAILURE() << "Buffer handed out twice in round " << round;
+        lost_buffer = true;
+        break;
+      }
+      seen[idx] = true;
+    }
+    if (lost_buffer)
+      break;
+    EXPECT_FALSE(pool.TryGetFramebuffer().is_valid());
+
+    while (first.finished_rounds.load(std::memory_order_acquire) < round ||
+           second.finished_rounds.load(std::memory_order_acquire) < round) {
+      pw::this_thread::yield();
+    }
+    for (size_t i = 0; i < kNumBuffers; i++) {
+      Releaser& releaser = i < kBuffersPerReleaser ? first : second;
+      releaser.buffers[i % kBuffersPerReleaser] = std::move(retrieved[i]);
+    }
+    started_rounds.store(round + 1, std::memory_order_release);
+  }
+  // Let the releasers finish if the test stopped early.
+  started_rounds.store(kRounds, std::memory_order_release);
+
+  first_thread.join();
+  second_thread.join();
+  ASSERT_FALSE(lost_buffer);
+  EXPECT_EQ(first.failures, 0);
+  EXPECT_EQ(second.failures, 0);
+  for (size_t i = 0; i < kNumBuffers; i++)
+    EXPECT_EQ(pool.buffer_state(i), BufferState::kFree);
+}
+
+}  // namespace
+
+}  // namespace pw::framebuffer_pool
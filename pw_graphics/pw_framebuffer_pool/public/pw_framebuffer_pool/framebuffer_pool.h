@@ -15,11 +15,16 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 
+#include "pw_chrono/system_clock.h"
+#include "pw_color/color.h"
 #include "pw_containers/vector.h"
 #include "pw_framebuffer/framebuffer.h"
 #include "pw_math/size.h"
+#include "pw_span/span.h"
 #include "pw_status/status.h"
 #include "pw_sync/counting_semaphore.h"
 
@@ -28,16 +33,35 @@ namespace pw::framebuffer_pool {
 // FramebufferPool manages a collection of (one or more) framebuffers.
 // It provides a mechanism to retrieve a buffer from the pool for use, and
 // for returning that buffer back to the pool.
+//
+// Free buffers are handed out in the order in which they were released, so
+// the buffer returned by GetFramebuffer is always the one that has been idle
+// the longest. The free list is a lock-free ring with a single consumer and
+// multiple producers: one context (typically the drawing thread) retrieves
+// buffers, and any number of contexts, including interrupts, may release
+// them concurrently.
 class FramebufferPool {
  public:
   using BufferArray = pw::Vector<void*>;
 
+  // The maximum number of buffers a pool can manage.
+  static constexpr size_t kMaxBuffers = 8;
+
+  // The ownership state of each buffer in the pool.
+  enum class BufferState : uint8_t {
+    kFree,      // Available to GetFramebuffer.
+    kDrawing,   // Handed out by GetFramebuffer.
+    kInFlight,  // Being written to the display.
+  };
+
   // Constructor parameters.
   struct Config {
     const BufferArray& fb_addr;  // Address of each buffer in this pool.
     pw::math::Size<uint16_t> dimensions;  // width/height of each buffer.
     uint16_t row_bytes;                   // row bytes of each buffer.
     pw::framebuffer::PixelFormat pixel_format;
+    // Palette given to each framebuffer when the pixel format is indexed.
+    span<const pw::color::color_rgb565_t> palette = {};
   };
 
   FramebufferPool(const Config& config);
@@ -58,27 +82,87 @@ class FramebufferPool {
   // Return the pixel format for each framebuffer in this pool.
   pw::framebuffer::PixelFormat pixel_format() const { return pixel_format_; }
 
+  // Return the palette given to each framebuffer in this pool.
+  span<const pw::color::color_rgb565_t> palette() const { return palette_; }
+
   // Return a framebuffer to the caller for use. This call WILL BLOCK until a
   // framebuffer is returned for use. Framebuffers *must* be returned to this
   // pool by a corresponding call to ReleaseFramebuffer. This function will only
   // return a valid framebuffers.
   //
-  // This call is thread-safe, but not interrupt safe.
+  // This call is not interrupt safe, and only one thread may retrieve buffers
+  // from the pool at a time.
   virtual pw::framebuffer::Framebuffer GetFramebuffer();
 
+  // Return a framebuffer to the caller if one is free, or an invalid
+  // framebuffer if all buffers are in use. Never blocks.
+  virtual pw::framebuffer::Framebuffer TryGetFramebuffer();
+
+  // Return a framebuffer to the caller, waiting at most |timeout| for one to
+  // be released. Returns an invalid framebuffer if the timeout expires.
+  virtual pw::framebuffer::Framebuffer TryGetFramebufferFor(
+      pw::chrono::SystemClock::duration timeout);
+
   // Return the framebuffer to the pool available for use by the next call to
-  // GetFramebuffer.
+  // GetFramebuffer. Returns INVALID_ARGUMENT if |framebuffer| does not belong
+  // to this pool, or FAILED_PRECONDITION if it is already free.
   //
   // This may be called on another thread or during an interrupt.
   virtual Status ReleaseFramebuffer(pw::framebuffer::Framebuffer framebuffer);
 
+  // Record that |framebuffer| has been handed to the display for writing.
+  // This only affects the state reported by buffer_state(). Returns
+  // FAILED_PRECONDITION if the buffer was not retrieved from this pool.
+  Status MarkInFlight(const pw::framebuffer::Framebuffer& framebuffer);
+
+  // Return the number of buffers managed by this pool.
+  size_t num_buffers() const { return buffer_addresses_.size(); }
+
+  // Return the current state of the buffer at |idx|. This is intended for
+  // diagnostics; the state may change as soon as it is read.
+  BufferState buffer_state(size_t idx) const;
+
  private:
+  // Return the index of the buffer whose pixel data is at |data|, or
+  // num_buffers() if it does not belong to this pool.
+  size_t BufferIndex(const void* data) const;
+
+  // Return true if the buffer at the head of the free ring has been published
+  // and a semaphore count is held to pop it.
+  bool FreeBufferReady() const;
+
+  // Pop the least recently released buffer from the free ring. The caller
+  // must have checked FreeBufferReady().
+  pw::framebuffer::Framebuffer PopFreeBuffer();
+
+  // Push buffer |idx| onto the free ring. Safe to call from several contexts
+  // at once.
+  void PushFreeBuffer(size_t idx);
+
+  // An entry in the free ring. |sequence| is the push count at which the slot
+  // may next be written, plus one once |buffer_index| has been published.
+  struct FreeSlot {
+    std::atomic<uint32_t> sequence;
+    uint8_t buffer_index;
+  };
+
   pw::sync::CountingSemaphore framebuffer_semaphore_;
   const BufferArray& buffer_addresses_;         // Address of each pixel buffer.
   pw::math::Size<uint16_t> buffer_dimensions_;  // width/height of all buffers
   uint16_t row_bytes_;                          // All row bytes are the same.
   pw::framebuffer::PixelFormat pixel_format_;   // Shared pixel format.
-  volatile size_t next_fb_idx_;
+  span<const pw::color::color_rgb565_t> palette_;  // Initial palette.
+  std::array<std::atomic<BufferState>, kMaxBuffers> buffer_states_;
+  // Indices of free buffers, in release order. |free_head_| counts pops and
+  // is only used by the consumer. |free_tail_| counts pushes, and producers
+  // claim a slot by advancing it.
+  std::array<FreeSlot, kMaxBuffers> free_ring_;
+  uint32_t free_head_;
+  std::atomic<uint32_t> free_tail_;
+  // Semaphore counts taken by the consumer but not yet spent on a pop. Pushes
+  // can finish out of order, so a count may belong to a buffer that is not
+  // at the head of the ring yet.
+  uint32_t acquired_count_;
 };
 
 }  // namespace pw::framebuffer_pool
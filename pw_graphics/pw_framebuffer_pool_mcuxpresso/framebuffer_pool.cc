@@ -32,6 +32,17 @@ Framebuffer FramebufferPoolMCUXpresso::GetFramebuffer() {
   return device_->GetFramebuffer();
 }
 
+Framebuffer FramebufferPoolMCUXpresso::TryGetFramebuffer() {
+  PW_ASSERT(device_ != nullptr);
+  return device_->TryGetFramebuffer();
+}
+
+Framebuffer FramebufferPoolMCUXpresso::TryGetFramebufferFor(
+    pw::chrono::SystemClock::duration timeout) {
+  PW_ASSERT(device_ != nullptr);
+  return device_->TryGetFramebufferFor(timeout);
+}
+
 Status FramebufferPoolMCUXpresso::ReleaseFramebuffer(Framebuffer framebuffer) {
   // framebuffers are implicitly released to the NXP device during the
   // rendering process. The |device_| has a drawing callback that informs it
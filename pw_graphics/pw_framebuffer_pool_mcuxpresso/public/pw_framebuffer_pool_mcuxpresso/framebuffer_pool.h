@@ -32,6 +32,9 @@ class FramebufferPoolMCUXpresso : public FramebufferPool {
 
   // pw::framebuffer_pool::FramebufferPool implementation:
   pw::framebuffer::Framebuffer GetFramebuffer() override;
+  pw::framebuffer::Framebuffer TryGetFramebuffer() override;
+  pw::framebuffer::Framebuffer TryGetFramebufferFor(
+      pw::chrono::SystemClock::duration timeout) override;
   Status ReleaseFramebuffer(pw::framebuffer::Framebuffer framebuffer) override;
 
  private:
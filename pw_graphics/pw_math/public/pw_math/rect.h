@@ -0,0 +1,84 @@
+// Copyright 2023 The Pigweed Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License. You may obtain a copy of
+// the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations under
+// the License.
+#pragma once
+
+#include <algorithm>
+
+#include "pw_math/size.h"
+
+namespace pw::math {
+
+// An axis aligned rectangle whose upper left corner is at (x, y).
+template <typename T>
+struct Rect {
+  T x;
+  T y;
+  T width;
+  T height;
+
+  Size<T> size() const { return Size<T>{width, height}; }
+
+  // Return true if this rectangle contains no pixels.
+  bool IsEmpty() const { return width <= 0 || height <= 0; }
+
+  // Return the overlapping area of this rectangle and |other|. An empty
+  // rectangle is returned if they do not overlap.
+  Rect<T> Intersect(const Rect<T>& other) const {
+    const T left = std::max(x, other.x);
+    const T top = std::max(y, other.y);
+    const T right = std::min<T>(x + width, other.x + other.width);
+    const T bottom = std::min<T>(y + height, other.y + other.height);
+    if (right <= left || bottom <= top) {
+      return Rect<T>{left, top, 0, 0};
+    }
+    return Rect<T>{left,
+                   top,
+                   static_cast<T>(right - left),
+                   static_cast<T>(bottom - top)};
+  }
+
+  // Return the smallest rectangle containing both this rectangle and |other|.
+  // Empty rectangles are ignored.
+  Rect<T> Union(const Rect<T>& other) const {
+    if (other.IsEmpty()) {
+      return *this;
+    }
+    if (IsEmpty()) {
+      return other;
+    }
+    const T left = std::min(x, other.x);
+    const T top = std::min(y, other.y);
+    const T right = std::max<T>(x + width, other.x + other.width);
+    const T bottom = std::max<T>(y + height, other.y + other.height);
+    return Rect<T>{left,
+                   top,
+                   static_cast<T>(right - left),
+                   static_cast<T>(bottom - top)};
+  }
+
+  // Return true if |other| lies entirely within this rectangle.
+  bool Contains(const Rect<T>& other) const {
+    return other.x >= x && other.y >= y &&
+           other.x + other.width <= x + width &&
+           other.y + other.height <= y + height;
+  }
+
+  bool operator!=(const Rect<T>& rhs) const { return !(*this == rhs); }
+  bool operator==(const Rect<T>& rhs) const {
+    return x == rhs.x && y == rhs.y && width == rhs.width &&
+           height == rhs.height;
+  }
+};
+
+}  // namespace pw::math
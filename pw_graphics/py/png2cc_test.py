@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+# Copyright 2023 The Pigweed Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not
+# use this file except in compliance with the License. You may obtain a copy of
+# the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+# License for the specific language governing permissions and limitations under
+# the License.
+"""Tests for the png2cc converter."""
+
+import os
+from pathlib import Path
+import sys
+import tempfile
+import unittest
+from unittest import mock
+
+from PIL import Image  # type: ignore
+
+from pw_graphics import png2cc
+
+
+class Png2ccTest(unittest.TestCase):
+    """Runs each output mode of png2cc through main()."""
+
+    def setUp(self) -> None:
+        self._temp_dir = tempfile.TemporaryDirectory()
+        self._old_cwd = os.getcwd()
+        os.chdir(self._temp_dir.name)
+        # Two 4x2 sprites: an opaque red rectangle with a transparent corner,
+        # and a black and white pattern for the font mode.
+        image = Image.new('RGBA', (8, 2), (255, 0, 255, 255))
+        for x in range(1, 4):
+            image.putpixel((x, 0), (255, 0, 0, 255))
+        for x in range(0, 4):
+            image.putpixel((x, 1), (255, 0, 0, 255))
+        for x in range(4, 8, 2):
+            image.putpixel((x, 0), (0, 0, 0, 255))
+            image.putpixel((x + 1, 1), (0, 0, 0, 255))
+        image.save('Test Sprites.png')
+
+    def tearDown(self) -> None:
+        os.chdir(self._old_cwd)
+        self._temp_dir.cleanup()
+
+    def _run(self, output_mode: str, out_name: str) -> str:
+        argv = [
+            'png2cc',
+            'Test Sprites.png',
+            '-W',
+            '4',
+            '-H',
+            '2',
+            '--output-mode',
+            output_mode,
+        ]
+        with mock.patch.object(sys, 'argv', argv):
+            png2cc.main()
+        return Path(out_name).read_text()
+
+    def test_rgb565(self) -> None:
+        header = self._run('rgb565', 'Test Sprites.h')
+        self.assertIn('test_sprites', header)
+        self.assertIn('0xf800', header.lower())
+
+    def test_rgb565_rle(self) -> None:
+        header = self._run('rgb565_rle', 'Test Sprites_rle.h')
+        self.assertIn('test_sprites', header)
+        self.assertIn('// Skip, length', header)
+
+    def test_indexed4(self) -> None:
+        header = self._run('indexed4', 'Test Sprites_indexed.h')
+        self.assertIn('test_sprites', header)
+        self.assertIn('0xf800', header.lower())
+
+    def test_indexed8(self) -> None:
+        header = self._run('indexed8', 'Test Sprites_indexed.h')
+        self.assertIn('test_sprites', header)
+        self.assertIn('0xf800', header.lower())
+
+    def test_font(self) -> None:
+        header = self._run('font', 'Test Sprites.h')
+        self.assertIn('test_sprites', header)
+        self.assertIn('0b', header)
+
+
+if __name__ == '__main__':
+    unittest.main()
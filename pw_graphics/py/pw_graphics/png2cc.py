@@ -53,7 +53,13 @@ def _arg_parser():
         '-H', '--sprite-height', type=int, required=True, help='Sprite height.'
     )
     parser.add_argument(
-        '--output-mode', default='rgb565', choices=['rgb565', 'font'], help=''
+        '--output-mode',
+        default='rgb565',
+        choices=['rgb565', 'rgb565_rle', 'indexed4', 'indexed8', 'font'],
+        help=(
+            'rgb565_rle stores each sprite row as runs of opaque pixels. '
+            'indexed4 and indexed8 store 4 or 8 bit indices into a palette.'
+        ),
     )
     parser.add_argument(
         '--transparent-color',
@@ -74,6 +80,15 @@ def rgb565(red, green, blue) -> int:
     return ((red & 0xF8) << 8) | ((green & 0xFC) << 3) | ((blue & 0xF8) >> 3)
 
 
+def rgb565_line(pix) -> str:
+    """Return the array entry for an RGB(A) pixel, commented with its color."""
+    hex_rgb565 = rgb565(pix[0], pix[1], pix[2])
+    hex_r = f"{pix[0]:02x}"
+    hex_g = f"{pix[1]:02x}"
+    hex_b = f"{pix[2]:02x}"
+    return f"{hex_rgb565:#04x},  // #{hex_r}{hex_g}{hex_b}\n"
+
+
 def render_rgb565_header(
     alpha_composite: Image,
     tile_width: int,
@@ -90,15 +105,159 @@ def render_rgb565_header(
                     globalx = twidth * sprite_width + currentx
                     globaly = theight * sprite_height + currenty
                     pix = alpha_composite.getpixel((globalx, globaly))
+                    sprite_data[-1].append(rgb565_line(pix))
+    return sprite_data
+
+
+def opaque_runs(row: list, transparent_color: int) -> list:
+    """Split a row of RGB(A) pixels into runs of opaque pixels.
+
+    Returns a (skip, pixels) tuple for each run, where skip is the number of
+    transparent pixels between the end of the previous run and this one.
+    """
+    runs: list[tuple[int, list]] = []
+    skip = 0
+    run: list = []
+    for pix in row:
+        if rgb565(pix[0], pix[1], pix[2]) == transparent_color:
+            if run:
+                runs.append((skip, run))
+                skip = 0
+                run = []
+            skip += 1
+        else:
+            run.append(pix)
+    if run:
+        runs.append((skip, run))
+    return runs
+
+
+def encode_rle_row(runs: list) -> list[str]:
+    """Encode the runs of a row for pw::draw::RleSpriteSheet."""
+    lines = [f"{len(runs)},  // Runs\n"]
+    for skip, run in runs:
+        lines.append(f"{skip}, {len(run)},  // Skip, length\n")
+        lines.extend(rgb565_line(pix) for pix in run)
+    return lines
+
+
+def render_rgb565_rle_header(
+    alpha_composite: Image,
+    tile_width: int,
+    tile_height: int,
+    sprite_width: int,
+    sprite_height: int,
+    transparent_color: int,
+) -> tuple[list, list]:
+    """Return the encoded lines of each sprite, and the offset of each row."""
+    sprite_data: list[list[str]] = []
+    row_offsets: list[int] = []
+    offset = 0
+    for theight in range(0, tile_height):
+        for twidth in range(0, tile_width):
+            sprite_data.append([])
+            for currenty in range(0, sprite_height):
+                globaly = theight * sprite_height + currenty
+                row = [
+                    alpha_composite.getpixel(
+                        (twidth * sprite_width + currentx, globaly)
+                    )
+                    for currentx in range(0, sprite_width)
+                ]
+                runs = opaque_runs(row, transparent_color)
+                row_offsets.append(offset)
+                offset += 1 + sum(2 + len(run) for _, run in runs)
+                sprite_data[-1].extend(encode_rle_row(runs))
+    return sprite_data, row_offsets
+
+
+def build_palette(pixels, transparent_color: int) -> tuple[list, dict]:
+    """Assign a palette index to each RGB565 color of |pixels|.
+
+    Colors are numbered in the order they are first seen, except that the
+    transparent color, if present, is always index 0. Returns the first RGB(A)
+    pixel seen of each color in index order, and a map from RGB565 color to
+    index.
+    """
+    pixels = list(pixels)
+    palette: list = []
+    indices: dict[int, int] = {}
+    transparent = [p for p in pixels if rgb565(*p[:3]) == transparent_color]
+    if transparent:
+        palette.append(transparent[0])
+        indices[transparent_color] = 0
+    for pix in pixels:
+        color = rgb565(pix[0], pix[1], pix[2])
+        if color not in indices:
+            indices[color] = len(palette)
+            palette.append(pix)
+    return palette, indices
+
+
+def pack_indices(indices: list[int], bits_per_pixel: int) -> list[int]:
+    """Pack a row of indices into bytes, first pixel in the high nibble."""
+    if bits_per_pixel == 8:
+        return list(indices)
+    if len(indices) % 2:
+        indices = indices + [0]
+    return [
+        (indices[i] << 4) | indices[i + 1] for i in range(0, len(indices), 2)
+    ]
+
 
-                    hex_rgb565 = rgb565(pix[0], pix[1], pix[2])
-                    hex_r = f"{pix[0]:02x}"
-                    hex_g = f"{pix[1]:02x}"
-                    hex_b = f"{pix[2]:02x}"
+def render_indexed_header(
+    alpha_composite: Image,
+    tile_width: int,
+    tile_height: int,
+    sprite_width: int,
+    sprite_height: int,
+    transparent_color: int,
+    bits_per_pixel: int,
+) -> tuple[list, list, int]:
+    """Return the packed rows of each sprite, the palette lines, and the
+    transparent index (-1 if there are no transparent pixels)."""
+    image_width = tile_width * sprite_width
+    image_height = tile_height * sprite_height
+    palette, indices = build_palette(
+        (
+            alpha_composite.getpixel((x, y))
+            for y in range(image_height)
+            for x in range(image_width)
+        ),
+        transparent_color,
+    )
+    if len(palette) > 1 << bits_per_pixel:
+        raise ValueError(
+            f'{len(palette)} colors do not fit in {bits_per_pixel} bits per '
+            'pixel'
+        )
+
+    bytes_per_line = 8
+    sprite_data: list[list[str]] = []
+    for theight in range(0, tile_height):
+        for twidth in range(0, tile_width):
+            sprite_data.append([])
+            for currenty in range(0, sprite_height):
+                globaly = theight * sprite_height + currenty
+                row = [
+                    indices[rgb565(*pix[:3])]
+                    for pix in (
+                        alpha_composite.getpixel(
+                            (twidth * sprite_width + currentx, globaly)
+                        )
+                        for currentx in range(0, sprite_width)
+                    )
+                ]
+                packed = pack_indices(row, bits_per_pixel)
+                sprite_data[-1].append(f"// Row {currenty}\n")
+                for i in range(0, len(packed), bytes_per_line):
+                    chunk = packed[i : i + bytes_per_line]
                     sprite_data[-1].append(
-                        f"{hex_rgb565:#04x},  // #{hex_r}{hex_g}{hex_b}\n"
+                        ' '.join(f"{b:#04x}," for b in chunk) + '\n'
                     )
-    return sprite_data
+    palette_lines = [rgb565_line(pix) for pix in palette]
+    transparent_index = 0 if transparent_color in indices else -1
+    return sprite_data, palette_lines, transparent_index
 
 
 def render_font_header(
@@ -145,6 +304,10 @@ def main() -> None:
         transparent_color = (int(rgb[0]), int(rgb[1]), int(rgb[2]))
 
     out_path = Path(image_path.stem + '.h')
+    if args.output_mode == 'rgb565_rle':
+        out_path = Path(image_path.stem + '_rle.h')
+    elif args.output_mode.startswith('indexed'):
+        out_path = Path(image_path.stem + '_indexed.h')
 
     img = Image.open(image_path).convert('RGBA')
     background = Image.new('RGBA', img.size, transparent_color)
@@ -158,6 +321,12 @@ def main() -> None:
     tile_width = max(tile_width, 1)
     tile_height = max(tile_height, 1)
 
+    # Only used by some of the templates, but every template is rendered with
+    # them.
+    row_offsets: list[int] = []
+    palette: list[str] = []
+    transparent_index = -1
+    bits_per_pixel = 16
     if args.output_mode == 'rgb565':
         sprite_data = render_rgb565_header(
             alpha_composite,
@@ -166,6 +335,26 @@ def main() -> None:
             sprite_width,
             sprite_height,
         )
+    elif args.output_mode == 'rgb565_rle':
+        sprite_data, row_offsets = render_rgb565_rle_header(
+            alpha_composite,
+            tile_width,
+            tile_height,
+            sprite_width,
+            sprite_height,
+            transparent_color_int,
+        )
+    elif args.output_mode in ('indexed4', 'indexed8'):
+        bits_per_pixel = 4 if args.output_mode == 'indexed4' else 8
+        sprite_data, palette, transparent_index = render_indexed_header(
+            alpha_composite,
+            tile_width,
+            tile_height,
+            sprite_width,
+            sprite_height,
+            transparent_color_int,
+            bits_per_pixel,
+        )
     elif args.output_mode == 'font':
         sprite_data = render_font_header(
             alpha_composite,
@@ -175,11 +364,18 @@ def main() -> None:
             sprite_height,
         )
 
-    template = jinja_env.get_template(args.output_mode + '.jinja')
+    template_name = args.output_mode
+    if args.output_mode.startswith('indexed'):
+        template_name = 'indexed'
+    template = jinja_env.get_template(template_name + '.jinja')
     out_path.write_text(
         template.render(
             file_name=file_name,
             sprite_data=sprite_data,
+            row_offsets=row_offsets,
+            palette=palette,
+            transparent_index=transparent_index,
+            bits_per_pixel=bits_per_pixel,
             sprite_width=sprite_width,
             sprite_height=sprite_height,
             transparent_color=f"{transparent_color_int:#04x}",
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include "pw_chrono/system_clock.h"
 #include "pw_framebuffer/framebuffer.h"
 #include "pw_function/function.h"
 #include "pw_status/status.h"
@@ -34,6 +35,15 @@ class Device {
   // available.
   virtual pw::framebuffer::Framebuffer GetFramebuffer() = 0;
 
+  // Retrieve a framebuffer if one is available, or an invalid framebuffer if
+  // not. Never blocks.
+  virtual pw::framebuffer::Framebuffer TryGetFramebuffer() = 0;
+
+  // Retrieve a framebuffer, waiting at most |timeout| for one to become
+  // available. Returns an invalid framebuffer if the timeout expires.
+  virtual pw::framebuffer::Framebuffer TryGetFramebufferFor(
+      pw::chrono::SystemClock::duration timeout) = 0;
+
   // Begin the process of transporting the |framebuffer| to the display.
   virtual void WriteFramebuffer(pw::framebuffer::Framebuffer framebuffer,
                                 WriteCallback write_callback) = 0;
@@ -156,6 +156,29 @@ Framebuffer MCUXpressoDevice::GetFramebuffer() {
                      framebuffer_pool_.row_bytes());
 }
 
+Framebuffer MCUXpressoDevice::TryGetFramebuffer() {
+  void* buffer = fbdev_.TryGetFramebuffer();
+  if (!buffer) {
+    return Framebuffer();
+  }
+  return Framebuffer(buffer,
+                     framebuffer_pool_.pixel_format(),
+                     framebuffer_pool_.dimensions(),
+                     framebuffer_pool_.row_bytes());
+}
+
+Framebuffer MCUXpressoDevice::TryGetFramebufferFor(
+    pw::chrono::SystemClock::duration timeout) {
+  void* buffer = fbdev_.TryGetFramebufferFor(timeout);
+  if (!buffer) {
+    return Framebuffer();
+  }
+  return Framebuffer(buffer,
+                     framebuffer_pool_.pixel_format(),
+                     framebuffer_pool_.dimensions(),
+                     framebuffer_pool_.row_bytes());
+}
+
 void MCUXpressoDevice::WriteFramebuffer(Framebuffer framebuffer,
                                         WriteCallback write_callback) {
   PW_ASSERT(framebuffer.is_valid());
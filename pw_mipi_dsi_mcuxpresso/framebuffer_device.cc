@@ -136,6 +136,21 @@ void* FramebufferDevice::GetFramebuffer() {
   return VIDEO_MEMPOOL_Get(&video_mempool_);
 }
 
+void* FramebufferDevice::TryGetFramebuffer() {
+  if (!framebuffer_semaphore_.try_acquire()) {
+    return nullptr;
+  }
+  return VIDEO_MEMPOOL_Get(&video_mempool_);
+}
+
+void* FramebufferDevice::TryGetFramebufferFor(
+    pw::chrono::SystemClock::duration timeout) {
+  if (!framebuffer_semaphore_.try_acquire_for(timeout)) {
+    return nullptr;
+  }
+  return VIDEO_MEMPOOL_Get(&video_mempool_);
+}
+
 void FramebufferDevice::WriteComplete(void* buffer, Status s) {
   PW_ASSERT(buffer == s_current_write_buffer);
   PW_ASSERT(s_write_callback);
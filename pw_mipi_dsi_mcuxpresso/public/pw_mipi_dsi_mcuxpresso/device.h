@@ -48,6 +48,9 @@ class MCUXpressoDevice : public Device {
 
   // pw::mipi::dsi::Device implementation:
   pw::framebuffer::Framebuffer GetFramebuffer() override;
+  pw::framebuffer::Framebuffer TryGetFramebuffer() override;
+  pw::framebuffer::Framebuffer TryGetFramebufferFor(
+      pw::chrono::SystemClock::duration timeout) override;
   void WriteFramebuffer(pw::framebuffer::Framebuffer framebuffer,
                         WriteCallback write_callback) override;
 
@@ -18,6 +18,7 @@
 
 #include "fsl_dc_fb.h"
 #include "fsl_video_common.h"
+#include "pw_chrono/system_clock.h"
 #include "pw_framebuffer_pool/framebuffer_pool.h"
 #include "pw_function/function.h"
 #include "pw_status/status.h"
@@ -57,6 +58,13 @@ class FramebufferDevice {
   // available.
   void* GetFramebuffer();
 
+  // Retrieve an unused framebuffer if one is available, otherwise nullptr.
+  void* TryGetFramebuffer();
+
+  // Retrieve an unused framebuffer, waiting at most |timeout| for one to
+  // become available. Returns nullptr if the timeout expires.
+  void* TryGetFramebufferFor(pw::chrono::SystemClock::duration timeout);
+
  private:
   static void BufferSwitchOffCallback(void* param, void* buffer);
   void WriteComplete(void*, Status);